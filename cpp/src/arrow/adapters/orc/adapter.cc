@@ -18,7 +18,9 @@
 #include "arrow/adapters/orc/adapter.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <list>
 #include <memory>
 #include <sstream>
@@ -37,8 +39,11 @@
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
 #include "arrow/util/bit-util.h"
+#include "arrow/util/compression.h"
 #include "arrow/util/decimal.h"
+#include "arrow/util/logging.h"
 #include "arrow/util/macros.h"
+#include "arrow/util/parallel.h"
 #include "arrow/util/visibility.h"
 
 #include "orc/OrcFile.hh"
@@ -92,12 +97,158 @@ class ArrowInputFile : public liborc::InputStream {
   std::shared_ptr<io::ReadableFileInterface> file_;
 };
 
+class ArrowOutputStream : public liborc::OutputStream {
+ public:
+  explicit ArrowOutputStream(const std::shared_ptr<io::OutputStream>& sink)
+      : sink_(sink), length_(0) {}
+
+  uint64_t getLength() const override { return length_; }
+
+  uint64_t getNaturalWriteSize() const override { return 128 * 1024; }
+
+  void write(const void* buf, size_t length) override {
+    ORC_THROW_NOT_OK(sink_->Write(reinterpret_cast<const uint8_t*>(buf),
+                                  static_cast<int64_t>(length)));
+    length_ += length;
+  }
+
+  const std::string& getName() const override {
+    static const std::string filename("ArrowOutputStream");
+    return filename;
+  }
+
+  // The sink belongs to the caller
+  void close() override {}
+
+ private:
+  std::shared_ptr<io::OutputStream> sink_;
+  uint64_t length_;
+};
+
 struct StripeInformation {
   uint64_t offset;
   uint64_t length;
   uint64_t num_rows;
+  uint64_t first_row;
 };
 
+ORCLiteral ORCLiteral::Integer(int64_t value) {
+  ORCLiteral literal;
+  literal.kind_ = INTEGER;
+  literal.int_value_ = value;
+  return literal;
+}
+
+ORCLiteral ORCLiteral::Double(double value) {
+  ORCLiteral literal;
+  literal.kind_ = DOUBLE;
+  literal.double_value_ = value;
+  return literal;
+}
+
+ORCLiteral ORCLiteral::String(const std::string& value) {
+  ORCLiteral literal;
+  literal.kind_ = STRING;
+  literal.string_value_ = value;
+  return literal;
+}
+
+template <typename T>
+static int ThreeWayCompare(const T& left, const T& right) {
+  return left < right ? -1 : (right < left ? 1 : 0);
+}
+
+bool ORCLiteral::Compare(const ORCLiteral& other, int* out) const {
+  if (kind_ == INTEGER && other.kind_ == INTEGER) {
+    *out = ThreeWayCompare(int_value_, other.int_value_);
+  } else if ((kind_ == INTEGER || kind_ == DOUBLE) &&
+             (other.kind_ == INTEGER || other.kind_ == DOUBLE)) {
+    const double left =
+        kind_ == INTEGER ? static_cast<double>(int_value_) : double_value_;
+    const double right = other.kind_ == INTEGER ? static_cast<double>(other.int_value_)
+                                                : other.double_value_;
+    if (std::isnan(left) || std::isnan(right)) {
+      return false;
+    }
+    *out = ThreeWayCompare(left, right);
+  } else if (kind_ == STRING && other.kind_ == STRING) {
+    *out = ThreeWayCompare(string_value_, other.string_value_);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+ORCPredicate::ORCPredicate(Op op, int column, const ORCLiteral& value,
+                           const std::vector<std::shared_ptr<ORCPredicate>>& children)
+    : op_(op), column_(column), value_(value), children_(children) {}
+
+std::shared_ptr<ORCPredicate> ORCPredicate::Compare(int column, Op op,
+                                                    const ORCLiteral& value) {
+  DCHECK(op != AND && op != OR);
+  return std::shared_ptr<ORCPredicate>(new ORCPredicate(op, column, value, {}));
+}
+
+std::shared_ptr<ORCPredicate> ORCPredicate::And(
+    const std::vector<std::shared_ptr<ORCPredicate>>& children) {
+  return std::shared_ptr<ORCPredicate>(new ORCPredicate(AND, -1, ORCLiteral(), children));
+}
+
+std::shared_ptr<ORCPredicate> ORCPredicate::Or(
+    const std::vector<std::shared_ptr<ORCPredicate>>& children) {
+  return std::shared_ptr<ORCPredicate>(new ORCPredicate(OR, -1, ORCLiteral(), children));
+}
+
+bool ORCPredicate::MayMatch(const std::vector<ORCColumnStatistics>& statistics) const {
+  if (op_ == AND) {
+    for (const auto& child : children_) {
+      if (!child->MayMatch(statistics)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (op_ == OR) {
+    for (const auto& child : children_) {
+      if (child->MayMatch(statistics)) {
+        return true;
+      }
+    }
+    return children_.empty();
+  }
+  if (column_ < 0 || column_ >= static_cast<int>(statistics.size())) {
+    return true;
+  }
+  const ORCColumnStatistics& column = statistics[column_];
+  // Comparisons with null are never satisfied
+  if (column.num_values == 0) {
+    return false;
+  }
+  // -1, 0 or 1 as the minimum or the maximum compares with the value
+  int min_order;
+  int max_order;
+  if (!column.minimum.Compare(value_, &min_order) ||
+      !column.maximum.Compare(value_, &max_order)) {
+    return true;
+  }
+  switch (op_) {
+    case EQUAL:
+      return min_order <= 0 && max_order >= 0;
+    case NOT_EQUAL:
+      return min_order != 0 || max_order != 0;
+    case LESS:
+      return min_order < 0;
+    case LESS_EQUAL:
+      return min_order <= 0;
+    case GREATER:
+      return max_order > 0;
+    case GREATER_EQUAL:
+      return max_order >= 0;
+    default:
+      return true;
+  }
+}
+
 Status GetArrowType(const liborc::Type* type, std::shared_ptr<DataType>* out) {
   // When subselecting fields on read, liborc will set some nodes to nullptr,
   // so we need to check for nullptr before progressing
@@ -212,12 +363,17 @@ Status GetArrowType(const liborc::Type* type, std::shared_ptr<DataType>* out) {
 // The number of rows to read in a ColumnVectorBatch
 constexpr int64_t kReadRowsBatch = 1000;
 
+// The number of rows to write in a ColumnVectorBatch
+constexpr int64_t kWriteRowsBatch = 10000;
+
 // The numer of nanoseconds in a second
 constexpr int64_t kOneSecondNanos = 1000000000LL;
 
 class ORCFileReader::Impl {
  public:
-  Impl() {}
+  class BatchReader;
+
+  Impl() : num_threads_(1) {}
   ~Impl() {}
 
   Status Open(const std::shared_ptr<io::ReadableFileInterface>& file, MemoryPool* pool) {
@@ -226,31 +382,175 @@ class ORCFileReader::Impl {
     std::unique_ptr<liborc::Reader> liborc_reader;
     try {
       liborc_reader = createReader(std::move(io_wrapper), options);
-    } catch (const liborc::ParseError& e) {
+    } catch (const std::exception& e) {
       return Status::IOError(e.what());
     }
+    file_ = file;
     pool_ = pool;
     reader_ = std::move(liborc_reader);
 
     return Init();
   }
 
+  // Open another liborc reader on the same file, from the file tail that has
+  // already been parsed, so that it does not share any state with reader_.
+  Status OpenStripeReader(const std::string& file_tail,
+                          std::unique_ptr<liborc::Reader>* out) {
+    std::unique_ptr<ArrowInputFile> io_wrapper(new ArrowInputFile(file_));
+    liborc::ReaderOptions options;
+    options.setSerializedFileTail(file_tail);
+    try {
+      *out = createReader(std::move(io_wrapper), options);
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
+    }
+    return Status::OK();
+  }
+
   Status Init() {
     int64_t nstripes = reader_->getNumberOfStripes();
     stripes_.resize(nstripes);
     std::unique_ptr<liborc::StripeInformation> stripe;
+    uint64_t first_row = 0;
     for (int i = 0; i < nstripes; ++i) {
       stripe = reader_->getStripe(i);
-      stripes_[i] = StripeInformation(
-          {stripe->getOffset(), stripe->getLength(), stripe->getNumberOfRows()});
+      stripes_[i] = StripeInformation({stripe->getOffset(), stripe->getLength(),
+                                       stripe->getNumberOfRows(), first_row});
+      first_row += stripe->getNumberOfRows();
     }
+    AddColumnTypes(&reader_->getType());
     return Status::OK();
   }
 
+  void AddColumnTypes(const liborc::Type* type) {
+    const uint64_t column = type->getColumnId();
+    if (column >= column_types_.size()) {
+      column_types_.resize(column + 1);
+    }
+    column_types_[column] = type;
+    for (uint64_t child = 0; child < type->getSubtypeCount(); ++child) {
+      AddColumnTypes(type->getSubtype(child));
+    }
+  }
+
   int64_t NumberOfStripes() { return stripes_.size(); }
 
   int64_t NumberOfRows() { return reader_->getNumberOfRows(); }
 
+  void set_num_threads(int num_threads) { num_threads_ = std::max(num_threads, 1); }
+
+  Status ReadColumnStatistics(std::vector<ORCColumnStatistics>* out) {
+    std::unique_ptr<liborc::Statistics> statistics;
+    try {
+      statistics = reader_->getStatistics();
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
+    }
+    out->resize(statistics->getNumberOfColumns());
+    for (uint32_t column = 0; column < out->size(); ++column) {
+      ConvertStatistics(column, statistics->getColumnStatistics(column), &(*out)[column]);
+    }
+    return Status::OK();
+  }
+
+  Status ReadStripeStatistics(int64_t stripe, std::vector<ORCColumnStatistics>* out) {
+    std::unique_ptr<liborc::StripeStatistics> statistics;
+    RETURN_NOT_OK(GetStripeStatistics(reader_.get(), stripe, &statistics));
+    out->clear();
+    if (statistics == nullptr) {
+      return Status::OK();
+    }
+    out->resize(statistics->getNumberOfColumns());
+    for (uint32_t column = 0; column < out->size(); ++column) {
+      ConvertStatistics(column, statistics->getColumnStatistics(column), &(*out)[column]);
+    }
+    return Status::OK();
+  }
+
+  // Set statistics to null if the file has no statistics for the stripe
+  Status GetStripeStatistics(liborc::Reader* reader, int64_t stripe,
+                             std::unique_ptr<liborc::StripeStatistics>* statistics) {
+    if (stripe < 0 || stripe >= NumberOfStripes()) {
+      std::stringstream ss;
+      ss << "Out of bounds stripe: " << stripe;
+      return Status::Invalid(ss.str());
+    }
+    statistics->reset();
+    try {
+      if (static_cast<uint64_t>(stripe) < reader->getNumberOfStripeStatistics()) {
+        *statistics = reader->getStripeStatistics(stripe);
+      }
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
+    }
+    return Status::OK();
+  }
+
+  void ConvertStatistics(uint32_t column, const liborc::ColumnStatistics* statistics,
+                         ORCColumnStatistics* out) {
+    *out = ORCColumnStatistics();
+    if (statistics == nullptr) {
+      return;
+    }
+    out->num_values = static_cast<int64_t>(statistics->getNumberOfValues());
+    out->has_null = statistics->hasNull();
+    if (column >= column_types_.size() || column_types_[column] == nullptr) {
+      return;
+    }
+    switch (column_types_[column]->getKind()) {
+      case liborc::BYTE:
+      case liborc::SHORT:
+      case liborc::INT:
+      case liborc::LONG: {
+        auto stats = dynamic_cast<const liborc::IntegerColumnStatistics*>(statistics);
+        if (stats != nullptr && stats->hasMinimum() && stats->hasMaximum()) {
+          out->minimum = ORCLiteral::Integer(stats->getMinimum());
+          out->maximum = ORCLiteral::Integer(stats->getMaximum());
+        }
+        break;
+      }
+      case liborc::DATE: {
+        auto stats = dynamic_cast<const liborc::DateColumnStatistics*>(statistics);
+        if (stats != nullptr && stats->hasMinimum() && stats->hasMaximum()) {
+          out->minimum = ORCLiteral::Integer(stats->getMinimum());
+          out->maximum = ORCLiteral::Integer(stats->getMaximum());
+        }
+        break;
+      }
+      case liborc::TIMESTAMP: {
+        // The statistics are in milliseconds, and the values in nanoseconds
+        auto stats = dynamic_cast<const liborc::TimestampColumnStatistics*>(statistics);
+        if (stats != nullptr && stats->hasMinimum() && stats->hasMaximum()) {
+          constexpr int64_t kOneMilliNanos = 1000000LL;
+          const int64_t maximum = (stats->getMaximum() + 1) * kOneMilliNanos - 1;
+          out->minimum = ORCLiteral::Integer(stats->getMinimum() * kOneMilliNanos);
+          out->maximum = ORCLiteral::Integer(maximum);
+        }
+        break;
+      }
+      case liborc::FLOAT:
+      case liborc::DOUBLE: {
+        auto stats = dynamic_cast<const liborc::DoubleColumnStatistics*>(statistics);
+        if (stats != nullptr && stats->hasMinimum() && stats->hasMaximum()) {
+          out->minimum = ORCLiteral::Double(stats->getMinimum());
+          out->maximum = ORCLiteral::Double(stats->getMaximum());
+        }
+        break;
+      }
+      case liborc::VARCHAR:
+      case liborc::STRING: {
+        auto stats = dynamic_cast<const liborc::StringColumnStatistics*>(statistics);
+        if (stats != nullptr && stats->hasMinimum() && stats->hasMaximum()) {
+          out->minimum = ORCLiteral::String(stats->getMinimum());
+          out->maximum = ORCLiteral::String(stats->getMaximum());
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
   Status ReadSchema(std::shared_ptr<Schema>* out) {
     const liborc::Type& type = reader_->getType();
     return GetArrowSchema(type, out);
@@ -294,10 +594,144 @@ class ORCFileReader::Impl {
     return ReadTable(opts, out);
   }
 
+  Status Read(const std::vector<int>& include_indices, const ORCPredicate& predicate,
+              std::shared_ptr<Table>* out) {
+    liborc::RowReaderOptions opts;
+    RETURN_NOT_OK(SelectIndices(&opts, include_indices));
+    // The stripes that cannot match are left null
+    std::vector<std::shared_ptr<RecordBatch>> stripe_batches(stripes_.size());
+    auto read_stripe = [this, &opts, &predicate, &stripe_batches](liborc::Reader* reader,
+                                                                  int stripe) {
+      std::vector<std::pair<int64_t, int64_t>> row_ranges;
+      RETURN_NOT_OK(SelectRowGroups(reader, stripe, predicate, &row_ranges));
+      if (row_ranges.empty()) {
+        return Status::OK();
+      }
+      liborc::RowReaderOptions stripe_opts(opts);
+      stripe_opts.range(stripes_[stripe].offset, stripes_[stripe].length);
+      return ReadRowRanges(reader, stripe_opts, stripe, row_ranges,
+                           &stripe_batches[stripe]);
+    };
+    RETURN_NOT_OK(ForEachStripe(read_stripe));
+
+    std::vector<std::shared_ptr<RecordBatch>> batches;
+    for (const auto& batch : stripe_batches) {
+      if (batch != nullptr) {
+        batches.push_back(batch);
+      }
+    }
+    if (batches.empty() && NumberOfStripes() > 0) {
+      // Read no rows to get an empty table with the selected schema
+      std::shared_ptr<RecordBatch> batch;
+      RETURN_NOT_OK(SelectStripe(&opts, 0));
+      RETURN_NOT_OK(ReadRowRanges(reader_.get(), opts, 0, {}, &batch));
+      batches.push_back(batch);
+    }
+    return Table::FromRecordBatches(batches, out);
+  }
+
+  // Find the ranges of rows in a stripe, as pairs of the first row and the
+  // end row within the stripe, whose row group may satisfy the predicate.
+  Status SelectRowGroups(liborc::Reader* reader, int64_t stripe,
+                         const ORCPredicate& predicate,
+                         std::vector<std::pair<int64_t, int64_t>>* row_ranges) {
+    const int64_t num_rows = static_cast<int64_t>(stripes_[stripe].num_rows);
+    std::unique_ptr<liborc::StripeStatistics> statistics;
+    RETURN_NOT_OK(GetStripeStatistics(reader, stripe, &statistics));
+    if (statistics == nullptr) {
+      row_ranges->emplace_back(0, num_rows);
+      return Status::OK();
+    }
+    const uint32_t num_columns = statistics->getNumberOfColumns();
+    std::vector<ORCColumnStatistics> column_statistics(num_columns);
+    for (uint32_t column = 0; column < num_columns; ++column) {
+      ConvertStatistics(column, statistics->getColumnStatistics(column),
+                        &column_statistics[column]);
+    }
+    if (!predicate.MayMatch(column_statistics)) {
+      return Status::OK();
+    }
+
+    const int64_t stride = static_cast<int64_t>(reader->getRowIndexStride());
+    if (stride == 0) {
+      row_ranges->emplace_back(0, num_rows);
+      return Status::OK();
+    }
+    const int64_t num_groups = (num_rows + stride - 1) / stride;
+    for (int64_t group = 0; group < num_groups; ++group) {
+      for (uint32_t column = 0; column < num_columns; ++column) {
+        const liborc::ColumnStatistics* group_statistics = nullptr;
+        if (group < statistics->getNumberOfRowIndexStats(column)) {
+          group_statistics =
+              statistics->getRowIndexStatistics(column, static_cast<uint32_t>(group));
+        }
+        ConvertStatistics(column, group_statistics, &column_statistics[column]);
+      }
+      if (!predicate.MayMatch(column_statistics)) {
+        continue;
+      }
+      const int64_t start = group * stride;
+      const int64_t end = std::min(start + stride, num_rows);
+      if (!row_ranges->empty() && row_ranges->back().second == start) {
+        row_ranges->back().second = end;
+      } else {
+        row_ranges->emplace_back(start, end);
+      }
+    }
+    return Status::OK();
+  }
+
+  Status ReadRowRanges(liborc::Reader* reader, const liborc::RowReaderOptions& opts,
+                       int64_t stripe,
+                       const std::vector<std::pair<int64_t, int64_t>>& row_ranges,
+                       std::shared_ptr<RecordBatch>* out) {
+    int64_t nrows = 0;
+    for (const auto& range : row_ranges) {
+      nrows += range.second - range.first;
+    }
+    std::unique_ptr<liborc::RowReader> rowreader;
+    std::unique_ptr<liborc::ColumnVectorBatch> batch;
+    try {
+      rowreader = reader->createRowReader(opts);
+      // liborc does not allow empty batches
+      const int64_t batch_size = std::max<int64_t>(1, std::min(nrows, kReadRowsBatch));
+      batch = rowreader->createRowBatch(batch_size);
+    } catch (const std::exception& e) {
+      return Status::Invalid(e.what());
+    }
+    const liborc::Type& type = rowreader->getSelectedType();
+    std::shared_ptr<Schema> schema;
+    RETURN_NOT_OK(GetArrowSchema(type, &schema));
+
+    std::unique_ptr<RecordBatchBuilder> builder;
+    RETURN_NOT_OK(RecordBatchBuilder::Make(schema, pool_, nrows, &builder));
+
+    const auto& struct_batch = static_cast<liborc::StructVectorBatch&>(*batch);
+    try {
+      int64_t position = 0;
+      for (const auto& range : row_ranges) {
+        // Seeking uses the row index, so avoid it when reading on
+        if (range.first != position) {
+          rowreader->seekToRow(stripes_[stripe].first_row + range.first);
+        }
+        int64_t remaining = range.second - range.first;
+        while (remaining > 0 && rowreader->next(*batch)) {
+          const int64_t length = std::min<int64_t>(remaining, batch->numElements);
+          RETURN_NOT_OK(AppendFields(type, struct_batch, 0, length, builder.get()));
+          remaining -= length;
+        }
+        position = range.second;
+      }
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
+    }
+    return builder->Flush(out);
+  }
+
   Status ReadStripe(int64_t stripe, std::shared_ptr<RecordBatch>* out) {
     liborc::RowReaderOptions opts;
     RETURN_NOT_OK(SelectStripe(&opts, stripe));
-    return ReadBatch(opts, stripes_[stripe].num_rows, out);
+    return ReadBatch(reader_.get(), opts, stripes_[stripe].num_rows, out);
   }
 
   Status ReadStripe(int64_t stripe, const std::vector<int>& include_indices,
@@ -305,9 +739,25 @@ class ORCFileReader::Impl {
     liborc::RowReaderOptions opts;
     RETURN_NOT_OK(SelectIndices(&opts, include_indices));
     RETURN_NOT_OK(SelectStripe(&opts, stripe));
-    return ReadBatch(opts, stripes_[stripe].num_rows, out);
+    return ReadBatch(reader_.get(), opts, stripes_[stripe].num_rows, out);
+  }
+
+  Status GetRecordBatchReader(int64_t batch_size,
+                              std::shared_ptr<RecordBatchReader>* out) {
+    liborc::RowReaderOptions opts;
+    return GetRecordBatchReader(opts, batch_size, out);
   }
 
+  Status GetRecordBatchReader(int64_t batch_size, const std::vector<int>& include_indices,
+                              std::shared_ptr<RecordBatchReader>* out) {
+    liborc::RowReaderOptions opts;
+    RETURN_NOT_OK(SelectIndices(&opts, include_indices));
+    return GetRecordBatchReader(opts, batch_size, out);
+  }
+
+  Status GetRecordBatchReader(const liborc::RowReaderOptions& opts, int64_t batch_size,
+                              std::shared_ptr<RecordBatchReader>* out);
+
   Status SelectStripe(liborc::RowReaderOptions* opts, int64_t stripe) {
     if (stripe < 0 || stripe >= NumberOfStripes()) {
       std::stringstream ss;
@@ -333,23 +783,46 @@ class ORCFileReader::Impl {
 
   Status ReadTable(const liborc::RowReaderOptions& row_opts,
                    std::shared_ptr<Table>* out) {
-    liborc::RowReaderOptions opts(row_opts);
     std::vector<std::shared_ptr<RecordBatch>> batches(stripes_.size());
-    for (size_t stripe = 0; stripe < stripes_.size(); stripe++) {
+    auto read_stripe = [this, &row_opts, &batches](liborc::Reader* reader, int stripe) {
+      liborc::RowReaderOptions opts(row_opts);
       opts.range(stripes_[stripe].offset, stripes_[stripe].length);
-      RETURN_NOT_OK(ReadBatch(opts, stripes_[stripe].num_rows, &batches[stripe]));
-    }
+      return ReadBatch(reader, opts, stripes_[stripe].num_rows, &batches[stripe]);
+    };
+    RETURN_NOT_OK(ForEachStripe(read_stripe));
     return Table::FromRecordBatches(batches, out);
   }
 
-  Status ReadBatch(const liborc::RowReaderOptions& opts, int64_t nrows,
-                   std::shared_ptr<RecordBatch>* out) {
+  // Call func(reader, stripe) for each stripe. With more than one thread,
+  // the stripes are processed concurrently and each by its own liborc
+  // reader, since those are not thread-safe. They all read through the same
+  // file, whose ReadAt is. Otherwise they are processed in order by reader_.
+  template <typename Function>
+  Status ForEachStripe(Function&& func) {
+    const int nstripes = static_cast<int>(stripes_.size());
+    if (num_threads_ > 1 && nstripes > 1) {
+      const std::string file_tail = reader_->getSerializedFileTail();
+      auto process_stripe = [this, &file_tail, &func](int stripe) {
+        std::unique_ptr<liborc::Reader> reader;
+        RETURN_NOT_OK(OpenStripeReader(file_tail, &reader));
+        return func(reader.get(), stripe);
+      };
+      return ParallelFor(std::min(num_threads_, nstripes), nstripes, process_stripe);
+    }
+    for (int stripe = 0; stripe < nstripes; stripe++) {
+      RETURN_NOT_OK(func(reader_.get(), stripe));
+    }
+    return Status::OK();
+  }
+
+  Status ReadBatch(liborc::Reader* reader, const liborc::RowReaderOptions& opts,
+                   int64_t nrows, std::shared_ptr<RecordBatch>* out) {
     std::unique_ptr<liborc::RowReader> rowreader;
     std::unique_ptr<liborc::ColumnVectorBatch> batch;
     try {
-      rowreader = reader_->createRowReader(opts);
+      rowreader = reader->createRowReader(opts);
       batch = rowreader->createRowBatch(std::min(nrows, kReadRowsBatch));
-    } catch (const liborc::ParseError& e) {
+    } catch (const std::exception& e) {
       return Status::Invalid(e.what());
     }
     const liborc::Type& type = rowreader->getSelectedType();
@@ -362,18 +835,32 @@ class ORCFileReader::Impl {
     // The top-level type must be a struct to read into an arrow table
     const auto& struct_batch = static_cast<liborc::StructVectorBatch&>(*batch);
 
-    while (rowreader->next(*batch)) {
-      for (int i = 0; i < builder->num_fields(); i++) {
-        RETURN_NOT_OK(AppendBatch(type.getSubtype(i), struct_batch.fields[i], 0,
-                                  batch->numElements, builder->GetField(i)));
+    // No exception must escape, as this may run on a worker thread. liborc
+    // also throws exceptions other than ParseError, such as std::logic_error.
+    try {
+      while (rowreader->next(*batch)) {
+        RETURN_NOT_OK(
+            AppendFields(type, struct_batch, 0, batch->numElements, builder.get()));
       }
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
     }
     RETURN_NOT_OK(builder->Flush(out));
     return Status::OK();
   }
 
-  Status AppendBatch(const liborc::Type* type, liborc::ColumnVectorBatch* batch,
-                     int64_t offset, int64_t length, ArrayBuilder* builder) {
+  static Status AppendFields(const liborc::Type& type,
+                             const liborc::StructVectorBatch& batch, int64_t offset,
+                             int64_t length, RecordBatchBuilder* builder) {
+    for (int i = 0; i < builder->num_fields(); i++) {
+      RETURN_NOT_OK(AppendBatch(type.getSubtype(i), batch.fields[i], offset, length,
+                                builder->GetField(i)));
+    }
+    return Status::OK();
+  }
+
+  static Status AppendBatch(const liborc::Type* type, liborc::ColumnVectorBatch* batch,
+                            int64_t offset, int64_t length, ArrayBuilder* builder) {
     if (type == nullptr) {
       return Status::OK();
     }
@@ -426,8 +913,9 @@ class ORCFileReader::Impl {
     }
   }
 
-  Status AppendStructBatch(const liborc::Type* type, liborc::ColumnVectorBatch* cbatch,
-                           int64_t offset, int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendStructBatch(const liborc::Type* type,
+                                  liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                  int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<StructBuilder*>(abuilder);
     auto batch = static_cast<liborc::StructVectorBatch*>(cbatch);
 
@@ -444,30 +932,35 @@ class ORCFileReader::Impl {
     return Status::OK();
   }
 
-  Status AppendListBatch(const liborc::Type* type, liborc::ColumnVectorBatch* cbatch,
-                         int64_t offset, int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendListBatch(const liborc::Type* type,
+                                liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<ListBuilder*>(abuilder);
     auto batch = static_cast<liborc::ListVectorBatch*>(cbatch);
     liborc::ColumnVectorBatch* elements = batch->elements.get();
     const liborc::Type* elemtype = type->getSubtype(0);
 
-    const bool has_nulls = batch->hasNulls;
-    for (int64_t i = offset; i < length + offset; i++) {
-      if (!has_nulls || batch->notNull[i]) {
-        int64_t start = batch->offsets[i];
-        int64_t end = batch->offsets[i + 1];
-        RETURN_NOT_OK(builder->Append());
-        RETURN_NOT_OK(AppendBatch(elemtype, elements, start, end - start,
-                                  builder->value_builder()));
-      } else {
-        RETURN_NOT_OK(builder->AppendNull());
-      }
+    if (length == 0) {
+      return Status::OK();
     }
-    return Status::OK();
+    // The elements of all the lists are contiguous, so they are appended at once
+    const int64_t* source_offsets = batch->offsets.data() + offset;
+    std::vector<int32_t> offsets;
+    RETURN_NOT_OK(ConvertOffsets(source_offsets, length,
+                                 builder->value_builder()->length(), &offsets));
+    const uint8_t* valid_bytes = nullptr;
+    if (batch->hasNulls) {
+      valid_bytes = reinterpret_cast<const uint8_t*>(batch->notNull.data()) + offset;
+    }
+    RETURN_NOT_OK(builder->Append(offsets.data(), length, valid_bytes));
+    return AppendBatch(elemtype, elements, source_offsets[0],
+                       source_offsets[length] - source_offsets[0],
+                       builder->value_builder());
   }
 
-  Status AppendMapBatch(const liborc::Type* type, liborc::ColumnVectorBatch* cbatch,
-                        int64_t offset, int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendMapBatch(const liborc::Type* type,
+                               liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                               int64_t length, ArrayBuilder* abuilder) {
     auto list_builder = static_cast<ListBuilder*>(abuilder);
     auto struct_builder = static_cast<StructBuilder*>(list_builder->value_builder());
     auto batch = static_cast<liborc::MapVectorBatch*>(cbatch);
@@ -476,25 +969,47 @@ class ORCFileReader::Impl {
     const liborc::Type* keytype = type->getSubtype(0);
     const liborc::Type* valtype = type->getSubtype(1);
 
-    const bool has_nulls = batch->hasNulls;
-    for (int64_t i = offset; i < length + offset; i++) {
-      RETURN_NOT_OK(list_builder->Append());
-      int64_t start = batch->offsets[i];
-      int64_t list_length = batch->offsets[i + 1] - start;
-      if (list_length && (!has_nulls || batch->notNull[i])) {
-        RETURN_NOT_OK(struct_builder->Append(list_length, nullptr));
-        RETURN_NOT_OK(AppendBatch(keytype, keys, start, list_length,
-                                  struct_builder->field_builder(0)));
-        RETURN_NOT_OK(AppendBatch(valtype, vals, start, list_length,
-                                  struct_builder->field_builder(1)));
-      }
+    if (length == 0) {
+      return Status::OK();
+    }
+    const int64_t* source_offsets = batch->offsets.data() + offset;
+    std::vector<int32_t> offsets;
+    RETURN_NOT_OK(
+        ConvertOffsets(source_offsets, length, struct_builder->length(), &offsets));
+    const uint8_t* valid_bytes = nullptr;
+    if (batch->hasNulls) {
+      valid_bytes = reinterpret_cast<const uint8_t*>(batch->notNull.data()) + offset;
+    }
+    RETURN_NOT_OK(list_builder->Append(offsets.data(), length, valid_bytes));
+
+    const int64_t start = source_offsets[0];
+    const int64_t num_entries = source_offsets[length] - start;
+    RETURN_NOT_OK(struct_builder->Append(num_entries, nullptr));
+    RETURN_NOT_OK(
+        AppendBatch(keytype, keys, start, num_entries, struct_builder->field_builder(0)));
+    return AppendBatch(valtype, vals, start, num_entries,
+                       struct_builder->field_builder(1));
+  }
+
+  // Rebase the offsets of a batch of lists onto the values already in the
+  // builder. liborc gives null lists a length of zero, so the offsets can be
+  // used as they are.
+  static Status ConvertOffsets(const int64_t* source, int64_t length, int64_t base,
+                               std::vector<int32_t>* out) {
+    if (base + source[length] - source[0] > std::numeric_limits<int32_t>::max()) {
+      return Status::Invalid("ListArray cannot contain more than INT32_MAX elements");
+    }
+    out->resize(length);
+    const int64_t shift = base - source[0];
+    for (int64_t i = 0; i < length; i++) {
+      (*out)[i] = static_cast<int32_t>(source[i] + shift);
     }
     return Status::OK();
   }
 
   template <class builder_type, class batch_type, class elem_type>
-  Status AppendNumericBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
-                            int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendNumericBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                   int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<builder_type*>(abuilder);
     auto batch = static_cast<batch_type*>(cbatch);
 
@@ -511,8 +1026,8 @@ class ORCFileReader::Impl {
   }
 
   template <class builder_type, class target_type, class batch_type, class source_type>
-  Status AppendNumericBatchCast(liborc::ColumnVectorBatch* cbatch, int64_t offset,
-                                int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendNumericBatchCast(liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                       int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<builder_type*>(abuilder);
     auto batch = static_cast<batch_type*>(cbatch);
 
@@ -535,8 +1050,8 @@ class ORCFileReader::Impl {
     return Status::OK();
   }
 
-  Status AppendBoolBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
-                         int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendBoolBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<BooleanBuilder*>(abuilder);
     auto batch = static_cast<liborc::LongVectorBatch*>(cbatch);
 
@@ -555,17 +1070,13 @@ class ORCFileReader::Impl {
     uint8_t* target = reinterpret_cast<uint8_t*>(builder->data()->mutable_data());
 
     for (int64_t i = 0; i < length; i++) {
-      if (source[i]) {
-        BitUtil::SetBit(target, start + i);
-      } else {
-        BitUtil::ClearBit(target, start + i);
-      }
+      BitUtil::SetBitTo(target, start + i, source[i] != 0);
     }
     return Status::OK();
   }
 
-  Status AppendTimestampBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
-                              int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendTimestampBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                     int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<TimestampBuilder*>(abuilder);
     auto batch = static_cast<liborc::TimestampVectorBatch*>(cbatch);
 
@@ -593,12 +1104,21 @@ class ORCFileReader::Impl {
   }
 
   template <class builder_type>
-  Status AppendBinaryBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
-                           int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendBinaryBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                  int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<builder_type*>(abuilder);
     auto batch = static_cast<liborc::StringVectorBatch*>(cbatch);
 
+    // Reserve the offsets and the value data once for the whole batch
     const bool has_nulls = batch->hasNulls;
+    int64_t data_length = 0;
+    for (int64_t i = offset; i < length + offset; i++) {
+      if (!has_nulls || batch->notNull[i]) {
+        data_length += batch->length[i];
+      }
+    }
+    RETURN_NOT_OK(builder->Reserve(length));
+    RETURN_NOT_OK(builder->ReserveData(data_length));
     for (int64_t i = offset; i < length + offset; i++) {
       if (!has_nulls || batch->notNull[i]) {
         RETURN_NOT_OK(
@@ -610,11 +1130,12 @@ class ORCFileReader::Impl {
     return Status::OK();
   }
 
-  Status AppendFixedBinaryBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
-                                int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendFixedBinaryBatch(liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                       int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<FixedSizeBinaryBuilder*>(abuilder);
     auto batch = static_cast<liborc::StringVectorBatch*>(cbatch);
 
+    RETURN_NOT_OK(builder->Reserve(length));
     const bool has_nulls = batch->hasNulls;
     for (int64_t i = offset; i < length + offset; i++) {
       if (!has_nulls || batch->notNull[i]) {
@@ -626,10 +1147,12 @@ class ORCFileReader::Impl {
     return Status::OK();
   }
 
-  Status AppendDecimalBatch(const liborc::Type* type, liborc::ColumnVectorBatch* cbatch,
-                            int64_t offset, int64_t length, ArrayBuilder* abuilder) {
+  static Status AppendDecimalBatch(const liborc::Type* type,
+                                   liborc::ColumnVectorBatch* cbatch, int64_t offset,
+                                   int64_t length, ArrayBuilder* abuilder) {
     auto builder = static_cast<Decimal128Builder*>(abuilder);
 
+    RETURN_NOT_OK(builder->Reserve(length));
     const bool has_nulls = cbatch->hasNulls;
     if (type->getPrecision() == 0 || type->getPrecision() > 18) {
       auto batch = static_cast<liborc::Decimal128VectorBatch*>(cbatch);
@@ -655,11 +1178,98 @@ class ORCFileReader::Impl {
   }
 
  private:
+  std::shared_ptr<io::ReadableFileInterface> file_;
   MemoryPool* pool_;
   std::unique_ptr<liborc::Reader> reader_;
   std::vector<StripeInformation> stripes_;
+  // The types of the columns by ORC column id
+  std::vector<const liborc::Type*> column_types_;
+  int num_threads_;
+};
+
+// Reads an ORC file in batches of a fixed number of rows, except for the
+// last one. liborc stops its batches at the end of each stripe, so the rows
+// of the liborc batch that do not fit in a batch are kept for the next one.
+// The liborc batch is reused, so only one batch of the file is decoded in
+// memory at a time.
+class ORCFileReader::Impl::BatchReader : public RecordBatchReader {
+ public:
+  BatchReader(std::unique_ptr<liborc::RowReader> rowreader,
+              std::unique_ptr<liborc::ColumnVectorBatch> batch, int64_t batch_size,
+              const std::shared_ptr<Schema>& schema, MemoryPool* pool)
+      : rowreader_(std::move(rowreader)),
+        batch_(std::move(batch)),
+        batch_size_(batch_size),
+        position_(0),
+        schema_(schema),
+        pool_(pool) {}
+
+  std::shared_ptr<Schema> schema() const override { return schema_; }
+
+  Status ReadNext(std::shared_ptr<RecordBatch>* out) override {
+    std::unique_ptr<RecordBatchBuilder> builder;
+    RETURN_NOT_OK(RecordBatchBuilder::Make(schema_, pool_, batch_size_, &builder));
+    const liborc::Type& type = rowreader_->getSelectedType();
+    const auto& struct_batch = static_cast<liborc::StructVectorBatch&>(*batch_);
+    int64_t num_rows = 0;
+    while (num_rows < batch_size_) {
+      if (position_ == static_cast<int64_t>(batch_->numElements)) {
+        try {
+          if (!rowreader_->next(*batch_)) {
+            break;
+          }
+        } catch (const std::exception& e) {
+          return Status::IOError(e.what());
+        }
+        position_ = 0;
+      }
+      const int64_t length = std::min(
+          batch_size_ - num_rows, static_cast<int64_t>(batch_->numElements) - position_);
+      RETURN_NOT_OK(
+          Impl::AppendFields(type, struct_batch, position_, length, builder.get()));
+      position_ += length;
+      num_rows += length;
+    }
+    if (num_rows == 0) {
+      out->reset();
+      return Status::OK();
+    }
+    return builder->Flush(out);
+  }
+
+ private:
+  std::unique_ptr<liborc::RowReader> rowreader_;
+  std::unique_ptr<liborc::ColumnVectorBatch> batch_;
+  int64_t batch_size_;
+  // The number of rows of batch_ already returned
+  int64_t position_;
+  std::shared_ptr<Schema> schema_;
+  MemoryPool* pool_;
 };
 
+Status ORCFileReader::Impl::GetRecordBatchReader(
+    const liborc::RowReaderOptions& opts, int64_t batch_size,
+    std::shared_ptr<RecordBatchReader>* out) {
+  if (batch_size <= 0) {
+    return Status::Invalid("Batch size must be positive");
+  }
+  // The row reader keeps the file contents alive, so the batch reader does
+  // not depend on this reader.
+  std::unique_ptr<liborc::RowReader> rowreader;
+  std::unique_ptr<liborc::ColumnVectorBatch> batch;
+  try {
+    rowreader = reader_->createRowReader(opts);
+    batch = rowreader->createRowBatch(batch_size);
+  } catch (const std::exception& e) {
+    return Status::Invalid(e.what());
+  }
+  std::shared_ptr<Schema> schema;
+  RETURN_NOT_OK(GetArrowSchema(rowreader->getSelectedType(), &schema));
+  *out = std::make_shared<BatchReader>(std::move(rowreader), std::move(batch),
+                                       batch_size, schema, pool_);
+  return Status::OK();
+}
+
 ORCFileReader::ORCFileReader() { impl_.reset(new ORCFileReader::Impl()); }
 
 ORCFileReader::~ORCFileReader() {}
@@ -683,6 +1293,11 @@ Status ORCFileReader::Read(const std::vector<int>& include_indices,
   return impl_->Read(include_indices, out);
 }
 
+Status ORCFileReader::Read(const std::vector<int>& include_indices,
+                           const ORCPredicate& predicate, std::shared_ptr<Table>* out) {
+  return impl_->Read(include_indices, predicate, out);
+}
+
 Status ORCFileReader::ReadStripe(int64_t stripe, std::shared_ptr<RecordBatch>* out) {
   return impl_->ReadStripe(stripe, out);
 }
@@ -692,10 +1307,446 @@ Status ORCFileReader::ReadStripe(int64_t stripe, const std::vector<int>& include
   return impl_->ReadStripe(stripe, include_indices, out);
 }
 
+Status ORCFileReader::ReadColumnStatistics(std::vector<ORCColumnStatistics>* out) {
+  return impl_->ReadColumnStatistics(out);
+}
+
+Status ORCFileReader::ReadStripeStatistics(int64_t stripe,
+                                           std::vector<ORCColumnStatistics>* out) {
+  return impl_->ReadStripeStatistics(stripe, out);
+}
+
 int64_t ORCFileReader::NumberOfStripes() { return impl_->NumberOfStripes(); }
 
 int64_t ORCFileReader::NumberOfRows() { return impl_->NumberOfRows(); }
 
+Status ORCFileReader::GetRecordBatchReader(int64_t batch_size,
+                                           std::shared_ptr<RecordBatchReader>* out) {
+  return impl_->GetRecordBatchReader(batch_size, out);
+}
+
+Status ORCFileReader::GetRecordBatchReader(int64_t batch_size,
+                                           const std::vector<int>& include_indices,
+                                           std::shared_ptr<RecordBatchReader>* out) {
+  return impl_->GetRecordBatchReader(batch_size, include_indices, out);
+}
+
+void ORCFileReader::set_num_threads(int num_threads) {
+  impl_->set_num_threads(num_threads);
+}
+
+// ----------------------------------------------------------------------
+// ORCFileWriter
+
+ORCWriterOptions::ORCWriterOptions()
+    : stripe_size(64 * 1024 * 1024),
+      compression(Compression::GZIP),
+      compression_block_size(64 * 1024),
+      row_index_stride(10000),
+      batch_size(kWriteRowsBatch) {}
+
+Status GetORCType(const DataType& type, std::unique_ptr<liborc::Type>* out) {
+  switch (type.id()) {
+    case Type::BOOL:
+      *out = liborc::createPrimitiveType(liborc::BOOLEAN);
+      break;
+    case Type::INT8:
+      *out = liborc::createPrimitiveType(liborc::BYTE);
+      break;
+    case Type::INT16:
+      *out = liborc::createPrimitiveType(liborc::SHORT);
+      break;
+    case Type::INT32:
+      *out = liborc::createPrimitiveType(liborc::INT);
+      break;
+    case Type::INT64:
+      *out = liborc::createPrimitiveType(liborc::LONG);
+      break;
+    case Type::FLOAT:
+      *out = liborc::createPrimitiveType(liborc::FLOAT);
+      break;
+    case Type::DOUBLE:
+      *out = liborc::createPrimitiveType(liborc::DOUBLE);
+      break;
+    case Type::STRING:
+      *out = liborc::createPrimitiveType(liborc::STRING);
+      break;
+    case Type::BINARY:
+    case Type::FIXED_SIZE_BINARY:
+      *out = liborc::createPrimitiveType(liborc::BINARY);
+      break;
+    case Type::DATE32:
+      *out = liborc::createPrimitiveType(liborc::DATE);
+      break;
+    case Type::TIMESTAMP:
+      *out = liborc::createPrimitiveType(liborc::TIMESTAMP);
+      break;
+    case Type::DECIMAL: {
+      const auto& decimal_type = static_cast<const Decimal128Type&>(type);
+      *out = liborc::createDecimalType(decimal_type.precision(), decimal_type.scale());
+      break;
+    }
+    case Type::LIST: {
+      std::unique_ptr<liborc::Type> elemtype;
+      RETURN_NOT_OK(GetORCType(*type.child(0)->type(), &elemtype));
+      *out = liborc::createListType(std::move(elemtype));
+      break;
+    }
+    case Type::STRUCT: {
+      *out = liborc::createStructType();
+      for (int child = 0; child < type.num_children(); ++child) {
+        std::unique_ptr<liborc::Type> elemtype;
+        RETURN_NOT_OK(GetORCType(*type.child(child)->type(), &elemtype));
+        (*out)->addStructField(type.child(child)->name(), std::move(elemtype));
+      }
+      break;
+    }
+    default: {
+      std::stringstream ss;
+      ss << "Arrow type " << type.ToString() << " cannot be written to ORC";
+      return Status::NotImplemented(ss.str());
+    }
+  }
+  return Status::OK();
+}
+
+Status GetORCCompression(Compression::type compression, liborc::CompressionKind* out) {
+  switch (compression) {
+    case Compression::UNCOMPRESSED:
+      *out = liborc::CompressionKind_NONE;
+      break;
+    case Compression::GZIP:
+      *out = liborc::CompressionKind_ZLIB;
+      break;
+    case Compression::SNAPPY:
+      *out = liborc::CompressionKind_SNAPPY;
+      break;
+    case Compression::LZ4:
+      *out = liborc::CompressionKind_LZ4;
+      break;
+    case Compression::ZSTD:
+      *out = liborc::CompressionKind_ZSTD;
+      break;
+    case Compression::LZO:
+      *out = liborc::CompressionKind_LZO;
+      break;
+    default:
+      return Status::NotImplemented("Compression is not supported by ORC");
+  }
+  return Status::OK();
+}
+
+// Fill liborc batches from a range of an Arrow array. Fixed width values are
+// copied in bulk, and binary values point into the Arrow buffers.
+class ORCBatchFiller {
+ public:
+  static Status Fill(const Array& array, int64_t offset, int64_t length,
+                     liborc::ColumnVectorBatch* batch) {
+    FillNulls(array, offset, length, batch);
+    switch (array.type_id()) {
+      case Type::BOOL:
+        return FillBool(array, offset, length, batch);
+      case Type::INT8:
+        return FillNumeric<Int8Type, liborc::LongVectorBatch>(array, offset, length,
+                                                               batch);
+      case Type::INT16:
+        return FillNumeric<Int16Type, liborc::LongVectorBatch>(array, offset, length,
+                                                                batch);
+      case Type::INT32:
+        return FillNumeric<Int32Type, liborc::LongVectorBatch>(array, offset, length,
+                                                                batch);
+      case Type::INT64:
+        return FillNumeric<Int64Type, liborc::LongVectorBatch>(array, offset, length,
+                                                                batch);
+      case Type::FLOAT:
+        return FillNumeric<FloatType, liborc::DoubleVectorBatch>(array, offset, length,
+                                                                  batch);
+      case Type::DOUBLE:
+        return FillNumeric<DoubleType, liborc::DoubleVectorBatch>(array, offset, length,
+                                                                   batch);
+      case Type::DATE32:
+        return FillNumeric<Date32Type, liborc::LongVectorBatch>(array, offset, length,
+                                                                 batch);
+      case Type::STRING:
+      case Type::BINARY:
+        return FillBinary(array, offset, length, batch);
+      case Type::FIXED_SIZE_BINARY:
+        return FillFixedBinary(array, offset, length, batch);
+      case Type::TIMESTAMP:
+        return FillTimestamp(array, offset, length, batch);
+      case Type::DECIMAL:
+        return FillDecimal(array, offset, length, batch);
+      case Type::LIST:
+        return FillList(array, offset, length, batch);
+      case Type::STRUCT:
+        return FillStruct(array, offset, length, batch);
+      default: {
+        std::stringstream ss;
+        ss << "Arrow type " << array.type()->ToString() << " cannot be written to ORC";
+        return Status::NotImplemented(ss.str());
+      }
+    }
+  }
+
+ private:
+  static void FillNulls(const Array& array, int64_t offset, int64_t length,
+                        liborc::ColumnVectorBatch* batch) {
+    batch->numElements = length;
+    batch->hasNulls = array.null_count() > 0;
+    if (batch->hasNulls) {
+      char* not_null = batch->notNull.data();
+      internal::BitmapReader valid_reader(array.null_bitmap_data(),
+                                          array.offset() + offset, length);
+      for (int64_t i = 0; i < length; i++) {
+        not_null[i] = valid_reader.IsSet();
+        valid_reader.Next();
+      }
+    }
+  }
+
+  template <class ArrowType, class batch_type>
+  static Status FillNumeric(const Array& array, int64_t offset, int64_t length,
+                            liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<batch_type*>(cbatch);
+    const auto* source =
+        static_cast<const NumericArray<ArrowType>&>(array).raw_values() + offset;
+    // This is a memcpy when the widths are the same
+    std::copy(source, source + length, batch->data.data());
+    return Status::OK();
+  }
+
+  static Status FillBool(const Array& array, int64_t offset, int64_t length,
+                         liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<liborc::LongVectorBatch*>(cbatch);
+    const auto& bool_array = static_cast<const BooleanArray&>(array);
+    int64_t* target = batch->data.data();
+    internal::BitmapReader value_reader(bool_array.values()->data(),
+                                        array.offset() + offset, length);
+    for (int64_t i = 0; i < length; i++) {
+      target[i] = value_reader.IsSet();
+      value_reader.Next();
+    }
+    return Status::OK();
+  }
+
+  static Status FillBinary(const Array& array, int64_t offset, int64_t length,
+                           liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<liborc::StringVectorBatch*>(cbatch);
+    const auto& binary_array = static_cast<const BinaryArray&>(array);
+    const int32_t* offsets = binary_array.raw_value_offsets() + offset;
+    // liborc only reads the values, so they can point into the Arrow buffer
+    char* data = reinterpret_cast<char*>(
+        const_cast<uint8_t*>(binary_array.value_data()->data()));
+    char** target = batch->data.data();
+    int64_t* target_length = batch->length.data();
+    for (int64_t i = 0; i < length; i++) {
+      target[i] = data + offsets[i];
+      target_length[i] = offsets[i + 1] - offsets[i];
+    }
+    return Status::OK();
+  }
+
+  static Status FillFixedBinary(const Array& array, int64_t offset, int64_t length,
+                                liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<liborc::StringVectorBatch*>(cbatch);
+    const auto& binary_array = static_cast<const FixedSizeBinaryArray&>(array);
+    const int32_t byte_width = binary_array.byte_width();
+    char* data = reinterpret_cast<char*>(
+        const_cast<uint8_t*>(binary_array.GetValue(offset)));
+    char** target = batch->data.data();
+    int64_t* target_length = batch->length.data();
+    for (int64_t i = 0; i < length; i++) {
+      target[i] = data + i * byte_width;
+      target_length[i] = byte_width;
+    }
+    return Status::OK();
+  }
+
+  static Status FillTimestamp(const Array& array, int64_t offset, int64_t length,
+                              liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<liborc::TimestampVectorBatch*>(cbatch);
+    const auto& type = static_cast<const TimestampType&>(*array.type());
+    int64_t unit_nanos = 1;
+    switch (type.unit()) {
+      case TimeUnit::SECOND:
+        unit_nanos = kOneSecondNanos;
+        break;
+      case TimeUnit::MILLI:
+        unit_nanos = 1000000LL;
+        break;
+      case TimeUnit::MICRO:
+        unit_nanos = 1000LL;
+        break;
+      case TimeUnit::NANO:
+        break;
+    }
+    const int64_t units_per_second = kOneSecondNanos / unit_nanos;
+    const int64_t* source =
+        static_cast<const TimestampArray&>(array).raw_values() + offset;
+    int64_t* seconds = batch->data.data();
+    int64_t* nanos = batch->nanoseconds.data();
+    for (int64_t i = 0; i < length; i++) {
+      // Round towards negative infinity, so that the nanoseconds are positive
+      int64_t second = source[i] / units_per_second;
+      if (source[i] % units_per_second < 0) {
+        second -= 1;
+      }
+      seconds[i] = second;
+      nanos[i] = (source[i] - second * units_per_second) * unit_nanos;
+    }
+    return Status::OK();
+  }
+
+  static Status FillDecimal(const Array& array, int64_t offset, int64_t length,
+                            liborc::ColumnVectorBatch* cbatch) {
+    const auto& decimal_array = static_cast<const Decimal128Array&>(array);
+    const auto& type = static_cast<const Decimal128Type&>(*array.type());
+    if (type.precision() > 18) {
+      auto batch = static_cast<liborc::Decimal128VectorBatch*>(cbatch);
+      for (int64_t i = 0; i < length; i++) {
+        Decimal128 value(decimal_array.GetValue(offset + i));
+        batch->values[i] = liborc::Int128(value.high_bits(), value.low_bits());
+      }
+    } else {
+      auto batch = static_cast<liborc::Decimal64VectorBatch*>(cbatch);
+      for (int64_t i = 0; i < length; i++) {
+        Decimal128 value(decimal_array.GetValue(offset + i));
+        batch->values[i] = static_cast<int64_t>(value.low_bits());
+      }
+    }
+    return Status::OK();
+  }
+
+  static Status FillList(const Array& array, int64_t offset, int64_t length,
+                         liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<liborc::ListVectorBatch*>(cbatch);
+    const auto& list_array = static_cast<const ListArray&>(array);
+    const int32_t* offsets = list_array.raw_value_offsets() + offset;
+    int64_t* target = batch->offsets.data();
+    for (int64_t i = 0; i <= length; i++) {
+      target[i] = offsets[i] - offsets[0];
+    }
+    const int64_t num_elements = offsets[length] - offsets[0];
+    if (batch->elements->capacity < static_cast<uint64_t>(num_elements)) {
+      batch->elements->resize(num_elements);
+    }
+    return Fill(*list_array.values(), offsets[0], num_elements, batch->elements.get());
+  }
+
+  static Status FillStruct(const Array& array, int64_t offset, int64_t length,
+                           liborc::ColumnVectorBatch* cbatch) {
+    auto batch = static_cast<liborc::StructVectorBatch*>(cbatch);
+    const auto& struct_array = static_cast<const StructArray&>(array);
+    // The fields are not sliced with the struct
+    for (int i = 0; i < array.num_fields(); i++) {
+      RETURN_NOT_OK(Fill(*struct_array.field(i), array.offset() + offset, length,
+                         batch->fields[i]));
+    }
+    return Status::OK();
+  }
+};
+
+class ORCFileWriter::Impl {
+ public:
+  Status Open(const std::shared_ptr<Schema>& schema,
+              const std::shared_ptr<io::OutputStream>& sink,
+              const ORCWriterOptions& options) {
+    if (options.batch_size <= 0) {
+      return Status::Invalid("Batch size must be positive");
+    }
+    schema_ = schema;
+    batch_size_ = options.batch_size;
+    RETURN_NOT_OK(GetORCType(*struct_(schema->fields()), &type_));
+
+    liborc::CompressionKind compression;
+    RETURN_NOT_OK(GetORCCompression(options.compression, &compression));
+    liborc::WriterOptions orc_options;
+    orc_options.setStripeSize(options.stripe_size);
+    orc_options.setCompression(compression);
+    orc_options.setCompressionBlockSize(options.compression_block_size);
+    orc_options.setRowIndexStride(options.row_index_stride);
+
+    stream_.reset(new ArrowOutputStream(sink));
+    try {
+      writer_ = liborc::createWriter(*type_, stream_.get(), orc_options);
+      batch_ = writer_->createRowBatch(batch_size_);
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
+    }
+    return Status::OK();
+  }
+
+  Status Write(const RecordBatch& batch) {
+    if (!batch.schema()->Equals(*schema_)) {
+      return Status::Invalid("Record batch schema does not match the writer schema");
+    }
+    auto root = static_cast<liborc::StructVectorBatch*>(batch_.get());
+    for (int64_t offset = 0; offset < batch.num_rows(); offset += batch_size_) {
+      const int64_t length = std::min(batch_size_, batch.num_rows() - offset);
+      root->numElements = length;
+      root->hasNulls = false;
+      for (int i = 0; i < batch.num_columns(); i++) {
+        RETURN_NOT_OK(
+            ORCBatchFiller::Fill(*batch.column(i), offset, length, root->fields[i]));
+      }
+      try {
+        writer_->add(*batch_);
+      } catch (const std::exception& e) {
+        return Status::IOError(e.what());
+      }
+    }
+    return Status::OK();
+  }
+
+  Status Write(const Table& table) {
+    TableBatchReader reader(table);
+    std::shared_ptr<RecordBatch> batch;
+    RETURN_NOT_OK(reader.ReadNext(&batch));
+    while (batch != nullptr) {
+      RETURN_NOT_OK(Write(*batch));
+      RETURN_NOT_OK(reader.ReadNext(&batch));
+    }
+    return Status::OK();
+  }
+
+  Status Close() {
+    try {
+      writer_->close();
+    } catch (const std::exception& e) {
+      return Status::IOError(e.what());
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<Schema> schema_;
+  int64_t batch_size_;
+  std::unique_ptr<liborc::Type> type_;
+  std::unique_ptr<ArrowOutputStream> stream_;
+  std::unique_ptr<liborc::Writer> writer_;
+  std::unique_ptr<liborc::ColumnVectorBatch> batch_;
+};
+
+ORCFileWriter::ORCFileWriter() { impl_.reset(new ORCFileWriter::Impl()); }
+
+ORCFileWriter::~ORCFileWriter() {}
+
+Status ORCFileWriter::Open(const std::shared_ptr<Schema>& schema,
+                           const std::shared_ptr<io::OutputStream>& sink,
+                           const ORCWriterOptions& options,
+                           std::unique_ptr<ORCFileWriter>* writer) {
+  auto result = std::unique_ptr<ORCFileWriter>(new ORCFileWriter());
+  RETURN_NOT_OK(result->impl_->Open(schema, sink, options));
+  *writer = std::move(result);
+  return Status::OK();
+}
+
+Status ORCFileWriter::Write(const RecordBatch& batch) { return impl_->Write(batch); }
+
+Status ORCFileWriter::Write(const Table& table) { return impl_->Write(table); }
+
+Status ORCFileWriter::Close() { return impl_->Close(); }
+
 }  // namespace orc
 }  // namespace adapters
 }  // namespace arrow
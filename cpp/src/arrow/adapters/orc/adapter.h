@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "arrow/io/interfaces.h"
@@ -27,6 +28,7 @@
 #include "arrow/record_batch.h"
 #include "arrow/status.h"
 #include "arrow/type.h"
+#include "arrow/util/compression.h"
 #include "arrow/util/visibility.h"
 
 namespace arrow {
@@ -35,6 +37,97 @@ namespace adapters {
 
 namespace orc {
 
+/// \class ORCLiteral
+/// \brief A value of a column in statistics or in a predicate
+///
+/// Integer values also stand for dates, as days since the UNIX epoch, and
+/// for timestamps, as nanoseconds since the UNIX epoch.
+class ARROW_EXPORT ORCLiteral {
+ public:
+  enum Kind { NONE, INTEGER, DOUBLE, STRING };
+
+  /// \brief Construct an unknown value
+  ORCLiteral() : kind_(NONE), int_value_(0), double_value_(0) {}
+
+  static ORCLiteral Integer(int64_t value);
+  static ORCLiteral Double(double value);
+  static ORCLiteral String(const std::string& value);
+
+  /// \brief Compare with another value
+  ///
+  /// Integers and doubles can be compared with each other.
+  ///
+  /// \param[in] other the value to compare with
+  /// \param[out] out less than, equal to or greater than 0 if this value is
+  /// less than, equal to or greater than other
+  /// \return false if the values cannot be compared
+  bool Compare(const ORCLiteral& other, int* out) const;
+
+  Kind kind() const { return kind_; }
+  int64_t int_value() const { return int_value_; }
+  double double_value() const { return double_value_; }
+  const std::string& string_value() const { return string_value_; }
+
+ private:
+  Kind kind_;
+  int64_t int_value_;
+  double double_value_;
+  std::string string_value_;
+};
+
+/// \class ORCColumnStatistics
+/// \brief Statistics of a column in a file, a stripe or a row group
+struct ARROW_EXPORT ORCColumnStatistics {
+  ORCColumnStatistics() : num_values(-1), has_null(true) {}
+
+  /// The number of values that are not null, -1 if unknown
+  int64_t num_values;
+  /// Whether there may be null values
+  bool has_null;
+  /// The smallest and largest values, of kind NONE if unknown
+  ORCLiteral minimum;
+  ORCLiteral maximum;
+};
+
+/// \class ORCPredicate
+/// \brief A condition on the values of columns, used to skip the stripes and
+/// row groups of an ORC file whose statistics show that no row satisfies it
+///
+/// Columns are identified by their ORC column id, as with the field indices
+/// of ORCFileReader::Read, where 0 is the top-level struct.
+class ARROW_EXPORT ORCPredicate {
+ public:
+  enum Op { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, AND, OR };
+
+  /// \brief Compare a column with a value, as in column < value for LESS
+  static std::shared_ptr<ORCPredicate> Compare(int column, Op op,
+                                               const ORCLiteral& value);
+
+  /// \brief Combine predicates that must all be satisfied
+  static std::shared_ptr<ORCPredicate> And(
+      const std::vector<std::shared_ptr<ORCPredicate>>& children);
+
+  /// \brief Combine predicates of which one must be satisfied
+  static std::shared_ptr<ORCPredicate> Or(
+      const std::vector<std::shared_ptr<ORCPredicate>>& children);
+
+  /// \brief Return false if no row with the given column statistics can
+  /// satisfy the predicate
+  ///
+  /// \param[in] statistics the statistics indexed by ORC column id. Columns
+  /// that are missing are assumed to have any value.
+  bool MayMatch(const std::vector<ORCColumnStatistics>& statistics) const;
+
+ private:
+  ORCPredicate(Op op, int column, const ORCLiteral& value,
+               const std::vector<std::shared_ptr<ORCPredicate>>& children);
+
+  Op op_;
+  int column_;
+  ORCLiteral value_;
+  std::vector<std::shared_ptr<ORCPredicate>> children_;
+};
+
 /// \class ORCFileReader
 /// \brief Read an Arrow Table or RecordBatch from an ORC file.
 class ARROW_EXPORT ORCFileReader {
@@ -70,6 +163,20 @@ class ARROW_EXPORT ORCFileReader {
   /// \param[out] out the returned RecordBatch
   Status Read(const std::vector<int>& include_indices, std::shared_ptr<Table>* out);
 
+  /// \brief Read the parts of the file that may satisfy a predicate
+  ///
+  /// Stripes and row groups whose statistics show that none of their rows
+  /// satisfies the predicate are skipped. The predicate is not evaluated on
+  /// individual rows, so the table may contain rows that do not satisfy it.
+  /// Like the other Read methods, it decodes stripes on the threads set with
+  /// set_num_threads.
+  ///
+  /// \param[in] include_indices the selected field indices to read
+  /// \param[in] predicate the predicate
+  /// \param[out] out the returned Table
+  Status Read(const std::vector<int>& include_indices, const ORCPredicate& predicate,
+              std::shared_ptr<Table>* out);
+
   /// \brief Read a single stripe as a RecordBatch
   ///
   /// \param[in] stripe the stripe index
@@ -84,18 +191,122 @@ class ARROW_EXPORT ORCFileReader {
   Status ReadStripe(int64_t stripe, const std::vector<int>& include_indices,
                     std::shared_ptr<RecordBatch>* out);
 
+  /// \brief Return a reader that iterates over the file in record batches
+  ///
+  /// The batches have batch_size rows, except for the last one, and may span
+  /// stripes, so that the memory used does not depend on the size of the
+  /// stripes. The returned reader remains valid after this reader is
+  /// destroyed.
+  ///
+  /// \param[in] batch_size the number of rows in each batch
+  /// \param[out] out the returned RecordBatchReader
+  Status GetRecordBatchReader(int64_t batch_size,
+                              std::shared_ptr<RecordBatchReader>* out);
+
+  /// \brief Return a reader that iterates over the file in record batches
+  ///
+  /// \param[in] batch_size the number of rows in each batch
+  /// \param[in] include_indices the selected field indices to read
+  /// \param[out] out the returned RecordBatchReader
+  Status GetRecordBatchReader(int64_t batch_size, const std::vector<int>& include_indices,
+                              std::shared_ptr<RecordBatchReader>* out);
+
+  /// \brief Return the statistics of the columns in the whole file
+  ///
+  /// \param[out] out the statistics, indexed by ORC column id
+  Status ReadColumnStatistics(std::vector<ORCColumnStatistics>* out);
+
+  /// \brief Return the statistics of the columns in a stripe
+  ///
+  /// The statistics are empty if the file does not have stripe statistics.
+  ///
+  /// \param[in] stripe the stripe index
+  /// \param[out] out the statistics, indexed by ORC column id
+  Status ReadStripeStatistics(int64_t stripe, std::vector<ORCColumnStatistics>* out);
+
   /// \brief The number of stripes in the file
   int64_t NumberOfStripes();
 
   /// \brief The number of rows in the file
   int64_t NumberOfRows();
 
+  /// \brief Set the number of threads used by the Read methods to decode stripes
+  ///
+  /// With more than one thread, the stripes are decoded concurrently, each
+  /// by an independent ORC reader. The file must then support concurrent
+  /// calls to ReadAt. The default is 1.
+  ///
+  /// \param[in] num_threads the number of threads
+  void set_num_threads(int num_threads);
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
   ORCFileReader();
 };
 
+/// \class ORCWriterOptions
+/// \brief Options for writing ORC files
+struct ARROW_EXPORT ORCWriterOptions {
+  ORCWriterOptions();
+
+  /// The size in bytes of the stripes, before compression
+  int64_t stripe_size;
+  /// The compression of the streams. UNCOMPRESSED and GZIP, which is written
+  /// as ZLIB, are supported by all versions of liborc.
+  Compression::type compression;
+  /// The size in bytes of the blocks that are compressed independently
+  int64_t compression_block_size;
+  /// The number of rows in each row group of the row index
+  int64_t row_index_stride;
+  /// The number of rows that are converted to ORC at once
+  int64_t batch_size;
+};
+
+/// \class ORCFileWriter
+/// \brief Write Arrow Tables and RecordBatches to an ORC file
+///
+/// Fixed size binary columns are written as ORC binary columns, and dates,
+/// timestamps, decimals, lists and structs as their ORC counterparts.
+class ARROW_EXPORT ORCFileWriter {
+ public:
+  ~ORCFileWriter();
+
+  /// \brief Create a new ORC writer
+  ///
+  /// \param[in] schema the schema of the data to write
+  /// \param[in] sink the output stream, which is not closed by the writer
+  /// \param[in] options the writer options
+  /// \param[out] writer the returned writer object
+  /// \return Status
+  static Status Open(const std::shared_ptr<Schema>& schema,
+                     const std::shared_ptr<io::OutputStream>& sink,
+                     const ORCWriterOptions& options,
+                     std::unique_ptr<ORCFileWriter>* writer);
+
+  /// \brief Write a record batch with the schema of the writer
+  ///
+  /// \param[in] batch the record batch
+  /// \return Status
+  Status Write(const RecordBatch& batch);
+
+  /// \brief Write a table with the schema of the writer
+  ///
+  /// \param[in] table the table
+  /// \return Status
+  Status Write(const Table& table);
+
+  /// \brief Write the file footer. The writer cannot be used afterwards.
+  ///
+  /// \return Status
+  Status Close();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+  ORCFileWriter();
+};
+
 }  // namespace orc
 
 }  // namespace adapters
@@ -0,0 +1,270 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/adapters/orc/adapter.h"
+#include "arrow/api.h"
+#include "arrow/io/memory.h"
+#include "arrow/test-util.h"
+
+#include "orc/OrcFile.hh"
+
+namespace liborc = orc;
+
+namespace arrow {
+
+constexpr int64_t kRowsPerBatch = 10000;
+
+class StringOutputStream : public liborc::OutputStream {
+ public:
+  explicit StringOutputStream(std::string* out) : out_(out) {}
+
+  uint64_t getLength() const override { return out_->size(); }
+
+  uint64_t getNaturalWriteSize() const override { return 128 * 1024; }
+
+  void write(const void* buf, size_t length) override {
+    out_->append(reinterpret_cast<const char*>(buf), length);
+  }
+
+  const std::string& getName() const override {
+    static const std::string filename("StringOutputStream");
+    return filename;
+  }
+
+  void close() override {}
+
+ private:
+  std::string* out_;
+};
+
+class BufferInputStream : public liborc::InputStream {
+ public:
+  explicit BufferInputStream(const std::shared_ptr<Buffer>& buffer) : buffer_(buffer) {}
+
+  uint64_t getLength() const override { return buffer_->size(); }
+
+  uint64_t getNaturalReadSize() const override { return 128 * 1024; }
+
+  void read(void* buf, uint64_t length, uint64_t offset) override {
+    std::memcpy(buf, buffer_->data() + offset, length);
+  }
+
+  const std::string& getName() const override {
+    static const std::string filename("BufferInputStream");
+    return filename;
+  }
+
+ private:
+  std::shared_ptr<Buffer> buffer_;
+};
+
+// Write an ORC file with an increasing integer id, a floating point, a string
+// and a boolean column, split into stripes of roughly stripe_size bytes.
+static std::shared_ptr<Buffer> MakeOrcFile(int64_t num_rows, uint64_t stripe_size) {
+  std::string contents;
+  StringOutputStream stream(&contents);
+  std::unique_ptr<liborc::Type> type(
+      liborc::Type::buildTypeFromString(
+          "struct<id:bigint,value:double,name:string,flag:boolean>"));
+  liborc::WriterOptions options;
+  options.setStripeSize(stripe_size);
+  std::unique_ptr<liborc::Writer> writer = liborc::createWriter(*type, &stream, options);
+
+  std::vector<int64_t> numbers;
+  std::vector<int64_t> names;
+  test::randint<int64_t>(kRowsPerBatch, 0, 1000000, &numbers);
+  test::randint<int64_t>(kRowsPerBatch, 0, 1000, &names);
+  std::vector<std::string> strings;
+  for (int64_t name : names) {
+    strings.push_back("name" + std::to_string(name));
+  }
+
+  std::unique_ptr<liborc::ColumnVectorBatch> batch =
+      writer->createRowBatch(kRowsPerBatch);
+  auto& root = static_cast<liborc::StructVectorBatch&>(*batch);
+  auto& id_batch = static_cast<liborc::LongVectorBatch&>(*root.fields[0]);
+  auto& value_batch = static_cast<liborc::DoubleVectorBatch&>(*root.fields[1]);
+  auto& name_batch = static_cast<liborc::StringVectorBatch&>(*root.fields[2]);
+  auto& flag_batch = static_cast<liborc::LongVectorBatch&>(*root.fields[3]);
+  for (int64_t row = 0; row < num_rows; row += kRowsPerBatch) {
+    const int64_t length = std::min(kRowsPerBatch, num_rows - row);
+    for (int64_t i = 0; i < length; ++i) {
+      id_batch.data[i] = row + i;
+      value_batch.data[i] = static_cast<double>(numbers[i]) / 7;
+      name_batch.data[i] = const_cast<char*>(strings[i].data());
+      name_batch.length[i] = static_cast<int64_t>(strings[i].size());
+      flag_batch.data[i] = numbers[i] % 2;
+    }
+    id_batch.numElements = value_batch.numElements = length;
+    name_batch.numElements = flag_batch.numElements = length;
+    root.numElements = length;
+    writer->add(*batch);
+  }
+  writer->close();
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(Buffer::FromString(contents, &buffer));
+  return buffer;
+}
+
+static std::shared_ptr<Buffer> GetOrcFile() {
+  static std::shared_ptr<Buffer> file = MakeOrcFile(4000000, 4 << 20);
+  return file;
+}
+
+static void BM_ReadTable(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetOrcFile();
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<adapters::orc::ORCFileReader> reader;
+    ABORT_NOT_OK(
+        adapters::orc::ORCFileReader::Open(source, default_memory_pool(), &reader));
+    reader->set_num_threads(static_cast<int>(state.range(0)));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read(&table));
+    num_rows = table->num_rows();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.SetBytesProcessed(state.iterations() * file->size());
+}
+
+static void BM_ReadColumn(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetOrcFile();
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<adapters::orc::ORCFileReader> reader;
+    ABORT_NOT_OK(
+        adapters::orc::ORCFileReader::Open(source, default_memory_pool(), &reader));
+    reader->set_num_threads(static_cast<int>(state.range(0)));
+    std::shared_ptr<Table> table;
+    // Type ids in ORC start with the root struct, so the second column is 2
+    ABORT_NOT_OK(reader->Read({2}, &table));
+    num_rows = table->num_rows();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+static void BM_ReadBatches(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetOrcFile();
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<adapters::orc::ORCFileReader> reader;
+    ABORT_NOT_OK(
+        adapters::orc::ORCFileReader::Open(source, default_memory_pool(), &reader));
+    std::shared_ptr<RecordBatchReader> batch_reader;
+    ABORT_NOT_OK(reader->GetRecordBatchReader(state.range(0), &batch_reader));
+    num_rows = 0;
+    std::shared_ptr<RecordBatch> batch;
+    ABORT_NOT_OK(batch_reader->ReadNext(&batch));
+    while (batch != nullptr) {
+      num_rows += batch->num_rows();
+      ABORT_NOT_OK(batch_reader->ReadNext(&batch));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.SetBytesProcessed(state.iterations() * file->size());
+}
+
+// Decode a column with liborc only, as a baseline for BM_ConvertColumn
+static void BM_DecodeColumn(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetOrcFile();
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    std::unique_ptr<liborc::InputStream> stream(new BufferInputStream(file));
+    std::unique_ptr<liborc::Reader> reader =
+        liborc::createReader(std::move(stream), liborc::ReaderOptions());
+    liborc::RowReaderOptions options;
+    options.includeTypes({static_cast<uint64_t>(state.range(0))});
+    std::unique_ptr<liborc::RowReader> row_reader = reader->createRowReader(options);
+    std::unique_ptr<liborc::ColumnVectorBatch> batch =
+        row_reader->createRowBatch(kRowsPerBatch);
+    num_rows = 0;
+    while (row_reader->next(*batch)) {
+      num_rows += batch->numElements;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+// Decode a column and convert it to Arrow
+static void BM_ConvertColumn(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetOrcFile();
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<adapters::orc::ORCFileReader> reader;
+    ABORT_NOT_OK(
+        adapters::orc::ORCFileReader::Open(source, default_memory_pool(), &reader));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read({static_cast<int>(state.range(0))}, &table));
+    num_rows = table->num_rows();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+// Read the rows with ids in a narrow range. The ids grow through the file, so
+// most stripes and row groups can be skipped.
+static void BM_ReadIdRange(benchmark::State& state) {  // NOLINT non-const reference
+  using adapters::orc::ORCLiteral;
+  using adapters::orc::ORCPredicate;
+  std::shared_ptr<Buffer> file = GetOrcFile();
+  auto predicate = ORCPredicate::And(
+      {ORCPredicate::Compare(1, ORCPredicate::GREATER_EQUAL,
+                             ORCLiteral::Integer(2000000)),
+       ORCPredicate::Compare(1, ORCPredicate::LESS, ORCLiteral::Integer(2100000))});
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<adapters::orc::ORCFileReader> reader;
+    ABORT_NOT_OK(
+        adapters::orc::ORCFileReader::Open(source, default_memory_pool(), &reader));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read({1, 2, 3, 4}, *predicate, &table));
+    num_rows = table->num_rows();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK(BM_ReadTable)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadColumn)->Arg(1)->Arg(4)->MinTime(1.0)->UseRealTime();
+
+// The argument is the ORC type id of the column, from 1 to 4
+BENCHMARK(BM_DecodeColumn)->DenseRange(1, 4)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ConvertColumn)->DenseRange(1, 4)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadIdRange)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadBatches)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+}  // namespace arrow
@@ -0,0 +1,685 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/adapters/orc/adapter.h"
+#include "arrow/api.h"
+#include "arrow/io/file.h"
+#include "arrow/io/memory.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+namespace adapters {
+namespace orc {
+
+class TestORCAdapter : public ::testing::Test {
+ public:
+  // Write the batches to an ORC file in memory and open it in reader_
+  void WriteAndOpen(const std::shared_ptr<Schema>& schema,
+                    const std::vector<std::shared_ptr<RecordBatch>>& batches,
+                    const ORCWriterOptions& options) {
+    std::shared_ptr<io::BufferOutputStream> sink;
+    ASSERT_OK(io::BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+    std::unique_ptr<ORCFileWriter> writer;
+    ASSERT_OK(ORCFileWriter::Open(schema, sink, options, &writer));
+    for (const auto& batch : batches) {
+      ASSERT_OK(writer->Write(*batch));
+    }
+    ASSERT_OK(writer->Close());
+
+    std::shared_ptr<Buffer> buffer;
+    ASSERT_OK(sink->Finish(&buffer));
+    auto file = std::make_shared<io::BufferReader>(buffer);
+    ASSERT_OK(ORCFileReader::Open(file, default_memory_pool(), &reader_));
+  }
+
+  // Open a file of the test-data directory in reader_
+  void OpenTestFile(const std::string& name) {
+    std::shared_ptr<io::ReadableFile> file;
+    const std::string path = std::string(ARROW_ORC_TEST_DATA) + "/" + name;
+    ASSERT_OK(io::ReadableFile::Open(path, &file));
+    ASSERT_OK(ORCFileReader::Open(file, default_memory_pool(), &reader_));
+  }
+
+ protected:
+  std::unique_ptr<ORCFileReader> reader_;
+};
+
+// A batch with a column of each type that is read back as the same type.
+// Every fifth value is null, and null structs have null fields.
+static std::shared_ptr<RecordBatch> MakeBatch(int64_t num_rows) {
+  auto schema = ::arrow::schema(
+      {field("bool", boolean()), field("int8", int8()), field("int16", int16()),
+       field("int32", int32()), field("int64", int64()), field("float", float32()),
+       field("double", float64()), field("string", utf8()), field("binary", binary()),
+       field("date", date32()), field("timestamp", timestamp(TimeUnit::NANO)),
+       field("decimal64", decimal(10, 2)), field("decimal128", decimal(30, 5)),
+       field("list", list(int32())),
+       field("struct", struct_({field("a", int32()), field("b", utf8())}))});
+
+  BooleanBuilder bool_builder;
+  Int8Builder int8_builder;
+  Int16Builder int16_builder;
+  Int32Builder int32_builder;
+  Int64Builder int64_builder;
+  FloatBuilder float_builder;
+  DoubleBuilder double_builder;
+  StringBuilder string_builder;
+  BinaryBuilder binary_builder;
+  Date32Builder date_builder;
+  TimestampBuilder timestamp_builder(timestamp(TimeUnit::NANO), default_memory_pool());
+  Decimal128Builder decimal64_builder(decimal(10, 2));
+  Decimal128Builder decimal128_builder(decimal(30, 5));
+  std::unique_ptr<ArrayBuilder> list_builder;
+  std::unique_ptr<ArrayBuilder> struct_builder;
+  ABORT_NOT_OK(
+      MakeBuilder(default_memory_pool(), schema->field(13)->type(), &list_builder));
+  ABORT_NOT_OK(
+      MakeBuilder(default_memory_pool(), schema->field(14)->type(), &struct_builder));
+  auto& lists = static_cast<ListBuilder&>(*list_builder);
+  auto& list_values = static_cast<Int32Builder&>(*lists.value_builder());
+  auto& structs = static_cast<StructBuilder&>(*struct_builder);
+  auto& struct_a = static_cast<Int32Builder&>(*structs.field_builder(0));
+  auto& struct_b = static_cast<StringBuilder&>(*structs.field_builder(1));
+
+  const Decimal128 large("123456789012345678901234");
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (i % 5 == 2) {
+      ABORT_NOT_OK(bool_builder.AppendNull());
+      ABORT_NOT_OK(int8_builder.AppendNull());
+      ABORT_NOT_OK(int16_builder.AppendNull());
+      ABORT_NOT_OK(int32_builder.AppendNull());
+      ABORT_NOT_OK(int64_builder.AppendNull());
+      ABORT_NOT_OK(float_builder.AppendNull());
+      ABORT_NOT_OK(double_builder.AppendNull());
+      ABORT_NOT_OK(string_builder.AppendNull());
+      ABORT_NOT_OK(binary_builder.AppendNull());
+      ABORT_NOT_OK(date_builder.AppendNull());
+      ABORT_NOT_OK(timestamp_builder.AppendNull());
+      ABORT_NOT_OK(decimal64_builder.AppendNull());
+      ABORT_NOT_OK(decimal128_builder.AppendNull());
+      ABORT_NOT_OK(lists.AppendNull());
+      ABORT_NOT_OK(structs.AppendNull());
+      ABORT_NOT_OK(struct_a.AppendNull());
+      ABORT_NOT_OK(struct_b.AppendNull());
+      continue;
+    }
+    const int64_t sign = i % 2 == 0 ? 1 : -1;
+    ABORT_NOT_OK(bool_builder.Append(i % 3 == 0));
+    ABORT_NOT_OK(int8_builder.Append(static_cast<int8_t>(sign * (i % 128))));
+    ABORT_NOT_OK(int16_builder.Append(static_cast<int16_t>(sign * i * 100)));
+    ABORT_NOT_OK(int32_builder.Append(static_cast<int32_t>(sign * i * 100000)));
+    ABORT_NOT_OK(int64_builder.Append(sign * i * 10000000000LL));
+    ABORT_NOT_OK(float_builder.Append(static_cast<float>(sign * i) / 4));
+    ABORT_NOT_OK(double_builder.Append(static_cast<double>(sign * i) / 3));
+    // Include empty strings
+    const char letter = static_cast<char>('a' + i % 26);
+    ABORT_NOT_OK(string_builder.Append(std::string(i % 4, letter)));
+    ABORT_NOT_OK(binary_builder.Append(std::string(i % 3, static_cast<char>(i))));
+    ABORT_NOT_OK(date_builder.Append(static_cast<int32_t>(sign * i * 1000)));
+    ABORT_NOT_OK(timestamp_builder.Append(sign * i * 1000000001LL));
+    ABORT_NOT_OK(decimal64_builder.Append(Decimal128(sign * i * 12345)));
+    ABORT_NOT_OK(decimal128_builder.Append(large * Decimal128(sign * i)));
+    // Include empty lists
+    ABORT_NOT_OK(lists.Append());
+    for (int64_t j = 0; j < i % 3; ++j) {
+      ABORT_NOT_OK(list_values.Append(static_cast<int32_t>(i + j)));
+    }
+    ABORT_NOT_OK(structs.Append());
+    ABORT_NOT_OK(struct_a.Append(static_cast<int32_t>(i)));
+    ABORT_NOT_OK(struct_b.Append("b" + std::to_string(i)));
+  }
+
+  std::vector<std::shared_ptr<Array>> arrays(schema->num_fields());
+  ABORT_NOT_OK(bool_builder.Finish(&arrays[0]));
+  ABORT_NOT_OK(int8_builder.Finish(&arrays[1]));
+  ABORT_NOT_OK(int16_builder.Finish(&arrays[2]));
+  ABORT_NOT_OK(int32_builder.Finish(&arrays[3]));
+  ABORT_NOT_OK(int64_builder.Finish(&arrays[4]));
+  ABORT_NOT_OK(float_builder.Finish(&arrays[5]));
+  ABORT_NOT_OK(double_builder.Finish(&arrays[6]));
+  ABORT_NOT_OK(string_builder.Finish(&arrays[7]));
+  ABORT_NOT_OK(binary_builder.Finish(&arrays[8]));
+  ABORT_NOT_OK(date_builder.Finish(&arrays[9]));
+  ABORT_NOT_OK(timestamp_builder.Finish(&arrays[10]));
+  ABORT_NOT_OK(decimal64_builder.Finish(&arrays[11]));
+  ABORT_NOT_OK(decimal128_builder.Finish(&arrays[12]));
+  ABORT_NOT_OK(list_builder->Finish(&arrays[13]));
+  ABORT_NOT_OK(struct_builder->Finish(&arrays[14]));
+  return RecordBatch::Make(schema, num_rows, arrays);
+}
+
+TEST_F(TestORCAdapter, WriteReadRoundTrip) {
+  std::shared_ptr<RecordBatch> batch = MakeBatch(100);
+
+  // The second batch is sliced, and the small batch size makes the writer
+  // fill liborc batches from the middle of the arrays.
+  ORCWriterOptions options;
+  options.batch_size = 7;
+  WriteAndOpen(batch->schema(), {batch->Slice(0, 33), batch->Slice(33)}, options);
+  ASSERT_EQ(100, reader_->NumberOfRows());
+
+  std::shared_ptr<Schema> schema;
+  ASSERT_OK(reader_->ReadSchema(&schema));
+  ASSERT_TRUE(schema->Equals(*batch->schema()));
+
+  std::shared_ptr<Table> expected;
+  std::shared_ptr<Table> table;
+  ASSERT_OK(Table::FromRecordBatches({batch}, &expected));
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST_F(TestORCAdapter, WriteTable) {
+  std::shared_ptr<RecordBatch> batch = MakeBatch(50);
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(Table::FromRecordBatches({batch->Slice(0, 20), batch->Slice(20)}, &expected));
+
+  std::shared_ptr<io::BufferOutputStream> sink;
+  ASSERT_OK(io::BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+  std::unique_ptr<ORCFileWriter> writer;
+  ASSERT_OK(ORCFileWriter::Open(expected->schema(), sink, ORCWriterOptions(), &writer));
+  ASSERT_OK(writer->Write(*expected));
+  ASSERT_OK(writer->Close());
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(sink->Finish(&buffer));
+  ASSERT_OK(ORCFileReader::Open(std::make_shared<io::BufferReader>(buffer),
+                                default_memory_pool(), &reader_));
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST_F(TestORCAdapter, ReadThreads) {
+  std::shared_ptr<RecordBatch> batch = MakeBatch(1000);
+  ORCWriterOptions options;
+  options.stripe_size = 1;
+  options.batch_size = 300;
+  WriteAndOpen(batch->schema(), {batch}, options);
+  ASSERT_GT(reader_->NumberOfStripes(), 1);
+
+  std::shared_ptr<Table> expected;
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read(&expected));
+  reader_->set_num_threads(4);
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_EQ(reader_->NumberOfStripes(), table->column(0)->data()->num_chunks());
+  ASSERT_TRUE(table->Equals(*expected));
+
+  ASSERT_OK(reader_->Read({2, 16}, &expected));
+  reader_->set_num_threads(1);
+  ASSERT_OK(reader_->Read({2, 16}, &table));
+  ASSERT_EQ(2, table->num_columns());
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+// The rows of test-data/stripes.orc from start, which has 1000 rows in
+// stripes of 300 rows, with the columns
+//   id: the row number
+//   name: "r" followed by the row number, null when the id % 7 is 3
+//   value: a quarter of the row number, null when the id % 5 is 2
+static std::shared_ptr<RecordBatch> MakeStripesBatch(int64_t start, int64_t length) {
+  std::vector<int64_t> ids;
+  std::vector<std::string> names;
+  std::vector<double> values;
+  std::vector<bool> name_is_valid;
+  std::vector<bool> value_is_valid;
+  for (int64_t i = start; i < start + length; ++i) {
+    ids.push_back(i);
+    names.push_back("r" + std::to_string(i));
+    values.push_back(static_cast<double>(i) / 4);
+    name_is_valid.push_back(i % 7 != 3);
+    value_is_valid.push_back(i % 5 != 2);
+  }
+  std::vector<std::shared_ptr<Array>> arrays(3);
+  ArrayFromVector<Int64Type, int64_t>(ids, &arrays[0]);
+  ArrayFromVector<StringType, std::string>(name_is_valid, names, &arrays[1]);
+  ArrayFromVector<DoubleType, double>(value_is_valid, values, &arrays[2]);
+  auto schema = ::arrow::schema(
+      {field("id", int64()), field("name", utf8()), field("value", float64())});
+  return RecordBatch::Make(schema, length, arrays);
+}
+
+TEST_F(TestORCAdapter, ReadFileThreads) {
+  OpenTestFile("stripes.orc");
+  ASSERT_EQ(4, reader_->NumberOfStripes());
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(Table::FromRecordBatches({MakeStripesBatch(0, 1000)}, &expected));
+
+  // Each stripe is a chunk of the table, in the order of the file, with
+  // more threads than stripes as well
+  for (int num_threads : {1, 3, 8}) {
+    reader_->set_num_threads(num_threads);
+    std::shared_ptr<Table> table;
+    ASSERT_OK(reader_->Read(&table));
+    ASSERT_TRUE(table->Equals(*expected)) << num_threads;
+    std::shared_ptr<ChunkedArray> ids = table->column(0)->data();
+    ASSERT_EQ(4, ids->num_chunks());
+    ASSERT_EQ(300, ids->chunk(0)->length());
+    ASSERT_EQ(100, ids->chunk(3)->length());
+  }
+
+  std::shared_ptr<RecordBatch> selected;
+  ASSERT_OK(MakeStripesBatch(0, 1000)->RemoveColumn(1, &selected));
+  ASSERT_OK(Table::FromRecordBatches({selected}, &expected));
+  std::shared_ptr<Table> table;
+  reader_->set_num_threads(4);
+  ASSERT_OK(reader_->Read({1, 3}, &table));
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST_F(TestORCAdapter, RecordBatchReader) {
+  OpenTestFile("stripes.orc");
+  ASSERT_EQ(4, reader_->NumberOfStripes());
+
+  // The batches span the stripes of 300 rows, and only the last one is short
+  for (int64_t batch_size : {1, 128, 300, 1000, 4096}) {
+    std::shared_ptr<RecordBatchReader> batch_reader;
+    ASSERT_OK(reader_->GetRecordBatchReader(batch_size, &batch_reader));
+    ASSERT_TRUE(batch_reader->schema()->Equals(*MakeStripesBatch(0, 0)->schema()));
+    int64_t start = 0;
+    while (true) {
+      std::shared_ptr<RecordBatch> batch;
+      ASSERT_OK(batch_reader->ReadNext(&batch));
+      if (batch == nullptr) {
+        break;
+      }
+      const int64_t length = std::min<int64_t>(batch_size, 1000 - start);
+      ASSERT_TRUE(batch->Equals(*MakeStripesBatch(start, length)))
+          << "batch size " << batch_size << " at row " << start;
+      start += length;
+    }
+    ASSERT_EQ(1000, start);
+  }
+
+  std::shared_ptr<RecordBatchReader> batch_reader;
+  ASSERT_OK(reader_->GetRecordBatchReader(128, {1, 3}, &batch_reader));
+  for (int64_t start = 0; start < 1000; start += 128) {
+    std::shared_ptr<RecordBatch> batch;
+    std::shared_ptr<RecordBatch> expected;
+    ASSERT_OK(batch_reader->ReadNext(&batch));
+    ASSERT_NE(nullptr, batch);
+    const int64_t length = std::min<int64_t>(128, 1000 - start);
+    ASSERT_OK(MakeStripesBatch(start, length)->RemoveColumn(1, &expected));
+    ASSERT_TRUE(batch->Equals(*expected)) << start;
+  }
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(batch_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+
+  ASSERT_RAISES(Invalid, reader_->GetRecordBatchReader(0, &batch_reader));
+}
+
+// Read the whole file in batches of batch_size rows
+static void ReadInBatches(ORCFileReader* reader, int64_t batch_size,
+                          std::shared_ptr<Table>* out) {
+  std::shared_ptr<RecordBatchReader> batch_reader;
+  ASSERT_OK(reader->GetRecordBatchReader(batch_size, &batch_reader));
+  std::vector<std::shared_ptr<RecordBatch>> batches;
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(batch_reader->ReadNext(&batch));
+  while (batch != nullptr) {
+    batches.push_back(batch);
+    ASSERT_OK(batch_reader->ReadNext(&batch));
+  }
+  ASSERT_OK(Table::FromRecordBatches(batches, out));
+}
+
+TEST_F(TestORCAdapter, ReadFileTypes) {
+  // test-data/types.orc has the rows of MakeBatch(2500) in one stripe,
+  // without the timestamps, whose conversion depends on the time zone of the
+  // reader. The stripe is converted in several liborc batches.
+  OpenTestFile("types.orc");
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeBatch(2500)->RemoveColumn(10, &batch));
+  std::shared_ptr<Table> expected;
+  std::shared_ptr<Table> table;
+  ASSERT_OK(Table::FromRecordBatches({batch}, &expected));
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_TRUE(table->schema()->Equals(*expected->schema()));
+  ASSERT_TRUE(table->Equals(*expected));
+
+  // Batches of 700 rows convert the columns from the middle of liborc batches
+  ReadInBatches(reader_.get(), 700, &table);
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST_F(TestORCAdapter, ReadFileMap) {
+  // test-data/map.orc has a column of maps from strings to integers, with
+  // the rows {a: 1, b: 2}, null, {}, {c: null}, null and {d: 4, e: 5, f: 6}.
+  // Maps are read as lists of key and value structs, and null maps are null
+  // rather than empty.
+  auto type = list(struct_({field("key", utf8()), field("value", int32())}));
+  std::unique_ptr<ArrayBuilder> builder;
+  ASSERT_OK(MakeBuilder(default_memory_pool(), type, &builder));
+  auto& maps = static_cast<ListBuilder&>(*builder);
+  auto& entries = static_cast<StructBuilder&>(*maps.value_builder());
+  auto& keys = static_cast<StringBuilder&>(*entries.field_builder(0));
+  auto& values = static_cast<Int32Builder&>(*entries.field_builder(1));
+  auto append_entry = [&](const std::string& key, int32_t value, bool is_valid) {
+    ASSERT_OK(entries.Append());
+    ASSERT_OK(keys.Append(key));
+    ASSERT_OK(is_valid ? values.Append(value) : values.AppendNull());
+  };
+  ASSERT_OK(maps.Append());
+  append_entry("a", 1, true);
+  append_entry("b", 2, true);
+  ASSERT_OK(maps.AppendNull());
+  ASSERT_OK(maps.Append());
+  ASSERT_OK(maps.Append());
+  append_entry("c", 0, false);
+  ASSERT_OK(maps.AppendNull());
+  ASSERT_OK(maps.Append());
+  append_entry("d", 4, true);
+  append_entry("e", 5, true);
+  append_entry("f", 6, true);
+  std::shared_ptr<Array> array;
+  ASSERT_OK(builder->Finish(&array));
+  ASSERT_EQ(2, array->null_count());
+  auto schema = ::arrow::schema({field("map", type)});
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(Table::FromRecordBatches({RecordBatch::Make(schema, 6, {array})}, &expected));
+
+  OpenTestFile("map.orc");
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_TRUE(table->schema()->Equals(*schema));
+  ASSERT_TRUE(table->Equals(*expected));
+
+  ReadInBatches(reader_.get(), 4, &table);
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST_F(TestORCAdapter, WriteTimestampsBefore1970) {
+  // ORC stores seconds and positive nanoseconds, so times before the epoch
+  // with a fraction of a second are rounded towards negative infinity.
+  // Timestamps are read back in nanoseconds.
+  const std::vector<int64_t> millis = {-1,       -999,  -1000,        -1001, -1500,
+                                       -86400000, 0,    -946684799877, 1,     1500};
+  std::vector<int64_t> nanos;
+  for (int64_t value : millis) {
+    nanos.push_back(value * 1000000LL);
+  }
+  std::vector<bool> is_valid(millis.size(), true);
+  is_valid[3] = false;
+
+  std::shared_ptr<Array> array;
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::MILLI), is_valid, millis,
+                                          &array);
+  ArrayFromVector<TimestampType, int64_t>(timestamp(TimeUnit::NANO), is_valid, nanos,
+                                          &expected);
+
+  auto schema = ::arrow::schema({field("timestamp", array->type())});
+  auto batch = RecordBatch::Make(schema, array->length(), {array});
+  ORCWriterOptions options;
+  options.batch_size = 3;
+  WriteAndOpen(schema, {batch}, options);
+
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_EQ(1, table->num_columns());
+  ASSERT_TRUE(table->column(0)->type()->Equals(timestamp(TimeUnit::NANO)));
+  ASSERT_TRUE(table->column(0)->data()->Equals(ChunkedArray({expected})));
+}
+
+TEST_F(TestORCAdapter, WriteErrors) {
+  auto schema = ::arrow::schema({field("int32", int32())});
+  std::shared_ptr<io::BufferOutputStream> sink;
+  ASSERT_OK(io::BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+  std::unique_ptr<ORCFileWriter> writer;
+
+  ORCWriterOptions options;
+  options.compression = Compression::BROTLI;
+  ASSERT_RAISES(NotImplemented, ORCFileWriter::Open(schema, sink, options, &writer));
+
+  options = ORCWriterOptions();
+  options.batch_size = 0;
+  ASSERT_RAISES(Invalid, ORCFileWriter::Open(schema, sink, options, &writer));
+
+  auto union_schema =
+      ::arrow::schema({field("union", union_({field("a", int32())}, {0}))});
+  ASSERT_RAISES(NotImplemented,
+                ORCFileWriter::Open(union_schema, sink, ORCWriterOptions(), &writer));
+
+  // A batch must have the schema of the writer
+  ASSERT_OK(ORCFileWriter::Open(schema, sink, ORCWriterOptions(), &writer));
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int64Type, int64_t>({1, 2, 3}, &array);
+  auto batch = RecordBatch::Make(::arrow::schema({field("int32", int64())}), 3, {array});
+  ASSERT_RAISES(Invalid, writer->Write(*batch));
+}
+
+static ORCColumnStatistics IntegerStatistics(int64_t minimum, int64_t maximum) {
+  ORCColumnStatistics statistics;
+  statistics.num_values = 10;
+  statistics.has_null = false;
+  statistics.minimum = ORCLiteral::Integer(minimum);
+  statistics.maximum = ORCLiteral::Integer(maximum);
+  return statistics;
+}
+
+TEST(TestORCPredicate, MayMatch) {
+  // Column 1 has values from 10 to 20, and column 2 only nulls
+  std::vector<ORCColumnStatistics> statistics(3);
+  statistics[1] = IntegerStatistics(10, 20);
+  statistics[2].num_values = 0;
+
+  auto compare = [](int column, ORCPredicate::Op op, int64_t value) {
+    return ORCPredicate::Compare(column, op, ORCLiteral::Integer(value));
+  };
+  ASSERT_TRUE(compare(1, ORCPredicate::EQUAL, 10)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::EQUAL, 20)->MayMatch(statistics));
+  ASSERT_FALSE(compare(1, ORCPredicate::EQUAL, 21)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::NOT_EQUAL, 15)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::LESS, 11)->MayMatch(statistics));
+  ASSERT_FALSE(compare(1, ORCPredicate::LESS, 10)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::LESS_EQUAL, 10)->MayMatch(statistics));
+  ASSERT_FALSE(compare(1, ORCPredicate::LESS_EQUAL, 9)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::GREATER, 19)->MayMatch(statistics));
+  ASSERT_FALSE(compare(1, ORCPredicate::GREATER, 20)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::GREATER_EQUAL, 20)->MayMatch(statistics));
+  ASSERT_FALSE(compare(1, ORCPredicate::GREATER_EQUAL, 21)->MayMatch(statistics));
+
+  // Integers compare with doubles, but not with strings or NaN
+  auto less = [](double value) {
+    return ORCPredicate::Compare(1, ORCPredicate::LESS, ORCLiteral::Double(value));
+  };
+  ASSERT_FALSE(less(9.5)->MayMatch(statistics));
+  ASSERT_TRUE(less(10.5)->MayMatch(statistics));
+  ASSERT_TRUE(less(NAN)->MayMatch(statistics));
+  auto string_equal =
+      ORCPredicate::Compare(1, ORCPredicate::EQUAL, ORCLiteral::String("a"));
+  ASSERT_TRUE(string_equal->MayMatch(statistics));
+
+  // A column with a single value only fails NOT_EQUAL for that value
+  statistics[1] = IntegerStatistics(15, 15);
+  ASSERT_FALSE(compare(1, ORCPredicate::NOT_EQUAL, 15)->MayMatch(statistics));
+  ASSERT_TRUE(compare(1, ORCPredicate::NOT_EQUAL, 16)->MayMatch(statistics));
+
+  // No comparison is satisfied by nulls, and unknown columns may match
+  ASSERT_FALSE(compare(2, ORCPredicate::NOT_EQUAL, 0)->MayMatch(statistics));
+  ASSERT_TRUE(compare(0, ORCPredicate::EQUAL, 0)->MayMatch(statistics));
+  ASSERT_TRUE(compare(3, ORCPredicate::EQUAL, 0)->MayMatch(statistics));
+  statistics[1] = ORCColumnStatistics();
+  ASSERT_TRUE(compare(1, ORCPredicate::EQUAL, 0)->MayMatch(statistics));
+
+  statistics[1] = IntegerStatistics(10, 20);
+  auto match = compare(1, ORCPredicate::EQUAL, 15);
+  auto no_match = compare(1, ORCPredicate::EQUAL, 25);
+  ASSERT_TRUE(ORCPredicate::And({match, match})->MayMatch(statistics));
+  ASSERT_FALSE(ORCPredicate::And({match, no_match})->MayMatch(statistics));
+  ASSERT_TRUE(ORCPredicate::Or({no_match, match})->MayMatch(statistics));
+  ASSERT_FALSE(ORCPredicate::Or({no_match, no_match})->MayMatch(statistics));
+  ASSERT_TRUE(ORCPredicate::And({})->MayMatch(statistics));
+  ASSERT_TRUE(ORCPredicate::Or({})->MayMatch(statistics));
+}
+
+// test-data/row-groups.orc has 2000 rows in two stripes of 1000 rows and
+// row groups of 100 rows, with the columns
+//   id: the row number
+//   key: the row group number
+//   name: "k" followed by the row group number
+//   value: half the row number, null in the row group from 500 to 599
+// so that the ORC column ids of id, key, name and value are 1 to 4.
+class TestORCPredicateRead : public TestORCAdapter {
+ public:
+  void SetUp() {
+    OpenTestFile("row-groups.orc");
+    ASSERT_EQ(2, reader_->NumberOfStripes());
+  }
+
+  // Check that reading with the predicate returns the rows of the ranges,
+  // with the stripes read serially and concurrently
+  void CheckRows(const std::shared_ptr<ORCPredicate>& predicate,
+                 const std::vector<std::pair<int64_t, int64_t>>& ranges) {
+    std::vector<int64_t> expected;
+    for (const auto& range : ranges) {
+      for (int64_t i = range.first; i < range.second; ++i) {
+        expected.push_back(i);
+      }
+    }
+    for (int num_threads : {1, 4}) {
+      reader_->set_num_threads(num_threads);
+      std::shared_ptr<Table> table;
+      ASSERT_OK(reader_->Read({1}, *predicate, &table));
+      ASSERT_EQ(1, table->num_columns());
+      std::vector<int64_t> ids;
+      for (const auto& chunk : table->column(0)->data()->chunks()) {
+        const auto& array = static_cast<const Int64Array&>(*chunk);
+        for (int64_t i = 0; i < array.length(); ++i) {
+          ids.push_back(array.Value(i));
+        }
+      }
+      ASSERT_EQ(expected, ids) << num_threads << " threads";
+    }
+  }
+
+  std::shared_ptr<ORCPredicate> Compare(int column, ORCPredicate::Op op, int64_t value) {
+    return ORCPredicate::Compare(column, op, ORCLiteral::Integer(value));
+  }
+};
+
+TEST_F(TestORCPredicateRead, Equal) {
+  CheckRows(Compare(1, ORCPredicate::EQUAL, 250), {{200, 300}});
+  CheckRows(Compare(1, ORCPredicate::EQUAL, 999), {{900, 1000}});
+  auto name_equal =
+      ORCPredicate::Compare(3, ORCPredicate::EQUAL, ORCLiteral::String("k7"));
+  CheckRows(name_equal, {{700, 800}});
+}
+
+TEST_F(TestORCPredicateRead, NotEqual) {
+  // Only the row group where the key has the single value 3 is skipped
+  CheckRows(Compare(2, ORCPredicate::NOT_EQUAL, 3), {{0, 300}, {400, 2000}});
+  CheckRows(Compare(1, ORCPredicate::NOT_EQUAL, 3), {{0, 2000}});
+}
+
+TEST_F(TestORCPredicateRead, Range) {
+  CheckRows(Compare(1, ORCPredicate::LESS, 100), {{0, 100}});
+  CheckRows(Compare(1, ORCPredicate::LESS_EQUAL, 100), {{0, 200}});
+  CheckRows(Compare(1, ORCPredicate::GREATER, 899), {{900, 2000}});
+  CheckRows(Compare(1, ORCPredicate::GREATER_EQUAL, 899), {{800, 2000}});
+  CheckRows(Compare(1, ORCPredicate::GREATER_EQUAL, 1450), {{1400, 2000}});
+  auto value_less = ORCPredicate::Compare(4, ORCPredicate::LESS, ORCLiteral::Double(60));
+  CheckRows(value_less, {{0, 200}});
+}
+
+TEST_F(TestORCPredicateRead, AndOr) {
+  auto range = ORCPredicate::And({Compare(1, ORCPredicate::GREATER_EQUAL, 150),
+                                  Compare(1, ORCPredicate::LESS, 420)});
+  CheckRows(range, {{100, 500}});
+  auto either = ORCPredicate::Or({Compare(1, ORCPredicate::LESS, 50),
+                                  Compare(1, ORCPredicate::GREATER_EQUAL, 930)});
+  CheckRows(either, {{0, 100}, {900, 2000}});
+  auto both = ORCPredicate::And({either, Compare(2, ORCPredicate::EQUAL, 9)});
+  CheckRows(both, {{900, 1000}});
+}
+
+TEST_F(TestORCPredicateRead, AllNullRowGroup) {
+  // The row group with only null values never satisfies a comparison
+  auto value_positive =
+      ORCPredicate::Compare(4, ORCPredicate::GREATER_EQUAL, ORCLiteral::Double(0));
+  CheckRows(value_positive, {{0, 500}, {600, 2000}});
+  auto value_any =
+      ORCPredicate::Compare(4, ORCPredicate::NOT_EQUAL, ORCLiteral::Double(-1));
+  CheckRows(value_any, {{0, 500}, {600, 2000}});
+}
+
+TEST_F(TestORCPredicateRead, Stripes) {
+  // A stripe that cannot match is not read, so the table has a chunk for
+  // each of the other stripes, with the selected columns
+  reader_->set_num_threads(2);
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read({1, 4}, *Compare(1, ORCPredicate::LESS, 1000), &table));
+  ASSERT_EQ(2, table->num_columns());
+  ASSERT_EQ(1, table->column(0)->data()->num_chunks());
+  ASSERT_EQ(1000, table->num_rows());
+  ASSERT_OK(reader_->Read({1, 4}, *Compare(1, ORCPredicate::EQUAL, 1000), &table));
+  ASSERT_EQ(1, table->column(0)->data()->num_chunks());
+  ASSERT_EQ(100, table->num_rows());
+  ASSERT_OK(reader_->Read({1, 4}, *Compare(2, ORCPredicate::LESS, 20), &table));
+  ASSERT_EQ(2, table->column(0)->data()->num_chunks());
+  ASSERT_EQ(2000, table->num_rows());
+}
+
+TEST_F(TestORCAdapter, WriteRowIndexStride) {
+  // The row groups of the writer are those that a predicate selects
+  std::vector<int64_t> ids;
+  for (int64_t i = 0; i < 1000; ++i) {
+    ids.push_back(i);
+  }
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int64Type, int64_t>(ids, &array);
+  auto schema = ::arrow::schema({field("id", int64())});
+  auto batch = RecordBatch::Make(schema, 1000, {array});
+  ORCWriterOptions options;
+  options.row_index_stride = 100;
+  WriteAndOpen(schema, {batch}, options);
+
+  auto predicate =
+      ORCPredicate::Compare(1, ORCPredicate::EQUAL, ORCLiteral::Integer(250));
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read({1}, *predicate, &table));
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(Table::FromRecordBatches({batch->Slice(200, 100)}, &expected));
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST_F(TestORCPredicateRead, NoMatch) {
+  // No stripe matches, so the table is empty but has the selected columns
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read({1, 3}, *Compare(1, ORCPredicate::GREATER, 2000), &table));
+  ASSERT_EQ(0, table->num_rows());
+  auto schema = ::arrow::schema({field("id", int64()), field("name", utf8())});
+  ASSERT_TRUE(table->schema()->Equals(*schema));
+
+  CheckRows(Compare(2, ORCPredicate::EQUAL, 20), {});
+}
+
+}  // namespace orc
+}  // namespace adapters
+}  // namespace arrow
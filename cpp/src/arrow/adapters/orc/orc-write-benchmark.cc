@@ -0,0 +1,141 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/adapters/orc/adapter.h"
+#include "arrow/api.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/api.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+
+// A table with an integer, a floating point, a string and a boolean column.
+// The columns have a single chunk, as Feather writes contiguous columns.
+static std::shared_ptr<Table> MakeTable(int64_t num_rows) {
+  auto schema = ::arrow::schema({field("id", int64()), field("value", float64()),
+                                 field("name", utf8()), field("flag", boolean())});
+
+  std::vector<int64_t> numbers;
+  std::vector<bool> is_valid;
+  test::randint<int64_t>(num_rows, 0, 1000000, &numbers);
+  test::random_is_valid(num_rows, 0.1, &is_valid);
+
+  Int64Builder id_builder;
+  DoubleBuilder value_builder;
+  StringBuilder name_builder;
+  BooleanBuilder flag_builder;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    ABORT_NOT_OK(id_builder.Append(i));
+    if (is_valid[i]) {
+      ABORT_NOT_OK(value_builder.Append(static_cast<double>(numbers[i]) / 7));
+    } else {
+      ABORT_NOT_OK(value_builder.AppendNull());
+    }
+    ABORT_NOT_OK(name_builder.Append("name" + std::to_string(numbers[i] % 1000)));
+    ABORT_NOT_OK(flag_builder.Append(numbers[i] % 2 == 0));
+  }
+  std::vector<std::shared_ptr<Array>> arrays(4);
+  ABORT_NOT_OK(id_builder.Finish(&arrays[0]));
+  ABORT_NOT_OK(value_builder.Finish(&arrays[1]));
+  ABORT_NOT_OK(name_builder.Finish(&arrays[2]));
+  ABORT_NOT_OK(flag_builder.Finish(&arrays[3]));
+  return Table::Make(schema, arrays);
+}
+
+static std::shared_ptr<Table> GetTable() {
+  static std::shared_ptr<Table> table = MakeTable(1 << 20);
+  return table;
+}
+
+// The size of the columns in memory, so that the throughputs are comparable
+static int64_t TableSize(const Table& table) {
+  int64_t size = 0;
+  for (int i = 0; i < table.num_columns(); ++i) {
+    for (const auto& buffer : table.column(i)->data()->chunk(0)->data()->buffers) {
+      size += buffer == nullptr ? 0 : buffer->size();
+    }
+  }
+  return size;
+}
+
+static void BM_WriteOrc(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Table> table = GetTable();
+  adapters::orc::ORCWriterOptions options;
+  options.compression = static_cast<Compression::type>(state.range(0));
+  while (state.KeepRunning()) {
+    std::shared_ptr<io::BufferOutputStream> sink;
+    ABORT_NOT_OK(io::BufferOutputStream::Create(1 << 20, default_memory_pool(), &sink));
+    std::unique_ptr<adapters::orc::ORCFileWriter> writer;
+    ABORT_NOT_OK(
+        adapters::orc::ORCFileWriter::Open(table->schema(), sink, options, &writer));
+    ABORT_NOT_OK(writer->Write(*table));
+    ABORT_NOT_OK(writer->Close());
+  }
+  state.SetItemsProcessed(state.iterations() * table->num_rows());
+  state.SetBytesProcessed(state.iterations() * TableSize(*table));
+}
+
+static void BM_WriteFeather(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Table> table = GetTable();
+  while (state.KeepRunning()) {
+    std::shared_ptr<io::BufferOutputStream> sink;
+    ABORT_NOT_OK(io::BufferOutputStream::Create(1 << 20, default_memory_pool(), &sink));
+    std::unique_ptr<ipc::feather::TableWriter> writer;
+    ABORT_NOT_OK(ipc::feather::TableWriter::Open(sink, &writer));
+    for (int i = 0; i < table->num_columns(); ++i) {
+      const Column& column = *table->column(i);
+      ABORT_NOT_OK(writer->Append(column.name(), *column.data()->chunk(0)));
+    }
+    ABORT_NOT_OK(writer->Finalize());
+  }
+  state.SetItemsProcessed(state.iterations() * table->num_rows());
+  state.SetBytesProcessed(state.iterations() * TableSize(*table));
+}
+
+static void BM_WriteIpc(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Table> table = GetTable();
+  while (state.KeepRunning()) {
+    std::shared_ptr<io::BufferOutputStream> sink;
+    ABORT_NOT_OK(io::BufferOutputStream::Create(1 << 20, default_memory_pool(), &sink));
+    std::shared_ptr<ipc::RecordBatchWriter> writer;
+    ABORT_NOT_OK(ipc::RecordBatchFileWriter::Open(sink.get(), table->schema(), &writer));
+    ABORT_NOT_OK(writer->WriteTable(*table));
+    ABORT_NOT_OK(writer->Close());
+  }
+  state.SetItemsProcessed(state.iterations() * table->num_rows());
+  state.SetBytesProcessed(state.iterations() * TableSize(*table));
+}
+
+// The argument is the compression, either UNCOMPRESSED or GZIP (ORC's ZLIB)
+BENCHMARK(BM_WriteOrc)
+    ->Arg(Compression::UNCOMPRESSED)
+    ->Arg(Compression::GZIP)
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK(BM_WriteFeather)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_WriteIpc)->MinTime(1.0)->UseRealTime();
+
+}  // namespace arrow
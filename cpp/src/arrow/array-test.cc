@@ -202,6 +202,36 @@ TEST_F(TestBuilder, TestReserve) {
   ASSERT_EQ(4, builder.null_bitmap()->size());
 }
 
+TEST_F(TestBuilder, TestAppendValidBytes) {
+  // Append runs of every length up to 20, and a longer one, so that they
+  // start and end at every bit of a bitmap byte. Every non-zero byte is valid.
+  vector<int32_t> values;
+  vector<uint8_t> valid_bytes;
+  for (int32_t i = 0; i < 400; ++i) {
+    values.push_back(i);
+    valid_bytes.push_back(static_cast<uint8_t>((i * 37 + i / 5) % 4));
+  }
+  Int32Builder builder(pool_);
+  int64_t length = 0;
+  for (int64_t run = 0; run <= 20; ++run) {
+    ASSERT_OK(builder.Append(values.data() + length, run, valid_bytes.data() + length));
+    length += run;
+  }
+  ASSERT_OK(builder.Append(values.data() + length, 100, valid_bytes.data() + length));
+  length += 100;
+  ASSERT_EQ(length, builder.length());
+
+  std::shared_ptr<Array> result;
+  ASSERT_OK(builder.Finish(&result));
+  ASSERT_EQ(length, result->length());
+  int64_t null_count = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    ASSERT_EQ(valid_bytes[i] == 0, result->IsNull(i)) << i;
+    null_count += valid_bytes[i] == 0;
+  }
+  ASSERT_EQ(null_count, result->null_count());
+}
+
 template <typename Attrs>
 class TestPrimitiveBuilder : public TestBuilder {
  public:
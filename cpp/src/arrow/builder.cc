@@ -132,31 +132,30 @@ void ArrayBuilder::UnsafeAppendToBitmap(const uint8_t* valid_bytes, int64_t leng
     return;
   }
 
-  int64_t byte_offset = length_ / 8;
-  int64_t bit_offset = length_ % 8;
-  uint8_t bitset = null_bitmap_data_[byte_offset];
-
-  for (int64_t i = 0; i < length; ++i) {
-    if (bit_offset == 8) {
-      bit_offset = 0;
-      null_bitmap_data_[byte_offset] = bitset;
-      byte_offset++;
-      // TODO: Except for the last byte, this shouldn't be needed
-      bitset = null_bitmap_data_[byte_offset];
-    }
-
-    if (valid_bytes[i]) {
-      bitset |= BitUtil::kBitmask[bit_offset];
-    } else {
-      bitset &= BitUtil::kFlippedBitmask[bit_offset];
-      ++null_count_;
+  int64_t num_valid = 0;
+  int64_t i = 0;
+  // Set bits one at a time up to a byte boundary of the bitmap, then pack
+  // eight bytes into each byte of the bitmap without branching
+  for (; i < length && (length_ + i) % 8 != 0; ++i) {
+    const bool is_valid = valid_bytes[i] != 0;
+    BitUtil::SetBitTo(null_bitmap_data_, length_ + i, is_valid);
+    num_valid += is_valid;
+  }
+  uint8_t* bitmap = null_bitmap_data_ + (length_ + i) / 8;
+  for (; i + 8 <= length; i += 8) {
+    uint8_t bits = 0;
+    for (int bit = 0; bit < 8; ++bit) {
+      bits |= static_cast<uint8_t>((valid_bytes[i + bit] != 0) << bit);
     }
-
-    bit_offset++;
+    *bitmap++ = bits;
+    num_valid += BitUtil::Popcount(bits);
   }
-  if (bit_offset != 0) {
-    null_bitmap_data_[byte_offset] = bitset;
+  for (; i < length; ++i) {
+    const bool is_valid = valid_bytes[i] != 0;
+    BitUtil::SetBitTo(null_bitmap_data_, length_ + i, is_valid);
+    num_valid += is_valid;
   }
+  null_count_ += length - num_valid;
   length_ += length;
 }
 
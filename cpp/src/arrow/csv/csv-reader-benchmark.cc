@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/csv/reader.h"
+#include "arrow/io/memory.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+
+// A CSV file with an integer, a floating point, a string and a boolean column
+static std::shared_ptr<Buffer> MakeCsvFile(int64_t num_rows) {
+  std::vector<int64_t> numbers;
+  std::vector<double> reals;
+  test::randint<int64_t>(num_rows, 0, 1000000, &numbers);
+  test::random_real<double>(num_rows, 0, -1000.0, 1000.0, &reals);
+
+  std::stringstream ss;
+  ss << "id,value,name,flag\n";
+  for (int64_t i = 0; i < num_rows; ++i) {
+    ss << numbers[i] << "," << reals[i] << ",name" << numbers[i] % 1000 << ","
+       << (numbers[i] % 2 == 0 ? "true" : "false") << "\n";
+  }
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(Buffer::FromString(ss.str(), &buffer));
+  return buffer;
+}
+
+static std::shared_ptr<Buffer> GetCsvFile() {
+  static std::shared_ptr<Buffer> file = MakeCsvFile(1000000);
+  return file;
+}
+
+// Report the throughput of each thread, which is flat when reading scales
+static void SetThroughputPerCore(benchmark::State& state,  // NOLINT non-const reference
+                                 int64_t num_bytes, double seconds) {
+  std::stringstream ss;
+  ss.precision(1);
+  ss << std::fixed << num_bytes / seconds / state.range(0) / (1 << 20)
+     << " MB/s per core";
+  state.SetLabel(ss.str());
+  state.SetBytesProcessed(num_bytes);
+}
+
+static void BM_ReadTable(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetCsvFile();
+  csv::ReadOptions options;
+  options.num_threads = static_cast<int>(state.range(0));
+  double seconds = 0;
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<csv::TableReader> reader;
+    ABORT_NOT_OK(csv::TableReader::Open(std::make_shared<io::BufferReader>(file),
+                                        default_memory_pool(), options, &reader));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read(&table));
+    num_rows = table->num_rows();
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                   .count();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  SetThroughputPerCore(state, state.iterations() * file->size(), seconds);
+}
+
+static void BM_ReadBatches(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetCsvFile();
+  csv::ReadOptions options;
+  options.num_threads = static_cast<int>(state.range(0));
+  double seconds = 0;
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<csv::StreamingReader> reader;
+    ABORT_NOT_OK(csv::StreamingReader::Open(std::make_shared<io::BufferReader>(file),
+                                            default_memory_pool(), options, &reader));
+    num_rows = 0;
+    std::shared_ptr<RecordBatch> batch;
+    ABORT_NOT_OK(reader->ReadNext(&batch));
+    while (batch != nullptr) {
+      num_rows += batch->num_rows();
+      ABORT_NOT_OK(reader->ReadNext(&batch));
+    }
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                   .count();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  SetThroughputPerCore(state, state.iterations() * file->size(), seconds);
+}
+
+BENCHMARK(BM_ReadTable)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadBatches)->Arg(1)->Arg(4)->MinTime(1.0)->UseRealTime();
+
+}  // namespace arrow
@@ -0,0 +1,486 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/csv/reader.h"
+#include "arrow/io/memory.h"
+#include "arrow/memory_pool.h"
+#include "arrow/record_batch.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace csv {
+
+static std::shared_ptr<io::InputStream> MakeInput(const std::string& contents) {
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(Buffer::FromString(contents, &buffer));
+  return std::make_shared<io::BufferReader>(buffer);
+}
+
+static Status ReadCsv(const std::string& contents, const ReadOptions& options,
+                      std::shared_ptr<Table>* out) {
+  std::unique_ptr<TableReader> reader;
+  RETURN_NOT_OK(
+      TableReader::Open(MakeInput(contents), default_memory_pool(), options, &reader));
+  return reader->Read(out);
+}
+
+static void AssertColumnEquals(const Array& expected, const Table& table, int i) {
+  ASSERT_TRUE(table.column(i)->type()->Equals(*expected.type()))
+      << table.column(i)->type()->ToString();
+  auto actual = table.column(i)->data();
+  ASSERT_EQ(expected.length(), actual->length());
+  int64_t offset = 0;
+  for (const auto& chunk : actual->chunks()) {
+    AssertArraysEqual(*expected.Slice(offset, chunk->length()), *chunk);
+    offset += chunk->length();
+  }
+}
+
+// Rows with every inferred type, and quoted fields with delimiters, doubled
+// quotes and line breaks
+static std::string MakeCsv(int num_rows) {
+  std::stringstream ss;
+  ss << "id,value,name,flag\n";
+  for (int i = 0; i < num_rows; ++i) {
+    ss << i << "," << i * 0.25 << ",";
+    if (i % 3 == 0) {
+      ss << "\"name, \"\"" << i << "\"\"\nquoted\"";
+    } else {
+      ss << "name" << i;
+    }
+    ss << "," << (i % 2 == 0 ? "true" : "false") << "\n";
+  }
+  return ss.str();
+}
+
+TEST(TestCsvReader, InferTypes) {
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("a,b,c,d,e\n1,1.5,true,x,\n-2,-2e3,False,y,\n", ReadOptions(),
+                    &table));
+  ASSERT_EQ(5, table->num_columns());
+  ASSERT_EQ(2, table->num_rows());
+
+  auto expected_schema =
+      schema({field("a", int64()), field("b", float64()), field("c", boolean()),
+              field("d", utf8()), field("e", null())});
+  ASSERT_TRUE(table->schema()->Equals(*expected_schema));
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<Int64Type, int64_t>({1, -2}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  ArrayFromVector<DoubleType, double>({1.5, -2000}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+  ArrayFromVector<BooleanType, bool>({true, false}, &expected);
+  AssertColumnEquals(*expected, *table, 2);
+  ArrayFromVector<StringType, std::string>({"x", "y"}, &expected);
+  AssertColumnEquals(*expected, *table, 3);
+  AssertColumnEquals(NullArray(2), *table, 4);
+}
+
+TEST(TestCsvReader, MixedTypes) {
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("a,b,c\n1,true,1\n2.5,1,x\n", ReadOptions(), &table));
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<DoubleType, double>({1, 2.5}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  ArrayFromVector<StringType, std::string>({"true", "1"}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+  ArrayFromVector<StringType, std::string>({"1", "x"}, &expected);
+  AssertColumnEquals(*expected, *table, 2);
+}
+
+TEST(TestCsvReader, EmptyValues) {
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("a,b,c\n1,,x\n,2.5,\n", ReadOptions(), &table));
+
+  // Empty values are nulls, except in string columns
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<Int64Type, int64_t>({true, false}, {1, 0}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  ArrayFromVector<DoubleType, double>({false, true}, {0, 2.5}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+  ArrayFromVector<StringType, std::string>({"x", ""}, &expected);
+  AssertColumnEquals(*expected, *table, 2);
+}
+
+TEST(TestCsvReader, Quoting) {
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("a,b\n\"x,1\",\"say \"\"hi\"\"\"\n\"two\nlines\",\"\"\n",
+                    ReadOptions(), &table));
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<StringType, std::string>({"x,1", "two\nlines"}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  ArrayFromVector<StringType, std::string>({"say \"hi\"", ""}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+
+  ReadOptions options;
+  options.quoting = false;
+  ASSERT_OK(ReadCsv("a,b\n\"x\",y\n", options, &table));
+  ArrayFromVector<StringType, std::string>({"\"x\""}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+}
+
+TEST(TestCsvReader, LineBreaks) {
+  std::shared_ptr<Table> table;
+  // CRLF line breaks, blank lines and no line break after the last row
+  ASSERT_OK(ReadCsv("a,b\r\n1,\"x\"\r\n\r\n\n2,y", ReadOptions(), &table));
+  ASSERT_EQ(2, table->num_rows());
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<Int64Type, int64_t>({1, 2}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  ArrayFromVector<StringType, std::string>({"x", "y"}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+}
+
+TEST(TestCsvReader, Options) {
+  ReadOptions options;
+  options.header = false;
+  options.delimiter = '|';
+  options.column_types["f1"] = int32();
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("1|2\n3|4\n", options, &table));
+
+  auto expected_schema = schema({field("f0", int64()), field("f1", int32())});
+  ASSERT_TRUE(table->schema()->Equals(*expected_schema));
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<Int32Type, int32_t>({2, 4}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+}
+
+TEST(TestCsvReader, ColumnTypes) {
+  ReadOptions options;
+  options.column_types["a"] = uint8();
+  options.column_types["b"] = float32();
+  options.column_types["c"] = utf8();
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("a,b,c\n255,0.5,1\n,-1,2\n", options, &table));
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<UInt8Type, uint8_t>({true, false}, {255, 0}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  ArrayFromVector<FloatType, float>({0.5f, -1.0f}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+  ArrayFromVector<StringType, std::string>({"1", "2"}, &expected);
+  AssertColumnEquals(*expected, *table, 2);
+
+  ASSERT_RAISES(Invalid, ReadCsv("a,b,c\n256,0,x\n", options, &table));
+  options.column_types["a"] = date32();
+  ASSERT_RAISES(NotImplemented, ReadCsv("a,b,c\n1,0,x\n", options, &table));
+}
+
+TEST(TestCsvReader, Integers) {
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("a,b\n9223372036854775807,9223372036854775808\n"
+                    "-9223372036854775808,1\n+0,-0\n",
+                    ReadOptions(), &table));
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<Int64Type, int64_t>({std::numeric_limits<int64_t>::max(),
+                                       std::numeric_limits<int64_t>::min(), 0},
+                                      &expected);
+  AssertColumnEquals(*expected, *table, 0);
+  // Too large for int64
+  ArrayFromVector<DoubleType, double>({9223372036854775808.0, 1, -0.0}, &expected);
+  AssertColumnEquals(*expected, *table, 1);
+}
+
+TEST(TestCsvReader, Doubles) {
+  const std::vector<std::string> values = {
+      "0.1",    "-1.5e-3",  "1E22",    "1e23", "0.30000000000000004", "5e-324",
+      ".5",     "3.",       "+2.5e+2", "-0",   "1.7976931348623157e308",
+      "1e-400", "12345678901234567890123"};
+  std::string contents = "a\n";
+  for (const std::string& value : values) {
+    contents += value + "\n";
+  }
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv(contents, ReadOptions(), &table));
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<DoubleType, double>(
+      {0.1, -1.5e-3, 1e22, 1e23, 0.30000000000000004, 5e-324, 0.5, 3, 250, -0.0,
+       1.7976931348623157e308, 0, 12345678901234567890123.0},
+      &expected);
+  AssertColumnEquals(*expected, *table, 0);
+
+  ASSERT_OK(ReadCsv("a\nnan\n-inf\nInfinity\n1e400\n", ReadOptions(), &table));
+  auto column = std::static_pointer_cast<DoubleArray>(table->column(0)->data()->chunk(0));
+  ASSERT_TRUE(std::isnan(column->Value(0)));
+  ASSERT_EQ(-std::numeric_limits<double>::infinity(), column->Value(1));
+  ASSERT_EQ(std::numeric_limits<double>::infinity(), column->Value(2));
+  ASSERT_EQ(std::numeric_limits<double>::infinity(), column->Value(3));
+
+  // Not numbers
+  for (const char* value : {"1e", "e1", ".", "-", "1.5.", "1,5", "0x10", " 1"}) {
+    ASSERT_OK(ReadCsv(std::string("a\n\"") + value + "\"\n", ReadOptions(), &table));
+    ASSERT_EQ(Type::STRING, table->column(0)->type()->id()) << value;
+  }
+}
+
+TEST(TestCsvReader, IgnoresLocale) {
+  std::locale locale;
+  try {
+    locale = std::locale("de_DE.UTF-8");
+  } catch (const std::runtime_error&) {
+    return;
+  }
+  std::locale previous = std::locale::global(locale);
+  std::shared_ptr<Table> table;
+  Status s = ReadCsv("a\n0.12345678901234567\n1e30\n", ReadOptions(), &table);
+  std::locale::global(previous);
+  ASSERT_OK(s);
+
+  std::shared_ptr<Array> expected;
+  ArrayFromVector<DoubleType, double>({0.12345678901234567, 1e30}, &expected);
+  AssertColumnEquals(*expected, *table, 0);
+}
+
+TEST(TestCsvReader, Blocks) {
+  const std::string contents = MakeCsv(1000);
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(ReadCsv(contents, ReadOptions(), &expected));
+  ASSERT_EQ(1000, expected->num_rows());
+  ASSERT_EQ(1, expected->column(0)->data()->num_chunks());
+
+  for (int num_threads : {1, 4}) {
+    for (int64_t block_size : {1, 64, 1000}) {
+      ReadOptions options;
+      options.num_threads = num_threads;
+      options.block_size = block_size;
+      std::shared_ptr<Table> table;
+      ASSERT_OK(ReadCsv(contents, options, &table));
+      ASSERT_LT(1, table->column(0)->data()->num_chunks());
+      ASSERT_TRUE(table->Equals(*expected))
+          << "num_threads=" << num_threads << " block_size=" << block_size;
+    }
+  }
+}
+
+TEST(TestCsvReader, TypesAcrossBlocks) {
+  // The first blocks have only integers, booleans or empty values, and the
+  // last one changes the type of every column
+  std::string contents = "a,b,c,d,e\n";
+  std::vector<double> a;
+  std::vector<std::string> c;
+  for (int i = 0; i < 100; ++i) {
+    contents += std::to_string(i) + ",," + std::to_string(i) + ".50,true,\n";
+    a.push_back(i);
+    c.push_back(std::to_string(i) + ".50");
+  }
+  contents += "0.5,x,y,z,false\n";
+  a.push_back(0.5);
+  c.push_back("y");
+
+  for (int num_threads : {1, 3}) {
+    ReadOptions options;
+    options.block_size = 32;
+    options.num_threads = num_threads;
+    std::shared_ptr<Table> table;
+    ASSERT_OK(ReadCsv(contents, options, &table));
+    ASSERT_EQ(101, table->num_rows());
+    ASSERT_LT(1, table->column(0)->data()->num_chunks());
+
+    std::shared_ptr<Array> expected;
+    ArrayFromVector<DoubleType, double>(a, &expected);
+    AssertColumnEquals(*expected, *table, 0);
+    std::vector<std::string> b(100, "");
+    b.push_back("x");
+    ArrayFromVector<StringType, std::string>(b, &expected);
+    AssertColumnEquals(*expected, *table, 1);
+    // Strings keep the text of values first read as numbers
+    ArrayFromVector<StringType, std::string>(c, &expected);
+    AssertColumnEquals(*expected, *table, 2);
+    std::vector<std::string> d(100, "true");
+    d.push_back("z");
+    ArrayFromVector<StringType, std::string>(d, &expected);
+    AssertColumnEquals(*expected, *table, 3);
+    std::vector<bool> e_valid(100, false);
+    e_valid.push_back(true);
+    ArrayFromVector<BooleanType, bool>(e_valid, std::vector<bool>(101, false),
+                                       &expected);
+    AssertColumnEquals(*expected, *table, 4);
+  }
+}
+
+TEST(TestCsvReader, StringsAcrossBlocks) {
+  // The first block shows that the columns hold strings, and the later blocks
+  // have only numbers and booleans, which are read as strings too
+  std::string contents = "a,b\nx,y\n";
+  std::vector<std::string> a = {"x"};
+  std::vector<std::string> b = {"y"};
+  for (int i = 0; i < 100; ++i) {
+    contents += std::to_string(i) + "," + (i % 2 == 0 ? "true\n" : "false\n");
+    a.push_back(std::to_string(i));
+    b.push_back(i % 2 == 0 ? "true" : "false");
+  }
+
+  for (int num_threads : {1, 3}) {
+    ReadOptions options;
+    options.block_size = 32;
+    options.num_threads = num_threads;
+    std::shared_ptr<Table> table;
+    ASSERT_OK(ReadCsv(contents, options, &table));
+    ASSERT_EQ(101, table->num_rows());
+    ASSERT_LT(1, table->column(0)->data()->num_chunks());
+
+    std::shared_ptr<Array> expected;
+    ArrayFromVector<StringType, std::string>(a, &expected);
+    AssertColumnEquals(*expected, *table, 0);
+    ArrayFromVector<StringType, std::string>(b, &expected);
+    AssertColumnEquals(*expected, *table, 1);
+  }
+}
+
+TEST(TestCsvReader, StrayQuotes) {
+  std::shared_ptr<Table> table;
+  // A quote inside an unquoted field is an ordinary character, and does not
+  // start a quoted field
+  const std::string contents = "a,b\nx\"y,1\n\"p\nq\",2\n";
+  std::shared_ptr<Array> expected_a;
+  std::shared_ptr<Array> expected_b;
+  ArrayFromVector<StringType, std::string>({"x\"y", "p\nq"}, &expected_a);
+  ArrayFromVector<Int64Type, int64_t>({1, 2}, &expected_b);
+  for (int64_t block_size : {1, 2, 3, 5, 8, 1 << 20}) {
+    ReadOptions options;
+    options.block_size = block_size;
+    ASSERT_OK(ReadCsv(contents, options, &table));
+    AssertColumnEquals(*expected_a, *table, 0);
+    AssertColumnEquals(*expected_b, *table, 1);
+  }
+
+  // An odd number of stray quotes does not hide the later row ends
+  std::string rows = "a,b\n";
+  for (int i = 0; i < 100; ++i) {
+    rows += "x\"" + std::to_string(i) + ",\"" + std::to_string(i) + "\n\"\n";
+  }
+  ReadOptions options;
+  options.block_size = 64;
+  ASSERT_OK(ReadCsv(rows, options, &table));
+  ASSERT_EQ(100, table->num_rows());
+  ASSERT_LT(static_cast<int>(rows.size() / 128), table->column(0)->data()->num_chunks());
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(ReadCsv(rows, ReadOptions(), &expected));
+  ASSERT_TRUE(table->Equals(*expected));
+}
+
+TEST(TestCsvReader, EmptyInput) {
+  std::shared_ptr<Table> table;
+  ASSERT_OK(ReadCsv("", ReadOptions(), &table));
+  ASSERT_EQ(0, table->num_columns());
+
+  ASSERT_OK(ReadCsv("a,b\n", ReadOptions(), &table));
+  ASSERT_EQ(2, table->num_columns());
+  ASSERT_EQ(0, table->num_rows());
+  ASSERT_EQ("b", table->column(1)->name());
+}
+
+TEST(TestCsvReader, Errors) {
+  std::shared_ptr<Table> table;
+  ASSERT_RAISES(Invalid, ReadCsv("a,b\n1,2\n3\n", ReadOptions(), &table));
+  ASSERT_RAISES(Invalid, ReadCsv("a,b\n1,\"2\n", ReadOptions(), &table));
+  ASSERT_RAISES(Invalid, ReadCsv("a,b\n1,\"2\"3\n", ReadOptions(), &table));
+
+  // Rows of different sizes in different blocks
+  ReadOptions options;
+  options.block_size = 4;
+  options.num_threads = 2;
+  ASSERT_RAISES(Invalid, ReadCsv("a,b\n1,2\n3,4\n5\n", options, &table));
+
+  options.block_size = 0;
+  ASSERT_RAISES(Invalid, ReadCsv("a\n1\n", options, &table));
+  options = ReadOptions();
+  options.delimiter = '"';
+  ASSERT_RAISES(Invalid, ReadCsv("a\n1\n", options, &table));
+}
+
+TEST(TestStreamingReader, ReadBatches) {
+  const std::string contents = MakeCsv(1000);
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(ReadCsv(contents, ReadOptions(), &expected));
+
+  for (int num_threads : {1, 4}) {
+    ReadOptions options;
+    options.num_threads = num_threads;
+    options.block_size = 256;
+    std::shared_ptr<StreamingReader> reader;
+    ASSERT_OK(StreamingReader::Open(MakeInput(contents), default_memory_pool(), options,
+                                    &reader));
+    ASSERT_TRUE(reader->schema()->Equals(*expected->schema()));
+
+    std::vector<std::shared_ptr<RecordBatch>> batches;
+    std::shared_ptr<RecordBatch> batch;
+    ASSERT_OK(reader->ReadNext(&batch));
+    while (batch != nullptr) {
+      batches.push_back(batch);
+      ASSERT_OK(reader->ReadNext(&batch));
+    }
+    ASSERT_LT(1, static_cast<int>(batches.size()));
+    std::shared_ptr<Table> table;
+    ASSERT_OK(Table::FromRecordBatches(batches, &table));
+    ASSERT_TRUE(table->Equals(*expected));
+  }
+}
+
+TEST(TestStreamingReader, TypesFromFirstBlock) {
+  ReadOptions options;
+  options.block_size = 4;
+  std::shared_ptr<StreamingReader> reader;
+  ASSERT_OK(StreamingReader::Open(MakeInput("a,b\n1,\n2,\nx,y\n"), default_memory_pool(),
+                                  options, &reader));
+
+  // Columns that are empty in the first block are strings
+  auto expected_schema = schema({field("a", int64()), field("b", utf8())});
+  ASSERT_TRUE(reader->schema()->Equals(*expected_schema));
+
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(reader->ReadNext(&batch));
+  ASSERT_EQ(1, batch->num_rows());
+  ASSERT_OK(reader->ReadNext(&batch));
+  ASSERT_RAISES(Invalid, reader->ReadNext(&batch));
+}
+
+TEST(TestStreamingReader, EmptyInput) {
+  std::shared_ptr<StreamingReader> reader;
+  ASSERT_OK(StreamingReader::Open(MakeInput("a,b\n"), default_memory_pool(),
+                                  ReadOptions(), &reader));
+  ASSERT_EQ(2, reader->schema()->num_fields());
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+}
+
+}  // namespace csv
+}  // namespace arrow
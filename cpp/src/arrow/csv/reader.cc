@@ -0,0 +1,1270 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/csv/reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/builder.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+#include "arrow/util/parallel.h"
+
+namespace arrow {
+namespace csv {
+
+ReadOptions::ReadOptions()
+    : delimiter(','),
+      quoting(true),
+      quote_char('"'),
+      header(true),
+      block_size(1 << 20),
+      num_threads(1) {}
+
+namespace {
+
+Status ValidateOptions(const ReadOptions& options) {
+  if (options.delimiter == '\n' || options.delimiter == '\r') {
+    return Status::Invalid("CSV delimiter cannot be a line break");
+  }
+  if (options.quoting && options.quote_char == options.delimiter) {
+    return Status::Invalid("CSV quote character cannot be the delimiter");
+  }
+  if (options.block_size <= 0) {
+    return Status::Invalid("CSV block size must be positive");
+  }
+  if (options.num_threads < 1) {
+    return Status::Invalid("CSV reader needs at least one thread");
+  }
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Splitting the input into blocks of whole rows
+
+// Find the row ends in data the same way ParsedBlock::Parse splits rows. A
+// quote character opens a quoted field only at the start of a field, and
+// elsewhere in an unquoted field it is an ordinary character.
+//
+// The scan state carries over from one call to the next, so that a stream is
+// scanned only once however it is cut into pieces.
+class RowEndScanner {
+ public:
+  explicit RowEndScanner(const ReadOptions& options)
+      : delimiter_(static_cast<uint8_t>(options.delimiter)),
+        quote_char_(static_cast<uint8_t>(options.quote_char)),
+        quoting_(options.quoting),
+        state_(FIELD_START) {}
+
+  // Scan the data that follows what was scanned before. Return the size of
+  // data up to and including its last row end, or 0 if there is none.
+  int64_t Scan(const uint8_t* data, int64_t size) {
+    if (size == 0) {
+      return 0;
+    }
+    if (!quoting_ || ((state_ == FIELD_START || state_ == UNQUOTED) &&
+                      std::memchr(data, quote_char_, size) == nullptr)) {
+      // No field is quoted, so every line break ends a row
+      const uint8_t last = data[size - 1];
+      state_ = (last == delimiter_ || last == '\n') ? FIELD_START : UNQUOTED;
+      for (int64_t i = size - 1; i >= 0; --i) {
+        if (data[i] == '\n') {
+          return i + 1;
+        }
+      }
+      return 0;
+    }
+
+    int64_t end = 0;
+    State state = state_;
+    for (int64_t i = 0; i < size; ++i) {
+      const uint8_t c = data[i];
+      switch (state) {
+        case QUOTED:
+          if (c == quote_char_) {
+            state = QUOTE_IN_QUOTED;
+          }
+          continue;
+        case QUOTE_IN_QUOTED:
+          if (c == quote_char_) {
+            // A doubled quote
+            state = QUOTED;
+            continue;
+          }
+          break;
+        case FIELD_START:
+          if (c == quote_char_) {
+            state = QUOTED;
+            continue;
+          }
+          break;
+        case UNQUOTED:
+          break;
+      }
+      if (c == '\n') {
+        end = i + 1;
+        state = FIELD_START;
+      } else if (c == delimiter_) {
+        state = FIELD_START;
+      } else {
+        state = UNQUOTED;
+      }
+    }
+    state_ = state;
+    return end;
+  }
+
+ private:
+  enum State { FIELD_START, UNQUOTED, QUOTED, QUOTE_IN_QUOTED };
+
+  const uint8_t delimiter_;
+  const uint8_t quote_char_;
+  const bool quoting_;
+  State state_;
+};
+
+// Read an input stream in blocks of about block_size bytes, ending at row
+// boundaries. A row that does not end in a block is carried over to the next.
+class BlockReader {
+ public:
+  BlockReader(const std::shared_ptr<io::InputStream>& input, MemoryPool* pool,
+              const ReadOptions& options)
+      : input_(input), pool_(pool), options_(options), scanner_(options), eof_(false) {}
+
+  // Read the next block, or null at the end of the input
+  Status ReadNext(std::shared_ptr<Buffer>* out) {
+    while (!eof_) {
+      // Read at least as much as is carried over, so that the bytes of a long
+      // row are copied a bounded number of times
+      const int64_t partial_size = partial_ ? partial_->size() : 0;
+      const int64_t read_size = std::max(options_.block_size, partial_size);
+      std::shared_ptr<ResizableBuffer> buffer;
+      RETURN_NOT_OK(AllocateResizableBuffer(pool_, partial_size + read_size, &buffer));
+      if (partial_size > 0) {
+        std::memcpy(buffer->mutable_data(), partial_->data(), partial_size);
+      }
+      int64_t bytes_read = 0;
+      RETURN_NOT_OK(
+          input_->Read(read_size, &bytes_read, buffer->mutable_data() + partial_size));
+      RETURN_NOT_OK(buffer->Resize(partial_size + bytes_read));
+      partial_ = buffer;
+      if (bytes_read == 0) {
+        eof_ = true;
+        break;
+      }
+      // The carried over bytes were scanned already
+      const int64_t end = scanner_.Scan(buffer->data() + partial_size, bytes_read);
+      if (end > 0) {
+        *out = SliceBuffer(partial_, 0, partial_size + end);
+        partial_ = SliceBuffer(partial_, partial_size + end, bytes_read - end);
+        return Status::OK();
+      }
+    }
+    // The last row of the input need not end with a line break
+    if (partial_ && partial_->size() > 0) {
+      *out = partial_;
+    } else {
+      *out = nullptr;
+    }
+    partial_.reset();
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<io::InputStream> input_;
+  MemoryPool* pool_;
+  const ReadOptions& options_;
+  RowEndScanner scanner_;
+  std::shared_ptr<Buffer> partial_;
+  bool eof_;
+};
+
+// ----------------------------------------------------------------------
+// Parsing a block into fields
+
+// A field of a parsed block. It points into the block data, or into the
+// unescaped values of the block for quoted fields with doubled quotes.
+struct FieldRef {
+  const char* data;
+  int32_t size;
+};
+
+class ParsedBlock {
+ public:
+  ParsedBlock() : num_columns_(-1), num_rows_(0), first_row_(0) {}
+
+  // Split data into rows and fields. Blank lines are skipped, and all rows
+  // must have the same number of fields.
+  Status Parse(const ReadOptions& options, const std::shared_ptr<Buffer>& data);
+
+  int num_columns() const { return num_columns_; }
+
+  int64_t num_rows() const { return num_rows_ - first_row_; }
+
+  const FieldRef& field(int64_t row, int column) const {
+    return fields_[(first_row_ + row) * num_columns_ + column];
+  }
+
+  // Skip the first row, after reading it as the header
+  void DropFirstRow() { ++first_row_; }
+
+ private:
+  std::shared_ptr<Buffer> data_;
+  // Allocated at the first doubled quote, as large as the rest of the data, so
+  // that it is never reallocated under the fields
+  std::vector<char> unescaped_;
+  std::vector<FieldRef> fields_;
+  int num_columns_;
+  int64_t num_rows_;
+  int64_t first_row_;
+};
+
+Status ParsedBlock::Parse(const ReadOptions& options,
+                          const std::shared_ptr<Buffer>& data) {
+  data_ = data;
+  // The next position in unescaped_
+  char* unescaped = nullptr;
+
+  const char delimiter = options.delimiter;
+  const char quote_char = options.quote_char;
+  const bool quoting = options.quoting;
+  const char* p = reinterpret_cast<const char*>(data->data());
+  const char* end = p + data->size();
+
+  while (p < end) {
+    if (*p == '\n') {
+      ++p;
+      continue;
+    }
+    if (*p == '\r' && (p + 1 == end || p[1] == '\n')) {
+      p += p + 1 == end ? 1 : 2;
+      continue;
+    }
+    const size_t row_start = fields_.size();
+    while (true) {
+      FieldRef field;
+      if (quoting && p < end && *p == quote_char) {
+        const char* start = ++p;
+        char* out = nullptr;
+        while (true) {
+          const char* quote = static_cast<const char*>(
+              std::memchr(p, quote_char, static_cast<size_t>(end - p)));
+          if (quote == nullptr) {
+            return Status::Invalid("CSV quoted field is not terminated");
+          }
+          if (quote + 1 < end && quote[1] == quote_char) {
+            // A doubled quote: copy the field up to the first one
+            if (out == nullptr) {
+              if (unescaped == nullptr) {
+                unescaped_.resize(static_cast<size_t>(end - start));
+                unescaped = unescaped_.data();
+              }
+              out = unescaped;
+            }
+            std::memcpy(out, p, quote + 1 - p);
+            out += quote + 1 - p;
+            p = quote + 2;
+            continue;
+          }
+          if (out == nullptr) {
+            field.data = start;
+            field.size = static_cast<int32_t>(quote - start);
+          } else {
+            std::memcpy(out, p, quote - p);
+            out += quote - p;
+            field.data = unescaped;
+            field.size = static_cast<int32_t>(out - unescaped);
+            unescaped = out;
+          }
+          p = quote + 1;
+          break;
+        }
+        if (p < end && *p == '\r' && (p + 1 == end || p[1] == '\n')) {
+          ++p;
+        }
+        if (p < end && *p != delimiter && *p != '\n') {
+          return Status::Invalid("CSV quoted field is followed by other characters");
+        }
+      } else {
+        const char* start = p;
+        while (p < end && *p != delimiter && *p != '\n') {
+          ++p;
+        }
+        const char* field_end = p;
+        if (field_end > start && field_end[-1] == '\r' && (p == end || *p == '\n')) {
+          --field_end;
+        }
+        field.data = start;
+        field.size = static_cast<int32_t>(field_end - start);
+      }
+      fields_.push_back(field);
+      if (p == end) {
+        break;
+      }
+      if (*p++ == '\n') {
+        break;
+      }
+    }
+
+    const int64_t row_size = static_cast<int64_t>(fields_.size() - row_start);
+    if (num_columns_ < 0) {
+      num_columns_ = static_cast<int>(row_size);
+    } else if (row_size != num_columns_) {
+      std::stringstream ss;
+      ss << "CSV row has " << row_size << " fields, expected " << num_columns_;
+      return Status::Invalid(ss.str());
+    }
+    ++num_rows_;
+  }
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Converting values without regard to the locale
+
+bool ParseBoolean(const FieldRef& field, bool* out) {
+  static const char* kTrue[] = {"true", "True", "TRUE"};
+  static const char* kFalse[] = {"false", "False", "FALSE"};
+  const size_t size = static_cast<size_t>(field.size);
+  if (size == 4) {
+    for (const char* value : kTrue) {
+      if (std::memcmp(field.data, value, 4) == 0) {
+        *out = true;
+        return true;
+      }
+    }
+  } else if (size == 5) {
+    for (const char* value : kFalse) {
+      if (std::memcmp(field.data, value, 5) == 0) {
+        *out = false;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Parse one or more decimal digits, failing if the value exceeds max
+bool ParseDigits(const char* p, const char* end, uint64_t max, uint64_t* out) {
+  if (p == end) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (; p < end; ++p) {
+    const uint64_t digit = static_cast<uint64_t>(*p - '0');
+    if (digit > 9 || value > (max - digit) / 10) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  *out = value;
+  return true;
+}
+
+bool ParseInt64(const FieldRef& field, int64_t* out) {
+  const char* p = field.data;
+  const char* end = p + field.size;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p++ == '-';
+  }
+  const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+  uint64_t value;
+  if (!ParseDigits(p, end, negative ? max + 1 : max, &value)) {
+    return false;
+  }
+  if (negative) {
+    *out = value == 0 ? 0 : -static_cast<int64_t>(value - 1) - 1;
+  } else {
+    *out = static_cast<int64_t>(value);
+  }
+  return true;
+}
+
+bool ParseUInt64(const FieldRef& field, uint64_t* out) {
+  const char* p = field.data;
+  const char* end = p + field.size;
+  if (p < end && *p == '+') {
+    ++p;
+  }
+  return ParseDigits(p, end, std::numeric_limits<uint64_t>::max(), out);
+}
+
+bool EqualsIgnoreCase(const char* p, const char* end, const char* value) {
+  const size_t size = std::strlen(value);
+  if (static_cast<size_t>(end - p) != size) {
+    return false;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    if ((p[i] | 0x20) != value[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Powers of ten that are exact as doubles
+const double kPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                               1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                               1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Parse a decimal number, with an optional exponent, or nan, inf or infinity.
+//
+// When the significant digits fit in 53 bits and the exponent is at most 22,
+// both are exact doubles and a single multiplication or division gives the
+// correctly rounded value. Other numbers are converted by a stream in the
+// classic locale.
+bool ParseDouble(const FieldRef& field, double* out) {
+  const char* p = field.data;
+  const char* end = p + field.size;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p++ == '-';
+  }
+  const char* number = p;
+  if (p < end && (*p < '0' || *p > '9') && *p != '.') {
+    if (EqualsIgnoreCase(p, end, "nan")) {
+      *out = std::numeric_limits<double>::quiet_NaN();
+    } else if (EqualsIgnoreCase(p, end, "inf") || EqualsIgnoreCase(p, end, "infinity")) {
+      *out = std::numeric_limits<double>::infinity();
+    } else {
+      return false;
+    }
+    if (negative) {
+      *out = -*out;
+    }
+    return true;
+  }
+
+  uint64_t mantissa = 0;
+  int num_digits = 0;
+  int exponent = 0;
+  bool any_digits = false;
+  bool truncated = false;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+    any_digits = true;
+    if (num_digits < 19) {
+      if (mantissa > 0 || *p != '0') {
+        mantissa = mantissa * 10 + (*p - '0');
+        ++num_digits;
+      }
+    } else {
+      truncated = true;
+      ++exponent;
+    }
+  }
+  if (p < end && *p == '.') {
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+      any_digits = true;
+      if (num_digits < 19) {
+        if (mantissa > 0 || *p != '0') {
+          mantissa = mantissa * 10 + (*p - '0');
+          ++num_digits;
+        }
+        --exponent;
+      } else {
+        truncated = true;
+      }
+    }
+  }
+  if (!any_digits) {
+    return false;
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative_exponent = *p++ == '-';
+    }
+    if (p == end) {
+      return false;
+    }
+    int explicit_exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      if (explicit_exponent < 100000) {
+        explicit_exponent = explicit_exponent * 10 + (*p - '0');
+      }
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+  if (p != end) {
+    return false;
+  }
+
+  double value;
+  if (mantissa == 0) {
+    value = 0;
+  } else if (!truncated && mantissa <= (1ULL << 53) && exponent >= -22 &&
+             exponent <= 22) {
+    value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+      value /= kPowersOfTen[-exponent];
+    } else {
+      value *= kPowersOfTen[exponent];
+    }
+  } else {
+    static thread_local std::istringstream stream;
+    static thread_local bool imbued = false;
+    if (!imbued) {
+      stream.imbue(std::locale::classic());
+      imbued = true;
+    }
+    stream.clear();
+    stream.str(std::string(number, end - number));
+    stream >> value;
+    if (stream.fail()) {
+      // The syntax is valid, so the value is out of range
+      value = exponent > 0 ? std::numeric_limits<double>::infinity() : 0;
+    }
+  }
+  *out = negative ? -value : value;
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,
+                        bool>::type
+ParseValue(const FieldRef& field, T* out) {
+  int64_t value;
+  if (!ParseInt64(field, &value) || value < std::numeric_limits<T>::min() ||
+      value > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  *out = static_cast<T>(value);
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value,
+                        bool>::type
+ParseValue(const FieldRef& field, T* out) {
+  uint64_t value;
+  if (!ParseUInt64(field, &value) || value > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  *out = static_cast<T>(value);
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type ParseValue(
+    const FieldRef& field, T* out) {
+  double value;
+  if (!ParseDouble(field, &value)) {
+    return false;
+  }
+  *out = static_cast<T>(value);
+  return true;
+}
+
+// ----------------------------------------------------------------------
+// Type inference
+
+// The inferred types, in the order they are tried
+enum class InferredType : int { NA, BOOLEAN, INT64, DOUBLE, STRING };
+
+InferredType InferColumnType(const ParsedBlock& block, int column) {
+  InferredType type = InferredType::NA;
+  for (int64_t row = 0; row < block.num_rows(); ++row) {
+    const FieldRef& field = block.field(row, column);
+    if (field.size == 0) {
+      continue;
+    }
+    if (type <= InferredType::BOOLEAN) {
+      bool value;
+      if (ParseBoolean(field, &value)) {
+        type = InferredType::BOOLEAN;
+        continue;
+      }
+      if (type == InferredType::BOOLEAN) {
+        return InferredType::STRING;
+      }
+    }
+    if (type <= InferredType::INT64) {
+      int64_t value;
+      if (ParseInt64(field, &value)) {
+        type = InferredType::INT64;
+        continue;
+      }
+    }
+    double value;
+    if (!ParseDouble(field, &value)) {
+      return InferredType::STRING;
+    }
+    type = InferredType::DOUBLE;
+  }
+  return type;
+}
+
+// The type of a column inferred from blocks of type left and right
+InferredType MergeTypes(InferredType left, InferredType right) {
+  if (left == right || right == InferredType::NA) {
+    return left;
+  }
+  if (left == InferredType::NA) {
+    return right;
+  }
+  if (left >= InferredType::INT64 && left <= InferredType::DOUBLE &&
+      right >= InferredType::INT64 && right <= InferredType::DOUBLE) {
+    return InferredType::DOUBLE;
+  }
+  return InferredType::STRING;
+}
+
+std::shared_ptr<DataType> GetDataType(InferredType type) {
+  switch (type) {
+    case InferredType::NA:
+      return null();
+    case InferredType::BOOLEAN:
+      return boolean();
+    case InferredType::INT64:
+      return int64();
+    case InferredType::DOUBLE:
+      return float64();
+    default:
+      return utf8();
+  }
+}
+
+// ----------------------------------------------------------------------
+// Conversion of a column of a block to an Arrow array
+
+Status InvalidValue(const FieldRef& field, const DataType& type) {
+  std::stringstream ss;
+  ss << "CSV value '" << std::string(field.data, field.size) << "' is not a valid "
+     << type.ToString();
+  return Status::Invalid(ss.str());
+}
+
+Status ConvertBoolean(const ParsedBlock& block, int column, MemoryPool* pool,
+                      std::shared_ptr<Array>* out) {
+  const int64_t length = block.num_rows();
+  std::vector<uint8_t> values(length);
+  std::vector<uint8_t> valid_bytes(length);
+  for (int64_t row = 0; row < length; ++row) {
+    const FieldRef& field = block.field(row, column);
+    if (field.size == 0) {
+      continue;
+    }
+    bool value;
+    if (!ParseBoolean(field, &value)) {
+      return InvalidValue(field, *boolean());
+    }
+    values[row] = value;
+    valid_bytes[row] = 1;
+  }
+  BooleanBuilder builder(pool);
+  RETURN_NOT_OK(builder.Append(values.data(), length, valid_bytes.data()));
+  return builder.Finish(out);
+}
+
+template <typename ArrowType>
+Status ConvertNumeric(const ParsedBlock& block, int column,
+                      const std::shared_ptr<DataType>& type, MemoryPool* pool,
+                      std::shared_ptr<Array>* out) {
+  using c_type = typename ArrowType::c_type;
+  const int64_t length = block.num_rows();
+  std::vector<c_type> values(length);
+  std::vector<uint8_t> valid_bytes(length);
+  for (int64_t row = 0; row < length; ++row) {
+    const FieldRef& field = block.field(row, column);
+    if (field.size == 0) {
+      continue;
+    }
+    if (!ParseValue(field, &values[row])) {
+      return InvalidValue(field, *type);
+    }
+    valid_bytes[row] = 1;
+  }
+  NumericBuilder<ArrowType> builder(type, pool);
+  RETURN_NOT_OK(builder.Append(values.data(), length, valid_bytes.data()));
+  return builder.Finish(out);
+}
+
+// Empty fields are empty values rather than nulls
+template <typename BuilderType>
+Status ConvertBinary(const ParsedBlock& block, int column, MemoryPool* pool,
+                     std::shared_ptr<Array>* out) {
+  const int64_t length = block.num_rows();
+  int64_t data_size = 0;
+  for (int64_t row = 0; row < length; ++row) {
+    data_size += block.field(row, column).size;
+  }
+  BuilderType builder(pool);
+  RETURN_NOT_OK(builder.Reserve(length));
+  RETURN_NOT_OK(builder.ReserveData(data_size));
+  for (int64_t row = 0; row < length; ++row) {
+    const FieldRef& field = block.field(row, column);
+    RETURN_NOT_OK(builder.Append(field.data, field.size));
+  }
+  return builder.Finish(out);
+}
+
+Status ConvertColumn(const ParsedBlock& block, int column,
+                     const std::shared_ptr<DataType>& type, MemoryPool* pool,
+                     std::shared_ptr<Array>* out) {
+  switch (type->id()) {
+    case Type::NA:
+      *out = std::make_shared<NullArray>(block.num_rows());
+      return Status::OK();
+    case Type::BOOL:
+      return ConvertBoolean(block, column, pool, out);
+    case Type::INT8:
+      return ConvertNumeric<Int8Type>(block, column, type, pool, out);
+    case Type::INT16:
+      return ConvertNumeric<Int16Type>(block, column, type, pool, out);
+    case Type::INT32:
+      return ConvertNumeric<Int32Type>(block, column, type, pool, out);
+    case Type::INT64:
+      return ConvertNumeric<Int64Type>(block, column, type, pool, out);
+    case Type::UINT8:
+      return ConvertNumeric<UInt8Type>(block, column, type, pool, out);
+    case Type::UINT16:
+      return ConvertNumeric<UInt16Type>(block, column, type, pool, out);
+    case Type::UINT32:
+      return ConvertNumeric<UInt32Type>(block, column, type, pool, out);
+    case Type::UINT64:
+      return ConvertNumeric<UInt64Type>(block, column, type, pool, out);
+    case Type::FLOAT:
+      return ConvertNumeric<FloatType>(block, column, type, pool, out);
+    case Type::DOUBLE:
+      return ConvertNumeric<DoubleType>(block, column, type, pool, out);
+    case Type::STRING:
+      return ConvertBinary<StringBuilder>(block, column, pool, out);
+    case Type::BINARY:
+      return ConvertBinary<BinaryBuilder>(block, column, pool, out);
+    default:
+      break;
+  }
+  return Status::NotImplemented("Cannot read CSV values as " + type->ToString());
+}
+
+Status ConvertBlock(const ParsedBlock& block, const std::shared_ptr<Schema>& schema,
+                    MemoryPool* pool, std::vector<std::shared_ptr<Array>>* out) {
+  out->resize(schema->num_fields());
+  for (int i = 0; i < schema->num_fields(); ++i) {
+    RETURN_NOT_OK(ConvertColumn(block, i, schema->field(i)->type(), pool, &(*out)[i]));
+  }
+  return Status::OK();
+}
+
+template <typename BuilderType, typename T>
+Status MakeNulls(int64_t length, MemoryPool* pool, std::shared_ptr<Array>* out) {
+  std::vector<T> values(length);
+  std::vector<uint8_t> valid_bytes(length);
+  BuilderType builder(pool);
+  RETURN_NOT_OK(builder.Append(values.data(), length, valid_bytes.data()));
+  return builder.Finish(out);
+}
+
+// A column of empty fields converted to type, as nulls or empty strings
+Status MakeEmptyValues(const std::shared_ptr<DataType>& type, int64_t length,
+                       MemoryPool* pool, std::shared_ptr<Array>* out) {
+  switch (type->id()) {
+    case Type::NA:
+      *out = std::make_shared<NullArray>(length);
+      return Status::OK();
+    case Type::BOOL:
+      return MakeNulls<BooleanBuilder, uint8_t>(length, pool, out);
+    case Type::INT64:
+      return MakeNulls<Int64Builder, int64_t>(length, pool, out);
+    case Type::DOUBLE:
+      return MakeNulls<DoubleBuilder, double>(length, pool, out);
+    case Type::STRING: {
+      StringBuilder builder(pool);
+      RETURN_NOT_OK(builder.Reserve(length));
+      for (int64_t i = 0; i < length; ++i) {
+        RETURN_NOT_OK(builder.Append("", 0));
+      }
+      return builder.Finish(out);
+    }
+    default:
+      break;
+  }
+  return Status::NotImplemented("Cannot make empty CSV values of " + type->ToString());
+}
+
+// Widen an int64 column to doubles. Each integer is exact, so it rounds to the
+// same double as its text would.
+Status CastToDouble(const Array& array, MemoryPool* pool, std::shared_ptr<Array>* out) {
+  const auto& integers = static_cast<const Int64Array&>(array);
+  std::shared_ptr<Buffer> data;
+  RETURN_NOT_OK(AllocateBuffer(pool, array.length() * sizeof(double), &data));
+  auto values = reinterpret_cast<double*>(data->mutable_data());
+  for (int64_t i = 0; i < array.length(); ++i) {
+    values[i] = static_cast<double>(integers.Value(i));
+  }
+  *out = std::make_shared<DoubleArray>(array.length(), data, array.null_bitmap(),
+                                       array.null_count());
+  return Status::OK();
+}
+
+// Get the column names from the first block with rows, dropping the header
+Status ReadColumnNames(const ReadOptions& options, ParsedBlock* block,
+                       std::vector<std::string>* out) {
+  out->clear();
+  for (int i = 0; i < block->num_columns(); ++i) {
+    if (options.header) {
+      const FieldRef& field = block->field(0, i);
+      out->emplace_back(field.data, field.size);
+    } else {
+      out->push_back("f" + std::to_string(i));
+    }
+  }
+  if (options.header) {
+    block->DropFirstRow();
+  }
+  return Status::OK();
+}
+
+Status CheckNumColumns(const ParsedBlock& block, int num_columns) {
+  if (block.num_rows() > 0 && block.num_columns() != num_columns) {
+    std::stringstream ss;
+    ss << "CSV row has " << block.num_columns() << " fields, expected " << num_columns;
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// TableReader implementation
+
+class TableReader::Impl {
+ public:
+  Impl(const std::shared_ptr<io::InputStream>& input, MemoryPool* pool,
+       const ReadOptions& options)
+      : pool_(pool),
+        options_(options),
+        block_reader_(input, pool, options_),
+        num_columns_(0) {}
+
+  Status Read(std::shared_ptr<Table>* out) {
+    // Take the column names from the first block with rows
+    std::shared_ptr<Buffer> data;
+    std::unique_ptr<ParsedBlock> block;
+    while (true) {
+      RETURN_NOT_OK(block_reader_.ReadNext(&data));
+      if (data == nullptr) {
+        auto schema = std::make_shared<Schema>(std::vector<std::shared_ptr<Field>>());
+        *out = Table::Make(schema, std::vector<std::shared_ptr<Column>>(), 0);
+        return Status::OK();
+      }
+      block.reset(new ParsedBlock());
+      RETURN_NOT_OK(block->Parse(options_, data));
+      if (block->num_rows() > 0) {
+        break;
+      }
+    }
+    num_columns_ = block->num_columns();
+    std::vector<std::string> names;
+    RETURN_NOT_OK(ReadColumnNames(options_, block.get(), &names));
+    column_types_.resize(num_columns_);
+    for (int i = 0; i < num_columns_; ++i) {
+      auto it = options_.column_types.find(names[i]);
+      if (it != options_.column_types.end()) {
+        column_types_[i] = it->second;
+      }
+    }
+
+    std::vector<InferredType> merged_types(num_columns_, InferredType::NA);
+    blocks_.emplace_back(new ConvertedBlock());
+    RETURN_NOT_OK(ConvertBlock(data, *block, options_.header, merged_types,
+                               blocks_.back().get()));
+    block.reset();
+    MergeBlockTypes(*blocks_.back(), &merged_types);
+    RETURN_NOT_OK(ConvertBlocks(&merged_types));
+
+    // Convert the columns of the blocks that were inferred as other types than
+    // the types merged over all blocks
+    std::vector<std::shared_ptr<Field>> fields;
+    for (int i = 0; i < num_columns_; ++i) {
+      if (column_types_[i] == nullptr) {
+        column_types_[i] = GetDataType(merged_types[i]);
+      }
+      fields.push_back(field(names[i], column_types_[i]));
+    }
+    const int num_blocks = static_cast<int>(blocks_.size());
+    const int num_threads = std::max(1, std::min(options_.num_threads, num_blocks));
+    RETURN_NOT_OK(ParallelFor(num_threads, num_blocks, [&](int i) {
+      return PromoteBlock(merged_types, blocks_[i].get());
+    }));
+
+    auto schema = std::make_shared<Schema>(fields);
+    std::vector<std::shared_ptr<Column>> columns;
+    int64_t num_rows = 0;
+    for (const auto& converted : blocks_) {
+      num_rows += converted->num_rows;
+    }
+    for (int i = 0; i < num_columns_; ++i) {
+      ArrayVector chunks;
+      for (const auto& converted : blocks_) {
+        if (converted->num_rows > 0) {
+          chunks.push_back(converted->columns[i]);
+        }
+      }
+      if (chunks.empty()) {
+        std::unique_ptr<ArrayBuilder> builder;
+        std::shared_ptr<Array> empty;
+        RETURN_NOT_OK(MakeBuilder(pool_, column_types_[i], &builder));
+        RETURN_NOT_OK(builder->Finish(&empty));
+        chunks.push_back(empty);
+      }
+      columns.push_back(std::make_shared<Column>(schema->field(i), chunks));
+    }
+    *out = Table::Make(schema, columns, num_rows);
+    return Status::OK();
+  }
+
+ private:
+  // The columns of a block, converted to the types inferred from the block
+  // alone, or as strings once earlier blocks showed that a column holds
+  // strings. The block data is kept only if a column may have to be converted
+  // again as strings.
+  struct ConvertedBlock {
+    int64_t num_rows;
+    std::vector<InferredType> types;
+    std::vector<std::shared_ptr<Array>> columns;
+    std::shared_ptr<Buffer> data;
+    bool header;
+  };
+
+  // Convert a block given the types merged over the blocks converted so far
+  Status ConvertBlock(const std::shared_ptr<Buffer>& data, const ParsedBlock& block,
+                      bool header, const std::vector<InferredType>& merged_types,
+                      ConvertedBlock* out) {
+    out->num_rows = block.num_rows();
+    out->types.assign(num_columns_, InferredType::NA);
+    out->columns.resize(num_columns_);
+    out->header = header;
+    if (out->num_rows == 0) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(CheckNumColumns(block, num_columns_));
+    for (int i = 0; i < num_columns_; ++i) {
+      std::shared_ptr<DataType> type = column_types_[i];
+      if (type == nullptr) {
+        out->types[i] = merged_types[i] == InferredType::STRING
+                            ? InferredType::STRING
+                            : InferColumnType(block, i);
+        type = GetDataType(out->types[i]);
+        if (out->types[i] != InferredType::NA && out->types[i] != InferredType::STRING) {
+          out->data = data;
+        }
+      }
+      RETURN_NOT_OK(ConvertColumn(block, i, type, pool_, &out->columns[i]));
+    }
+    return Status::OK();
+  }
+
+  void MergeBlockTypes(const ConvertedBlock& converted,
+                       std::vector<InferredType>* merged_types) {
+    for (int i = 0; i < num_columns_; ++i) {
+      (*merged_types)[i] = MergeTypes((*merged_types)[i], converted.types[i]);
+    }
+  }
+
+  // Read, parse and convert the rest of the input, and merge the types of the
+  // blocks into merged_types. The threads take turns to read the next block
+  // and then convert it, so that reading overlaps parsing. Each parsed block
+  // is freed once it is converted.
+  Status ConvertBlocks(std::vector<InferredType>* merged_types) {
+    std::mutex mutex;
+    Status status;
+    bool done = false;
+
+    auto convert_blocks = [&]() {
+      while (true) {
+        std::shared_ptr<Buffer> data;
+        ConvertedBlock* converted;
+        std::vector<InferredType> block_merged_types;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (done) {
+            return;
+          }
+          Status s = block_reader_.ReadNext(&data);
+          if (!s.ok() || data == nullptr) {
+            status = s;
+            done = true;
+            return;
+          }
+          blocks_.emplace_back(new ConvertedBlock());
+          converted = blocks_.back().get();
+          block_merged_types = *merged_types;
+        }
+        ParsedBlock block;
+        Status s = block.Parse(options_, data);
+        if (s.ok()) {
+          s = ConvertBlock(data, block, false, block_merged_types, converted);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!s.ok()) {
+          if (status.ok()) {
+            status = s;
+          }
+          done = true;
+          return;
+        }
+        MergeBlockTypes(*converted, merged_types);
+      }
+    };
+
+    if (options_.num_threads == 1) {
+      convert_blocks();
+    } else {
+      std::vector<std::thread> threads;
+      for (int i = 0; i < options_.num_threads; ++i) {
+        threads.emplace_back(convert_blocks);
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+    return status;
+  }
+
+  // Bring the columns of a block to the merged types. Integers widen to
+  // doubles and columns without values become columns of nulls or empty
+  // strings, but other columns read as strings are parsed again.
+  Status PromoteBlock(const std::vector<InferredType>& merged_types,
+                      ConvertedBlock* converted) {
+    std::unique_ptr<ParsedBlock> block;
+    for (int i = 0; i < num_columns_ && converted->num_rows > 0; ++i) {
+      const InferredType type = converted->types[i];
+      const InferredType merged_type = merged_types[i];
+      if (type == merged_type) {
+        continue;
+      }
+      std::shared_ptr<Array>* column = &converted->columns[i];
+      if (type == InferredType::NA) {
+        RETURN_NOT_OK(
+            MakeEmptyValues(column_types_[i], converted->num_rows, pool_, column));
+      } else if (type == InferredType::INT64 && merged_type == InferredType::DOUBLE) {
+        RETURN_NOT_OK(CastToDouble(**column, pool_, column));
+      } else {
+        if (block == nullptr) {
+          block.reset(new ParsedBlock());
+          RETURN_NOT_OK(block->Parse(options_, converted->data));
+          if (converted->header) {
+            block->DropFirstRow();
+          }
+        }
+        RETURN_NOT_OK(ConvertColumn(*block, i, column_types_[i], pool_, column));
+      }
+    }
+    converted->data.reset();
+    return Status::OK();
+  }
+
+  MemoryPool* pool_;
+  ReadOptions options_;
+  BlockReader block_reader_;
+  int num_columns_;
+  // The types of the columns, explicit or once inferred
+  std::vector<std::shared_ptr<DataType>> column_types_;
+  std::vector<std::unique_ptr<ConvertedBlock>> blocks_;
+};
+
+TableReader::TableReader() {}
+
+TableReader::~TableReader() {}
+
+Status TableReader::Open(const std::shared_ptr<io::InputStream>& input,
+                         MemoryPool* pool, const ReadOptions& options,
+                         std::unique_ptr<TableReader>* out) {
+  RETURN_NOT_OK(ValidateOptions(options));
+  std::unique_ptr<TableReader> result(new TableReader());
+  result->impl_.reset(new Impl(input, pool, options));
+  *out = std::move(result);
+  return Status::OK();
+}
+
+Status TableReader::Read(std::shared_ptr<Table>* out) { return impl_->Read(out); }
+
+// ----------------------------------------------------------------------
+// StreamingReader implementation
+
+class StreamingReader::Impl {
+ public:
+  Impl(const std::shared_ptr<io::InputStream>& input, MemoryPool* pool,
+       const ReadOptions& options)
+      : pool_(pool),
+        options_(options),
+        block_reader_(input, pool, options_),
+        eof_(false) {}
+
+  // Infer the schema from the first block with rows after the header.
+  // Columns with only empty values there are read as strings, so that later
+  // values are not lost.
+  Status Init() {
+    std::unique_ptr<ParsedBlock> block;
+    std::vector<std::string> names;
+    int num_columns = -1;
+    while (true) {
+      std::shared_ptr<Buffer> data;
+      RETURN_NOT_OK(block_reader_.ReadNext(&data));
+      if (data == nullptr) {
+        eof_ = true;
+        block.reset();
+        break;
+      }
+      block.reset(new ParsedBlock());
+      RETURN_NOT_OK(block->Parse(options_, data));
+      if (block->num_rows() == 0) {
+        continue;
+      }
+      if (num_columns < 0) {
+        num_columns = block->num_columns();
+        RETURN_NOT_OK(ReadColumnNames(options_, block.get(), &names));
+      } else {
+        RETURN_NOT_OK(CheckNumColumns(*block, num_columns));
+      }
+      if (block->num_rows() > 0) {
+        break;
+      }
+    }
+
+    std::vector<std::shared_ptr<Field>> fields;
+    for (int i = 0; i < num_columns; ++i) {
+      std::shared_ptr<DataType> type;
+      auto it = options_.column_types.find(names[i]);
+      if (it != options_.column_types.end()) {
+        type = it->second;
+      } else {
+        InferredType inferred =
+            block == nullptr ? InferredType::NA : InferColumnType(*block, i);
+        if (inferred == InferredType::NA) {
+          inferred = InferredType::STRING;
+        }
+        type = GetDataType(inferred);
+      }
+      fields.push_back(field(names[i], type));
+    }
+    schema_ = std::make_shared<Schema>(fields);
+    first_block_ = std::move(block);
+    return Status::OK();
+  }
+
+  std::shared_ptr<Schema> schema() const { return schema_; }
+
+  Status ReadNext(std::shared_ptr<RecordBatch>* batch) {
+    while (batches_.empty() && (!eof_ || first_block_ != nullptr)) {
+      RETURN_NOT_OK(ReadBatches());
+    }
+    if (batches_.empty()) {
+      *batch = nullptr;
+      return Status::OK();
+    }
+    *batch = batches_.front();
+    batches_.pop_front();
+    return Status::OK();
+  }
+
+ private:
+  // Read up to num_threads blocks, and parse and convert them in parallel
+  Status ReadBatches() {
+    std::vector<std::unique_ptr<ParsedBlock>> blocks;
+    std::vector<std::shared_ptr<Buffer>> data;
+    if (first_block_ != nullptr) {
+      blocks.push_back(std::move(first_block_));
+      data.emplace_back();
+    }
+    while (!eof_ && static_cast<int>(data.size()) < options_.num_threads) {
+      std::shared_ptr<Buffer> block_data;
+      RETURN_NOT_OK(block_reader_.ReadNext(&block_data));
+      if (block_data == nullptr) {
+        eof_ = true;
+        break;
+      }
+      blocks.emplace_back(new ParsedBlock());
+      data.push_back(block_data);
+    }
+
+    const int num_blocks = static_cast<int>(blocks.size());
+    std::vector<std::shared_ptr<RecordBatch>> batches(num_blocks);
+    RETURN_NOT_OK(ParallelFor(std::max(1, num_blocks), num_blocks, [&](int i) {
+      if (data[i] != nullptr) {
+        RETURN_NOT_OK(blocks[i]->Parse(options_, data[i]));
+      }
+      if (blocks[i]->num_rows() == 0) {
+        return Status::OK();
+      }
+      RETURN_NOT_OK(CheckNumColumns(*blocks[i], schema_->num_fields()));
+      std::vector<std::shared_ptr<Array>> columns;
+      RETURN_NOT_OK(ConvertBlock(*blocks[i], schema_, pool_, &columns));
+      batches[i] = RecordBatch::Make(schema_, blocks[i]->num_rows(), std::move(columns));
+      return Status::OK();
+    }));
+    for (auto& batch : batches) {
+      if (batch != nullptr) {
+        batches_.push_back(batch);
+      }
+    }
+    return Status::OK();
+  }
+
+  MemoryPool* pool_;
+  ReadOptions options_;
+  BlockReader block_reader_;
+  bool eof_;
+  std::shared_ptr<Schema> schema_;
+  std::unique_ptr<ParsedBlock> first_block_;
+  std::deque<std::shared_ptr<RecordBatch>> batches_;
+};
+
+StreamingReader::StreamingReader() {}
+
+StreamingReader::~StreamingReader() {}
+
+Status StreamingReader::Open(const std::shared_ptr<io::InputStream>& input,
+                             MemoryPool* pool, const ReadOptions& options,
+                             std::shared_ptr<StreamingReader>* out) {
+  RETURN_NOT_OK(ValidateOptions(options));
+  std::shared_ptr<StreamingReader> result(new StreamingReader());
+  result->impl_.reset(new Impl(input, pool, options));
+  RETURN_NOT_OK(result->impl_->Init());
+  *out = result;
+  return Status::OK();
+}
+
+std::shared_ptr<Schema> StreamingReader::schema() const { return impl_->schema(); }
+
+Status StreamingReader::ReadNext(std::shared_ptr<RecordBatch>* batch) {
+  return impl_->ReadNext(batch);
+}
+
+}  // namespace csv
+}  // namespace arrow
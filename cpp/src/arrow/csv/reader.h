@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Read CSV files as Arrow tables and record batches
+
+#ifndef ARROW_CSV_READER_H
+#define ARROW_CSV_READER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "arrow/record_batch.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class DataType;
+class MemoryPool;
+class Schema;
+class Status;
+class Table;
+
+namespace io {
+
+class InputStream;
+
+}  // namespace io
+
+namespace csv {
+
+/// \class ReadOptions
+/// \brief Options for parsing and converting CSV data
+struct ARROW_EXPORT ReadOptions {
+  ReadOptions();
+
+  /// The character between the fields of a row
+  char delimiter;
+  /// Whether fields can be quoted. A quote in a quoted field is written twice.
+  bool quoting;
+  /// The character around quoted fields
+  char quote_char;
+  /// Whether the first row has the column names. Otherwise the columns are
+  /// named f0, f1 and so on.
+  bool header;
+  /// The number of bytes of the input that are parsed at once. Each block of
+  /// a Table is a chunk of its columns.
+  int64_t block_size;
+  /// The number of threads that parse and convert blocks
+  int num_threads;
+  /// The types of some of the columns, by name. The types of the other
+  /// columns are inferred.
+  std::unordered_map<std::string, std::shared_ptr<DataType>> column_types;
+};
+
+/// \class TableReader
+/// \brief Read a CSV stream as a Table
+///
+/// The input is split into blocks at row boundaries, and the blocks are
+/// parsed and converted in parallel. A block is converted as soon as it is
+/// parsed. It is parsed again only for columns that have numbers or booleans
+/// in the block but turn out to hold strings.
+///
+/// The type of a column is inferred from all of its values, as null if they
+/// are all empty, then boolean (true or false), int64, double or else
+/// string. Empty fields are null, except in string columns. Numbers are
+/// converted the same way whatever the locale.
+class ARROW_EXPORT TableReader {
+ public:
+  ~TableReader();
+
+  /// \brief Create a new CSV reader
+  ///
+  /// \param[in] input the CSV data, read from its current position
+  /// \param[in] pool the memory pool for the converted data
+  /// \param[in] options the read options
+  /// \param[out] out the returned reader object
+  /// \return Status
+  static Status Open(const std::shared_ptr<io::InputStream>& input, MemoryPool* pool,
+                     const ReadOptions& options, std::unique_ptr<TableReader>* out);
+
+  /// \brief Read the rest of the input as a Table
+  ///
+  /// \param[out] out the returned table
+  /// \return Status
+  Status Read(std::shared_ptr<Table>* out);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+  TableReader();
+};
+
+/// \class StreamingReader
+/// \brief Read a CSV stream as record batches, a block at a time
+///
+/// The schema is inferred from the first block, and the following blocks
+/// must have values of the same types. Up to num_threads blocks are read
+/// ahead and converted in parallel.
+class ARROW_EXPORT StreamingReader : public RecordBatchReader {
+ public:
+  ~StreamingReader() override;
+
+  /// \brief Create a new streaming CSV reader
+  ///
+  /// This reads the first block of the input to infer the schema.
+  ///
+  /// \param[in] input the CSV data, read from its current position
+  /// \param[in] pool the memory pool for the converted data
+  /// \param[in] options the read options
+  /// \param[out] out the returned reader object
+  /// \return Status
+  static Status Open(const std::shared_ptr<io::InputStream>& input, MemoryPool* pool,
+                     const ReadOptions& options, std::shared_ptr<StreamingReader>* out);
+
+  std::shared_ptr<Schema> schema() const override;
+
+  Status ReadNext(std::shared_ptr<RecordBatch>* batch) override;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+  StreamingReader();
+};
+
+}  // namespace csv
+}  // namespace arrow
+
+#endif  // ARROW_CSV_READER_H
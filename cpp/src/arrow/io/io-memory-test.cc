@@ -20,6 +20,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -129,6 +130,31 @@ TEST(TestBufferReader, RetainParentReference) {
   ASSERT_EQ(0, std::memcmp(slice2->data(), data.c_str() + 4, 6));
 }
 
+TEST(TestBufferReader, ReadPastEnd) {
+  std::string data = "data123456";
+  std::string padding(64, 'x');
+
+  // The reader sees a slice, so bytes after its end are valid memory
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(Buffer::FromString(data + padding, &buffer));
+  BufferReader reader(SliceBuffer(buffer, 0, static_cast<int64_t>(data.size())));
+
+  std::vector<char> out(32, '\0');
+  int64_t bytes_read;
+  ASSERT_OK(reader.Read(4, &bytes_read, out.data()));
+  ASSERT_EQ(4, bytes_read);
+  ASSERT_OK(reader.Read(32, &bytes_read, out.data()));
+  ASSERT_EQ(6, bytes_read);
+  ASSERT_EQ(0, std::memcmp(out.data(), data.c_str() + 4, 6));
+  // Only the bytes read are written
+  for (size_t i = 6; i < out.size(); ++i) {
+    ASSERT_EQ('\0', out[i]) << i;
+  }
+
+  ASSERT_OK(reader.Read(32, &bytes_read, out.data()));
+  ASSERT_EQ(0, bytes_read);
+}
+
 TEST(TestMemcopy, ParallelMemcopy) {
   for (int i = 0; i < 5; ++i) {
     // randomize size so the memcopy alignment is tested
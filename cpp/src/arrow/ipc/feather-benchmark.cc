@@ -0,0 +1,183 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/feather.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+
+constexpr int kNumColumns = 1000;
+constexpr int64_t kNumRows = 10000;
+
+// A wide Feather file of double columns with some nulls
+static std::shared_ptr<Buffer> MakeWideFile() {
+  std::vector<bool> is_valid;
+  std::vector<double> values;
+  test::random_is_valid(kNumRows, 0.1, &is_valid);
+  test::random_real<double>(kNumRows, 0, 0.0, 1.0, &values);
+  std::shared_ptr<Array> array;
+  ArrayFromVector<DoubleType, double>(is_valid, values, &array);
+
+  std::shared_ptr<io::BufferOutputStream> stream;
+  ABORT_NOT_OK(io::BufferOutputStream::Create(1 << 20, default_memory_pool(), &stream));
+  std::unique_ptr<ipc::feather::TableWriter> writer;
+  ABORT_NOT_OK(ipc::feather::TableWriter::Open(stream, &writer));
+  for (int i = 0; i < kNumColumns; ++i) {
+    ABORT_NOT_OK(writer->Append("f" + std::to_string(i), *array));
+  }
+  ABORT_NOT_OK(writer->Finalize());
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(stream->Finish(&buffer));
+  return buffer;
+}
+
+static std::shared_ptr<Buffer> GetWideFile() {
+  static std::shared_ptr<Buffer> file = MakeWideFile();
+  return file;
+}
+
+// Read the columns one at a time, as a baseline for BM_ReadTable
+static void BM_GetColumns(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetWideFile();
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<ipc::feather::TableReader> reader;
+    ABORT_NOT_OK(ipc::feather::TableReader::Open(source, &reader));
+    std::shared_ptr<Column> column;
+    for (int i = 0; i < reader->num_columns(); ++i) {
+      ABORT_NOT_OK(reader->GetColumn(i, &column));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumColumns);
+  state.SetBytesProcessed(state.iterations() * file->size());
+}
+
+static void BM_ReadTable(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetWideFile();
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<ipc::feather::TableReader> reader;
+    ABORT_NOT_OK(ipc::feather::TableReader::Open(source, &reader));
+    reader->set_num_threads(static_cast<int>(state.range(0)));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read(&table));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumColumns);
+  state.SetBytesProcessed(state.iterations() * file->size());
+}
+
+// Read every tenth column by name
+static void BM_ReadProjection(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file = GetWideFile();
+  std::vector<std::string> names;
+  for (int i = 0; i < kNumColumns; i += 10) {
+    names.push_back("f" + std::to_string(i));
+  }
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<ipc::feather::TableReader> reader;
+    ABORT_NOT_OK(ipc::feather::TableReader::Open(source, &reader));
+    reader->set_num_threads(static_cast<int>(state.range(0)));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read(names, &table));
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+// A Feather file of 100 record batches with 10 double columns, written in
+// chunks with the given compression
+static std::shared_ptr<Buffer> MakeChunkedFile(Compression::type compression) {
+  constexpr int kNumBatches = 100;
+  std::vector<bool> is_valid;
+  std::vector<double> values;
+  test::random_is_valid(kNumRows, 0.1, &is_valid);
+  // Few distinct values, so that the data compresses
+  test::random_real<double>(kNumRows, 0, 0.0, 100.0, &values);
+  for (double& value : values) {
+    value = static_cast<double>(static_cast<int>(value));
+  }
+  std::shared_ptr<Array> array;
+  ArrayFromVector<DoubleType, double>(is_valid, values, &array);
+
+  std::vector<std::shared_ptr<Field>> fields;
+  for (int i = 0; i < 10; ++i) {
+    fields.push_back(field("f" + std::to_string(i), float64()));
+  }
+  auto batch = RecordBatch::Make(::arrow::schema(fields), kNumRows,
+                                 std::vector<std::shared_ptr<Array>>(10, array));
+
+  std::shared_ptr<io::BufferOutputStream> stream;
+  ABORT_NOT_OK(io::BufferOutputStream::Create(1 << 20, default_memory_pool(), &stream));
+  std::unique_ptr<ipc::feather::TableWriter> writer;
+  ABORT_NOT_OK(ipc::feather::TableWriter::Open(stream, &writer));
+  ABORT_NOT_OK(writer->SetCompression(compression));
+  for (int i = 0; i < kNumBatches; ++i) {
+    ABORT_NOT_OK(writer->Append(*batch));
+  }
+  ABORT_NOT_OK(writer->Finalize());
+  std::shared_ptr<Buffer> buffer;
+  ABORT_NOT_OK(stream->Finish(&buffer));
+  return buffer;
+}
+
+// The first argument is the compression, the second the number of threads
+static void BM_ReadChunked(benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<Buffer> file =
+      MakeChunkedFile(static_cast<Compression::type>(state.range(0)));
+  int64_t num_rows = 0;
+  while (state.KeepRunning()) {
+    auto source = std::make_shared<io::BufferReader>(file);
+    std::unique_ptr<ipc::feather::TableReader> reader;
+    ABORT_NOT_OK(ipc::feather::TableReader::Open(source, &reader));
+    reader->set_num_threads(static_cast<int>(state.range(1)));
+    std::shared_ptr<Table> table;
+    ABORT_NOT_OK(reader->Read(&table));
+    num_rows = table->num_rows();
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+  state.SetBytesProcessed(state.iterations() * file->size());
+}
+
+BENCHMARK(BM_GetColumns)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadTable)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadProjection)->Arg(1)->Arg(4)->MinTime(1.0)->UseRealTime();
+
+BENCHMARK(BM_ReadChunked)
+    ->Args({Compression::UNCOMPRESSED, 1})
+#ifdef ARROW_WITH_LZ4
+    ->Args({Compression::LZ4, 1})
+    ->Args({Compression::LZ4, 4})
+#endif
+#ifdef ARROW_WITH_ZSTD
+    ->Args({Compression::ZSTD, 1})
+    ->Args({Compression::ZSTD, 4})
+#endif
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+}  // namespace arrow
@@ -47,7 +47,8 @@ struct ARROW_EXPORT ColumnType {
 };
 
 struct ARROW_EXPORT ArrayMetadata {
-  ArrayMetadata() {}
+  ArrayMetadata()
+      : compression(fbs::CompressionType_UNCOMPRESSED), uncompressed_bytes(0) {}
 
   ArrayMetadata(fbs::Type type, int64_t offset, int64_t length, int64_t null_count,
                 int64_t total_bytes)
@@ -55,12 +56,16 @@ struct ARROW_EXPORT ArrayMetadata {
         offset(offset),
         length(length),
         null_count(null_count),
-        total_bytes(total_bytes) {}
+        total_bytes(total_bytes),
+        compression(fbs::CompressionType_UNCOMPRESSED),
+        uncompressed_bytes(0) {}
 
   bool Equals(const ArrayMetadata& other) const {
     return this->type == other.type && this->offset == other.offset &&
            this->length == other.length && this->null_count == other.null_count &&
-           this->total_bytes == other.total_bytes;
+           this->total_bytes == other.total_bytes &&
+           this->compression == other.compression &&
+           this->uncompressed_bytes == other.uncompressed_bytes;
   }
 
   fbs::Type type;
@@ -68,6 +73,10 @@ struct ARROW_EXPORT ArrayMetadata {
   int64_t length;
   int64_t null_count;
   int64_t total_bytes;
+
+  // If the data is compressed, total_bytes is its compressed size
+  fbs::CompressionType compression;
+  int64_t uncompressed_bytes;
 };
 
 struct ARROW_EXPORT CategoryMetadata {
@@ -104,6 +113,7 @@ class ARROW_EXPORT TableBuilder {
   std::unique_ptr<ColumnBuilder> AddColumn(const std::string& name);
   void SetDescription(const std::string& description);
   void SetNumRows(int64_t num_rows);
+  void SetVersion(int version);
   void add_column(const flatbuffers::Offset<fbs::Column>& col);
 
  private:
@@ -115,6 +125,7 @@ class ARROW_EXPORT TableBuilder {
   bool finished_;
   std::string description_;
   int64_t num_rows_;
+  int version_;
 };
 
 class ARROW_EXPORT TableMetadata {
@@ -156,7 +167,8 @@ class ARROW_EXPORT TableMetadata {
 static inline flatbuffers::Offset<fbs::PrimitiveArray> GetPrimitiveArray(
     FBB& fbb, const ArrayMetadata& array) {
   return fbs::CreatePrimitiveArray(fbb, array.type, fbs::Encoding_PLAIN, array.offset,
-                                   array.length, array.null_count, array.total_bytes);
+                                   array.length, array.null_count, array.total_bytes,
+                                   array.compression, array.uncompressed_bytes);
 }
 
 static inline fbs::TimeUnit ToFlatbufferEnum(TimeUnit::type unit) {
@@ -187,6 +199,8 @@ static inline void FromFlatbuffer(const fbs::PrimitiveArray* values, ArrayMetada
   out->length = values->length();
   out->null_count = values->null_count();
   out->total_bytes = values->total_bytes();
+  out->compression = values->compression();
+  out->uncompressed_bytes = values->uncompressed_bytes();
 }
 
 class ARROW_EXPORT ColumnBuilder {
@@ -198,6 +212,7 @@ class ARROW_EXPORT ColumnBuilder {
 
   Status Finish();
   void SetValues(const ArrayMetadata& values);
+  void AddChunk(const ArrayMetadata& chunk);
   void SetUserMetadata(const std::string& data);
   void SetCategory(const ArrayMetadata& levels, bool ordered = false);
   void SetTimestamp(TimeUnit::type unit);
@@ -211,6 +226,7 @@ class ARROW_EXPORT ColumnBuilder {
 
   std::string name_;
   ArrayMetadata values_;
+  std::vector<ArrayMetadata> chunks_;
   std::string user_metadata_;
 
   // Column metadata
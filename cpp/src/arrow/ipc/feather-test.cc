@@ -16,6 +16,7 @@
 // under the License.
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <random>
 #include <sstream>
@@ -141,6 +142,30 @@ TEST_F(TestTableBuilder, AddPrimitiveColumn) {
   AssertArrayEquals(values4, values2);
 }
 
+TEST_F(TestTableBuilder, AddChunkedColumn) {
+  std::unique_ptr<ColumnBuilder> cb = tb_->AddColumn("f0");
+  ArrayMetadata chunk1(fbs::Type_INT32, 10000, 1000, 100, 4000);
+  ArrayMetadata chunk2(fbs::Type_INT32, 14000, 500, 0, 2000);
+  cb->AddChunk(chunk1);
+  cb->AddChunk(chunk2);
+  ASSERT_OK(cb->Finish());
+  Finish();
+
+  auto col = table_->column(0);
+  ASSERT_EQ(2, static_cast<int>(col->chunks()->size()));
+  ArrayMetadata chunk;
+  FromFlatbuffer(col->chunks()->Get(0), &chunk);
+  AssertArrayEquals(chunk, chunk1);
+  FromFlatbuffer(col->chunks()->Get(1), &chunk);
+  AssertArrayEquals(chunk, chunk2);
+
+  // Readers of version 2 find empty values of the same type
+  ASSERT_NE(nullptr, col->values());
+  ArrayMetadata values;
+  FromFlatbuffer(col->values(), &values);
+  AssertArrayEquals(values, ArrayMetadata(fbs::Type_INT32, 0, 0, 0, 0));
+}
+
 TEST_F(TestTableBuilder, AddCategoryColumn) {
   ArrayMetadata values1(fbs::Type_UINT8, 10000, 1000, 100, 4000);
   ArrayMetadata levels(fbs::Type_UTF8, 14000, 10, 0, 300);
@@ -289,6 +314,30 @@ class TestTableWriter : public ::testing::Test {
     }
   }
 
+  void CheckChunkedBatches(const std::vector<std::shared_ptr<RecordBatch>>& batches) {
+    int64_t num_rows = 0;
+    for (const auto& batch : batches) {
+      ASSERT_OK(writer_->Append(*batch));
+      num_rows += batch->num_rows();
+    }
+    Finish();
+    ASSERT_EQ(kFeatherChunkedVersion, reader_->version());
+    ASSERT_EQ(num_rows, reader_->num_rows());
+
+    reader_->set_num_threads(4);
+    std::shared_ptr<Table> table;
+    ASSERT_OK(reader_->Read(&table));
+    ASSERT_EQ(num_rows, table->num_rows());
+    for (int i = 0; i < table->num_columns(); ++i) {
+      const ChunkedArray& chunks = *table->column(i)->data();
+      ASSERT_EQ(batches[0]->column_name(i), table->column(i)->name());
+      ASSERT_EQ(static_cast<int>(batches.size()), chunks.num_chunks());
+      for (size_t chunk = 0; chunk < batches.size(); ++chunk) {
+        CheckArrays(*batches[chunk]->column(i), *chunks.chunk(static_cast<int>(chunk)));
+      }
+    }
+  }
+
  protected:
   std::shared_ptr<io::BufferOutputStream> stream_;
   std::unique_ptr<TableWriter> writer_;
@@ -297,6 +346,70 @@ class TestTableWriter : public ::testing::Test {
   std::shared_ptr<Buffer> output_;
 };
 
+// Lay out a Feather file with the given array data, which starts at offset 4
+// after the magic bytes, followed by the metadata of the builder
+static void MakeFile(const std::string& data, TableBuilder* builder,
+                     std::shared_ptr<Buffer>* out) {
+  ASSERT_OK(builder->Finish());
+  std::shared_ptr<Buffer> metadata = builder->GetBuffer();
+  const uint32_t metadata_length = static_cast<uint32_t>(metadata->size());
+
+  const int64_t magic_size = static_cast<int64_t>(strlen(kFeatherMagicBytes));
+
+  std::shared_ptr<io::BufferOutputStream> stream;
+  ASSERT_OK(io::BufferOutputStream::Create(1024, default_memory_pool(), &stream));
+  ASSERT_OK(stream->Write(kFeatherMagicBytes, magic_size));
+  ASSERT_OK(stream->Write(data.data(), static_cast<int64_t>(data.size())));
+  ASSERT_OK(stream->Write(metadata->data(), metadata->size()));
+  ASSERT_OK(stream->Write(&metadata_length, sizeof(uint32_t)));
+  ASSERT_OK(stream->Write(kFeatherMagicBytes, magic_size));
+  ASSERT_OK(stream->Finish(out));
+}
+
+TEST(TestTableReader, NewerVersion) {
+  // A file with only metadata, of a version this reader does not know
+  TableBuilder builder(0);
+  builder.SetVersion(kFeatherChunkedVersion + 1);
+  std::shared_ptr<Buffer> file;
+  MakeFile("", &builder, &file);
+
+  std::unique_ptr<TableReader> reader;
+  ASSERT_RAISES(NotImplemented,
+                TableReader::Open(std::make_shared<io::BufferReader>(file), &reader));
+}
+
+TEST(TestTableReader, ArraySizes) {
+  // Read a column of 100 rows from 400 bytes of data
+  auto read = [](const ArrayMetadata& values) {
+    TableBuilder builder(100);
+    std::unique_ptr<ColumnBuilder> column = builder.AddColumn("f0");
+    column->SetValues(values);
+    EXPECT_OK(column->Finish());
+    std::shared_ptr<Buffer> file;
+    MakeFile(std::string(400, '\0'), &builder, &file);
+
+    std::unique_ptr<TableReader> reader;
+    EXPECT_OK(TableReader::Open(std::make_shared<io::BufferReader>(file), &reader));
+    std::shared_ptr<Table> table;
+    return reader->Read(&table);
+  };
+  ASSERT_OK(read(ArrayMetadata(fbs::Type_INT32, 4, 100, 0, 400)));
+  ASSERT_OK(read(ArrayMetadata(fbs::Type_BOOL, 4, 100, 10, 400)));
+
+  // The data is too short for the null bitmap, the values or the offsets
+  ASSERT_RAISES(Invalid, read(ArrayMetadata(fbs::Type_INT32, 4, 100, 10, 400)));
+  ASSERT_RAISES(Invalid, read(ArrayMetadata(fbs::Type_INT32, 4, 100, 0, 396)));
+  ASSERT_RAISES(Invalid, read(ArrayMetadata(fbs::Type_UTF8, 4, 100, 0, 400)));
+  ASSERT_RAISES(Invalid, read(ArrayMetadata(fbs::Type_INT64, 4, 1LL << 60, 0, 400)));
+  ASSERT_RAISES(Invalid, read(ArrayMetadata(fbs::Type_INT32, 4, -1, 0, 400)));
+
+  // A negative uncompressed size is rejected before decompressing
+  ArrayMetadata compressed(fbs::Type_INT32, 4, 100, 0, 400);
+  compressed.compression = fbs::CompressionType_ZSTD;
+  compressed.uncompressed_bytes = -1;
+  ASSERT_RAISES(Invalid, read(compressed));
+}
+
 TEST_F(TestTableWriter, EmptyTable) {
   Finish();
 
@@ -343,6 +456,104 @@ TEST_F(TestTableWriter, PrimitiveRoundTrip) {
   ASSERT_EQ("f1", col->name());
 }
 
+TEST_F(TestTableWriter, ReadTable) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntRecordBatch(&batch));
+
+  ASSERT_OK(writer_->Append("f0", *batch->column(0)));
+  ASSERT_OK(writer_->Append("f1", *batch->column(1)));
+  Finish();
+  reader_->set_num_threads(2);
+
+  std::shared_ptr<Table> table;
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_EQ(2, table->num_columns());
+  ASSERT_EQ(batch->num_rows(), table->num_rows());
+  ASSERT_EQ("f0", table->column(0)->name());
+  ASSERT_TRUE(table->column(0)->data()->chunk(0)->Equals(batch->column(0)));
+  ASSERT_TRUE(table->column(1)->data()->chunk(0)->Equals(batch->column(1)));
+
+  ASSERT_OK(reader_->Read(std::vector<int>({1}), &table));
+  ASSERT_EQ(1, table->num_columns());
+  ASSERT_EQ("f1", table->column(0)->name());
+  ASSERT_TRUE(table->column(0)->data()->chunk(0)->Equals(batch->column(1)));
+
+  ASSERT_OK(reader_->Read(std::vector<std::string>({"f1", "f0"}), &table));
+  ASSERT_EQ("f1", table->column(0)->name());
+  ASSERT_EQ("f0", table->column(1)->name());
+  ASSERT_TRUE(table->column(1)->data()->chunk(0)->Equals(batch->column(0)));
+
+  ASSERT_RAISES(Invalid, reader_->Read(std::vector<int>({2}), &table));
+  ASSERT_RAISES(Invalid, reader_->Read(std::vector<std::string>({"f2"}), &table));
+
+  // No threads means reading on the calling thread
+  reader_->set_num_threads(0);
+  ASSERT_OK(reader_->Read(&table));
+  ASSERT_EQ(2, table->num_columns());
+  ASSERT_TRUE(table->column(1)->data()->chunk(0)->Equals(batch->column(1)));
+}
+
+TEST_F(TestTableWriter, ChunkedRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntBatchSized(100, &batch));
+  // Sliced batches are written from their offset
+  CheckChunkedBatches({batch, batch->Slice(3, 50), batch->Slice(16)});
+}
+
+TEST_F(TestTableWriter, ChunkedVLenRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeStringTypesRecordBatch(&batch));
+  CheckChunkedBatches({batch->Slice(0, 3), batch->Slice(3)});
+}
+
+TEST_F(TestTableWriter, ChunkedCategoryRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeDictionaryFlat(&batch));
+  CheckChunkedBatches({batch, batch});
+}
+
+TEST_F(TestTableWriter, ChunkedSchemaMismatch) {
+  std::shared_ptr<RecordBatch> int_batch;
+  std::shared_ptr<RecordBatch> string_batch;
+  ASSERT_OK(MakeIntRecordBatch(&int_batch));
+  ASSERT_OK(MakeStringTypesRecordBatch(&string_batch));
+
+  ASSERT_OK(writer_->Append(*int_batch));
+  ASSERT_RAISES(Invalid, writer_->Append(*string_batch));
+  ASSERT_RAISES(Invalid, writer_->Append("f0", *int_batch->column(0)));
+}
+
+TEST_F(TestTableWriter, UnsupportedCompression) {
+  ASSERT_RAISES(NotImplemented, writer_->SetCompression(Compression::SNAPPY));
+}
+
+#ifdef ARROW_WITH_LZ4
+TEST_F(TestTableWriter, LZ4RoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeStringTypesRecordBatch(&batch));
+  ASSERT_OK(writer_->SetCompression(Compression::LZ4));
+  CheckChunkedBatches({batch, batch->Slice(1)});
+}
+#endif
+
+#ifdef ARROW_WITH_ZSTD
+TEST_F(TestTableWriter, ZSTDRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntBatchSized(1000, &batch));
+  ASSERT_OK(writer_->SetCompression(Compression::ZSTD));
+  CheckChunkedBatches({batch, batch->Slice(5, 500)});
+}
+
+TEST_F(TestTableWriter, ZSTDColumnRoundTrip) {
+  // Columns that are not chunked can also be compressed
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeIntRecordBatch(&batch));
+  ASSERT_OK(writer_->SetCompression(Compression::ZSTD));
+  CheckBatch(*batch);
+  ASSERT_EQ(kFeatherChunkedVersion, reader_->version());
+}
+#endif
+
 TEST_F(TestTableWriter, CategoryRoundtrip) {
   std::shared_ptr<RecordBatch> batch;
   ASSERT_OK(MakeDictionaryFlat(&batch));
@@ -17,11 +17,13 @@
 
 #include "arrow/ipc/feather.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <sstream>  // IWYU pragma: keep
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,15 +32,18 @@
 #include "arrow/array.h"
 #include "arrow/buffer.h"
 #include "arrow/io/interfaces.h"
+#include "arrow/io/memory.h"
 #include "arrow/ipc/feather-internal.h"
 #include "arrow/ipc/feather_generated.h"
 #include "arrow/ipc/util.h"  // IWYU pragma: keep
+#include "arrow/memory_pool.h"
 #include "arrow/record_batch.h"
 #include "arrow/status.h"
 #include "arrow/table.h"
 #include "arrow/type.h"
 #include "arrow/util/bit-util.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/parallel.h"
 #include "arrow/visitor.h"
 
 namespace arrow {
@@ -47,6 +52,9 @@ namespace feather {
 
 static const uint8_t kPaddingBytes[kFeatherDefaultAlignment] = {0};
 
+// The initial size of the buffer in which an array is laid out to be compressed
+static constexpr int64_t kCompressionBufferSize = 1 << 16;
+
 static inline int64_t PaddedLength(int64_t nbytes) {
   static const int64_t alignment = kFeatherDefaultAlignment;
   return ((nbytes + alignment - 1) / alignment) * alignment;
@@ -92,10 +100,47 @@ static Status WritePaddedBlank(io::OutputStream* stream, int64_t length,
   return Status::OK();
 }
 
+static Status FromFlatbufferEnum(fbs::CompressionType compression,
+                                 Compression::type* out) {
+  switch (compression) {
+    case fbs::CompressionType_UNCOMPRESSED:
+      *out = Compression::UNCOMPRESSED;
+      break;
+    case fbs::CompressionType_LZ4:
+      *out = Compression::LZ4;
+      break;
+    case fbs::CompressionType_ZSTD:
+      *out = Compression::ZSTD;
+      break;
+    default:
+      return Status::Invalid("Unrecognized compression");
+  }
+  return Status::OK();
+}
+
+static Status ToFlatbufferEnum(Compression::type compression,
+                               fbs::CompressionType* out) {
+  switch (compression) {
+    case Compression::UNCOMPRESSED:
+      *out = fbs::CompressionType_UNCOMPRESSED;
+      break;
+    case Compression::LZ4:
+      *out = fbs::CompressionType_LZ4;
+      break;
+    case Compression::ZSTD:
+      *out = fbs::CompressionType_ZSTD;
+      break;
+    default:
+      return Status::NotImplemented("Feather only supports LZ4 and ZSTD compression");
+  }
+  return Status::OK();
+}
+
 // ----------------------------------------------------------------------
 // TableBuilder
 
-TableBuilder::TableBuilder(int64_t num_rows) : finished_(false), num_rows_(num_rows) {}
+TableBuilder::TableBuilder(int64_t num_rows)
+    : finished_(false), num_rows_(num_rows), version_(kFeatherVersion) {}
 
 FBB& TableBuilder::fbb() { return fbb_; }
 
@@ -112,7 +157,7 @@ Status TableBuilder::Finish() {
   flatbuffers::Offset<flatbuffers::String> metadata = 0;
 
   auto root = fbs::CreateCTable(fbb_, desc, num_rows_, fbb_.CreateVector(columns_),
-                                kFeatherVersion, metadata);
+                                version_, metadata);
   fbb_.Finish(root);
   finished_ = true;
 
@@ -130,6 +175,8 @@ void TableBuilder::SetDescription(const std::string& description) {
 
 void TableBuilder::SetNumRows(int64_t num_rows) { num_rows_ = num_rows; }
 
+void TableBuilder::SetVersion(int version) { version_ = version; }
+
 void TableBuilder::add_column(const flatbuffers::Offset<fbs::Column>& col) {
   columns_.push_back(col);
 }
@@ -179,13 +226,27 @@ flatbuffers::Offset<void> ColumnBuilder::CreateColumnMetadata() {
 Status ColumnBuilder::Finish() {
   FBB& buf = fbb();
 
-  // values
-  auto values = GetPrimitiveArray(buf, values_);
+  // values, or chunks if the column was written in chunks
+  flatbuffers::Offset<fbs::PrimitiveArray> values = 0;
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<fbs::PrimitiveArray>>>
+      chunks = 0;
+  if (chunks_.empty()) {
+    values = GetPrimitiveArray(buf, values_);
+  } else {
+    std::vector<flatbuffers::Offset<fbs::PrimitiveArray>> chunk_offsets;
+    for (const ArrayMetadata& chunk : chunks_) {
+      chunk_offsets.push_back(GetPrimitiveArray(buf, chunk));
+    }
+    chunks = buf.CreateVector(chunk_offsets);
+    // Readers that predate chunks require values, so give them an empty array
+    ArrayMetadata placeholder(chunks_[0].type, 0, 0, 0, 0);
+    values = GetPrimitiveArray(buf, placeholder);
+  }
   flatbuffers::Offset<void> metadata = CreateColumnMetadata();
 
   auto column = fbs::CreateColumn(buf, buf.CreateString(name_), values,
                                   ToFlatbufferEnum(type_),  // metadata_type
-                                  metadata, buf.CreateString(user_metadata_));
+                                  metadata, buf.CreateString(user_metadata_), chunks);
 
   // bad coupling, but OK for now
   parent_->add_column(column);
@@ -194,6 +255,8 @@ Status ColumnBuilder::Finish() {
 
 void ColumnBuilder::SetValues(const ArrayMetadata& values) { values_ = values; }
 
+void ColumnBuilder::AddChunk(const ArrayMetadata& chunk) { chunks_.push_back(chunk); }
+
 void ColumnBuilder::SetUserMetadata(const std::string& data) { user_metadata_ = data; }
 
 void ColumnBuilder::SetCategory(const ArrayMetadata& levels, bool ordered) {
@@ -230,7 +293,7 @@ std::unique_ptr<ColumnBuilder> TableBuilder::AddColumn(const std::string& name)
 
 class TableReader::TableReaderImpl {
  public:
-  TableReaderImpl() {}
+  TableReaderImpl() : num_threads_(1) {}
 
   Status Open(const std::shared_ptr<io::RandomAccessFile>& source) {
     source_ = source;
@@ -267,7 +330,14 @@ class TableReader::TableReaderImpl {
         source->ReadAt(size - footer_size - metadata_length, metadata_length, &buffer));
 
     metadata_.reset(new TableMetadata());
-    return metadata_->Open(buffer);
+    RETURN_NOT_OK(metadata_->Open(buffer));
+    if (metadata_->version() > kFeatherChunkedVersion) {
+      std::stringstream ss;
+      ss << "Feather file version " << metadata_->version()
+         << " is newer than the supported version " << kFeatherChunkedVersion;
+      return Status::NotImplemented(ss.str());
+    }
+    return Status::OK();
   }
 
   Status GetDataType(const fbs::PrimitiveArray* values, fbs::TypeMetadata metadata_type,
@@ -351,6 +421,10 @@ class TableReader::TableReaderImpl {
     // input source)
     std::shared_ptr<Buffer> buffer;
     RETURN_NOT_OK(source_->ReadAt(meta->offset(), meta->total_bytes(), &buffer));
+    if (meta->compression() != fbs::CompressionType_UNCOMPRESSED) {
+      RETURN_NOT_OK(DecompressValues(meta, &buffer));
+    }
+    RETURN_NOT_OK(CheckValuesSize(meta, *type, buffer->size()));
 
     int64_t offset = 0;
 
@@ -390,22 +464,166 @@ class TableReader::TableReaderImpl {
     return col_meta->name()->str();
   }
 
-  Status GetColumn(int i, std::shared_ptr<Column>* out) {
+  // Check that the data of an array holds the null bitmap, offsets and
+  // fixed-width values that LoadValues slices for the length of the array
+  Status CheckValuesSize(const fbs::PrimitiveArray* meta, const DataType& type,
+                         int64_t size) {
+    const int64_t length = meta->length();
+    if (length < 0 || meta->null_count() < 0) {
+      return Status::Invalid("Negative length or null count of Feather array");
+    }
+    // Every value takes at least a bit, which also keeps the sizes below from
+    // overflowing
+    int64_t expected_size = length / 8;
+    if (expected_size <= size) {
+      expected_size = 0;
+      if (meta->null_count() > 0) {
+        expected_size += GetOutputLength(BitUtil::BytesForBits(length));
+      }
+      if (is_binary_like(type.id())) {
+        expected_size += GetOutputLength((length + 1) * sizeof(int32_t));
+      } else if (type.id() == Type::BOOL) {
+        expected_size += BitUtil::BytesForBits(length);
+      } else {
+        const auto& fw_type = static_cast<const FixedWidthType&>(type);
+        expected_size += length * fw_type.bit_width() / 8;
+      }
+    }
+    if (size < expected_size) {
+      std::stringstream ss;
+      ss << "Feather array of length " << length << " has " << size
+         << " bytes of data, expected at least " << expected_size;
+      return Status::Invalid(ss.str());
+    }
+    return Status::OK();
+  }
+
+  // Replace the compressed data of an array with the decompressed data, which
+  // is laid out as if it had not been compressed
+  Status DecompressValues(const fbs::PrimitiveArray* meta,
+                          std::shared_ptr<Buffer>* buffer) {
+    if (meta->uncompressed_bytes() < 0) {
+      return Status::Invalid("Negative uncompressed size of Feather array");
+    }
+    Compression::type compression;
+    RETURN_NOT_OK(FromFlatbufferEnum(meta->compression(), &compression));
+    std::unique_ptr<Codec> codec;
+    RETURN_NOT_OK(Codec::Create(compression, &codec));
+
+    std::shared_ptr<Buffer> decompressed;
+    RETURN_NOT_OK(
+        AllocateBuffer(default_memory_pool(), meta->uncompressed_bytes(), &decompressed));
+    RETURN_NOT_OK(codec->Decompress((*buffer)->size(), (*buffer)->data(),
+                                    meta->uncompressed_bytes(),
+                                    decompressed->mutable_data()));
+    *buffer = decompressed;
+    return Status::OK();
+  }
+
+  int num_chunks(int i) {
     const fbs::Column* col_meta = metadata_->column(i);
+    return col_meta->chunks() == nullptr ? 1
+                                         : static_cast<int>(col_meta->chunks()->size());
+  }
+
+  // Load a chunk of a column. Columns that are not chunked have one chunk.
+  Status LoadChunk(int i, int chunk, std::shared_ptr<Array>* out) {
+    const fbs::Column* col_meta = metadata_->column(i);
+    const fbs::PrimitiveArray* values = col_meta->chunks() == nullptr
+                                            ? col_meta->values()
+                                            : col_meta->chunks()->Get(chunk);
+    return LoadValues(values, col_meta->metadata_type(), col_meta->metadata(), out);
+  }
+
+  Status MakeColumn(int i, const ArrayVector& chunks, std::shared_ptr<Column>* out) {
+    if (chunks.empty()) {
+      return Status::Invalid("Column has no chunks");
+    }
+    auto column_field = ::arrow::field(GetColumnName(i), chunks[0]->type());
+    out->reset(new Column(column_field, chunks));
+    return Status::OK();
+  }
 
+  Status GetColumn(int i, std::shared_ptr<Column>* out) {
     // auto user_meta = column->user_metadata();
     // if (user_meta->size() > 0) { user_metadata_ = user_meta->str(); }
 
-    std::shared_ptr<Array> values;
-    RETURN_NOT_OK(LoadValues(col_meta->values(), col_meta->metadata_type(),
-                             col_meta->metadata(), &values));
-    out->reset(new Column(col_meta->name()->str(), values));
+    ArrayVector chunks(num_chunks(i));
+    for (int chunk = 0; chunk < num_chunks(i); ++chunk) {
+      RETURN_NOT_OK(LoadChunk(i, chunk, &chunks[chunk]));
+    }
+    return MakeColumn(i, chunks, out);
+  }
+
+  Status Read(const std::vector<int>& indices, std::shared_ptr<Table>* out) {
+    for (int i : indices) {
+      if (i < 0 || i >= num_columns()) {
+        std::stringstream ss;
+        ss << "Column index " << i << " is out of bounds";
+        return Status::Invalid(ss.str());
+      }
+    }
+    // Each chunk is read with a positional read, which is a zero-copy slice
+    // if the source supports it, and decompressed, so the chunks of all the
+    // columns can be read concurrently.
+    std::vector<ArrayVector> chunks(indices.size());
+    std::vector<std::pair<int, int>> tasks;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      chunks[i].resize(num_chunks(indices[i]));
+      for (int chunk = 0; chunk < num_chunks(indices[i]); ++chunk) {
+        tasks.emplace_back(static_cast<int>(i), chunk);
+      }
+    }
+    const int num_tasks = static_cast<int>(tasks.size());
+    auto read_chunk = [&indices, &chunks, &tasks, this](int task) {
+      const int i = tasks[task].first;
+      const int chunk = tasks[task].second;
+      return LoadChunk(indices[i], chunk, &chunks[i][chunk]);
+    };
+    if (num_threads_ > 1 && num_tasks > 1) {
+      RETURN_NOT_OK(ParallelFor(std::min(num_threads_, num_tasks), num_tasks,
+                                read_chunk));
+    } else {
+      for (int task = 0; task < num_tasks; ++task) {
+        RETURN_NOT_OK(read_chunk(task));
+      }
+    }
+
+    std::vector<std::shared_ptr<Column>> columns(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      RETURN_NOT_OK(MakeColumn(indices[i], chunks[i], &columns[i]));
+    }
+
+    std::vector<std::shared_ptr<Field>> fields;
+    for (const auto& column : columns) {
+      fields.push_back(column->field());
+    }
+    *out = Table::Make(::arrow::schema(fields), columns, num_rows());
     return Status::OK();
   }
 
+  Status Read(const std::vector<std::string>& names, std::shared_ptr<Table>* out) {
+    std::unordered_map<std::string, int> name_to_index;
+    for (int i = 0; i < num_columns(); ++i) {
+      name_to_index.insert({GetColumnName(i), i});
+    }
+    std::vector<int> indices;
+    for (const std::string& name : names) {
+      auto it = name_to_index.find(name);
+      if (it == name_to_index.end()) {
+        return Status::Invalid("No column named " + name);
+      }
+      indices.push_back(it->second);
+    }
+    return Read(indices, out);
+  }
+
+  void set_num_threads(int num_threads) { num_threads_ = std::max(num_threads, 1); }
+
  private:
   std::shared_ptr<io::RandomAccessFile> source_;
   std::unique_ptr<TableMetadata> metadata_;
+  int num_threads_;
 
   std::shared_ptr<Schema> schema_;
 };
@@ -439,6 +657,27 @@ Status TableReader::GetColumn(int i, std::shared_ptr<Column>* out) {
   return impl_->GetColumn(i, out);
 }
 
+Status TableReader::Read(std::shared_ptr<Table>* out) {
+  std::vector<int> indices(static_cast<size_t>(num_columns()));
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int>(i);
+  }
+  return impl_->Read(indices, out);
+}
+
+Status TableReader::Read(const std::vector<int>& indices, std::shared_ptr<Table>* out) {
+  return impl_->Read(indices, out);
+}
+
+Status TableReader::Read(const std::vector<std::string>& names,
+                         std::shared_ptr<Table>* out) {
+  return impl_->Read(names, out);
+}
+
+void TableReader::set_num_threads(int num_threads) {
+  impl_->set_num_threads(num_threads);
+}
+
 // ----------------------------------------------------------------------
 // writer.cc
 
@@ -498,9 +737,26 @@ static Status SanitizeUnsupportedTypes(const Array& values, std::shared_ptr<Arra
   }
 }
 
+// The bits of a bitmap from a bit offset, which are copied unless the offset
+// is a multiple of 8
+static Status GetBitmap(const std::shared_ptr<Buffer>& bitmap, int64_t offset,
+                        int64_t length, std::shared_ptr<Buffer>* out) {
+  if (offset % 8 == 0) {
+    *out = SliceBuffer(bitmap, offset / 8, BitUtil::BytesForBits(length));
+    return Status::OK();
+  }
+  return CopyBitmap(default_memory_pool(), bitmap->data(), offset, length, out);
+}
+
 class TableWriter::TableWriterImpl : public ArrayVisitor {
  public:
-  TableWriterImpl() : initialized_stream_(false), metadata_(0) {}
+  TableWriterImpl()
+      : initialized_stream_(false),
+        metadata_(0),
+        has_columns_(false),
+        compression_(fbs::CompressionType_UNCOMPRESSED),
+        num_batches_(0),
+        num_rows_(0) {}
 
   Status Open(const std::shared_ptr<io::OutputStream>& stream) {
     stream_ = stream;
@@ -511,8 +767,21 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
 
   void SetNumRows(int64_t num_rows) { metadata_.SetNumRows(num_rows); }
 
+  Status SetCompression(Compression::type compression) {
+    RETURN_NOT_OK(ToFlatbufferEnum(compression, &compression_));
+    codec_.reset();
+    RETURN_NOT_OK(Codec::Create(compression, &codec_));
+    if (codec_ != nullptr) {
+      metadata_.SetVersion(kFeatherChunkedVersion);
+    }
+    return Status::OK();
+  }
+
   Status Finalize() {
     RETURN_NOT_OK(CheckStarted());
+    for (auto& column : chunked_columns_) {
+      RETURN_NOT_OK(column->Finish());
+    }
     RETURN_NOT_OK(metadata_.Finish());
 
     auto buffer = metadata_.GetBuffer();
@@ -549,7 +818,47 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
   Status WriteArray(const Array& values, ArrayMetadata* meta) {
     RETURN_NOT_OK(CheckStarted());
     RETURN_NOT_OK(LoadArrayMetadata(values, meta));
+    if (codec_ == nullptr) {
+      return WriteArrayData(values, stream_.get(), &meta->total_bytes);
+    }
+
+    // The data is laid out in memory as if it were not compressed, and then
+    // compressed at once
+    std::shared_ptr<io::BufferOutputStream> buffer_stream;
+    RETURN_NOT_OK(io::BufferOutputStream::Create(kCompressionBufferSize,
+                                                 default_memory_pool(), &buffer_stream));
+    int64_t uncompressed_bytes = 0;
+    RETURN_NOT_OK(WriteArrayData(values, buffer_stream.get(), &uncompressed_bytes));
+    std::shared_ptr<Buffer> uncompressed;
+    RETURN_NOT_OK(buffer_stream->Finish(&uncompressed));
+
+    const int64_t max_compressed_bytes =
+        codec_->MaxCompressedLen(uncompressed->size(), uncompressed->data());
+    if (compressed_ == nullptr) {
+      RETURN_NOT_OK(AllocateResizableBuffer(default_memory_pool(), max_compressed_bytes,
+                                            &compressed_));
+    } else if (compressed_->size() < max_compressed_bytes) {
+      RETURN_NOT_OK(compressed_->Resize(max_compressed_bytes));
+    }
+    int64_t compressed_bytes;
+    RETURN_NOT_OK(codec_->Compress(uncompressed->size(), uncompressed->data(),
+                                   compressed_->size(), compressed_->mutable_data(),
+                                   &compressed_bytes));
+
+    // The padding is not part of the compressed data
+    int64_t bytes_written;
+    RETURN_NOT_OK(WritePadded(stream_.get(), compressed_->data(), compressed_bytes,
+                              &bytes_written));
+    meta->total_bytes = compressed_bytes;
+    meta->compression = compression_;
+    meta->uncompressed_bytes = uncompressed_bytes;
+    return Status::OK();
+  }
 
+  // Write the null bitmask, offsets and values of an array to a stream, and
+  // add the number of bytes written to total_bytes
+  Status WriteArrayData(const Array& values, io::OutputStream* stream,
+                        int64_t* total_bytes) {
     int64_t bytes_written;
 
     // Write the null bitmask
@@ -558,38 +867,53 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
       // byte boundary, and we write this much data into the stream
       int64_t null_bitmap_size = GetOutputLength(BitUtil::BytesForBits(values.length()));
       if (values.null_bitmap()) {
-        RETURN_NOT_OK(WritePadded(stream_.get(), values.null_bitmap()->data(),
-                                  null_bitmap_size, &bytes_written));
+        std::shared_ptr<Buffer> null_bitmap;
+        RETURN_NOT_OK(GetBitmap(values.null_bitmap(), values.offset(), values.length(),
+                                &null_bitmap));
+        RETURN_NOT_OK(WritePadded(stream, null_bitmap->data(), null_bitmap->size(),
+                                  &bytes_written));
       } else {
-        RETURN_NOT_OK(WritePaddedBlank(stream_.get(), null_bitmap_size, &bytes_written));
+        RETURN_NOT_OK(WritePaddedBlank(stream, null_bitmap_size, &bytes_written));
       }
-      meta->total_bytes += bytes_written;
+      *total_bytes += bytes_written;
     }
 
     int64_t values_bytes = 0;
 
     const uint8_t* values_buffer = nullptr;
+    std::shared_ptr<Buffer> bitmap;
 
     if (is_binary_like(values.type_id())) {
       const auto& bin_values = static_cast<const BinaryArray&>(values);
 
       int64_t offset_bytes = sizeof(int32_t) * (values.length() + 1);
 
+      int32_t first_offset = 0;
       if (bin_values.value_offsets()) {
-        values_bytes = bin_values.raw_value_offsets()[values.length()];
+        const int32_t* value_offsets = bin_values.raw_value_offsets();
+        first_offset = value_offsets[0];
+        values_bytes = value_offsets[values.length()] - first_offset;
+
+        // The offsets of a sliced array are rebased to start at zero
+        std::vector<int32_t> rebased_offsets;
+        if (first_offset != 0) {
+          rebased_offsets.resize(values.length() + 1);
+          for (int64_t i = 0; i <= values.length(); ++i) {
+            rebased_offsets[i] = value_offsets[i] - first_offset;
+          }
+          value_offsets = rebased_offsets.data();
+        }
 
         // Write the variable-length offsets
-        RETURN_NOT_OK(
-            WritePadded(stream_.get(),
-                        reinterpret_cast<const uint8_t*>(bin_values.raw_value_offsets()),
-                        offset_bytes, &bytes_written));
+        RETURN_NOT_OK(WritePadded(stream, reinterpret_cast<const uint8_t*>(value_offsets),
+                                  offset_bytes, &bytes_written));
       } else {
-        RETURN_NOT_OK(WritePaddedBlank(stream_.get(), offset_bytes, &bytes_written));
+        RETURN_NOT_OK(WritePaddedBlank(stream, offset_bytes, &bytes_written));
       }
-      meta->total_bytes += bytes_written;
+      *total_bytes += bytes_written;
 
       if (bin_values.value_data()) {
-        values_buffer = bin_values.value_data()->data();
+        values_buffer = bin_values.value_data()->data() + first_offset;
       }
     } else {
       const auto& prim_values = static_cast<const PrimitiveArray&>(values);
@@ -602,17 +926,21 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
         values_bytes = values.length() * fw_type.bit_width() / 8;
       }
 
-      if (prim_values.values()) {
-        values_buffer = prim_values.values()->data();
+      if (prim_values.values() && values.type_id() == Type::BOOL) {
+        RETURN_NOT_OK(
+            GetBitmap(prim_values.values(), values.offset(), values.length(), &bitmap));
+        values_buffer = bitmap->data();
+      } else if (prim_values.values()) {
+        values_buffer =
+            prim_values.values()->data() + values.offset() * fw_type.bit_width() / 8;
       }
     }
     if (values_buffer) {
-      RETURN_NOT_OK(
-          WritePadded(stream_.get(), values_buffer, values_bytes, &bytes_written));
+      RETURN_NOT_OK(WritePadded(stream, values_buffer, values_bytes, &bytes_written));
     } else {
-      RETURN_NOT_OK(WritePaddedBlank(stream_.get(), values_bytes, &bytes_written));
+      RETURN_NOT_OK(WritePaddedBlank(stream, values_bytes, &bytes_written));
     }
-    meta->total_bytes += bytes_written;
+    *total_bytes += bytes_written;
 
     return Status::OK();
   }
@@ -621,7 +949,11 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
     // Prepare metadata payload
     ArrayMetadata meta;
     RETURN_NOT_OK(WriteArray(values, &meta));
-    current_column_->SetValues(meta);
+    if (schema_ != nullptr) {
+      current_column_->AddChunk(meta);
+    } else {
+      current_column_->SetValues(meta);
+    }
     return Status::OK();
   }
 
@@ -658,6 +990,10 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
     }
 
     RETURN_NOT_OK(WritePrimitiveValues(*values.indices()));
+    if (num_batches_ > 0) {
+      // The levels were written with the first chunk
+      return Status::OK();
+    }
 
     ArrayMetadata levels_meta;
     std::shared_ptr<Array> sanitized_dictionary;
@@ -693,11 +1029,42 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
   }
 
   Status Append(const std::string& name, const Array& values) {
+    if (schema_ != nullptr) {
+      return Status::Invalid("Cannot append a column after a record batch");
+    }
     current_column_ = metadata_.AddColumn(name);
     RETURN_NOT_OK(values.Accept(this));
+    has_columns_ = true;
     return current_column_->Finish();
   }
 
+  Status Append(const RecordBatch& batch) {
+    if (schema_ == nullptr) {
+      if (has_columns_) {
+        return Status::Invalid("Cannot append a record batch after a column");
+      }
+      schema_ = batch.schema();
+      for (int i = 0; i < schema_->num_fields(); ++i) {
+        chunked_columns_.push_back(metadata_.AddColumn(schema_->field(i)->name()));
+      }
+      metadata_.SetVersion(kFeatherChunkedVersion);
+    } else if (!batch.schema()->Equals(*schema_)) {
+      return Status::Invalid("Record batch schema does not match the first batch");
+    }
+
+    for (int i = 0; i < batch.num_columns(); ++i) {
+      // The column builders are kept until the file is finalized
+      current_column_.swap(chunked_columns_[i]);
+      Status status = batch.column(i)->Accept(this);
+      current_column_.swap(chunked_columns_[i]);
+      RETURN_NOT_OK(status);
+    }
+    num_batches_ += 1;
+    num_rows_ += batch.num_rows();
+    metadata_.SetNumRows(num_rows_);
+    return Status::OK();
+  }
+
  private:
   Status CheckStarted() {
     if (!initialized_stream_) {
@@ -716,6 +1083,18 @@ class TableWriter::TableWriterImpl : public ArrayVisitor {
   TableBuilder metadata_;
 
   std::unique_ptr<ColumnBuilder> current_column_;
+  bool has_columns_;
+
+  fbs::CompressionType compression_;
+  std::unique_ptr<Codec> codec_;
+  std::shared_ptr<ResizableBuffer> compressed_;
+
+  // The schema and columns of the record batches, if the file is written in
+  // chunks
+  std::shared_ptr<Schema> schema_;
+  std::vector<std::unique_ptr<ColumnBuilder>> chunked_columns_;
+  int64_t num_batches_;
+  int64_t num_rows_;
 
   Status AppendPrimitive(const PrimitiveArray& values, ArrayMetadata* out);
 };
@@ -734,10 +1113,16 @@ void TableWriter::SetDescription(const std::string& desc) { impl_->SetDescriptio
 
 void TableWriter::SetNumRows(int64_t num_rows) { impl_->SetNumRows(num_rows); }
 
+Status TableWriter::SetCompression(Compression::type compression) {
+  return impl_->SetCompression(compression);
+}
+
 Status TableWriter::Append(const std::string& name, const Array& values) {
   return impl_->Append(name, values);
 }
 
+Status TableWriter::Append(const RecordBatch& batch) { return impl_->Append(batch); }
+
 Status TableWriter::Finalize() { return impl_->Finalize(); }
 
 }  // namespace feather
@@ -24,14 +24,18 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "arrow/util/compression.h"
 #include "arrow/util/visibility.h"
 
 namespace arrow {
 
 class Array;
 class Column;
+class RecordBatch;
 class Status;
+class Table;
 
 namespace io {
 
@@ -45,6 +49,9 @@ namespace feather {
 
 static constexpr const int kFeatherVersion = 2;
 
+// The version of files with chunked or compressed columns
+static constexpr const int kFeatherChunkedVersion = 3;
+
 // ----------------------------------------------------------------------
 // Metadata accessor classes
 
@@ -57,6 +64,8 @@ class ARROW_EXPORT TableReader {
 
   /// \brief Open a Feather file from a RandomAccessFile interface
   ///
+  /// Files with a version newer than kFeatherChunkedVersion are rejected.
+  ///
   /// \param[in] source a RandomAccessFile instance
   /// \param[out] out the table reader
   static Status Open(const std::shared_ptr<io::RandomAccessFile>& source,
@@ -88,9 +97,39 @@ class ARROW_EXPORT TableReader {
   /// \param[out] out the returned column
   /// \return Status
   ///
-  /// This function is zero-copy if the file source supports zero-copy reads
+  /// This function is zero-copy if the file source supports zero-copy reads,
+  /// unless the column is compressed. A column that was written in chunks has
+  /// one chunk per record batch.
   Status GetColumn(int i, std::shared_ptr<Column>* out);
 
+  /// \brief Read all columns from the file as an arrow::Table.
+  ///
+  /// \param[out] out the returned table
+  /// \return Status
+  ///
+  /// This function is zero-copy if the file source supports zero-copy reads
+  Status Read(std::shared_ptr<Table>* out);
+
+  /// \brief Read a subset of the columns from the file as an arrow::Table.
+  ///
+  /// \param[in] indices the column indices to read, in the order of the table
+  /// \param[out] out the returned table
+  /// \return Status
+  Status Read(const std::vector<int>& indices, std::shared_ptr<Table>* out);
+
+  /// \brief Read a subset of the columns from the file as an arrow::Table.
+  ///
+  /// \param[in] names the column names to read, in the order of the table
+  /// \param[out] out the returned table
+  /// \return Status
+  Status Read(const std::vector<std::string>& names, std::shared_ptr<Table>* out);
+
+  /// \brief Set the number of threads used by Read to read columns
+  ///
+  /// The columns, and the chunks of chunked columns, are read and decompressed
+  /// in parallel. The default is 1, and smaller values are treated as 1.
+  void set_num_threads(int num_threads);
+
  private:
   class ARROW_NO_EXPORT TableReaderImpl;
   std::unique_ptr<TableReaderImpl> impl_;
@@ -115,6 +154,14 @@ class ARROW_EXPORT TableWriter {
   /// \brief Set the number of rows in the file
   void SetNumRows(int64_t num_rows);
 
+  /// \brief Set the compression of the column data that is written afterwards
+  ///
+  /// Files with compressed columns have version kFeatherChunkedVersion.
+  ///
+  /// \param[in] compression UNCOMPRESSED, LZ4 or ZSTD
+  /// \return Status
+  Status SetCompression(Compression::type compression);
+
   /// \brief Append a column to the file
   ///
   /// \param[in] name the column name
@@ -122,6 +169,19 @@ class ARROW_EXPORT TableWriter {
   /// \return Status
   Status Append(const std::string& name, const Array& values);
 
+  /// \brief Append a record batch as a chunk of each column
+  ///
+  /// The columns are those of the first batch, and all batches must have the
+  /// same schema. The columns of each batch are written, and can be freed,
+  /// before the next one is appended. The number of rows is the total of the
+  /// batches, and the file has version kFeatherChunkedVersion.
+  ///
+  /// This cannot be combined with Append(name, values).
+  ///
+  /// \param[in] batch the record batch
+  /// \return Status
+  Status Append(const RecordBatch& batch);
+
   /// \brief Finalize the file by writing the file metadata and footer
   /// \return Status
   Status Finalize();
@@ -130,6 +130,79 @@ void ArrowCapsule_Destructor(PyObject* capsule) {
 
 }  // namespace
 
+// Make the NumPy array arr a read-only view on Arrow memory. Its base is
+// py_ref, the Python object owning the memory if there is one, or else a
+// capsule holding a reference to the Arrow array data. The GIL must be held
+//
+// See ARROW-1973 for the original memory leak report.
+//
+// There are two scenarios: py_ref is nullptr or py_ref is not nullptr
+//
+//   1. py_ref is nullptr (it **was not** passed in to ArrowDeserializer's
+//      constructor)
+//
+//      In this case, the stolen reference must not be incremented since nothing
+//      outside of the PyArrayObject* (arr) is holding a reference to
+//      it. If we increment this, then we have a memory leak.
+//
+//
+//      Here's an example of how memory can be leaked when converting an arrow Array
+//      of List<Float64>.to a numpy array
+//
+//      1. Create a 1D numpy that is the flattened arrow array.
+//
+//         There's nothing outside of the serializer that owns this new numpy array.
+//
+//      2. Make a capsule for the base array.
+//
+//         The reference count of base is 1.
+//
+//      3. Call PyArray_SetBaseObject(arr, base)
+//
+//         The reference count is still 1, because the reference is stolen.
+//
+//      4. Increment the reference count of base (unconditionally)
+//
+//         The reference count is now 2. This is okay if there's an object holding
+//         another reference. The PyArrayObject that stole the reference will
+//         eventually decrement the reference count, which will leaves us with a
+//         refcount of 1, with nothing owning that 1 reference. Memory leakage
+//         ensues.
+//
+//   2. py_ref is not nullptr (it **was** passed in to ArrowDeserializer's
+//      constructor)
+//
+//      This case is simpler. We assume that the reference accounting is correct
+//      coming in. We need to preserve that accounting knowing that the
+//      PyArrayObject that stole the reference will eventually decref it, thus we
+//      increment the reference count.
+static Status SetArrowBase(PyArrayObject* arr, const std::shared_ptr<Array>& data,
+                           PyObject* py_ref = nullptr) {
+  PyObject* base;
+  if (py_ref == nullptr) {
+    auto capsule = new ArrowCapsule{{data}};
+    base = PyCapsule_New(reinterpret_cast<void*>(capsule), "arrow",
+                         &ArrowCapsule_Destructor);
+    if (base == nullptr) {
+      delete capsule;
+      RETURN_IF_PYERROR();
+    }
+  } else {
+    base = py_ref;
+    Py_INCREF(base);
+  }
+
+  if (PyArray_SetBaseObject(arr, base) == -1) {
+    Py_XDECREF(base);
+    RETURN_IF_PYERROR();
+  }
+
+  // Arrow data is immutable and owned by another
+  PyArray_CLEARFLAGS(arr, NPY_ARRAY_WRITEABLE);
+  PyArray_CLEARFLAGS(arr, NPY_ARRAY_OWNDATA);
+  return Status::OK();
+}
+
 // ----------------------------------------------------------------------
 // pandas 0.x DataFrame conversion internals
 
@@ -1001,8 +1074,10 @@ class CategoricalBlock : public PandasBlock {
     };
 
     if (!needs_copy_ && data.num_chunks() == 1 && indices_first.null_count() == 0) {
+      // Arrow signed integer indices have the same layout as pandas codes, so
+      // the block can be a view on the indices buffer
       RETURN_NOT_OK(CheckIndices(indices_first, dict_arr_first.dictionary()->length()));
-      RETURN_NOT_OK(AllocateNDArrayFromIndices<T>(npy_type, indices_first));
+      RETURN_NOT_OK(AllocateNDArrayFromIndices<T>(npy_type, dict_arr_first.indices()));
     } else {
       if (options_.zero_copy_only) {
         std::stringstream ss;
@@ -1029,8 +1104,17 @@ class CategoricalBlock : public PandasBlock {
         auto in_values = reinterpret_cast<const T*>(indices.raw_values());
 
         RETURN_NOT_OK(CheckIndices(indices, dict_arr.dictionary()->length()));
+        if (indices.null_count() == 0) {
+          // Chunks share the dictionary of the column type, so the indices
+          // can be concatenated as is
+          if (indices.length() > 0) {
+            memcpy(out_values, in_values, sizeof(T) * indices.length());
+            out_values += indices.length();
+          }
+          continue;
+        }
         // Null is -1 in CategoricalBlock
-        for (int i = 0; i < arr->length(); ++i) {
+        for (int64_t i = 0; i < arr->length(); ++i) {
           *out_values++ = indices.IsNull(i) ? -1 : in_values[i];
         }
       }
@@ -1109,10 +1193,10 @@ class CategoricalBlock : public PandasBlock {
 
  protected:
   template <typename T>
-  Status AllocateNDArrayFromIndices(int npy_type, const PrimitiveArray& indices) {
+  Status AllocateNDArrayFromIndices(int npy_type, const std::shared_ptr<Array>& indices) {
     npy_intp block_dims[1] = {num_rows_};
 
-    const T* in_values = GetPrimitiveValues<T>(indices);
+    const T* in_values = GetPrimitiveValues<T>(*indices);
     void* data = const_cast<T*>(in_values);
 
     PyAcquireGIL lock;
@@ -1126,12 +1210,15 @@ class CategoricalBlock : public PandasBlock {
     PyObject* block_arr = PyArray_NewFromDescr(&PyArray_Type, descr, 1, block_dims,
                                                nullptr, data, NPY_ARRAY_CARRAY, nullptr);
     RETURN_IF_PYERROR();
+    block_arr_.reset(block_arr);
+
+    // Keep the indices buffer alive for as long as the block references it
+    RETURN_NOT_OK(SetArrowBase(reinterpret_cast<PyArrayObject*>(block_arr), indices));
 
     npy_intp placement_dims[1] = {num_columns_};
     PyObject* placement_arr = PyArray_SimpleNew(1, placement_dims, NPY_INT64);
     RETURN_IF_PYERROR();
 
-    block_arr_.reset(block_arr);
     placement_arr_.reset(placement_arr);
 
     block_data_ = reinterpret_cast<uint8_t*>(
@@ -1470,76 +1557,7 @@ class ArrowDeserializer {
       return Status::OK();
     }
 
-    // See ARROW-1973 for the original memory leak report.
-    //
-    // There are two scenarios: py_ref_ is nullptr or py_ref_ is not nullptr
-    //
-    //   1. py_ref_ is nullptr (it **was not** passed in to ArrowDeserializer's
-    //      constructor)
-    //
-    //      In this case, the stolen reference must not be incremented since nothing
-    //      outside of the PyArrayObject* (the arr_ member) is holding a reference to
-    //      it. If we increment this, then we have a memory leak.
-    //
-    //
-    //      Here's an example of how memory can be leaked when converting an arrow Array
-    //      of List<Float64>.to a numpy array
-    //
-    //      1. Create a 1D numpy that is the flattened arrow array.
-    //
-    //         There's nothing outside of the serializer that owns this new numpy array.
-    //
-    //      2. Make a capsule for the base array.
-    //
-    //         The reference count of base is 1.
-    //
-    //      3. Call PyArray_SetBaseObject(arr_, base)
-    //
-    //         The reference count is still 1, because the reference is stolen.
-    //
-    //      4. Increment the reference count of base (unconditionally)
-    //
-    //         The reference count is now 2. This is okay if there's an object holding
-    //         another reference. The PyArrayObject that stole the reference will
-    //         eventually decrement the reference count, which will leaves us with a
-    //         refcount of 1, with nothing owning that 1 reference. Memory leakage
-    //         ensues.
-    //
-    //   2. py_ref_ is not nullptr (it **was** passed in to ArrowDeserializer's
-    //      constructor)
-    //
-    //      This case is simpler. We assume that the reference accounting is correct
-    //      coming in. We need to preserve that accounting knowing that the
-    //      PyArrayObject that stole the reference will eventually decref it, thus we
-    //      increment the reference count.
-
-    PyObject* base;
-    if (py_ref_ == nullptr) {
-      auto capsule = new ArrowCapsule{{arr}};
-      base = PyCapsule_New(reinterpret_cast<void*>(capsule), "arrow",
-                           &ArrowCapsule_Destructor);
-      if (base == nullptr) {
-        delete capsule;
-        RETURN_IF_PYERROR();
-      }
-    } else {
-      base = py_ref_;
-      Py_INCREF(base);
-    }
-
-    if (PyArray_SetBaseObject(arr_, base) == -1) {
-      // Error occurred, trust that SetBaseObject set the error state
-      Py_XDECREF(base);
-      return Status::OK();
-    }
-
-    // Arrow data is immutable.
-    PyArray_CLEARFLAGS(arr_, NPY_ARRAY_WRITEABLE);
-
-    // Arrow data is owned by another
-    PyArray_CLEARFLAGS(arr_, NPY_ARRAY_OWNDATA);
-
-    return Status::OK();
+    return SetArrowBase(arr_, arr, py_ref_);
   }
 
   // ----------------------------------------------------------------------
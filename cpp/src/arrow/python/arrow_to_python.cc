@@ -91,10 +91,36 @@ Status DeserializeDict(PyObject* context, const Array& array, int64_t start_idx,
   return Status::OK();
 }
 
+namespace {
+
+struct TensorCapsule {
+  std::shared_ptr<Tensor> tensor;
+};
+
+void TensorCapsule_Destructor(PyObject* capsule) {
+  delete reinterpret_cast<TensorCapsule*>(PyCapsule_GetPointer(capsule, "arrow"));
+}
+
+}  // namespace
+
 Status DeserializeArray(const Array& array, int64_t offset, PyObject* base,
                         const SerializedPyObject& blobs, PyObject** out) {
   int32_t index = static_cast<const Int32Array&>(array).Value(offset);
-  RETURN_NOT_OK(py::TensorToNdarray(*blobs.tensors[index], base, out));
+  const std::shared_ptr<Tensor>& tensor = blobs.tensors[index];
+  if (base == Py_None) {
+    // Nothing else owns the tensor memory (e.g. the object was reconstructed
+    // from components), so let the ndarray keep the tensor alive itself
+    auto capsule = new TensorCapsule{tensor};
+    OwnedRef tensor_base(PyCapsule_New(reinterpret_cast<void*>(capsule), "arrow",
+                                       &TensorCapsule_Destructor));
+    if (tensor_base.obj() == nullptr) {
+      delete capsule;
+      RETURN_IF_PYERROR();
+    }
+    RETURN_NOT_OK(py::TensorToNdarray(*tensor, tensor_base.obj(), out));
+  } else {
+    RETURN_NOT_OK(py::TensorToNdarray(*tensor, base, out));
+  }
   // Mark the array as immutable
   OwnedRef flags(PyObject_GetAttrString(*out, "flags"));
   DCHECK(flags.obj() != NULL) << "Could not mark Numpy array immutable";
@@ -104,6 +130,73 @@ Status DeserializeArray(const Array& array, int64_t offset, PyObject* base,
   return Status::OK();
 }
 
+// Create a Python list or tuple from a slice of the int64, double or string
+// values of a homogeneous sequence
+Status DeserializeTypedSequence(const Array& values, int64_t start_idx, int64_t stop_idx,
+                                bool is_tuple, PyObject** out) {
+  const int64_t size = stop_idx - start_idx;
+  OwnedRef result(is_tuple ? PyTuple_New(size) : PyList_New(size));
+  RETURN_IF_PYERROR();
+  for (int64_t i = start_idx; i < stop_idx; ++i) {
+    PyObject* value;
+    switch (values.type_id()) {
+      case Type::INT64:
+        value = PyLong_FromLongLong(static_cast<const Int64Array&>(values).Value(i));
+        break;
+      case Type::DOUBLE:
+        value = PyFloat_FromDouble(static_cast<const DoubleArray&>(values).Value(i));
+        break;
+      case Type::STRING: {
+        int32_t nchars;
+        const uint8_t* str =
+            static_cast<const StringArray&>(values).GetValue(i, &nchars);
+        value = PyUnicode_FromStringAndSize(reinterpret_cast<const char*>(str), nchars);
+      } break;
+      default:
+        return Status::NotImplemented("Cannot deserialize sequence of type " +
+                                      values.type()->ToString());
+    }
+    RETURN_IF_PYERROR();
+    if (is_tuple) {
+      PyTuple_SET_ITEM(result.obj(), i - start_idx, value);
+    } else {
+      PyList_SET_ITEM(result.obj(), i - start_idx, value);
+    }
+  }
+  *out = result.detach();
+  return Status::OK();
+}
+
+// Recreate an array.array with the given typecode from a buffer
+Status DeserializePyArray(char typecode, const std::shared_ptr<Buffer>& buffer,
+                          PyObject** out) {
+  OwnedRef array_module(PyImport_ImportModule("array"));
+  RETURN_IF_PYERROR();
+#if PY_MAJOR_VERSION >= 3
+  OwnedRef typecode_str(PyUnicode_FromStringAndSize(&typecode, 1));
+#else
+  OwnedRef typecode_str(PyBytes_FromStringAndSize(&typecode, 1));
+#endif
+  RETURN_IF_PYERROR();
+  OwnedRef result(
+      PyObject_CallMethod(array_module.obj(), "array", "O", typecode_str.obj()));
+  RETURN_IF_PYERROR();
+  OwnedRef wrapped(wrap_buffer(buffer));
+  RETURN_IF_PYERROR();
+#if PY_MAJOR_VERSION >= 3
+  OwnedRef ignored(PyObject_CallMethod(result.obj(), "frombytes", "O", wrapped.obj()));
+#else
+  OwnedRef view(PyMemoryView_FromObject(wrapped.obj()));
+  RETURN_IF_PYERROR();
+  OwnedRef bytes(PyObject_CallMethod(view.obj(), "tobytes", nullptr));
+  RETURN_IF_PYERROR();
+  OwnedRef ignored(PyObject_CallMethod(result.obj(), "fromstring", "O", bytes.obj()));
+#endif
+  RETURN_IF_PYERROR();
+  *out = result.detach();
+  return Status::OK();
+}
+
 Status GetValue(PyObject* context, const UnionArray& parent, const Array& arr,
                 int64_t index, int32_t type, PyObject* base,
                 const SerializedPyObject& blobs, PyObject** result) {
@@ -146,8 +239,21 @@ Status GetValue(PyObject* context, const UnionArray& parent, const Array& arr,
       RETURN_IF_PYERROR();
       return Status::OK();
     }
+    case Type::LIST: {
+      // A list or tuple of homogeneous ints, floats or strings
+      const auto& l = static_cast<const ListArray&>(arr);
+      const bool is_tuple = parent.type()->child(type)->name() == "tuple";
+      return DeserializeTypedSequence(*l.values(), l.value_offset(index),
+                                      l.value_offset(index + 1), is_tuple, result);
+    }
     case Type::STRUCT: {
       const auto& s = static_cast<const StructArray&>(arr);
+      if (s.type()->child(0)->name() == "typecode") {
+        const auto typecode = static_cast<const Int8Array&>(*s.field(0)).Value(index);
+        const auto ref = static_cast<const Int32Array&>(*s.field(1)).Value(index);
+        return DeserializePyArray(static_cast<char>(typecode), blobs.buffers[ref],
+                                  result);
+      }
       const auto& l = static_cast<const ListArray&>(*s.field(0));
       if (s.type()->child(0)->name() == "list") {
         return DeserializeList(context, *l.values(), l.value_offset(index),
@@ -173,6 +279,18 @@ Status GetValue(PyObject* context, const UnionArray& parent, const Array& arr,
         int32_t ref = static_cast<const Int32Array&>(arr).Value(index);
         *result = wrap_buffer(blobs.buffers[ref]);
         return Status::OK();
+      } else if (child_name == "bytes") {
+        int32_t ref = static_cast<const Int32Array&>(arr).Value(index);
+        const auto& buffer = blobs.buffers[ref];
+        *result = PyBytes_FromStringAndSize(reinterpret_cast<const char*>(buffer->data()),
+                                            buffer->size());
+        return CheckPyError();
+      } else if (child_name == "memoryview") {
+        int32_t ref = static_cast<const Int32Array&>(arr).Value(index);
+        OwnedRef wrapped(wrap_buffer(blobs.buffers[ref]));
+        RETURN_IF_PYERROR();
+        *result = PyMemoryView_FromObject(wrapped.obj());
+        return CheckPyError();
       } else {
         DCHECK(false) << "union tag " << type << " with child name '" << child_name
                       << "' not recognized";
@@ -320,18 +438,13 @@ Status GetSerializedFromComponents(int num_tensors, int num_buffers, PyObject* d
     gil.acquire();
   }
 
-  // Zero-copy reconstruct tensors
+  // Unwrap the tensor messages, then reconstruct the tensors (zero-copy)
+  // without holding the GIL
+  std::vector<std::shared_ptr<Buffer>> tensor_metadata(num_tensors);
+  std::vector<std::shared_ptr<Buffer>> tensor_bodies(num_tensors);
   for (int i = 0; i < num_tensors; ++i) {
-    std::shared_ptr<Buffer> metadata;
-    std::shared_ptr<Buffer> body;
-    std::shared_ptr<Tensor> tensor;
-    RETURN_NOT_OK(GetBuffer(buffer_index++, &metadata));
-    RETURN_NOT_OK(GetBuffer(buffer_index++, &body));
-
-    ipc::Message message(metadata, body);
-
-    RETURN_NOT_OK(ReadTensor(message, &tensor));
-    out->tensors.emplace_back(std::move(tensor));
+    RETURN_NOT_OK(GetBuffer(buffer_index++, &tensor_metadata[i]));
+    RETURN_NOT_OK(GetBuffer(buffer_index++, &tensor_bodies[i]));
   }
 
   // Unwrap and append buffers
@@ -341,6 +454,13 @@ Status GetSerializedFromComponents(int num_tensors, int num_buffers, PyObject* d
     out->buffers.emplace_back(std::move(buffer));
   }
 
+  gil.release();
+  out->tensors.resize(num_tensors);
+  for (int i = 0; i < num_tensors; ++i) {
+    ipc::Message message(tensor_metadata[i], tensor_bodies[i]);
+    RETURN_NOT_OK(ReadTensor(message, &out->tensors[i]));
+  }
+
   return Status::OK();
 }
 
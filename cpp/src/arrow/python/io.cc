@@ -17,8 +17,10 @@
 
 #include "arrow/python/io.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -51,7 +53,14 @@ static inline PyObject* cpp_PyObject_CallMethod(PyObject* obj, const char* metho
 // calling any methods
 class PythonFile {
  public:
-  explicit PythonFile(PyObject* file) : file_(file) { Py_INCREF(file_); }
+  explicit PythonFile(PyObject* file) : file_(file) {
+    Py_INCREF(file_);
+#if PYARROW_IS_PY2
+    has_readinto_ = false;
+#else
+    has_readinto_ = PyObject_HasAttrString(file_, "readinto") == 1;
+#endif
+  }
 
   ~PythonFile() { Py_DECREF(file_); }
 
@@ -78,6 +87,50 @@ class PythonFile {
     return Status::OK();
   }
 
+  // Read up to nbytes into out, stopping early only at end of file. Uses
+  // readinto() on a memoryview of out when available to avoid the
+  // intermediate bytes object
+  Status ReadInto(int64_t nbytes, int64_t* bytes_read, void* out) {
+    auto out_data = reinterpret_cast<char*>(out);
+    int64_t total_bytes = 0;
+    while (total_bytes < nbytes) {
+      int64_t chunk_size = 0;
+#if !PYARROW_IS_PY2
+      if (has_readinto_) {
+        PyObject* view = PyMemoryView_FromMemory(
+            out_data + total_bytes, static_cast<Py_ssize_t>(nbytes - total_bytes),
+            PyBUF_WRITE);
+        PY_RETURN_IF_ERROR(StatusCode::IOError);
+
+        PyObject* result = cpp_PyObject_CallMethod(file_, "readinto", "(O)", view);
+        Py_DECREF(view);
+        PY_RETURN_IF_ERROR(StatusCode::IOError);
+
+        // None is returned by non-blocking streams with no data available
+        if (result != Py_None) {
+          chunk_size = PyLong_AsLongLong(result);
+        }
+        Py_DECREF(result);
+        PY_RETURN_IF_ERROR(StatusCode::IOError);
+      } else {
+#endif
+        OwnedRef bytes_obj;
+        RETURN_NOT_OK(Read(nbytes - total_bytes, bytes_obj.ref()));
+        chunk_size = PyBytes_GET_SIZE(bytes_obj.obj());
+        std::memcpy(out_data + total_bytes, PyBytes_AS_STRING(bytes_obj.obj()),
+                    chunk_size);
+#if !PYARROW_IS_PY2
+      }
+#endif
+      if (chunk_size <= 0) {
+        break;
+      }
+      total_bytes += chunk_size;
+    }
+    *bytes_read = total_bytes;
+    return Status::OK();
+  }
+
   Status Write(const void* data, int64_t nbytes) {
     PyObject* py_data =
         PyBytes_FromStringAndSize(reinterpret_cast<const char*>(data), nbytes);
@@ -108,45 +161,128 @@ class PythonFile {
  private:
   std::mutex lock_;
   PyObject* file_;
+  bool has_readinto_;
 };
 
 // ----------------------------------------------------------------------
 // Seekable input stream
 
-PyReadableFile::PyReadableFile(PyObject* file) { file_.reset(new PythonFile(file)); }
+PyReadableFile::PyReadableFile(PyObject* file, int64_t buffer_size)
+    : buffer_size_(std::max<int64_t>(buffer_size, 0)),
+      buffer_position_(0),
+      buffer_length_(0) {
+  file_.reset(new PythonFile(file));
+}
 
 PyReadableFile::~PyReadableFile() {}
 
 Status PyReadableFile::Close() {
+  std::lock_guard<std::mutex> guard(file_->lock());
+  buffer_position_ = buffer_length_ = 0;
   PyAcquireGIL lock;
   return file_->Close();
 }
 
 Status PyReadableFile::Seek(int64_t position) {
+  std::lock_guard<std::mutex> guard(file_->lock());
+  return SeekInternal(position);
+}
+
+Status PyReadableFile::SeekInternal(int64_t position) {
   PyAcquireGIL lock;
+  if (buffered_bytes() > 0) {
+    // Stay within the read-ahead buffer if possible
+    int64_t raw_position = -1;
+    RETURN_NOT_OK(file_->Tell(&raw_position));
+    const int64_t buffer_start = raw_position - buffer_length_;
+    if (position >= buffer_start && position < raw_position) {
+      buffer_position_ = position - buffer_start;
+      return Status::OK();
+    }
+  }
+  buffer_position_ = buffer_length_ = 0;
   return file_->Seek(position, 0);
 }
 
 Status PyReadableFile::Tell(int64_t* position) const {
+  std::lock_guard<std::mutex> guard(file_->lock());
   PyAcquireGIL lock;
-  return file_->Tell(position);
+  int64_t raw_position = -1;
+  RETURN_NOT_OK(file_->Tell(&raw_position));
+  *position = raw_position - buffered_bytes();
+  return Status::OK();
 }
 
-Status PyReadableFile::Read(int64_t nbytes, int64_t* bytes_read, void* out) {
+Status PyReadableFile::FillBuffer() {
+  if (!buffer_) {
+    RETURN_NOT_OK(AllocateResizableBuffer(default_memory_pool(), buffer_size_, &buffer_));
+  }
+  buffer_position_ = buffer_length_ = 0;
+
   PyAcquireGIL lock;
+  return file_->ReadInto(buffer_size_, &buffer_length_, buffer_->mutable_data());
+}
 
-  PyObject* bytes_obj = NULL;
-  ARROW_RETURN_NOT_OK(file_->Read(nbytes, &bytes_obj));
-  DCHECK(bytes_obj != NULL);
+Status PyReadableFile::Read(int64_t nbytes, int64_t* bytes_read, void* out) {
+  std::lock_guard<std::mutex> guard(file_->lock());
+  return ReadInternal(nbytes, bytes_read, out);
+}
 
-  *bytes_read = PyBytes_GET_SIZE(bytes_obj);
-  std::memcpy(out, PyBytes_AS_STRING(bytes_obj), *bytes_read);
-  Py_XDECREF(bytes_obj);
+Status PyReadableFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  std::lock_guard<std::mutex> guard(file_->lock());
+  return ReadInternal(nbytes, out);
+}
+
+Status PyReadableFile::ReadInternal(int64_t nbytes, int64_t* bytes_read, void* out) {
+  if (buffer_size_ == 0) {
+    PyAcquireGIL lock;
+    return file_->ReadInto(nbytes, bytes_read, out);
+  }
+
+  auto out_data = reinterpret_cast<uint8_t*>(out);
 
+  // Serve what we can from the read-ahead buffer without taking the GIL
+  int64_t total_bytes = std::min(nbytes, buffered_bytes());
+  if (total_bytes > 0) {
+    std::memcpy(out_data, buffer_->data() + buffer_position_, total_bytes);
+    buffer_position_ += total_bytes;
+  }
+
+  const int64_t remaining = nbytes - total_bytes;
+  if (remaining >= buffer_size_) {
+    // Large read, bypass the buffer
+    int64_t direct_bytes = 0;
+    {
+      PyAcquireGIL lock;
+      RETURN_NOT_OK(file_->ReadInto(remaining, &direct_bytes, out_data + total_bytes));
+    }
+    total_bytes += direct_bytes;
+  } else if (remaining > 0) {
+    RETURN_NOT_OK(FillBuffer());
+    const int64_t chunk_size = std::min(remaining, buffer_length_);
+    std::memcpy(out_data + total_bytes, buffer_->data(), chunk_size);
+    buffer_position_ = chunk_size;
+    total_bytes += chunk_size;
+  }
+
+  *bytes_read = total_bytes;
   return Status::OK();
 }
 
-Status PyReadableFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+Status PyReadableFile::ReadInternal(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  if (buffer_size_ > 0 && (buffered_bytes() > 0 || nbytes < buffer_size_)) {
+    std::shared_ptr<ResizableBuffer> buffer;
+    RETURN_NOT_OK(AllocateResizableBuffer(default_memory_pool(), nbytes, &buffer));
+
+    int64_t bytes_read = 0;
+    RETURN_NOT_OK(ReadInternal(nbytes, &bytes_read, buffer->mutable_data()));
+    if (bytes_read < nbytes) {
+      RETURN_NOT_OK(buffer->Resize(bytes_read));
+    }
+    *out = buffer;
+    return Status::OK();
+  }
+
   PyAcquireGIL lock;
 
   OwnedRef bytes_obj;
@@ -159,18 +295,19 @@ Status PyReadableFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
 Status PyReadableFile::ReadAt(int64_t position, int64_t nbytes, int64_t* bytes_read,
                               void* out) {
   std::lock_guard<std::mutex> guard(file_->lock());
-  RETURN_NOT_OK(Seek(position));
-  return Read(nbytes, bytes_read, out);
+  RETURN_NOT_OK(SeekInternal(position));
+  return ReadInternal(nbytes, bytes_read, out);
 }
 
 Status PyReadableFile::ReadAt(int64_t position, int64_t nbytes,
                               std::shared_ptr<Buffer>* out) {
   std::lock_guard<std::mutex> guard(file_->lock());
-  RETURN_NOT_OK(Seek(position));
-  return Read(nbytes, out);
+  RETURN_NOT_OK(SeekInternal(position));
+  return ReadInternal(nbytes, out);
 }
 
 Status PyReadableFile::GetSize(int64_t* size) {
+  std::lock_guard<std::mutex> guard(file_->lock());
   PyAcquireGIL lock;
 
   int64_t current_position = -1;
@@ -194,26 +331,67 @@ bool PyReadableFile::supports_zero_copy() const { return false; }
 // ----------------------------------------------------------------------
 // Output stream
 
-PyOutputStream::PyOutputStream(PyObject* file) : position_(0) {
+PyOutputStream::PyOutputStream(PyObject* file, int64_t buffer_size)
+    : position_(0), buffer_size_(std::max<int64_t>(buffer_size, 0)), buffer_length_(0) {
   file_.reset(new PythonFile(file));
 }
 
-PyOutputStream::~PyOutputStream() {}
+PyOutputStream::~PyOutputStream() {
+  // Write out what is still buffered if the stream was not closed. The GIL
+  // is also needed to release the Python file.
+  PyAcquireGIL lock;
+  Status st = FlushBuffer();
+  if (!st.ok()) {
+    ARROW_LOG(ERROR) << "Error flushing PyOutputStream: " << st.ToString();
+  }
+  file_.reset();
+}
 
 Status PyOutputStream::Close() {
+  RETURN_NOT_OK(FlushBuffer());
   PyAcquireGIL lock;
   return file_->Close();
 }
 
+Status PyOutputStream::Flush() { return FlushBuffer(); }
+
 Status PyOutputStream::Tell(int64_t* position) const {
   *position = position_;
   return Status::OK();
 }
 
-Status PyOutputStream::Write(const void* data, int64_t nbytes) {
+Status PyOutputStream::FlushBuffer() {
+  if (buffer_length_ == 0) {
+    return Status::OK();
+  }
   PyAcquireGIL lock;
+  RETURN_NOT_OK(file_->Write(buffer_->data(), buffer_length_));
+  buffer_length_ = 0;
+  return Status::OK();
+}
+
+Status PyOutputStream::Write(const void* data, int64_t nbytes) {
   position_ += nbytes;
-  return file_->Write(data, nbytes);
+  if (buffer_size_ == 0) {
+    PyAcquireGIL lock;
+    return file_->Write(data, nbytes);
+  }
+
+  if (buffer_length_ + nbytes > buffer_size_) {
+    RETURN_NOT_OK(FlushBuffer());
+  }
+  if (nbytes >= buffer_size_) {
+    // Large write, bypass the buffer
+    PyAcquireGIL lock;
+    return file_->Write(data, nbytes);
+  }
+
+  if (!buffer_) {
+    RETURN_NOT_OK(AllocateResizableBuffer(default_memory_pool(), buffer_size_, &buffer_));
+  }
+  std::memcpy(buffer_->mutable_data() + buffer_length_, data, nbytes);
+  buffer_length_ += nbytes;
+  return Status::OK();
 }
 
 }  // namespace py
@@ -18,8 +18,10 @@
 #ifndef PYARROW_IO_H
 #define PYARROW_IO_H
 
+#include <cstdint>
 #include <memory>
 
+#include "arrow/buffer.h"
 #include "arrow/io/interfaces.h"
 #include "arrow/io/memory.h"
 #include "arrow/util/visibility.h"
@@ -36,9 +38,23 @@ namespace py {
 
 class ARROW_NO_EXPORT PythonFile;
 
+/// \brief RandomAccessFile wrapping a Python file-like object
+///
+/// When buffer_size is positive, reads smaller than the buffer are served
+/// from an internal read-ahead buffer that is refilled with a single Python
+/// call, so that the GIL is only acquired once per buffer_size bytes. Larger
+/// reads go straight into the caller's memory, through readinto() when the
+/// Python object provides it.
+///
+/// Reads, seeks and ReadAt take the same lock, so that they can be called from
+/// several threads. Read returns fewer bytes than requested only at the end of
+/// the file.
 class ARROW_EXPORT PyReadableFile : public io::RandomAccessFile {
  public:
-  explicit PyReadableFile(PyObject* file);
+  /// \param[in] file a Python file-like object
+  /// \param[in] buffer_size size of the read-ahead buffer in bytes, 0 to
+  /// disable buffering
+  explicit PyReadableFile(PyObject* file, int64_t buffer_size = 0);
   ~PyReadableFile() override;
 
   Status Close() override;
@@ -61,22 +77,57 @@ class ARROW_EXPORT PyReadableFile : public io::RandomAccessFile {
 
   bool supports_zero_copy() const override;
 
+  int64_t buffer_size() const { return buffer_size_; }
+
  private:
+  int64_t buffered_bytes() const { return buffer_length_ - buffer_position_; }
+
+  // Versions of Read and Seek for callers that hold the lock
+  Status ReadInternal(int64_t nbytes, int64_t* bytes_read, void* out);
+  Status ReadInternal(int64_t nbytes, std::shared_ptr<Buffer>* out);
+  Status SeekInternal(int64_t position);
+
+  // Refill the read-ahead buffer from the Python file. Acquires the GIL
+  Status FillBuffer();
+
   std::unique_ptr<PythonFile> file_;
+
+  int64_t buffer_size_;
+  std::shared_ptr<ResizableBuffer> buffer_;
+  int64_t buffer_position_;
+  int64_t buffer_length_;
 };
 
+/// \brief OutputStream wrapping a Python file-like object
+///
+/// When buffer_size is positive, small writes are accumulated without the GIL
+/// and handed to the Python object's write() method in buffer_size chunks.
+/// Buffered data is written out by Flush() and Close().
 class ARROW_EXPORT PyOutputStream : public io::OutputStream {
  public:
-  explicit PyOutputStream(PyObject* file);
+  /// \param[in] file a Python file-like object
+  /// \param[in] buffer_size size of the write buffer in bytes, 0 to disable
+  /// buffering
+  explicit PyOutputStream(PyObject* file, int64_t buffer_size = 0);
   ~PyOutputStream() override;
 
   Status Close() override;
+  Status Flush() override;
   Status Tell(int64_t* position) const override;
   Status Write(const void* data, int64_t nbytes) override;
 
+  int64_t buffer_size() const { return buffer_size_; }
+
  private:
+  // Hand buffered bytes to the Python file. Acquires the GIL
+  Status FlushBuffer();
+
   std::unique_ptr<PythonFile> file_;
   int64_t position_;
+
+  int64_t buffer_size_;
+  std::shared_ptr<ResizableBuffer> buffer_;
+  int64_t buffer_length_;
 };
 
 // TODO(wesm): seekable output files
@@ -0,0 +1,421 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/python/platform.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/python/numpy_interop.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+
+#include "arrow/python/arrow_to_pandas.h"
+#include "arrow/python/arrow_to_python.h"
+#include "arrow/python/builtin_convert.h"
+#include "arrow/python/common.h"
+#include "arrow/python/init.h"
+#include "arrow/python/numpy_to_arrow.h"
+#include "arrow/python/python_to_arrow.h"
+
+namespace arrow {
+namespace py {
+
+// The benchmarks run with the GIL released, like pyarrow calls into these
+// functions, and acquire it only to create or destroy Python objects
+static void InitializePython() {
+  static bool initialized = false;
+  if (!initialized) {
+    Py_Initialize();
+    arrow_init_numpy();
+    PyEval_SaveThread();
+    initialized = true;
+  }
+}
+
+constexpr int64_t kLength = 1 << 20;
+constexpr int kNumColumns = 8;
+
+static void AbortIfPyError() {
+  if (PyErr_Occurred()) {
+    PyErr_Print();
+    std::abort();
+  }
+}
+
+// ----------------------------------------------------------------------
+// Arrow -> pandas
+
+template <typename ArrowType>
+static std::shared_ptr<Array> MakePrimitiveArray(int64_t length, double null_percent) {
+  using T = typename ArrowType::c_type;
+  std::vector<int64_t> draws;
+  test::randint<int64_t>(length, 0, 1 << 16, &draws);
+  std::vector<T> values(draws.begin(), draws.end());
+
+  std::shared_ptr<Array> arr;
+  if (null_percent > 0) {
+    std::vector<bool> is_valid;
+    test::random_is_valid(length, null_percent, &is_valid);
+    ArrayFromVector<ArrowType, T>(is_valid, values, &arr);
+  } else {
+    ArrayFromVector<ArrowType, T>(values, &arr);
+  }
+  return arr;
+}
+
+static std::shared_ptr<Array> MakeStringArray(int64_t length, double null_percent) {
+  std::vector<int64_t> draws;
+  test::randint<int64_t>(length, 0, 1 << 16, &draws);
+  std::vector<std::string> values;
+  for (int64_t draw : draws) {
+    values.push_back(std::to_string(draw));
+  }
+
+  std::shared_ptr<Array> arr;
+  if (null_percent > 0) {
+    std::vector<bool> is_valid;
+    test::random_is_valid(length, null_percent, &is_valid);
+    ArrayFromVector<StringType, std::string>(is_valid, values, &arr);
+  } else {
+    ArrayFromVector<StringType, std::string>(values, &arr);
+  }
+  return arr;
+}
+
+static std::shared_ptr<Table> MakeTable(const std::shared_ptr<Array>& column) {
+  std::vector<std::shared_ptr<Field>> fields;
+  std::vector<std::shared_ptr<Array>> arrays;
+  for (int i = 0; i < kNumColumns; ++i) {
+    fields.push_back(field("f" + std::to_string(i), column->type()));
+    arrays.push_back(column);
+  }
+  return Table::Make(schema(fields), arrays);
+}
+
+static void BenchConvertTableToPandas(benchmark::State& state,  // NOLINT non-const ref
+                                      const std::shared_ptr<Array>& column,
+                                      int64_t value_size) {
+  InitializePython();
+  auto table = MakeTable(column);
+  const int nthreads = static_cast<int>(state.range(1));
+
+  while (state.KeepRunning()) {
+    PyObject* out;
+    ABORT_NOT_OK(ConvertTableToPandas(PandasOptions(), table, nthreads,
+                                      default_memory_pool(), &out));
+    PyAcquireGIL lock;
+    Py_DECREF(out);
+  }
+  const int64_t num_values = state.iterations() * kNumColumns * column->length();
+  state.SetItemsProcessed(num_values);
+  state.SetBytesProcessed(num_values * value_size);
+}
+
+static void BM_ConvertTableToPandasInt64(
+    benchmark::State& state) {  // NOLINT non-const reference
+  const double null_percent = static_cast<double>(state.range(0)) / 100;
+  BenchConvertTableToPandas(state, MakePrimitiveArray<Int64Type>(kLength, null_percent),
+                            sizeof(int64_t));
+}
+
+static void BM_ConvertTableToPandasDouble(
+    benchmark::State& state) {  // NOLINT non-const reference
+  const double null_percent = static_cast<double>(state.range(0)) / 100;
+  BenchConvertTableToPandas(state, MakePrimitiveArray<DoubleType>(kLength, null_percent),
+                            sizeof(double));
+}
+
+static void BM_ConvertTableToPandasString(
+    benchmark::State& state) {  // NOLINT non-const reference
+  const double null_percent = static_cast<double>(state.range(0)) / 100;
+  auto column = MakeStringArray(kLength / 8, null_percent);
+  const auto& strings = static_cast<const StringArray&>(*column);
+  BenchConvertTableToPandas(state, column,
+                            strings.value_offset(strings.length()) / strings.length());
+}
+
+// ----------------------------------------------------------------------
+// NumPy -> Arrow
+
+// Create a 1-D ndarray with random values and, if null_percent > 0, a boolean
+// mask (True is null)
+template <int NPY_TYPE, typename T>
+static void MakeNdarray(int64_t length, double null_percent, OwnedRefNoGIL* values,
+                        OwnedRefNoGIL* mask) {
+  PyAcquireGIL lock;
+  npy_intp dims[1] = {length};
+  values->reset(PyArray_SimpleNew(1, dims, NPY_TYPE));
+  AbortIfPyError();
+
+  std::vector<int64_t> draws;
+  test::randint<int64_t>(length, 0, 1 << 16, &draws);
+  auto data = reinterpret_cast<T*>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject*>(values->obj())));
+  for (int64_t i = 0; i < length; ++i) {
+    data[i] = static_cast<T>(draws[i]);
+  }
+
+  if (null_percent > 0) {
+    mask->reset(PyArray_SimpleNew(1, dims, NPY_BOOL));
+    AbortIfPyError();
+    test::random_null_bytes(
+        length, null_percent,
+        reinterpret_cast<uint8_t*>(
+            PyArray_DATA(reinterpret_cast<PyArrayObject*>(mask->obj()))));
+  } else {
+    Py_INCREF(Py_None);
+    mask->reset(Py_None);
+  }
+}
+
+template <int NPY_TYPE, typename T>
+static void BenchNdarrayToArrow(benchmark::State& state,  // NOLINT non-const reference
+                                const std::shared_ptr<DataType>& type) {
+  InitializePython();
+  const double null_percent = static_cast<double>(state.range(0)) / 100;
+  OwnedRefNoGIL values, mask;
+  MakeNdarray<NPY_TYPE, T>(kLength, null_percent, &values, &mask);
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<ChunkedArray> out;
+    ABORT_NOT_OK(NdarrayToArrow(default_memory_pool(), values.obj(), mask.obj(), false,
+                                type, &out));
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+  state.SetBytesProcessed(state.iterations() * kLength * sizeof(T));
+}
+
+static void BM_NdarrayToArrowInt64(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchNdarrayToArrow<NPY_INT64, int64_t>(state, int64());
+}
+
+static void BM_NdarrayToArrowDouble(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchNdarrayToArrow<NPY_FLOAT64, double>(state, float64());
+}
+
+static void BM_NdarrayToArrowDoubleToInt32(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchNdarrayToArrow<NPY_FLOAT64, double>(state, int32());
+}
+
+// ----------------------------------------------------------------------
+// Python sequences -> Arrow
+
+enum class PyValueKind { INT, FLOAT, STRING };
+
+// Create a list of Python objects of the given kind where about null_percent
+// of the entries are None
+static PyObject* MakePyList(PyValueKind kind, int64_t length, double null_percent) {
+  std::vector<int64_t> draws;
+  test::randint<int64_t>(length, 0, 1 << 16, &draws);
+  std::vector<bool> is_valid;
+  test::random_is_valid(length, null_percent, &is_valid);
+
+  PyObject* list = PyList_New(length);
+  AbortIfPyError();
+  for (int64_t i = 0; i < length; ++i) {
+    PyObject* item;
+    if (!is_valid[i]) {
+      Py_INCREF(Py_None);
+      item = Py_None;
+    } else if (kind == PyValueKind::INT) {
+      item = PyLong_FromLongLong(draws[i]);
+    } else if (kind == PyValueKind::FLOAT) {
+      item = PyFloat_FromDouble(static_cast<double>(draws[i]));
+    } else {
+      const std::string value = std::to_string(draws[i]);
+      item = PyUnicode_FromStringAndSize(value.data(), value.size());
+    }
+    AbortIfPyError();
+    PyList_SET_ITEM(list, i, item);
+  }
+  return list;
+}
+
+static void BenchConvertPySequence(benchmark::State& state,  // NOLINT non-const ref
+                                   PyValueKind kind) {
+  InitializePython();
+  const double null_percent = static_cast<double>(state.range(0)) / 100;
+  const int64_t length = kLength / 4;
+  OwnedRefNoGIL list;
+  {
+    PyAcquireGIL lock;
+    list.reset(MakePyList(kind, length, null_percent));
+  }
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<Array> out;
+    ABORT_NOT_OK(ConvertPySequence(list.obj(), default_memory_pool(), &out));
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+
+static void BM_ConvertPySequenceInt(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchConvertPySequence(state, PyValueKind::INT);
+}
+
+static void BM_ConvertPySequenceFloat(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchConvertPySequence(state, PyValueKind::FLOAT);
+}
+
+static void BM_ConvertPySequenceString(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchConvertPySequence(state, PyValueKind::STRING);
+}
+
+// ----------------------------------------------------------------------
+// Serialization of Python objects
+
+// A list of 16 float64 ndarrays, so throughput is dominated by the tensors
+static PyObject* MakeNdarrayList(int64_t length) {
+  const int num_arrays = 16;
+  PyObject* list = PyList_New(num_arrays);
+  AbortIfPyError();
+  for (int i = 0; i < num_arrays; ++i) {
+    npy_intp dims[1] = {length / num_arrays};
+    PyObject* arr = PyArray_ZEROS(1, dims, NPY_FLOAT64, 0);
+    AbortIfPyError();
+    PyList_SET_ITEM(list, i, arr);
+  }
+  return list;
+}
+
+// Returns the number of Python objects or bytes processed per iteration
+static int64_t MakeSerializationInput(int64_t kind, OwnedRefNoGIL* out,
+                                      bool* is_bytes) {
+  PyAcquireGIL lock;
+  PyObject* value;
+  int64_t size;
+  *is_bytes = false;
+  switch (kind) {
+    case 0:
+      value = MakePyList(PyValueKind::INT, kLength / 4, 0.1);
+      size = kLength / 4;
+      break;
+    case 1:
+      value = MakePyList(PyValueKind::STRING, kLength / 4, 0.1);
+      size = kLength / 4;
+      break;
+    default:
+      value = MakeNdarrayList(kLength);
+      size = kLength * static_cast<int64_t>(sizeof(double));
+      *is_bytes = true;
+      break;
+  }
+  // SerializeObject expects the object wrapped in a list, as pyarrow does
+  out->reset(PyList_New(1));
+  PyList_SET_ITEM(out->obj(), 0, value);
+  return size;
+}
+
+static void BM_SerializeObject(benchmark::State& state) {  // NOLINT non-const reference
+  InitializePython();
+  OwnedRefNoGIL value;
+  bool is_bytes;
+  const int64_t size = MakeSerializationInput(state.range(0), &value, &is_bytes);
+
+  while (state.KeepRunning()) {
+    SerializedPyObject serialized;
+    ABORT_NOT_OK(SerializeObject(Py_None, value.obj(), &serialized));
+  }
+  if (is_bytes) {
+    state.SetBytesProcessed(state.iterations() * size);
+  } else {
+    state.SetItemsProcessed(state.iterations() * size);
+  }
+}
+
+static void BM_DeserializeObject(benchmark::State& state) {  // NOLINT non-const ref
+  InitializePython();
+  OwnedRefNoGIL value;
+  bool is_bytes;
+  const int64_t size = MakeSerializationInput(state.range(0), &value, &is_bytes);
+  SerializedPyObject serialized;
+  ABORT_NOT_OK(SerializeObject(Py_None, value.obj(), &serialized));
+
+  while (state.KeepRunning()) {
+    PyObject* out;
+    ABORT_NOT_OK(DeserializeObject(Py_None, serialized, Py_None, &out));
+    PyAcquireGIL lock;
+    Py_DECREF(out);
+  }
+  if (is_bytes) {
+    state.SetBytesProcessed(state.iterations() * size);
+  } else {
+    state.SetItemsProcessed(state.iterations() * size);
+  }
+}
+
+// Arguments are the null percentage and, for pandas conversion, the number
+// of threads
+#define ADD_PANDAS_ARGS(WHAT)         \
+  WHAT->Args({0, 1})                  \
+      ->Args({10, 1})                 \
+      ->Args({0, 4})                  \
+      ->Args({10, 4})                 \
+      ->MinTime(1.0)                  \
+      ->Unit(benchmark::kMicrosecond) \
+      ->UseRealTime()
+
+#define ADD_NULL_ARGS(WHAT)           \
+  WHAT->Arg(0)                        \
+      ->Arg(10)                       \
+      ->Arg(50)                       \
+      ->MinTime(1.0)                  \
+      ->Unit(benchmark::kMicrosecond) \
+      ->UseRealTime()
+
+ADD_PANDAS_ARGS(BENCHMARK(BM_ConvertTableToPandasInt64));
+ADD_PANDAS_ARGS(BENCHMARK(BM_ConvertTableToPandasDouble));
+ADD_PANDAS_ARGS(BENCHMARK(BM_ConvertTableToPandasString));
+
+ADD_NULL_ARGS(BENCHMARK(BM_NdarrayToArrowInt64));
+ADD_NULL_ARGS(BENCHMARK(BM_NdarrayToArrowDouble));
+ADD_NULL_ARGS(BENCHMARK(BM_NdarrayToArrowDoubleToInt32));
+
+ADD_NULL_ARGS(BENCHMARK(BM_ConvertPySequenceInt));
+ADD_NULL_ARGS(BENCHMARK(BM_ConvertPySequenceFloat));
+ADD_NULL_ARGS(BENCHMARK(BM_ConvertPySequenceString));
+
+// Argument is the kind of object: list of ints, list of strings, ndarrays
+BENCHMARK(BM_SerializeObject)
+    ->DenseRange(0, 2)
+    ->MinTime(1.0)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_DeserializeObject)
+    ->DenseRange(0, 2)
+    ->MinTime(1.0)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+}  // namespace py
+}  // namespace arrow
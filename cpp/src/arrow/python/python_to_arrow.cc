@@ -18,7 +18,9 @@
 #include "arrow/python/python_to_arrow.h"
 #include "arrow/python/numpy_interop.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -32,11 +34,13 @@
 #include "arrow/builder.h"
 #include "arrow/io/interfaces.h"
 #include "arrow/io/memory.h"
+#include "arrow/ipc/util.h"
 #include "arrow/ipc/writer.h"
 #include "arrow/memory_pool.h"
 #include "arrow/record_batch.h"
 #include "arrow/tensor.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/parallel.h"
 
 #include "arrow/python/common.h"
 #include "arrow/python/helpers.h"
@@ -46,6 +50,10 @@
 
 constexpr int32_t kMaxRecursionDepth = 100;
 
+// bytes objects at least this large are referenced as buffers instead of
+// being copied into the binary child array
+constexpr int64_t kMinZeroCopyBytesSize = 1 << 16;
+
 namespace arrow {
 namespace py {
 
@@ -68,6 +76,16 @@ class SequenceBuilder {
         date64s_(::arrow::date64(), pool),
         tensor_indices_(::arrow::int32(), pool),
         buffer_indices_(::arrow::int32(), pool),
+        bytes_buffer_indices_(::arrow::int32(), pool),
+        memoryview_indices_(::arrow::int32(), pool),
+        pyarray_typecodes_(::arrow::int8(), pool),
+        pyarray_indices_(::arrow::int32(), pool),
+        int_lists_(pool, std::unique_ptr<ArrayBuilder>(new Int64Builder(pool))),
+        int_tuples_(pool, std::unique_ptr<ArrayBuilder>(new Int64Builder(pool))),
+        double_lists_(pool, std::unique_ptr<ArrayBuilder>(new DoubleBuilder(pool))),
+        double_tuples_(pool, std::unique_ptr<ArrayBuilder>(new DoubleBuilder(pool))),
+        string_lists_(pool, std::unique_ptr<ArrayBuilder>(new StringBuilder(pool))),
+        string_tuples_(pool, std::unique_ptr<ArrayBuilder>(new StringBuilder(pool))),
         list_offsets_({0}),
         tuple_offsets_({0}),
         dict_offsets_({0}),
@@ -159,6 +177,55 @@ class SequenceBuilder {
     return buffer_indices_.Append(buffer_index);
   }
 
+  /// Appending a bytes object referenced as a buffer to the sequence
+  ///
+  /// \param buffer_index Index of the buffer in the object.
+  Status AppendBytesBuffer(const int32_t buffer_index) {
+    RETURN_NOT_OK(Update(bytes_buffer_indices_.length(), &bytes_buffer_tag_));
+    return bytes_buffer_indices_.Append(buffer_index);
+  }
+
+  /// Appending a memoryview referenced as a buffer to the sequence
+  ///
+  /// \param buffer_index Index of the buffer in the object.
+  Status AppendMemoryView(const int32_t buffer_index) {
+    RETURN_NOT_OK(Update(memoryview_indices_.length(), &memoryview_tag_));
+    return memoryview_indices_.Append(buffer_index);
+  }
+
+  /// Appending an array.array referenced as a buffer to the sequence
+  ///
+  /// \param typecode The array.array typecode character.
+  /// \param buffer_index Index of the buffer in the object.
+  Status AppendPyArray(const char typecode, const int32_t buffer_index) {
+    RETURN_NOT_OK(Update(pyarray_indices_.length(), &pyarray_tag_));
+    RETURN_NOT_OK(pyarray_typecodes_.Append(static_cast<int8_t>(typecode)));
+    return pyarray_indices_.Append(buffer_index);
+  }
+
+  /// Append a list or tuple whose elements are all ints fitting in int64. It
+  /// is stored as one slot of a list<int64> child rather than as a nested
+  /// sequence with one union slot per element. The elements must then be
+  /// appended to *values.
+  Status AppendInt64Sequence(bool is_tuple, Int64Builder** values) {
+    return is_tuple ? AppendTypedSequence(&int_tuple_tag_, &int_tuples_, values)
+                    : AppendTypedSequence(&int_list_tag_, &int_lists_, values);
+  }
+
+  /// Append a list or tuple whose elements are all floats, see
+  /// AppendInt64Sequence
+  Status AppendDoubleSequence(bool is_tuple, DoubleBuilder** values) {
+    return is_tuple ? AppendTypedSequence(&double_tuple_tag_, &double_tuples_, values)
+                    : AppendTypedSequence(&double_list_tag_, &double_lists_, values);
+  }
+
+  /// Append a list or tuple whose elements are all unicode strings, see
+  /// AppendInt64Sequence
+  Status AppendStringSequence(bool is_tuple, StringBuilder** values) {
+    return is_tuple ? AppendTypedSequence(&string_tuple_tag_, &string_tuples_, values)
+                    : AppendTypedSequence(&string_list_tag_, &string_lists_, values);
+  }
+
   /// Add a sublist to the sequence. The data contained in the sublist will be
   /// specified in the "Finish" method.
   ///
@@ -196,6 +263,14 @@ class SequenceBuilder {
     return Status::OK();
   }
 
+  template <typename ValueBuilderType>
+  Status AppendTypedSequence(int8_t* tag, ListBuilder* out, ValueBuilderType** values) {
+    RETURN_NOT_OK(Update(out->length(), tag));
+    RETURN_NOT_OK(out->Append());
+    *values = static_cast<ValueBuilderType*>(out->value_builder());
+    return Status::OK();
+  }
+
   template <typename BuilderType>
   Status AddElement(const int8_t tag, BuilderType* out, const std::string& name = "") {
     if (tag != -1) {
@@ -207,6 +282,23 @@ class SequenceBuilder {
     return Status::OK();
   }
 
+  Status AddPyArrays() {
+    if (pyarray_tag_ != -1) {
+      std::shared_ptr<Array> typecodes, indices;
+      RETURN_NOT_OK(pyarray_typecodes_.Finish(&typecodes));
+      RETURN_NOT_OK(pyarray_indices_.Finish(&indices));
+      auto type = ::arrow::struct_({::arrow::field("typecode", typecodes->type()),
+                                    ::arrow::field("buffer", indices->type())});
+      fields_[pyarray_tag_] = ::arrow::field("", type);
+      std::vector<std::shared_ptr<Array>> fields = {typecodes, indices};
+      children_[pyarray_tag_] =
+          std::make_shared<StructArray>(type, indices->length(), fields);
+      RETURN_NOT_OK(nones_.AppendToBitmap(true));
+      type_ids_.push_back(pyarray_tag_);
+    }
+    return Status::OK();
+  }
+
   Status AddSubsequence(int8_t tag, const Array* data,
                         const std::vector<int32_t>& offsets, const std::string& name) {
     if (data != nullptr) {
@@ -247,6 +339,16 @@ class SequenceBuilder {
     RETURN_NOT_OK(AddElement(date64_tag_, &date64s_));
     RETURN_NOT_OK(AddElement(tensor_tag_, &tensor_indices_, "tensor"));
     RETURN_NOT_OK(AddElement(buffer_tag_, &buffer_indices_, "buffer"));
+    RETURN_NOT_OK(AddElement(bytes_buffer_tag_, &bytes_buffer_indices_, "bytes"));
+    RETURN_NOT_OK(AddElement(memoryview_tag_, &memoryview_indices_, "memoryview"));
+    RETURN_NOT_OK(AddPyArrays());
+
+    RETURN_NOT_OK(AddElement(int_list_tag_, &int_lists_, "list"));
+    RETURN_NOT_OK(AddElement(int_tuple_tag_, &int_tuples_, "tuple"));
+    RETURN_NOT_OK(AddElement(double_list_tag_, &double_lists_, "list"));
+    RETURN_NOT_OK(AddElement(double_tuple_tag_, &double_tuples_, "tuple"));
+    RETURN_NOT_OK(AddElement(string_list_tag_, &string_lists_, "list"));
+    RETURN_NOT_OK(AddElement(string_tuple_tag_, &string_tuples_, "tuple"));
 
     RETURN_NOT_OK(AddSubsequence(list_tag_, list_data, list_offsets_, "list"));
     RETURN_NOT_OK(AddSubsequence(tuple_tag_, tuple_data, tuple_offsets_, "tuple"));
@@ -278,6 +380,17 @@ class SequenceBuilder {
 
   Int32Builder tensor_indices_;
   Int32Builder buffer_indices_;
+  Int32Builder bytes_buffer_indices_;
+  Int32Builder memoryview_indices_;
+  Int8Builder pyarray_typecodes_;
+  Int32Builder pyarray_indices_;
+
+  ListBuilder int_lists_;
+  ListBuilder int_tuples_;
+  ListBuilder double_lists_;
+  ListBuilder double_tuples_;
+  ListBuilder string_lists_;
+  ListBuilder string_tuples_;
 
   std::vector<int32_t> list_offsets_;
   std::vector<int32_t> tuple_offsets_;
@@ -300,6 +413,16 @@ class SequenceBuilder {
 
   int8_t tensor_tag_ = -1;
   int8_t buffer_tag_ = -1;
+  int8_t bytes_buffer_tag_ = -1;
+  int8_t memoryview_tag_ = -1;
+  int8_t pyarray_tag_ = -1;
+
+  int8_t int_list_tag_ = -1;
+  int8_t int_tuple_tag_ = -1;
+  int8_t double_list_tag_ = -1;
+  int8_t double_tuple_tag_ = -1;
+  int8_t string_list_tag_ = -1;
+  int8_t string_tuple_tag_ = -1;
   int8_t list_tag_ = -1;
   int8_t tuple_tag_ = -1;
   int8_t dict_tag_ = -1;
@@ -400,6 +523,20 @@ Status CallDeserializeCallback(PyObject* context, PyObject* value,
   return CallCustomCallback(context, method_name.obj(), value, deserialized_object);
 }
 
+// Whether the context has a handler for the type of elem or one of its base
+// classes, which _serialize_callback would use
+Status HasSerializeHandler(PyObject* context, PyObject* elem, bool* out) {
+  *out = false;
+  if (context == Py_None) {
+    return Status::OK();
+  }
+  OwnedRef method_name(PyUnicode_FromString("_has_serialize_handler"));
+  OwnedRef result(PyObject_CallMethodObjArgs(context, method_name.obj(), elem, NULL));
+  RETURN_IF_PYERROR();
+  *out = PyObject_IsTrue(result.obj()) == 1;
+  return Status::OK();
+}
+
 Status SerializeDict(PyObject* context, std::vector<PyObject*> dicts,
                      int32_t recursion_depth, std::shared_ptr<Array>* out,
                      SerializedPyObject* blobs_out);
@@ -452,6 +589,164 @@ Status AppendScalar(PyObject* obj, SequenceBuilder* builder) {
   return builder->AppendInt64(value);
 }
 
+enum class HomogeneousKind { NONE, INT64, DOUBLE, STRING };
+
+// Determine whether all elements of a list or tuple are exactly Python ints
+// fitting in int64, floats, or unicode strings
+HomogeneousKind GetHomogeneousKind(PyObject* sequence) {
+  const Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+  if (size == 0) {
+    return HomogeneousKind::NONE;
+  }
+  PyObject** items = PySequence_Fast_ITEMS(sequence);
+
+  HomogeneousKind kind;
+  if (PyLong_CheckExact(items[0])) {
+    kind = HomogeneousKind::INT64;
+  } else if (PyFloat_CheckExact(items[0])) {
+    kind = HomogeneousKind::DOUBLE;
+#if PY_MAJOR_VERSION >= 3
+  } else if (PyUnicode_CheckExact(items[0])) {
+    kind = HomogeneousKind::STRING;
+#endif
+  } else {
+    return HomogeneousKind::NONE;
+  }
+
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    PyObject* item = items[i];
+    switch (kind) {
+      case HomogeneousKind::INT64: {
+        if (!PyLong_CheckExact(item)) {
+          return HomogeneousKind::NONE;
+        }
+        int overflow = 0;
+        PyLong_AsLongLongAndOverflow(item, &overflow);
+        if (overflow) {
+          return HomogeneousKind::NONE;
+        }
+      } break;
+      case HomogeneousKind::DOUBLE:
+        if (!PyFloat_CheckExact(item)) {
+          return HomogeneousKind::NONE;
+        }
+        break;
+      default:
+        if (!PyUnicode_CheckExact(item)) {
+          return HomogeneousKind::NONE;
+        }
+        break;
+    }
+  }
+  return kind;
+}
+
+// Append a list or tuple of elements of the given kind as a single typed slot
+Status AppendHomogeneousSequence(PyObject* sequence, HomogeneousKind kind, bool is_tuple,
+                                 SequenceBuilder* builder) {
+  const Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+  PyObject** items = PySequence_Fast_ITEMS(sequence);
+  switch (kind) {
+    case HomogeneousKind::INT64: {
+      Int64Builder* values;
+      RETURN_NOT_OK(builder->AppendInt64Sequence(is_tuple, &values));
+      RETURN_NOT_OK(values->Reserve(size));
+      for (Py_ssize_t i = 0; i < size; ++i) {
+        RETURN_NOT_OK(values->Append(PyLong_AsLongLong(items[i])));
+      }
+    } break;
+    case HomogeneousKind::DOUBLE: {
+      DoubleBuilder* values;
+      RETURN_NOT_OK(builder->AppendDoubleSequence(is_tuple, &values));
+      RETURN_NOT_OK(values->Reserve(size));
+      for (Py_ssize_t i = 0; i < size; ++i) {
+        RETURN_NOT_OK(values->Append(PyFloat_AS_DOUBLE(items[i])));
+      }
+    } break;
+    case HomogeneousKind::STRING: {
+      StringBuilder* values;
+      RETURN_NOT_OK(builder->AppendStringSequence(is_tuple, &values));
+      RETURN_NOT_OK(values->Reserve(size));
+      for (Py_ssize_t i = 0; i < size; ++i) {
+        // Only Python 3 str sequences are detected as homogeneous
+        Py_ssize_t length = 0;
+        const char* data = nullptr;
+#if PY_MAJOR_VERSION >= 3
+        data = PyUnicode_AsUTF8AndSize(items[i], &length);
+        RETURN_IF_PYERROR();
+#endif
+        if (length > std::numeric_limits<int32_t>::max()) {
+          return Status::Invalid("Cannot writes bytes over 2GB");
+        }
+        RETURN_NOT_OK(values->Append(data, static_cast<int32_t>(length)));
+      }
+    } break;
+    default:
+      DCHECK(false) << "sequence is not homogeneous";
+  }
+  return Status::OK();
+}
+
+// Append a contiguous memoryview or array.array without copying its data, if
+// possible. *appended is set to false if elem is neither, or if its type has
+// a handler registered in the context, which then takes precedence.
+Status AppendBufferLike(PyObject* context, PyObject* elem, SequenceBuilder* builder,
+                        SerializedPyObject* blobs_out, bool* appended) {
+  *appended = false;
+  bool has_handler = false;
+  if (PyMemoryView_Check(elem)) {
+    Py_buffer* view = PyMemoryView_GET_BUFFER(elem);
+    // Only plain byte views round-trip through a flat buffer
+    if (view->ndim > 1 || (view->format != nullptr && strcmp(view->format, "B") != 0) ||
+        !PyBuffer_IsContiguous(view, 'C')) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(HasSerializeHandler(context, elem, &has_handler));
+    if (has_handler) {
+      return Status::OK();
+    }
+    std::shared_ptr<Buffer> buffer;
+    RETURN_NOT_OK(PyBuffer::FromPyObject(elem, &buffer));
+    RETURN_NOT_OK(
+        builder->AppendMemoryView(static_cast<int32_t>(blobs_out->buffers.size())));
+    blobs_out->buffers.push_back(buffer);
+    *appended = true;
+    return Status::OK();
+  }
+
+  static PyObject* array_type = nullptr;
+  if (array_type == nullptr) {
+    OwnedRef array_module(PyImport_ImportModule("array"));
+    if (array_module.obj() == nullptr) {
+      PyErr_Clear();
+      return Status::OK();
+    }
+    array_type = PyObject_GetAttrString(array_module.obj(), "array");
+    RETURN_IF_PYERROR();
+  }
+  if (!PyObject_TypeCheck(elem, reinterpret_cast<PyTypeObject*>(array_type))) {
+    return Status::OK();
+  }
+  RETURN_NOT_OK(HasSerializeHandler(context, elem, &has_handler));
+  if (has_handler) {
+    return Status::OK();
+  }
+
+  OwnedRef typecode(PyObject_GetAttrString(elem, "typecode"));
+  RETURN_IF_PYERROR();
+  PyObjectStringify typecode_str(typecode.obj());
+  if (typecode_str.size != 1) {
+    return Status::OK();
+  }
+  std::shared_ptr<Buffer> buffer;
+  RETURN_NOT_OK(PyBuffer::FromPyObject(elem, &buffer));
+  RETURN_NOT_OK(builder->AppendPyArray(typecode_str.bytes[0],
+                                       static_cast<int32_t>(blobs_out->buffers.size())));
+  blobs_out->buffers.push_back(buffer);
+  *appended = true;
+  return Status::OK();
+}
+
 Status Append(PyObject* context, PyObject* elem, SequenceBuilder* builder,
               std::vector<PyObject*>* sublists, std::vector<PyObject*>* subtuples,
               std::vector<PyObject*>* subdicts, std::vector<PyObject*>* subsets,
@@ -484,6 +779,15 @@ Status Append(PyObject* context, PyObject* elem, SequenceBuilder* builder,
   } else if (PyBytes_Check(elem)) {
     auto data = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(elem));
     const int64_t size = static_cast<int64_t>(PyBytes_GET_SIZE(elem));
+    if (size >= kMinZeroCopyBytesSize) {
+      // Reference the bytes object memory rather than copying it
+      std::shared_ptr<Buffer> buffer;
+      RETURN_NOT_OK(PyBuffer::FromPyObject(elem, &buffer));
+      RETURN_NOT_OK(
+          builder->AppendBytesBuffer(static_cast<int32_t>(blobs_out->buffers.size())));
+      blobs_out->buffers.push_back(buffer);
+      return Status::OK();
+    }
     if (size > std::numeric_limits<int32_t>::max()) {
       return Status::Invalid("Cannot writes bytes over 2GB");
     }
@@ -502,14 +806,24 @@ Status Append(PyObject* context, PyObject* elem, SequenceBuilder* builder,
     }
     RETURN_NOT_OK(builder->AppendString(data, static_cast<int32_t>(size)));
   } else if (PyList_Check(elem)) {
-    RETURN_NOT_OK(builder->AppendList(PyList_Size(elem)));
-    sublists->push_back(elem);
+    HomogeneousKind kind = GetHomogeneousKind(elem);
+    if (kind != HomogeneousKind::NONE) {
+      RETURN_NOT_OK(AppendHomogeneousSequence(elem, kind, false, builder));
+    } else {
+      RETURN_NOT_OK(builder->AppendList(PyList_Size(elem)));
+      sublists->push_back(elem);
+    }
   } else if (PyDict_CheckExact(elem)) {
     RETURN_NOT_OK(builder->AppendDict(PyDict_Size(elem)));
     subdicts->push_back(elem);
   } else if (PyTuple_CheckExact(elem)) {
-    RETURN_NOT_OK(builder->AppendTuple(PyTuple_Size(elem)));
-    subtuples->push_back(elem);
+    HomogeneousKind kind = GetHomogeneousKind(elem);
+    if (kind != HomogeneousKind::NONE) {
+      RETURN_NOT_OK(AppendHomogeneousSequence(elem, kind, true, builder));
+    } else {
+      RETURN_NOT_OK(builder->AppendTuple(PyTuple_Size(elem)));
+      subtuples->push_back(elem);
+    }
   } else if (PySet_Check(elem)) {
     RETURN_NOT_OK(builder->AppendSet(PySet_Size(elem)));
     subsets->push_back(elem);
@@ -529,6 +843,11 @@ Status Append(PyObject* context, PyObject* elem, SequenceBuilder* builder,
     RETURN_NOT_OK(unwrap_buffer(elem, &buffer));
     blobs_out->buffers.push_back(buffer);
   } else {
+    bool appended = false;
+    RETURN_NOT_OK(AppendBufferLike(context, elem, builder, blobs_out, &appended));
+    if (appended) {
+      return Status::OK();
+    }
     // Attempt to serialize the object using the custom callback.
     PyObject* serialized_object;
     // The reference count of serialized_object will be decremented in SerializeDict
@@ -736,6 +1055,84 @@ Status SerializedPyObject::WriteTo(io::OutputStream* dst) {
   return Status::OK();
 }
 
+Status SerializedPyObject::WriteTo(const std::shared_ptr<Buffer>& dst, int nthreads) {
+  int32_t num_tensors = static_cast<int32_t>(this->tensors.size());
+  int32_t num_buffers = static_cast<int32_t>(this->buffers.size());
+
+  // The header and the record batch describing the object structure are
+  // small, write them on this thread
+  io::FixedSizeBufferWriter header_writer(dst);
+  RETURN_NOT_OK(header_writer.Write(reinterpret_cast<const uint8_t*>(&num_tensors),
+                                    sizeof(int32_t)));
+  RETURN_NOT_OK(header_writer.Write(reinterpret_cast<const uint8_t*>(&num_buffers),
+                                    sizeof(int32_t)));
+  RETURN_NOT_OK(ipc::WriteRecordBatchStream({this->batch}, &header_writer));
+
+  int64_t position;
+  RETURN_NOT_OK(header_writer.Tell(&position));
+
+  // Lay out the tensors and buffers as WriteTo(io::OutputStream*) would.
+  // Tensors are aligned, so the padding in front of each one is written here
+  // and each tensor is then written at an aligned offset of its own slice
+  const int num_tasks = num_tensors + num_buffers;
+  std::vector<int64_t> offsets(num_tasks);
+  std::vector<int64_t> sizes(num_tasks);
+
+  int32_t metadata_length;
+  int64_t body_length;
+  for (int i = 0; i < num_tensors; ++i) {
+    const int64_t padded_position = ipc::PaddedLength(position);
+    if (padded_position > dst->size()) {
+      return Status::Invalid("Destination buffer too small for serialized object");
+    }
+    std::memset(dst->mutable_data() + position, 0, padded_position - position);
+
+    io::MockOutputStream mock;
+    RETURN_NOT_OK(ipc::WriteTensor(*this->tensors[i], &mock, &metadata_length,
+                                   &body_length));
+    offsets[i] = padded_position;
+    sizes[i] = mock.GetExtentBytesWritten();
+    position = padded_position + sizes[i];
+  }
+
+  for (int i = 0; i < num_buffers; ++i) {
+    offsets[num_tensors + i] = position;
+    sizes[num_tensors + i] = sizeof(int64_t) + this->buffers[i]->size();
+    position += sizes[num_tensors + i];
+  }
+
+  if (position > dst->size()) {
+    return Status::Invalid("Destination buffer too small for serialized object");
+  }
+
+  // With fewer components than threads, split the copies themselves
+  const int memcopy_threads = std::max(1, nthreads / std::max(1, num_tasks));
+
+  auto WriteComponent = [&](int i) {
+    io::FixedSizeBufferWriter writer(SliceMutableBuffer(dst, offsets[i], sizes[i]));
+    writer.set_memcopy_threads(memcopy_threads);
+    if (i < num_tensors) {
+      int32_t tensor_metadata_length;
+      int64_t tensor_body_length;
+      return ipc::WriteTensor(*this->tensors[i], &writer, &tensor_metadata_length,
+                              &tensor_body_length);
+    }
+    const auto& buffer = this->buffers[i - num_tensors];
+    int64_t size = buffer->size();
+    RETURN_NOT_OK(writer.Write(reinterpret_cast<const uint8_t*>(&size), sizeof(int64_t)));
+    return writer.Write(buffer->data(), size);
+  };
+
+  nthreads = std::min(nthreads, num_tasks);
+  if (nthreads <= 1) {
+    for (int i = 0; i < num_tasks; ++i) {
+      RETURN_NOT_OK(WriteComponent(i));
+    }
+    return Status::OK();
+  }
+  return ParallelFor(nthreads, num_tasks, WriteComponent);
+}
+
 Status SerializedPyObject::GetComponents(MemoryPool* memory_pool, PyObject** out) {
   PyAcquireGIL py_gil;
 
@@ -52,6 +52,17 @@ struct ARROW_EXPORT SerializedPyObject {
   /// \return Status
   Status WriteTo(io::OutputStream* dst);
 
+  /// \brief Write serialized Python object to a preallocated buffer, copying
+  /// the tensors and buffers on multiple threads
+  ///
+  /// The output is identical to that of WriteTo(io::OutputStream*).
+  /// \param[in] dst a mutable Buffer at least as large as the number of bytes
+  /// written by WriteTo(io::OutputStream*), e.g. as counted by an
+  /// io::MockOutputStream
+  /// \param[in] nthreads number of threads to use for copying
+  /// \return Status
+  Status WriteTo(const std::shared_ptr<Buffer>& dst, int nthreads);
+
   /// \brief Convert SerializedPyObject to a dict containing the message
   /// components as Buffer instances with minimal memory allocation
   ///
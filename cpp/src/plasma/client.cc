@@ -24,10 +24,13 @@
 #endif
 
 #include <assert.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
@@ -42,9 +45,17 @@
 #include <vector>
 
 #include "arrow/buffer.h"
+#include "arrow/builder.h"
+#include "arrow/io/memory.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/record_batch.h"
+#include "arrow/table.h"
+#include "arrow/tensor.h"
 #include "plasma/common.h"
 #include "plasma/fling.h"
 #include "plasma/io.h"
+#include "plasma/notification_ring.h"
 #include "plasma/plasma.h"
 #include "plasma/protocol.h"
 
@@ -69,8 +80,12 @@ using arrow::MutableBuffer;
 // Number of threads used for memcopy and hash computations.
 constexpr int64_t kThreadPoolSize = 8;
 constexpr int64_t kBytesInMB = 1 << 20;
+/// The maximum number of digests that a client caches, see CacheDigest.
+constexpr size_t kMaxCachedDigests = 1 << 16;
 static std::vector<std::thread> threadpool_(kThreadPoolSize);
 
+class ObjectHasher;
+
 struct ObjectInUseEntry {
   /// A count of the number of times this client has called PlasmaClient::Create
   /// or
@@ -83,6 +98,9 @@ struct ObjectInUseEntry {
   PlasmaObject object;
   /// A flag representing whether the object has been sealed.
   bool is_sealed;
+  /// Hashes the data of an unsealed object as it is written, see
+  /// DigestMode::INCREMENTAL.
+  std::shared_ptr<ObjectHasher> hasher;
 };
 
 #ifdef PLASMA_GPU
@@ -100,7 +118,7 @@ static std::unordered_map<ObjectID, GpuProcessHandle*, UniqueIDHasher> gpu_objec
 static std::mutex gpu_mutex;
 #endif
 
-PlasmaClient::PlasmaClient() {
+PlasmaClient::PlasmaClient() : async_get_conn_(-1), next_async_get_id_(0) {
 #ifdef PLASMA_GPU
   CudaDeviceManager::GetInstance(&manager_);
 #endif
@@ -183,6 +201,8 @@ Status PlasmaClient::Create(const ObjectID& object_id, int64_t data_size,
                             std::shared_ptr<Buffer>* data, int device_num) {
   ARROW_LOG(DEBUG) << "called plasma_create on conn " << store_conn_ << " with size "
                    << data_size << " and metadata size " << metadata_size;
+  // A cached digest belongs to an object with this ID that has been deleted.
+  digests_.erase(object_id);
   RETURN_NOT_OK(
       SendCreateRequest(store_conn_, object_id, data_size, metadata_size, device_num));
   std::vector<uint8_t> buffer;
@@ -244,6 +264,55 @@ Status PlasmaClient::Create(const ObjectID& object_id, int64_t data_size,
   return Status::OK();
 }
 
+Status PlasmaClient::Create(const ObjectID* object_ids, int64_t num_objects,
+                            const int64_t* data_sizes, uint8_t* const* metadata,
+                            const int64_t* metadata_sizes,
+                            std::shared_ptr<Buffer>* data) {
+  ARROW_LOG(DEBUG) << "called plasma_create on conn " << store_conn_ << " with "
+                   << num_objects << " objects";
+  for (int64_t i = 0; i < num_objects; ++i) {
+    digests_.erase(object_ids[i]);
+  }
+  RETURN_NOT_OK(SendCreateBatchRequest(store_conn_, object_ids, num_objects, data_sizes,
+                                       metadata_sizes));
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaCreateBatchReply, &buffer));
+  std::vector<ObjectID> received_object_ids;
+  std::vector<PlasmaObject> objects;
+  std::vector<int> store_fds;
+  std::vector<int64_t> mmap_sizes;
+  // If the reply included an error, then the store will not send file
+  // descriptors.
+  RETURN_NOT_OK(ReadCreateBatchReply(buffer.data(), buffer.size(), &received_object_ids,
+                                     &objects, &store_fds, &mmap_sizes));
+  ARROW_CHECK(static_cast<int64_t>(objects.size()) == num_objects);
+  for (size_t i = 0; i < store_fds.size(); i++) {
+    int fd = recv_fd(store_conn_);
+    ARROW_CHECK(fd >= 0) << "recv not successful";
+    lookup_or_mmap(fd, store_fds[i], mmap_sizes[i]);
+  }
+  for (int64_t i = 0; i < num_objects; ++i) {
+    PlasmaObject* object = &objects[i];
+    DCHECK(received_object_ids[i] == object_ids[i]);
+    ARROW_CHECK(object->data_size == data_sizes[i]);
+    ARROW_CHECK(object->metadata_size == metadata_sizes[i]);
+    // The metadata should come right after the data.
+    ARROW_CHECK(object->metadata_offset == object->data_offset + data_sizes[i]);
+    data[i] = std::make_shared<MutableBuffer>(
+        lookup_mmapped_file(object->store_fd) + object->data_offset, data_sizes[i]);
+    if (metadata != NULL && metadata[i] != NULL) {
+      // Copy the metadata to the buffer.
+      memcpy(data[i]->mutable_data() + object->data_size, metadata[i],
+             metadata_sizes[i]);
+    }
+    // Like in the single object Create, one count is for the buffer and one is
+    // released when the object is sealed.
+    increment_object_count(object_ids[i], object, false);
+    increment_object_count(object_ids[i], object, false);
+  }
+  return Status::OK();
+}
+
 Status PlasmaClient::Get(const ObjectID* object_ids, int64_t num_objects,
                          int64_t timeout_ms, ObjectBuffer* object_buffers) {
   // Fill out the info for the objects that are already in use locally.
@@ -423,7 +492,10 @@ Status PlasmaClient::UnmapObject(const ObjectID& object_id) {
 /// releasing the object when the client is truly done with the object.
 ///
 /// @param object_id The object ID to attempt to release.
-Status PlasmaClient::PerformRelease(const ObjectID& object_id) {
+/// @param object_ids_to_release The object ID is appended here if the client
+///        no longer uses the object, so that it must be released in the store.
+Status PlasmaClient::PerformRelease(const ObjectID& object_id,
+                                    std::vector<ObjectID>* object_ids_to_release) {
   // Decrement the count of the number of instances of this object that are
   // being used by this client. The corresponding increment should have happened
   // in PlasmaClient::Get.
@@ -433,35 +505,49 @@ Status PlasmaClient::PerformRelease(const ObjectID& object_id) {
   ARROW_CHECK(object_entry->second->count >= 0);
   // Check if the client is no longer using this object.
   if (object_entry->second->count == 0) {
-    // Tell the store that the client no longer needs the object.
+    // The store must be told that the client no longer needs the object.
     RETURN_NOT_OK(UnmapObject(object_id));
-    RETURN_NOT_OK(SendReleaseRequest(store_conn_, object_id));
+    object_ids_to_release->push_back(object_id);
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::SendReleases(const std::vector<ObjectID>& object_ids) {
+  if (object_ids.size() == 1) {
+    return SendReleaseRequest(store_conn_, object_ids[0]);
+  } else if (object_ids.size() > 1) {
+    return SendReleaseBatchRequest(store_conn_, object_ids.data(), object_ids.size());
   }
   return Status::OK();
 }
 
-Status PlasmaClient::Release(const ObjectID& object_id) {
+Status PlasmaClient::Release(const ObjectID& object_id) { return Release(&object_id, 1); }
+
+Status PlasmaClient::Release(const ObjectID* object_ids, int64_t num_objects) {
   // If the client is already disconnected, ignore release requests.
   if (store_conn_ < 0) {
     return Status::OK();
   }
-  // Add the new object to the release history.
-  release_history_.push_front(object_id);
+  // Add the new objects to the release history.
+  for (int64_t i = 0; i < num_objects; ++i) {
+    release_history_.push_front(object_ids[i]);
+  }
   // If there are too many bytes in use by the client or if there are too many
   // pending release calls, and there are at least some pending release calls in
   // the release_history list, then release some objects.
 
   // TODO(wap) Evicition policy only works on host memory, and thus objects
   //           on the GPU cannot be released currently.
+  std::vector<ObjectID> object_ids_to_release;
   while ((in_use_object_bytes_ > std::min(kL3CacheSizeBytes, store_capacity_ / 100) ||
           release_history_.size() > config_.release_delay) &&
          release_history_.size() > 0) {
     // Perform a release for the object ID for the first pending release.
-    RETURN_NOT_OK(PerformRelease(release_history_.back()));
+    RETURN_NOT_OK(PerformRelease(release_history_.back(), &object_ids_to_release));
     // Remove the last entry from the release history.
     release_history_.pop_back();
   }
-  return Status::OK();
+  return SendReleases(object_ids_to_release);
 }
 
 Status PlasmaClient::FlushReleaseHistory() {
@@ -469,13 +555,14 @@ Status PlasmaClient::FlushReleaseHistory() {
   if (store_conn_ < 0) {
     return Status::OK();
   }
+  std::vector<ObjectID> object_ids_to_release;
   while (release_history_.size() > 0) {
     // Perform a release for the object ID for the first pending release.
-    RETURN_NOT_OK(PerformRelease(release_history_.back()));
+    RETURN_NOT_OK(PerformRelease(release_history_.back(), &object_ids_to_release));
     // Remove the last entry from the release history.
     release_history_.pop_back();
   }
-  return Status::OK();
+  return SendReleases(object_ids_to_release);
 }
 
 // This method is used to query whether the plasma store contains an object.
@@ -562,6 +649,153 @@ static uint64_t compute_object_hash(const ObjectBuffer& obj_buffer) {
   return XXH64_digest(&hash_state);
 }
 
+/// Computes the same digest as compute_object_hash from the data of an object
+/// as it is written in order. Large objects are hashed in the chunks that
+/// compute_object_hash_parallel hashes on separate threads.
+class ObjectHasher {
+ public:
+  explicit ObjectHasher(int64_t data_size)
+      : data_size_(data_size),
+        chunk_size_((data_size / BLOCK_SIZE / kThreadPoolSize) * BLOCK_SIZE),
+        chunked_(data_size >= kBytesInMB),
+        position_(0),
+        chunk_(0),
+        chunk_hashes_(kThreadPoolSize + 1) {
+    XXH64_reset(&state_, XXH64_DEFAULT_SEED);
+  }
+
+  void Update(const uint8_t* data, int64_t nbytes) {
+    while (nbytes > 0) {
+      // The chunk after the last full chunk ends with the data.
+      int64_t chunk_end = data_size_;
+      if (chunked_ && chunk_ < kThreadPoolSize) {
+        chunk_end = (chunk_ + 1) * chunk_size_;
+      }
+      int64_t chunk_bytes = std::min(nbytes, chunk_end - position_);
+      XXH64_update(&state_, data, chunk_bytes);
+      data += chunk_bytes;
+      nbytes -= chunk_bytes;
+      position_ += chunk_bytes;
+      if (chunked_ && chunk_ < kThreadPoolSize && position_ == chunk_end) {
+        chunk_hashes_[chunk_++] = XXH64_digest(&state_);
+        XXH64_reset(&state_, XXH64_DEFAULT_SEED);
+      }
+    }
+  }
+
+  /// Whether all of the data has been hashed.
+  bool complete() const { return position_ == data_size_; }
+
+  uint64_t Finish(const uint8_t* metadata, int64_t metadata_size) {
+    DCHECK(complete());
+    if (chunked_) {
+      chunk_hashes_[kThreadPoolSize] = XXH64_digest(&state_);
+      XXH64_reset(&state_, XXH64_DEFAULT_SEED);
+      XXH64_update(&state_, chunk_hashes_.data(),
+                   chunk_hashes_.size() * sizeof(uint64_t));
+    }
+    XXH64_update(&state_, metadata, metadata_size);
+    return XXH64_digest(&state_);
+  }
+
+ private:
+  int64_t data_size_;
+  int64_t chunk_size_;
+  bool chunked_;
+  int64_t position_;
+  int64_t chunk_;
+  std::vector<uint64_t> chunk_hashes_;
+  XXH64_state_t state_;
+};
+
+namespace {
+
+/// Writes the data of an unsealed object in order and hashes it on the way.
+class HashingObjectWriter : public arrow::io::OutputStream {
+ public:
+  HashingObjectWriter(uint8_t* data, int64_t size,
+                      const std::shared_ptr<ObjectHasher>& hasher)
+      : data_(data), size_(size), position_(0), hasher_(hasher) {}
+
+  Status Close() override { return Status::OK(); }
+
+  Status Tell(int64_t* position) const override {
+    *position = position_;
+    return Status::OK();
+  }
+
+  Status Write(const void* data, int64_t nbytes) override {
+    if (position_ + nbytes > size_) {
+      return Status::IOError("Write out of bounds");
+    }
+    memcpy(data_ + position_, data, nbytes);
+    // The data is hashed while it is still in the cache.
+    hasher_->Update(data_ + position_, nbytes);
+    position_ += nbytes;
+    return Status::OK();
+  }
+
+ private:
+  uint8_t* data_;
+  int64_t size_;
+  int64_t position_;
+  std::shared_ptr<ObjectHasher> hasher_;
+};
+
+}  // namespace
+
+void PlasmaClient::SetDigestMode(DigestMode mode) { config_.digest_mode = mode; }
+
+Status PlasmaClient::OpenObjectWriter(const ObjectID& object_id,
+                                      std::shared_ptr<arrow::io::OutputStream>* out) {
+  auto object_entry = objects_in_use_.find(object_id);
+  ARROW_CHECK(object_entry != objects_in_use_.end())
+      << "Plasma client called write on an object without a reference to it";
+  ARROW_CHECK(!object_entry->second->is_sealed)
+      << "Plasma client called write on a sealed object";
+  PlasmaObject* object = &object_entry->second->object;
+  if (object->device_num != 0) {
+    return Status::NotImplemented("Writers for GPU objects are not supported");
+  }
+  uint8_t* data = lookup_mmapped_file(object->store_fd) + object->data_offset;
+  if (config_.digest_mode == DigestMode::INCREMENTAL) {
+    // Writing the data again starts a new digest.
+    auto hasher = std::make_shared<ObjectHasher>(object->data_size);
+    object_entry->second->hasher = hasher;
+    *out = std::make_shared<HashingObjectWriter>(data, object->data_size, hasher);
+  } else {
+    *out = std::make_shared<arrow::io::FixedSizeBufferWriter>(
+        std::make_shared<MutableBuffer>(data, object->data_size));
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::ComputeSealDigest(const ObjectID& object_id,
+                                       ObjectInUseEntry* entry, uint8_t* digest) {
+  switch (config_.digest_mode) {
+    case DigestMode::EAGER:
+      return Hash(object_id, digest);
+    case DigestMode::NONE:
+    case DigestMode::LAZY:
+      memset(digest, 0, kDigestSize);
+      return Status::OK();
+    case DigestMode::INCREMENTAL: {
+      if (entry->hasher == nullptr || !entry->hasher->complete()) {
+        // Hash caches the digest.
+        return Hash(object_id, digest);
+      }
+      const PlasmaObject& object = entry->object;
+      uint8_t* metadata =
+          lookup_mmapped_file(object.store_fd) + object.data_offset + object.data_size;
+      uint64_t hash = entry->hasher->Finish(metadata, object.metadata_size);
+      entry->hasher.reset();
+      CacheDigest(object_id, hash);
+      memcpy(digest, &hash, sizeof(hash));
+    } break;
+  }
+  return Status::OK();
+}
+
 Status PlasmaClient::Seal(const ObjectID& object_id) {
   // Make sure this client has a reference to the object before sending the
   // request to Plasma.
@@ -573,7 +807,7 @@ Status PlasmaClient::Seal(const ObjectID& object_id) {
   object_entry->second->is_sealed = true;
   /// Send the seal request to Plasma.
   static unsigned char digest[kDigestSize];
-  RETURN_NOT_OK(Hash(object_id, &digest[0]));
+  RETURN_NOT_OK(ComputeSealDigest(object_id, object_entry->second.get(), &digest[0]));
   RETURN_NOT_OK(SendSealRequest(store_conn_, object_id, &digest[0]));
   // We call PlasmaClient::Release to decrement the number of instances of this
   // object
@@ -583,6 +817,174 @@ Status PlasmaClient::Seal(const ObjectID& object_id) {
   return Release(object_id);
 }
 
+Status PlasmaClient::Seal(const ObjectID* object_ids, int64_t num_objects) {
+  std::vector<unsigned char> digests(num_objects * kDigestSize);
+  for (int64_t i = 0; i < num_objects; ++i) {
+    auto object_entry = objects_in_use_.find(object_ids[i]);
+    ARROW_CHECK(object_entry != objects_in_use_.end())
+        << "Plasma client called seal an object without a reference to it";
+    ARROW_CHECK(!object_entry->second->is_sealed)
+        << "Plasma client called seal an already sealed object";
+    object_entry->second->is_sealed = true;
+    RETURN_NOT_OK(ComputeSealDigest(object_ids[i], object_entry->second.get(),
+                                    &digests[i * kDigestSize]));
+  }
+  RETURN_NOT_OK(
+      SendSealBatchRequest(store_conn_, object_ids, num_objects, digests.data()));
+  // Release the references that were taken by Create, see the single object
+  // Seal.
+  return Release(object_ids, num_objects);
+}
+
+namespace {
+
+/// A buffer that holds a reference to a sealed object and releases it when it
+/// is destroyed. The Arrow objects that are read from it consist of slices of
+/// this buffer, which keep it alive.
+class PlasmaBuffer : public Buffer {
+ public:
+  PlasmaBuffer(PlasmaClient* client, const ObjectID& object_id,
+               const std::shared_ptr<Buffer>& buffer)
+      : Buffer(buffer, 0, buffer->size()), client_(client), object_id_(object_id) {}
+
+  ~PlasmaBuffer() {
+    Status s = client_->Release(object_id_);
+    if (!s.ok()) {
+      ARROW_LOG(WARNING) << "Failed to release object " << object_id_.hex() << ": "
+                         << s.ToString();
+    }
+  }
+
+ private:
+  PlasmaClient* client_;
+  ObjectID object_id_;
+};
+
+}  // namespace
+
+Status PlasmaClient::PutArrowObject(
+    const ObjectID& object_id,
+    const std::function<Status(arrow::io::OutputStream*)>& write) {
+  // Only the metadata is serialized to compute the size, the buffers are
+  // copied into the object below.
+  arrow::io::MockOutputStream size_stream;
+  RETURN_NOT_OK(write(&size_stream));
+  std::shared_ptr<Buffer> data;
+  RETURN_NOT_OK(
+      Create(object_id, size_stream.GetExtentBytesWritten(), NULL, 0, &data));
+  std::shared_ptr<arrow::io::OutputStream> stream;
+  RETURN_NOT_OK(OpenObjectWriter(object_id, &stream));
+  Status s = write(stream.get());
+  if (!s.ok()) {
+    RETURN_NOT_OK(Release(object_id));
+    RETURN_NOT_OK(Abort(object_id));
+    return s;
+  }
+  return Seal(object_id);
+}
+
+Status PlasmaClient::Put(const ObjectID& object_id, const arrow::RecordBatch& batch) {
+  return PutArrowObject(object_id, [&batch](arrow::io::OutputStream* stream) {
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    RETURN_NOT_OK(
+        arrow::ipc::RecordBatchStreamWriter::Open(stream, batch.schema(), &writer));
+    RETURN_NOT_OK(writer->WriteRecordBatch(batch, true));
+    return writer->Close();
+  });
+}
+
+Status PlasmaClient::Put(const ObjectID& object_id, const arrow::Table& table) {
+  return PutArrowObject(object_id, [&table](arrow::io::OutputStream* stream) {
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    RETURN_NOT_OK(
+        arrow::ipc::RecordBatchStreamWriter::Open(stream, table.schema(), &writer));
+    RETURN_NOT_OK(writer->WriteTable(table));
+    return writer->Close();
+  });
+}
+
+Status PlasmaClient::Put(const ObjectID& object_id, const arrow::Tensor& tensor) {
+  return PutArrowObject(object_id, [&tensor](arrow::io::OutputStream* stream) {
+    int32_t metadata_length;
+    int64_t body_length;
+    return arrow::ipc::WriteTensor(tensor, stream, &metadata_length, &body_length);
+  });
+}
+
+Status PlasmaClient::GetArrowObject(const ObjectID& object_id, int64_t timeout_ms,
+                                    std::shared_ptr<Buffer>* buffer) {
+  ObjectBuffer object_buffer;
+  RETURN_NOT_OK(Get(&object_id, 1, timeout_ms, &object_buffer));
+  if (object_buffer.data_size == -1) {
+    return Status::PlasmaObjectNonexistent("object " + object_id.hex() +
+                                           " has not been sealed");
+  }
+  if (object_buffer.device_num != 0) {
+    RETURN_NOT_OK(Release(object_id));
+    return Status::NotImplemented("Arrow objects can only be read from host memory");
+  }
+  *buffer = std::make_shared<PlasmaBuffer>(this, object_id, object_buffer.data);
+  return Status::OK();
+}
+
+Status PlasmaClient::Get(const ObjectID& object_id, int64_t timeout_ms,
+                         std::shared_ptr<arrow::RecordBatch>* out) {
+  std::shared_ptr<Buffer> buffer;
+  RETURN_NOT_OK(GetArrowObject(object_id, timeout_ms, &buffer));
+  std::shared_ptr<arrow::RecordBatchReader> reader;
+  RETURN_NOT_OK(arrow::ipc::RecordBatchStreamReader::Open(
+      std::make_shared<arrow::io::BufferReader>(buffer), &reader));
+  RETURN_NOT_OK(reader->ReadNext(out));
+  std::shared_ptr<arrow::RecordBatch> next_batch;
+  RETURN_NOT_OK(reader->ReadNext(&next_batch));
+  if (*out == nullptr || next_batch != nullptr) {
+    *out = nullptr;
+    return Status::Invalid("object " + object_id.hex() +
+                           " does not hold a single record batch");
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::Get(const ObjectID& object_id, int64_t timeout_ms,
+                         std::shared_ptr<arrow::Table>* out) {
+  std::shared_ptr<Buffer> buffer;
+  RETURN_NOT_OK(GetArrowObject(object_id, timeout_ms, &buffer));
+  std::shared_ptr<arrow::RecordBatchReader> reader;
+  RETURN_NOT_OK(arrow::ipc::RecordBatchStreamReader::Open(
+      std::make_shared<arrow::io::BufferReader>(buffer), &reader));
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    RETURN_NOT_OK(reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    batches.push_back(batch);
+  }
+  if (batches.size() > 0) {
+    return arrow::Table::FromRecordBatches(batches, out);
+  }
+  // The table had no chunks, so it is made of empty columns.
+  std::shared_ptr<arrow::Schema> schema = reader->schema();
+  std::vector<std::shared_ptr<arrow::Array>> arrays(schema->num_fields());
+  for (int i = 0; i < schema->num_fields(); ++i) {
+    std::unique_ptr<arrow::ArrayBuilder> builder;
+    RETURN_NOT_OK(arrow::MakeBuilder(arrow::default_memory_pool(),
+                                     schema->field(i)->type(), &builder));
+    RETURN_NOT_OK(builder->Finish(&arrays[i]));
+  }
+  *out = arrow::Table::Make(schema, arrays);
+  return Status::OK();
+}
+
+Status PlasmaClient::Get(const ObjectID& object_id, int64_t timeout_ms,
+                         std::shared_ptr<arrow::Tensor>* out) {
+  std::shared_ptr<Buffer> buffer;
+  RETURN_NOT_OK(GetArrowObject(object_id, timeout_ms, &buffer));
+  arrow::io::BufferReader reader(buffer);
+  return arrow::ipc::ReadTensor(0, &reader, out);
+}
+
 Status PlasmaClient::Abort(const ObjectID& object_id) {
   auto object_entry = objects_in_use_.find(object_id);
   ARROW_CHECK(object_entry != objects_in_use_.end())
@@ -600,6 +1002,7 @@ Status PlasmaClient::Abort(const ObjectID& object_id) {
   }
 
   // Send the abort request.
+  digests_.erase(object_id);
   RETURN_NOT_OK(SendAbortRequest(store_conn_, object_id));
   // Decrease the reference count to zero, then remove the object.
   object_entry->second->count--;
@@ -619,6 +1022,7 @@ Status PlasmaClient::Delete(const ObjectID& object_id) {
     return Status::UnknownError("PlasmaClient::Object is in use.");
   } else {
     // If we don't already have a reference to the object, we can try to remove the object
+    digests_.erase(object_id);
     RETURN_NOT_OK(SendDeleteRequest(store_conn_, object_id));
     std::vector<uint8_t> buffer;
     RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaDeleteReply, &buffer));
@@ -639,7 +1043,23 @@ Status PlasmaClient::Evict(int64_t num_bytes, int64_t& num_bytes_evicted) {
   return ReadEvictReply(buffer.data(), buffer.size(), num_bytes_evicted);
 }
 
+Status PlasmaClient::Info(PlasmaStoreStats* stats) {
+  RETURN_NOT_OK(SendInfoRequest(store_conn_));
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaInfoReply, &buffer));
+  return ReadInfoReply(buffer.data(), buffer.size(), stats);
+}
+
 Status PlasmaClient::Hash(const ObjectID& object_id, uint8_t* digest) {
+  bool cache_digest = config_.digest_mode == DigestMode::LAZY ||
+                      config_.digest_mode == DigestMode::INCREMENTAL;
+  if (cache_digest) {
+    auto cached = digests_.find(object_id);
+    if (cached != digests_.end()) {
+      memcpy(digest, &cached->second, sizeof(cached->second));
+      return Status::OK();
+    }
+  }
   // Get the plasma object data. We pass in a timeout of 0 to indicate that
   // the operation should timeout immediately.
   ObjectBuffer object_buffer;
@@ -651,10 +1071,24 @@ Status PlasmaClient::Hash(const ObjectID& object_id, uint8_t* digest) {
   // Compute the hash.
   uint64_t hash = compute_object_hash(object_buffer);
   memcpy(digest, &hash, sizeof(hash));
+  if (cache_digest) {
+    CacheDigest(object_id, hash);
+  }
   // Release the plasma object.
   return Release(object_id);
 }
 
+void PlasmaClient::CacheDigest(const ObjectID& object_id, uint64_t hash) {
+  if (digests_.count(object_id) == 0) {
+    digest_history_.push_back(object_id);
+  }
+  digests_[object_id] = hash;
+  while (digest_history_.size() > kMaxCachedDigests) {
+    digests_.erase(digest_history_.front());
+    digest_history_.pop_front();
+  }
+}
+
 Status PlasmaClient::Subscribe(int* fd) {
   int sock[2];
   // Create a non-blocking socket pair. This will only be used to send
@@ -663,35 +1097,247 @@ Status PlasmaClient::Subscribe(int* fd) {
   // Make the socket non-blocking.
   int flags = fcntl(sock[1], F_GETFL, 0);
   ARROW_CHECK(fcntl(sock[1], F_SETFL, flags | O_NONBLOCK) == 0);
-  // Tell the Plasma store about the subscription.
+  // Tell the Plasma store about the subscription. The socket is still used if
+  // the store cannot assign a reader of the notification ring.
+#ifdef __linux__
+  RETURN_NOT_OK(SendSubscribeRingRequest(store_conn_));
+#else
   RETURN_NOT_OK(SendSubscribeRequest(store_conn_));
+#endif
   // Send the file descriptor that the Plasma store should use to push
   // notifications about sealed objects to this client.
   ARROW_CHECK(send_fd(store_conn_, sock[1]) >= 0);
   close(sock[1]);
+#ifdef __linux__
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(
+      PlasmaReceive(store_conn_, MessageType_PlasmaSubscribeRingReply, &buffer));
+  int reader;
+  int64_t ring_size;
+  RETURN_NOT_OK(
+      ReadSubscribeRingReply(buffer.data(), buffer.size(), &reader, &ring_size));
+  if (reader != -1) {
+    int ring_fd = recv_fd(store_conn_);
+    int event_fd = recv_fd(store_conn_);
+    if (ring_fd < 0 || event_fd < 0) {
+      for (int received_fd : {ring_fd, event_fd, sock[0]}) {
+        if (received_fd >= 0) {
+          close(received_fd);
+        }
+      }
+      return Status::IOError("Failed to receive the notification ring from the store");
+    }
+    if (notification_ring_ == nullptr) {
+      Status s = NotificationRing::Open(ring_fd, ring_size, &notification_ring_);
+      if (!s.ok()) {
+        close(event_fd);
+        close(sock[0]);
+        return s;
+      }
+    } else {
+      // The store has a single ring, which has been mapped already.
+      close(ring_fd);
+    }
+    ring_subscriptions_[event_fd] = {reader, sock[0], false};
+    *fd = event_fd;
+    return Status::OK();
+  }
+#endif
   // Return the file descriptor that the client should use to read notifications
   // about sealed objects.
   *fd = sock[0];
   return Status::OK();
 }
 
+Status PlasmaClient::GetAsyncFd(int* fd) {
+  if (async_get_conn_ == -1) {
+    // The replies are sent through their own socket, so that they do not mix
+    // with the replies to the other requests.
+    int sock[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sock) != 0) {
+      return Status::IOError(std::string("Failed to create a socket pair: ") +
+                             strerror(errno));
+    }
+    Status s = SendGetAsyncConnectRequest(store_conn_);
+    if (s.ok() && send_fd(store_conn_, sock[1]) < 0) {
+      s = Status::IOError("Failed to send the socket for asynchronous gets");
+    }
+    close(sock[1]);
+    if (!s.ok()) {
+      close(sock[0]);
+      return s;
+    }
+    async_get_conn_ = sock[0];
+  }
+  *fd = async_get_conn_;
+  return Status::OK();
+}
+
+Status PlasmaClient::GetAsync(const ObjectID* object_ids, int64_t num_objects,
+                              int64_t timeout_ms, const GetCallback& callback) {
+  if (num_objects == 0) {
+    return Status::OK();
+  }
+  int fd;
+  RETURN_NOT_OK(GetAsyncFd(&fd));
+  int64_t request_id = next_async_get_id_++;
+  RETURN_NOT_OK(
+      SendGetAsyncRequest(store_conn_, request_id, object_ids, num_objects, timeout_ms));
+  async_gets_[request_id] = {callback, num_objects};
+  return Status::OK();
+}
+
+Status PlasmaClient::ProcessGetAsyncReplies() {
+  if (async_get_conn_ == -1) {
+    return Status::OK();
+  }
+  struct pollfd poll_fd = {async_get_conn_, POLLIN, 0};
+  std::vector<uint8_t> buffer;
+  while (poll(&poll_fd, 1, 0) == 1) {
+    RETURN_NOT_OK(
+        PlasmaReceive(async_get_conn_, MessageType_PlasmaGetAsyncReply, &buffer));
+    int64_t request_id;
+    ObjectID object_id;
+    PlasmaObject object;
+    int store_fd;
+    int64_t mmap_size;
+    RETURN_NOT_OK(ReadGetAsyncReply(buffer.data(), buffer.size(), &request_id,
+                                    &object_id, &object, &store_fd, &mmap_size));
+    if (store_fd != -1) {
+      // The file descriptor is sent right after the reply.
+      int fd = recv_fd(async_get_conn_);
+      if (fd < 0) {
+        return Status::IOError("Failed to receive a file descriptor from the store");
+      }
+      lookup_or_mmap(fd, store_fd, mmap_size);
+    }
+
+    ObjectBuffer object_buffer;
+    object_buffer.data_size = object.data_size;
+    object_buffer.metadata_size = object.metadata_size;
+    object_buffer.device_num = object.device_num;
+    if (object.data_size != -1) {
+      if (object.device_num == 0) {
+        uint8_t* data = lookup_mmapped_file(object.store_fd);
+        object_buffer.data =
+            std::make_shared<Buffer>(data + object.data_offset, object.data_size);
+        object_buffer.metadata = std::make_shared<Buffer>(
+            data + object.data_offset + object.data_size, object.metadata_size);
+      } else {
+#ifdef PLASMA_GPU
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+        auto handle = gpu_object_map.find(object_id);
+        std::shared_ptr<CudaBuffer> gpu_handle;
+        if (handle == gpu_object_map.end()) {
+          std::shared_ptr<CudaContext> context;
+          RETURN_NOT_OK(manager_->GetContext(object.device_num - 1, &context));
+          GpuProcessHandle* obj_handle = new GpuProcessHandle();
+          RETURN_NOT_OK(context->OpenIpcBuffer(*object.ipc_handle, &obj_handle->ptr));
+          gpu_object_map[object_id] = obj_handle;
+          gpu_handle = obj_handle->ptr;
+        } else {
+          handle->second->client_count += 1;
+          gpu_handle = handle->second->ptr;
+        }
+        object_buffer.data =
+            std::make_shared<CudaBuffer>(gpu_handle, 0, object.data_size);
+        object_buffer.metadata = std::make_shared<CudaBuffer>(
+            gpu_handle, object.data_size, object.metadata_size);
+#else
+        ARROW_LOG(FATAL) << "Arrow GPU library is not enabled.";
+#endif
+      }
+      // The object has to be released like after Get.
+      increment_object_count(object_id, &object, true);
+    }
+
+    auto it = async_gets_.find(request_id);
+    ARROW_CHECK(it != async_gets_.end()) << "Reply to an unknown asynchronous get";
+    // The callback may make another asynchronous get, so it is called after the
+    // request has been updated.
+    GetCallback callback = it->second.callback;
+    if (--it->second.num_remaining == 0) {
+      async_gets_.erase(it);
+    }
+    callback(object_id, object_buffer);
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::GetRingNotification(int fd, RingSubscription* subscription,
+                                         std::vector<uint8_t>* notification) {
+  // Reset the eventfd, which is non-blocking. It is signaled again below if
+  // there are more notifications, so that it stays readable as long as there
+  // are notifications, like a socket.
+  uint64_t count;
+  while (read(fd, &count, sizeof(count)) < 0 && errno == EINTR) {
+  }
+  bool more_notifications = false;
+  while (!subscription->detached) {
+    auto status = notification_ring_->Read(subscription->reader, notification);
+    if (status == NotificationRing::ReadStatus::OK) {
+      more_notifications = notification_ring_->PrepareWait(subscription->reader);
+      break;
+    } else if (status == NotificationRing::ReadStatus::DETACHED) {
+      subscription->detached = true;
+    } else if (!notification_ring_->PrepareWait(subscription->reader)) {
+      // Wait until the store wakes us up.
+      struct pollfd poll_fd = {fd, POLLIN, 0};
+      if (poll(&poll_fd, 1, -1) < 0 && errno != EINTR) {
+        return Status::IOError("Failed to wait for object notifications");
+      }
+      while (read(fd, &count, sizeof(count)) < 0 && errno == EINTR) {
+      }
+    }
+  }
+  if (subscription->detached) {
+    // The client fell behind, so the store sends the notifications through the
+    // socket, starting with the ones that it has not read from the ring.
+    int64_t size;
+    RETURN_NOT_OK(ReadBytes(subscription->socket_fd, reinterpret_cast<uint8_t*>(&size),
+                            sizeof(size)));
+    notification->resize(size);
+    RETURN_NOT_OK(ReadBytes(subscription->socket_fd, notification->data(), size));
+    struct pollfd poll_fd = {subscription->socket_fd, POLLIN, 0};
+    more_notifications = poll(&poll_fd, 1, 0) > 0;
+  }
+  if (more_notifications) {
+    uint64_t one = 1;
+    if (write(fd, &one, sizeof(one)) != sizeof(one)) {
+      ARROW_LOG(WARNING) << "Failed to signal pending object notifications";
+    }
+  }
+  return Status::OK();
+}
+
 Status PlasmaClient::GetNotification(int fd, ObjectID* object_id, int64_t* data_size,
                                      int64_t* metadata_size) {
-  uint8_t* notification = read_message_async(fd);
-  if (notification == NULL) {
-    return Status::IOError("Failed to read object notification from Plasma socket");
+  const uint8_t* notification;
+  std::vector<uint8_t> ring_notification;
+  std::unique_ptr<uint8_t[]> socket_notification;
+  auto subscription = ring_subscriptions_.find(fd);
+  if (subscription != ring_subscriptions_.end()) {
+    RETURN_NOT_OK(GetRingNotification(fd, &subscription->second, &ring_notification));
+    notification = ring_notification.data();
+  } else {
+    socket_notification.reset(read_message_async(fd));
+    if (socket_notification == nullptr) {
+      return Status::IOError("Failed to read object notification from Plasma socket");
+    }
+    notification = socket_notification.get();
   }
   auto object_info = flatbuffers::GetRoot<ObjectInfo>(notification);
   ARROW_CHECK(object_info->object_id()->size() == sizeof(ObjectID));
   memcpy(object_id, object_info->object_id()->data(), sizeof(ObjectID));
   if (object_info->is_deletion()) {
+    // Another object may be created with the same ID.
+    digests_.erase(*object_id);
     *data_size = -1;
     *metadata_size = -1;
   } else {
     *data_size = object_info->data_size();
     *metadata_size = object_info->metadata_size();
   }
-  delete[] notification;
   return Status::OK();
 }
 
@@ -724,13 +1370,35 @@ Status PlasmaClient::Disconnect() {
   // that were in use by us when handling the SIGPIPE.
   close(store_conn_);
   store_conn_ = -1;
+  if (async_get_conn_ >= 0) {
+    close(async_get_conn_);
+    async_get_conn_ = -1;
+    async_gets_.clear();
+  }
   if (manager_conn_ >= 0) {
     close(manager_conn_);
     manager_conn_ = -1;
   }
+  // Close the eventfds of the subscriptions to the notification ring, and the
+  // sockets that they fall back to.
+  for (const auto& subscription : ring_subscriptions_) {
+    close(subscription.first);
+    close(subscription.second.socket_fd);
+  }
+  ring_subscriptions_.clear();
+  notification_ring_.reset();
   return Status::OK();
 }
 
+Status PlasmaClient::Replicate(const ObjectID* object_ids, int64_t num_objects,
+                               const std::string& store_socket_name) {
+  RETURN_NOT_OK(
+      SendReplicateRequest(store_conn_, object_ids, num_objects, store_socket_name));
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType_PlasmaReplicateReply, &buffer));
+  return ReadReplicateReply(buffer.data(), buffer.size());
+}
+
 Status PlasmaClient::Transfer(const char* address, int port, const ObjectID& object_id) {
   return SendDataRequest(manager_conn_, object_id, address, port);
 }
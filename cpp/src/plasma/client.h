@@ -22,9 +22,11 @@
 #include <time.h>
 
 #include <deque>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "arrow/buffer.h"
 #include "arrow/status.h"
@@ -34,6 +36,19 @@
 #include "arrow/gpu/cuda_api.h"
 #endif
 
+namespace arrow {
+
+class RecordBatch;
+class Table;
+class Tensor;
+
+namespace io {
+
+class OutputStream;
+
+}  // namespace io
+}  // namespace arrow
+
 using arrow::Buffer;
 using arrow::Status;
 
@@ -58,12 +73,42 @@ struct ObjectBuffer {
   int device_num;
 };
 
+/// Called by PlasmaClient::ProcessGetAsyncReplies for each object of an
+/// asynchronous get. The data size of the buffer is -1 if the object was not
+/// sealed before the request timed out. Otherwise the object must be released
+/// like an object returned by PlasmaClient::Get.
+using GetCallback =
+    std::function<void(const ObjectID& object_id, const ObjectBuffer& object_buffer)>;
+
+/// How the client computes the digests of the objects that it seals.
+enum class DigestMode {
+  /// Seal hashes the whole object. This is the default.
+  EAGER,
+  /// Seal does not hash the object and sends an all zero digest to the
+  /// store. Hash computes the digest whenever it is called.
+  NONE,
+  /// Like NONE, but Hash caches the digest of an object on its first call.
+  /// The digest is kept while the object stays sealed in the store. It is
+  /// dropped when the client creates, aborts or deletes the object itself, or
+  /// reads a notification from GetNotification that the object has been
+  /// deleted, which is also sent before another client replaces it. A client
+  /// that does not read notifications does not notice such replacements.
+  LAZY,
+  /// The data of an object is hashed while it is written through the stream
+  /// from OpenObjectWriter, so Seal does not need to read it again. Seal
+  /// hashes the whole object if its data was not written that way. The
+  /// digests are cached for Hash like with LAZY.
+  INCREMENTAL
+};
+
 /// Configuration options for the plasma client.
 struct PlasmaClientConfig {
   /// Number of release calls we wait until the object is actually released.
   /// This allows us to avoid invalidating the cpu cache on workers if objects
   /// are reused accross tasks.
   size_t release_delay;
+  /// How the digests of sealed objects are computed.
+  DigestMode digest_mode = DigestMode::EAGER;
 };
 
 struct ClientMmapTableEntry {
@@ -76,6 +121,26 @@ struct ClientMmapTableEntry {
   int count;
 };
 
+/// A subscription that reads notifications from the notification ring.
+struct RingSubscription {
+  /// The reader of the ring that is assigned to the subscription.
+  int reader;
+  /// The socket through which notifications are sent once the reader has
+  /// been detached from the ring.
+  int socket_fd;
+  /// Whether the reader has been detached from the ring.
+  bool detached;
+};
+
+/// An asynchronous get that waits for objects.
+struct AsyncGet {
+  /// The function that is called with each object.
+  GetCallback callback;
+  /// The number of objects that have not been returned yet.
+  int64_t num_remaining;
+};
+
+class NotificationRing;
 struct ObjectInUseEntry;
 struct ObjectRequest;
 struct PlasmaObject;
@@ -123,6 +188,24 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Create(const ObjectID& object_id, int64_t data_size, uint8_t* metadata,
                 int64_t metadata_size, std::shared_ptr<Buffer>* data, int device_num = 0);
+
+  /// Create several objects on the host with a single request to the Plasma
+  /// Store. Either all of the objects are created, or none of them. Each of
+  /// them must be sealed or aborted like an object returned by Create.
+  ///
+  /// \param object_ids The IDs to use for the newly created objects.
+  /// \param num_objects The number of objects to create.
+  /// \param data_sizes The sizes in bytes of the objects' data.
+  /// \param metadata The objects' metadata. If there is no metadata, this
+  ///        pointer should be NULL.
+  /// \param metadata_sizes The sizes in bytes of the objects' metadata.
+  /// \param data An array where the buffers of the newly created objects will
+  ///        be stored.
+  /// \return The return status.
+  Status Create(const ObjectID* object_ids, int64_t num_objects,
+                const int64_t* data_sizes, uint8_t* const* metadata,
+                const int64_t* metadata_sizes, std::shared_ptr<Buffer>* data);
+
   /// Get some objects from the Plasma Store. This function will block until the
   /// objects have all been created and sealed in the Plasma Store or the
   /// timeout
@@ -141,6 +224,36 @@ class ARROW_EXPORT PlasmaClient {
   Status Get(const ObjectID* object_ids, int64_t num_objects, int64_t timeout_ms,
              ObjectBuffer* object_buffers);
 
+  /// Get some objects without blocking. The callback is called once for each
+  /// object, by ProcessGetAsyncReplies, as soon as the object has been sealed
+  /// or the request has timed out. This allows waiting for many objects from
+  /// an event loop, see GetAsyncFd.
+  ///
+  /// \param object_ids The IDs of the objects to get.
+  /// \param num_objects The number of object IDs to get.
+  /// \param timeout_ms The amount of time in milliseconds to wait for each
+  ///        object. If this value is -1, then no timeout is set.
+  /// \param callback The function that is called with each object.
+  /// \return The return status.
+  Status GetAsync(const ObjectID* object_ids, int64_t num_objects, int64_t timeout_ms,
+                  const GetCallback& callback);
+
+  /// Get the file descriptor that becomes readable when there are replies to
+  /// asynchronous gets, so that it can be polled by an event loop. The
+  /// replies are read by ProcessGetAsyncReplies. The store holds on to the
+  /// replies that the client has not read yet.
+  ///
+  /// \param fd Out parameter for the file descriptor.
+  /// \return The return status.
+  Status GetAsyncFd(int* fd);
+
+  /// Read the replies to asynchronous gets that have arrived and call their
+  /// callbacks. This does not block. The callbacks may call any method of the
+  /// client.
+  ///
+  /// \return The return status.
+  Status ProcessGetAsyncReplies();
+
   /// Tell Plasma that the client no longer needs the object. This should be
   /// called
   /// after Get when the client is done with the object. After this call,
@@ -151,6 +264,14 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Release(const ObjectID& object_id);
 
+  /// Release several objects. Objects that this client no longer uses are
+  /// released in the store with a single request.
+  ///
+  /// \param object_ids The IDs of the objects that are no longer needed.
+  /// \param num_objects The number of object IDs to release.
+  /// \return The return status.
+  Status Release(const ObjectID* object_ids, int64_t num_objects);
+
   /// Check if the object store contains a particular object and the object has
   /// been sealed. The result will be stored in has_object.
   ///
@@ -172,6 +293,17 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Abort(const ObjectID& object_id);
 
+  /// Open a stream that writes the data of an object that this client has
+  /// created and not sealed yet, from the beginning. With
+  /// DigestMode::INCREMENTAL, the data is hashed while it is written. The
+  /// stream must not be used after the object has been sealed or aborted.
+  ///
+  /// \param object_id The ID of the object to write.
+  /// \param out The stream.
+  /// \return The return status.
+  Status OpenObjectWriter(const ObjectID& object_id,
+                          std::shared_ptr<arrow::io::OutputStream>* out);
+
   /// Seal an object in the object store. The object will be immutable after
   /// this
   /// call.
@@ -180,6 +312,73 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Seal(const ObjectID& object_id);
 
+  /// Seal several objects in the object store with a single request.
+  ///
+  /// \param object_ids The IDs of the objects to seal.
+  /// \param num_objects The number of object IDs to seal.
+  /// \return The return status.
+  Status Seal(const ObjectID* object_ids, int64_t num_objects);
+
+  /// Store a record batch as a sealed object. The record batch is written in
+  /// the Arrow IPC stream format straight into the object, so its buffers are
+  /// copied exactly once.
+  ///
+  /// \param object_id The ID of the object to create.
+  /// \param batch The record batch to store.
+  /// \return The return status.
+  Status Put(const ObjectID& object_id, const arrow::RecordBatch& batch);
+
+  /// Store a table as a sealed object in the Arrow IPC stream format, with
+  /// one record batch for each chunk of the table.
+  ///
+  /// \param object_id The ID of the object to create.
+  /// \param table The table to store.
+  /// \return The return status.
+  Status Put(const ObjectID& object_id, const arrow::Table& table);
+
+  /// Store a tensor as a sealed object in the Arrow IPC tensor format.
+  ///
+  /// \param object_id The ID of the object to create.
+  /// \param tensor The tensor to store.
+  /// \return The return status.
+  Status Put(const ObjectID& object_id, const arrow::Tensor& tensor);
+
+  /// Get a record batch that has been stored with Put. The buffers of the
+  /// record batch point into shared memory. The object is released once all of
+  /// them have been destroyed, which must happen before the client is
+  /// destroyed, and on a thread that may use the client.
+  ///
+  /// \param object_id The ID of the object to get.
+  /// \param timeout_ms The number of milliseconds to wait for the object to be
+  ///        sealed, or -1 to wait forever.
+  /// \param out The record batch.
+  /// \return The return status. It is PlasmaObjectNonexistent if the object
+  ///         was not sealed before the timeout.
+  Status Get(const ObjectID& object_id, int64_t timeout_ms,
+             std::shared_ptr<arrow::RecordBatch>* out);
+
+  /// Get a table that has been stored with Put, see the Get for record
+  /// batches. A stored record batch can be read as a table with one chunk.
+  ///
+  /// \param object_id The ID of the object to get.
+  /// \param timeout_ms The number of milliseconds to wait for the object to be
+  ///        sealed, or -1 to wait forever.
+  /// \param out The table.
+  /// \return The return status.
+  Status Get(const ObjectID& object_id, int64_t timeout_ms,
+             std::shared_ptr<arrow::Table>* out);
+
+  /// Get a tensor that has been stored with Put, see the Get for record
+  /// batches.
+  ///
+  /// \param object_id The ID of the object to get.
+  /// \param timeout_ms The number of milliseconds to wait for the object to be
+  ///        sealed, or -1 to wait forever.
+  /// \param out The tensor.
+  /// \return The return status.
+  Status Get(const ObjectID& object_id, int64_t timeout_ms,
+             std::shared_ptr<arrow::Tensor>* out);
+
   /// Delete an object from the object store. This currently assumes that the
   /// object is present, has been sealed and not used by another client. Otherwise,
   /// it is a no operation.
@@ -200,7 +399,14 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Evict(int64_t num_bytes, int64_t& num_bytes_evicted);
 
-  /// Compute the hash of an object in the object store.
+  /// Set how the digests of the objects that this client seals are computed.
+  ///
+  /// \param mode The digest mode.
+  void SetDigestMode(DigestMode mode);
+
+  /// Compute the hash of an object in the object store. With DigestMode::LAZY
+  /// and DigestMode::INCREMENTAL, the digest is cached by the client, see
+  /// DigestMode::LAZY.
   ///
   /// \param object_id The ID of the object we want to hash.
   /// \param digest A pointer at which to return the hash digest of the object.
@@ -209,8 +415,19 @@ class ARROW_EXPORT PlasmaClient {
   Status Hash(const ObjectID& object_id, uint8_t* digest);
 
   /// Subscribe to notifications when objects are sealed in the object store.
-  /// Whenever an object is sealed, a message will be written to the client
-  /// socket that is returned by this method.
+  /// Whenever an object is sealed, a notification is made available through
+  /// the file descriptor that is returned by this method, which becomes
+  /// readable when there are notifications.
+  ///
+  /// On Linux, the notifications are read from a ring buffer in shared memory
+  /// that all subscribers share, and the file descriptor is an eventfd. If the
+  /// store has no room for another reader of the ring, or if the client falls
+  /// too far behind, the notifications are sent through a socket instead.
+  ///
+  /// The file descriptor is therefore not always a socket. It must only be
+  /// polled for readability, and the notifications must be read with
+  /// GetNotification. An eventfd, and the socket behind it, are owned by the
+  /// client and closed by Disconnect.
   ///
   /// \param fd Out parameter for the file descriptor the client should use to
   /// read notifications
@@ -295,6 +512,22 @@ class ARROW_EXPORT PlasmaClient {
   Status Wait(int64_t num_object_requests, ObjectRequest* object_requests,
               int num_ready_objects, int64_t timeout_ms, int* num_objects_ready);
 
+  /// Copy sealed objects to another plasma store on the same machine. The
+  /// store sends their contents directly to the other store through a UNIX
+  /// domain socket, without going through this client, and the other store
+  /// seals them with the same digests. Objects that the other store already
+  /// has are skipped. This blocks until all objects have been copied.
+  ///
+  /// \param object_ids The IDs of the objects to copy.
+  /// \param num_objects The number of object IDs to copy.
+  /// \param store_socket_name The name of the UNIX domain socket of the store
+  ///        to copy the objects to.
+  /// \return The return status. It is PlasmaObjectNonexistent if one of the
+  ///         objects is not sealed in the memory of the store, in which case
+  ///         none of them is copied, and IOError if a copy failed.
+  Status Replicate(const ObjectID* object_ids, int64_t num_objects,
+                   const std::string& store_socket_name);
+
   /// Transfer local object to a different plasma manager.
   ///
   /// \param addr IP address of the plasma manager we are transfering to.
@@ -321,6 +554,15 @@ class ARROW_EXPORT PlasmaClient {
   /// \return The return status.
   Status Info(const ObjectID& object_id, int* object_status);
 
+  /// Get statistics about the store, such as the objects and bytes in each
+  /// state, the fragmentation of its memory, the number of evictions and the
+  /// latencies of the requests it has handled. The plasma_store_stats tool
+  /// prints them.
+  ///
+  /// \param stats Out parameter for the statistics.
+  /// \return The return status.
+  Status Info(PlasmaStoreStats* stats);
+
   /// Get the file descriptor for the socket connection to the plasma manager.
   ///
   /// \return The file descriptor for the manager connection. If there is no
@@ -338,15 +580,42 @@ class ARROW_EXPORT PlasmaClient {
   /// store.
   Status FlushReleaseHistory();
 
-  Status PerformRelease(const ObjectID& object_id);
+  Status PerformRelease(const ObjectID& object_id,
+                        std::vector<ObjectID>* object_ids_to_release);
+
+  /// Tell the store that the client no longer uses some objects.
+  Status SendReleases(const std::vector<ObjectID>& object_ids);
+
+  /// Create an object for an Arrow object, fill it with write and seal it.
+  /// write is called twice, first to compute the size of the object. The
+  /// object is aborted if write fails.
+  Status PutArrowObject(const ObjectID& object_id,
+                        const std::function<Status(arrow::io::OutputStream*)>& write);
+
+  /// Compute the digest that is sent with the seal request of an object.
+  Status ComputeSealDigest(const ObjectID& object_id, ObjectInUseEntry* entry,
+                           uint8_t* digest);
+
+  /// Get an object that has been stored with Put, as a buffer that releases
+  /// the object when it is destroyed.
+  Status GetArrowObject(const ObjectID& object_id, int64_t timeout_ms,
+                        std::shared_ptr<Buffer>* buffer);
 
   uint8_t* lookup_or_mmap(int fd, int store_fd_val, int64_t map_size);
 
   uint8_t* lookup_mmapped_file(int store_fd_val);
 
+  /// Read the next notification of a subscription to the notification ring.
+  Status GetRingNotification(int fd, RingSubscription* subscription,
+                             std::vector<uint8_t>* notification);
+
   void increment_object_count(const ObjectID& object_id, PlasmaObject* object,
                               bool is_sealed);
 
+  /// Remember the digest of an object for Hash. The oldest digests are dropped
+  /// once kMaxCachedDigests are cached.
+  void CacheDigest(const ObjectID& object_id, uint64_t hash);
+
   /// File descriptor of the Unix domain socket that connects to the store.
   int store_conn_;
   /// File descriptor of the Unix domain socket that connects to the manager.
@@ -371,10 +640,29 @@ class ARROW_EXPORT PlasmaClient {
   int64_t in_use_object_bytes_;
   /// Configuration options for the plasma client.
   PlasmaClientConfig config_;
+  /// The digests that have been computed with DigestMode::LAZY or
+  /// DigestMode::INCREMENTAL, see CacheDigest.
+  std::unordered_map<ObjectID, uint64_t, UniqueIDHasher> digests_;
+  /// The objects in digests_, oldest first, which bounds its size. An object
+  /// may appear more than once after its digest has been dropped and computed
+  /// again.
+  std::deque<ObjectID> digest_history_;
   /// The amount of memory available to the Plasma store. The client needs this
   /// information to make sure that it does not delay in releasing so much
   /// memory that the store is unable to evict enough objects to free up space.
   int64_t store_capacity_;
+  /// The notification ring of the store, once it has been mapped.
+  std::unique_ptr<NotificationRing> notification_ring_;
+  /// The subscriptions that use the notification ring, by the file descriptor
+  /// that was returned by Subscribe.
+  std::unordered_map<int, RingSubscription> ring_subscriptions_;
+  /// The socket through which the store sends the replies to asynchronous
+  /// gets, or -1 if it has not been created yet.
+  int async_get_conn_;
+  /// The ID of the next asynchronous get.
+  int64_t next_async_get_id_;
+  /// The asynchronous gets that have objects left, by their ID.
+  std::unordered_map<int64_t, AsyncGet> async_gets_;
 #ifdef PLASMA_GPU
   /// Cuda Device Manager.
   arrow::gpu::CudaDeviceManager* manager_;
@@ -20,6 +20,7 @@
 
 #include <cstring>
 #include <string>
+#include <vector>
 // TODO(pcm): Convert getopt and sscanf in the store to use more idiomatic C++
 // and get rid of the next three lines:
 #ifndef __STDC_FORMAT_MACROS
@@ -94,6 +95,75 @@ enum ObjectRequestType {
   PLASMA_QUERY_ANYWHERE
 };
 
+/// The number of buckets of a latency histogram. Bucket i counts the requests
+/// that took less than 2^i microseconds, but at least 2^(i-1). The last bucket
+/// counts all requests that took longer.
+constexpr int kNumLatencyBuckets = 24;
+
+/// The latencies of one kind of request that the store has handled.
+struct LatencyHistogram {
+  /// The name of the request, e.g. "PlasmaCreateRequest".
+  std::string operation;
+  /// The number of requests in each of the kNumLatencyBuckets buckets.
+  std::vector<int64_t> counts;
+};
+
+/// Statistics about the store, as returned by PlasmaClient::Info.
+struct PlasmaStoreStats {
+  /// The number of evicted objects that have been written to the spill
+  /// directory.
+  int64_t num_objects_spilled = 0;
+  /// The number of bytes that have been written to the spill directory.
+  int64_t bytes_spilled = 0;
+  /// The number of spilled objects that have been read back into memory.
+  int64_t num_objects_restored = 0;
+  /// The number of bytes that have been read back into memory.
+  int64_t bytes_restored = 0;
+  /// The number of objects that have been created, but not sealed yet.
+  int64_t num_objects_created = 0;
+  /// The number of bytes of the objects that have not been sealed yet.
+  int64_t bytes_created = 0;
+  /// The number of sealed objects in memory.
+  int64_t num_objects_sealed = 0;
+  /// The number of bytes of the sealed objects in memory.
+  int64_t bytes_sealed = 0;
+  /// The number of objects that are used by at least one client, sealed or
+  /// not.
+  int64_t num_objects_in_use = 0;
+  /// The number of bytes of the objects that are in use.
+  int64_t bytes_in_use = 0;
+  /// The number of objects that have been evicted, including the ones that
+  /// have been spilled.
+  int64_t num_objects_evicted = 0;
+  /// The number of bytes of the objects that have been evicted.
+  int64_t bytes_evicted = 0;
+  /// The number of bytes that the allocator has mapped for objects.
+  int64_t allocator_footprint = 0;
+  /// The number of mapped bytes that are allocated to objects.
+  int64_t allocator_allocated = 0;
+  /// The number of mapped bytes that are free. Free bytes that are spread
+  /// over many chunks indicate fragmentation.
+  int64_t allocator_free = 0;
+  /// The number of free chunks that the free bytes are spread over.
+  int64_t allocator_free_chunks = 0;
+  /// The size in bytes of the largest free chunk, which bounds the size of
+  /// the objects that can be created without evicting others.
+  int64_t allocator_largest_free = 0;
+  /// The fraction of the free bytes that are not in the largest free chunk,
+  /// between 0 for no fragmentation and close to 1 for heavy fragmentation.
+  double allocator_fragmentation = 0;
+  /// The number of get requests that wait for objects.
+  int64_t num_pending_get_requests = 0;
+  /// The number of connected clients.
+  int64_t num_clients = 0;
+  /// The number of subscribers to object notifications.
+  int64_t num_subscribers = 0;
+  /// The latencies of the requests that the store has handled, for each kind
+  /// of request that it has seen. The latency of a get request includes the
+  /// time that it waited for objects.
+  std::vector<LatencyHistogram> latencies;
+};
+
 extern int ObjectStatusLocal;
 extern int ObjectStatusRemote;
 
@@ -20,6 +20,10 @@
 #include <utility>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "arrow/util/logging.h"
 
 namespace plasma {
 
@@ -35,7 +39,24 @@ int EventLoop::TimerEventCallback(aeEventLoop* loop, TimerID timer_id, void* con
 
 constexpr int kInitialEventLoopSize = 1024;
 
-EventLoop::EventLoop() { loop_ = aeCreateEventLoop(kInitialEventLoopSize); }
+EventLoop::EventLoop() : thread_id_(std::thread::id()) {
+  loop_ = aeCreateEventLoop(kInitialEventLoopSize);
+  ARROW_CHECK(pipe(wakeup_pipe_) == 0);
+  // RunPostedCallbacks drains the pipe without blocking, and Post must not
+  // block if nobody drains it for a while.
+  for (int fd : wakeup_pipe_) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  }
+  AddFileEvent(wakeup_pipe_[0], kEventLoopRead,
+               [this](int events) { RunPostedCallbacks(); });
+}
+
+EventLoop::~EventLoop() {
+  aeDeleteEventLoop(loop_);
+  close(wakeup_pipe_[0]);
+  close(wakeup_pipe_[1]);
+}
 
 bool EventLoop::AddFileEvent(int fd, int events, const FileCallback& callback) {
   if (file_callbacks_.find(fd) != file_callbacks_.end()) {
@@ -66,11 +87,44 @@ void EventLoop::RemoveFileEvent(int fd) {
   file_callbacks_.erase(fd);
 }
 
-void EventLoop::Start() { aeMain(loop_); }
+void EventLoop::Start() {
+  thread_id_ = std::this_thread::get_id();
+  aeMain(loop_);
+}
+
+void EventLoop::Stop() { aeStop(loop_); }
 
-void EventLoop::Stop() {
-  aeStop(loop_);
-  aeDeleteEventLoop(loop_);
+void EventLoop::Post(const std::function<void()>& callback) {
+  {
+    std::lock_guard<std::mutex> lock(posted_mutex_);
+    posted_callbacks_.push_back(callback);
+  }
+  // If the pipe is full, the event loop has not been woken up yet and will
+  // see this callback as well.
+  char signal = 0;
+  if (write(wakeup_pipe_[1], &signal, 1) != 1 && errno != EAGAIN) {
+    ARROW_LOG(WARNING) << "failed to wake up event loop";
+  }
+}
+
+bool EventLoop::IsLoopThread() const {
+  return thread_id_ == std::this_thread::get_id();
+}
+
+void EventLoop::RunPostedCallbacks() {
+  // Drain the pipe before taking the callbacks, so that a callback that is
+  // posted concurrently wakes up the event loop again.
+  char buffer[64];
+  while (read(wakeup_pipe_[0], buffer, sizeof(buffer)) > 0) {
+  }
+  std::vector<std::function<void()>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(posted_mutex_);
+    callbacks.swap(posted_callbacks_);
+  }
+  for (const auto& callback : callbacks) {
+    callback();
+  }
 }
 
 int64_t EventLoop::AddTimer(int64_t timeout, const TimerCallback& callback) {
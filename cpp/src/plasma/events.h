@@ -18,9 +18,13 @@
 #ifndef PLASMA_EVENTS
 #define PLASMA_EVENTS
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 extern "C" {
 #include "ae/ae.h"
@@ -55,6 +59,8 @@ class EventLoop {
 
   EventLoop();
 
+  ~EventLoop();
+
   /// Add a new file event handler to the event loop.
   ///
   /// @param fd The file descriptor we are listening to.
@@ -88,14 +94,36 @@ class EventLoop {
   /// \brief Stop the event loop
   void Stop();
 
+  /// Run a callback on the thread of the event loop. Unlike the other methods,
+  /// this may be called from any thread. The callbacks are run in the order in
+  /// which they were posted.
+  ///
+  /// @param callback The callback that will be called.
+  void Post(const std::function<void()>& callback);
+
+  /// Check whether this is called from the thread that runs the event loop.
+  ///
+  /// @return True if the event loop is running on the calling thread.
+  bool IsLoopThread() const;
+
  private:
   static void FileEventCallback(aeEventLoop* loop, int fd, void* context, int events);
 
   static int TimerEventCallback(aeEventLoop* loop, TimerID timer_id, void* context);
 
+  void RunPostedCallbacks();
+
   aeEventLoop* loop_;
   std::unordered_map<int, std::unique_ptr<FileCallback>> file_callbacks_;
   std::unordered_map<int64_t, std::unique_ptr<TimerCallback>> timer_callbacks_;
+  /// The thread that runs the event loop, or no thread before Start.
+  std::atomic<std::thread::id> thread_id_;
+  /// A pipe that wakes up the event loop when a callback has been posted.
+  int wakeup_pipe_[2];
+  std::mutex posted_mutex_;
+  /// The callbacks that have been posted but not run yet. Protected by
+  /// posted_mutex_.
+  std::vector<std::function<void()>> posted_callbacks_;
 };
 
 }  // namespace plasma
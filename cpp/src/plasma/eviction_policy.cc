@@ -21,6 +21,51 @@
 
 namespace plasma {
 
+using arrow::Status;
+
+Status ParseEvictionPolicyType(const std::string& name, EvictionPolicyType* type) {
+  if (name == "lru") {
+    *type = EvictionPolicyType::LRU;
+  } else if (name == "lfu") {
+    *type = EvictionPolicyType::LFU;
+  } else if (name == "gds") {
+    *type = EvictionPolicyType::GDS;
+  } else if (name == "arc") {
+    *type = EvictionPolicyType::ARC;
+  } else {
+    return Status::Invalid("unknown eviction policy '" + name +
+                           "', expected one of lru, lfu, gds or arc");
+  }
+  return Status::OK();
+}
+
+std::string EvictionPolicyTypeName(EvictionPolicyType type) {
+  switch (type) {
+    case EvictionPolicyType::LRU:
+      return "lru";
+    case EvictionPolicyType::LFU:
+      return "lfu";
+    case EvictionPolicyType::GDS:
+      return "gds";
+    case EvictionPolicyType::ARC:
+      return "arc";
+  }
+  return "";
+}
+
+std::unique_ptr<ObjectCache> MakeObjectCache(EvictionPolicyType type, int64_t capacity) {
+  switch (type) {
+    case EvictionPolicyType::LFU:
+      return std::unique_ptr<ObjectCache>(new LFUCache());
+    case EvictionPolicyType::GDS:
+      return std::unique_ptr<ObjectCache>(new GreedyDualSizeCache());
+    case EvictionPolicyType::ARC:
+      return std::unique_ptr<ObjectCache>(new ARCCache(capacity));
+    default:
+      return std::unique_ptr<ObjectCache>(new LRUCache());
+  }
+}
+
 void LRUCache::add(const ObjectID& key, int64_t size) {
   auto it = item_map_.find(key);
   ARROW_CHECK(it == item_map_.end());
@@ -29,6 +74,10 @@ void LRUCache::add(const ObjectID& key, int64_t size) {
   item_map_.emplace(key, item_list_.begin());
 }
 
+bool LRUCache::contains(const ObjectID& key) const {
+  return item_map_.find(key) != item_map_.end();
+}
+
 void LRUCache::remove(const ObjectID& key) {
   auto it = item_map_.find(key);
   ARROW_CHECK(it != item_map_.end());
@@ -39,26 +88,230 @@ void LRUCache::remove(const ObjectID& key) {
 int64_t LRUCache::choose_objects_to_evict(int64_t num_bytes_required,
                                           std::vector<ObjectID>* objects_to_evict) {
   int64_t bytes_evicted = 0;
-  auto it = item_list_.end();
-  while (bytes_evicted < num_bytes_required && it != item_list_.begin()) {
-    it--;
-    objects_to_evict->push_back(it->first);
-    bytes_evicted += it->second;
+  while (bytes_evicted < num_bytes_required && !item_list_.empty()) {
+    const auto& item = item_list_.back();
+    objects_to_evict->push_back(item.first);
+    bytes_evicted += item.second;
+    item_map_.erase(item.first);
+    item_list_.pop_back();
+  }
+  return bytes_evicted;
+}
+
+void LFUCache::add(const ObjectID& key, int64_t size) {
+  ARROW_CHECK(item_map_.find(key) == item_map_.end());
+  int64_t use_count = ++use_counts_[key];
+  auto it = items_.emplace(std::make_pair(use_count, sequence_number_++),
+                           std::make_pair(key, size));
+  item_map_.emplace(key, it.first);
+}
+
+void LFUCache::remove(const ObjectID& key) {
+  auto it = item_map_.find(key);
+  ARROW_CHECK(it != item_map_.end());
+  items_.erase(it->second);
+  item_map_.erase(it);
+}
+
+int64_t LFUCache::choose_objects_to_evict(int64_t num_bytes_required,
+                                          std::vector<ObjectID>* objects_to_evict) {
+  int64_t bytes_evicted = 0;
+  while (bytes_evicted < num_bytes_required && !items_.empty()) {
+    auto it = items_.begin();
+    const ObjectID key = it->second.first;
+    objects_to_evict->push_back(key);
+    bytes_evicted += it->second.second;
+    item_map_.erase(key);
+    use_counts_.erase(key);
+    items_.erase(it);
+  }
+  return bytes_evicted;
+}
+
+bool LFUCache::contains(const ObjectID& key) const {
+  return item_map_.find(key) != item_map_.end();
+}
+
+void LFUCache::evict(const ObjectID& key) {
+  // Like choose_objects_to_evict, start over if the object comes back.
+  remove(key);
+  use_counts_.erase(key);
+}
+
+void LFUCache::forget(const ObjectID& key) { use_counts_.erase(key); }
+
+void GreedyDualSizeCache::add(const ObjectID& key, int64_t size) {
+  ARROW_CHECK(item_map_.find(key) == item_map_.end());
+  // All objects have the same cost to recreate, so the priority only depends
+  // on the size.
+  double priority = inflation_ + 1.0 / static_cast<double>(std::max<int64_t>(size, 1));
+  auto it = items_.emplace(std::make_pair(priority, sequence_number_++),
+                           std::make_pair(key, size));
+  item_map_.emplace(key, it.first);
+}
+
+bool GreedyDualSizeCache::contains(const ObjectID& key) const {
+  return item_map_.find(key) != item_map_.end();
+}
+
+void GreedyDualSizeCache::remove(const ObjectID& key) {
+  auto it = item_map_.find(key);
+  ARROW_CHECK(it != item_map_.end());
+  items_.erase(it->second);
+  item_map_.erase(it);
+}
+
+int64_t GreedyDualSizeCache::choose_objects_to_evict(
+    int64_t num_bytes_required, std::vector<ObjectID>* objects_to_evict) {
+  int64_t bytes_evicted = 0;
+  while (bytes_evicted < num_bytes_required && !items_.empty()) {
+    auto it = items_.begin();
+    inflation_ = it->first.first;
+    objects_to_evict->push_back(it->second.first);
+    bytes_evicted += it->second.second;
+    item_map_.erase(it->second.first);
+    items_.erase(it);
+  }
+  return bytes_evicted;
+}
+
+ARCCache::ARCCache(int64_t capacity) : capacity_(capacity), target_recent_bytes_(0) {
+  std::fill(list_bytes_, list_bytes_ + 4, 0);
+}
+
+void ARCCache::push(const ObjectID& key, Item* item, ListIndex list) {
+  lists_[list].push_front(key);
+  list_bytes_[list] += item->size;
+  item->list = list;
+  item->position = lists_[list].begin();
+}
+
+void ARCCache::erase(Item* item) {
+  if (item->list != NONE) {
+    lists_[item->list].erase(item->position);
+    list_bytes_[item->list] -= item->size;
+    item->list = NONE;
+  }
+}
+
+void ARCCache::trim_ghosts(ListIndex list) {
+  while (list_bytes_[list] > capacity_ && !lists_[list].empty()) {
+    auto it = items_.find(lists_[list].back());
+    ARROW_CHECK(it != items_.end());
+    erase(&it->second);
+    items_.erase(it);
+  }
+}
+
+void ARCCache::add(const ObjectID& key, int64_t size) {
+  auto it = items_.find(key);
+  if (it == items_.end()) {
+    Item item;
+    item.size = size;
+    item.num_adds = 0;
+    item.list = NONE;
+    item.frequent = false;
+    it = items_.emplace(key, item).first;
+  }
+  Item* item = &it->second;
+  ARROW_CHECK(item->list == NONE || item->list == RECENT_GHOST ||
+              item->list == FREQUENT_GHOST);
+
+  // A hit on a recently evicted object means that the list it was evicted
+  // from should have been larger.
+  if (item->list == RECENT_GHOST) {
+    int64_t delta = std::max<int64_t>(
+        size, list_bytes_[FREQUENT_GHOST] * size /
+                  std::max<int64_t>(list_bytes_[RECENT_GHOST], 1));
+    target_recent_bytes_ = std::min(capacity_, target_recent_bytes_ + delta);
+    item->frequent = true;
+  } else if (item->list == FREQUENT_GHOST) {
+    int64_t delta = std::max<int64_t>(
+        size, list_bytes_[RECENT_GHOST] * size /
+                  std::max<int64_t>(list_bytes_[FREQUENT_GHOST], 1));
+    target_recent_bytes_ = std::max<int64_t>(0, target_recent_bytes_ - delta);
+    item->frequent = true;
+  }
+  erase(item);
+  item->size = size;
+  // The object is added once when it is created and once when its creator
+  // releases it, so it has been used by another client if it is added again.
+  item->num_adds += 1;
+  if (item->num_adds > 2) {
+    item->frequent = true;
+  }
+  push(key, item, item->frequent ? FREQUENT : RECENT);
+}
+
+void ARCCache::remove(const ObjectID& key) {
+  auto it = items_.find(key);
+  ARROW_CHECK(it != items_.end());
+  ARROW_CHECK(it->second.list == RECENT || it->second.list == FREQUENT);
+  erase(&it->second);
+}
+
+int64_t ARCCache::choose_objects_to_evict(int64_t num_bytes_required,
+                                          std::vector<ObjectID>* objects_to_evict) {
+  int64_t bytes_evicted = 0;
+  while (bytes_evicted < num_bytes_required &&
+         !(lists_[RECENT].empty() && lists_[FREQUENT].empty())) {
+    ListIndex from;
+    if (lists_[FREQUENT].empty() ||
+        (!lists_[RECENT].empty() && list_bytes_[RECENT] > target_recent_bytes_)) {
+      from = RECENT;
+    } else {
+      from = FREQUENT;
+    }
+    const ObjectID key = lists_[from].back();
+    Item* item = &items_[key];
+    objects_to_evict->push_back(key);
+    bytes_evicted += item->size;
+    // Remember the evicted object so that its return adapts the target.
+    erase(item);
+    push(key, item, from == RECENT ? RECENT_GHOST : FREQUENT_GHOST);
   }
+  trim_ghosts(RECENT_GHOST);
+  trim_ghosts(FREQUENT_GHOST);
   return bytes_evicted;
 }
 
+bool ARCCache::contains(const ObjectID& key) const {
+  auto it = items_.find(key);
+  return it != items_.end() &&
+         (it->second.list == RECENT || it->second.list == FREQUENT);
+}
+
+void ARCCache::evict(const ObjectID& key) {
+  auto it = items_.find(key);
+  ARROW_CHECK(it != items_.end());
+  Item* item = &it->second;
+  ListIndex from = item->list;
+  ARROW_CHECK(from == RECENT || from == FREQUENT);
+  erase(item);
+  push(key, item, from == RECENT ? RECENT_GHOST : FREQUENT_GHOST);
+  trim_ghosts(from == RECENT ? RECENT_GHOST : FREQUENT_GHOST);
+}
+
+void ARCCache::forget(const ObjectID& key) {
+  auto it = items_.find(key);
+  if (it != items_.end()) {
+    erase(&it->second);
+    items_.erase(it);
+  }
+}
+
 EvictionPolicy::EvictionPolicy(PlasmaStoreInfo* store_info)
-    : memory_used_(0), store_info_(store_info) {}
+    : EvictionPolicy(store_info, std::unique_ptr<ObjectCache>(new LRUCache())) {}
+
+EvictionPolicy::EvictionPolicy(PlasmaStoreInfo* store_info,
+                               std::unique_ptr<ObjectCache> cache)
+    : memory_used_(0), store_info_(store_info), cache_(std::move(cache)) {}
 
 int64_t EvictionPolicy::choose_objects_to_evict(int64_t num_bytes_required,
                                                 std::vector<ObjectID>* objects_to_evict) {
+  /* The cache removes the objects it chooses. */
   int64_t bytes_evicted =
-      cache_.choose_objects_to_evict(num_bytes_required, objects_to_evict);
-  /* Update the LRU cache. */
-  for (auto& object_id : *objects_to_evict) {
-    cache_.remove(object_id);
-  }
+      cache_->choose_objects_to_evict(num_bytes_required, objects_to_evict);
   /* Update the number of bytes used. */
   memory_used_ -= bytes_evicted;
   ARROW_CHECK(memory_used_ >= 0);
@@ -67,7 +320,7 @@ int64_t EvictionPolicy::choose_objects_to_evict(int64_t num_bytes_required,
 
 void EvictionPolicy::object_created(const ObjectID& object_id) {
   auto entry = store_info_->objects[object_id].get();
-  cache_.add(object_id, entry->info.data_size + entry->info.metadata_size);
+  cache_->add(object_id, entry->info.data_size + entry->info.metadata_size);
   int64_t size = entry->info.data_size + entry->info.metadata_size;
   memory_used_ += size;
   ARROW_CHECK(memory_used_ <= store_info_->memory_capacity);
@@ -89,22 +342,58 @@ bool EvictionPolicy::require_space(int64_t size,
   return num_bytes_evicted >= required_space && num_bytes_evicted > 0;
 }
 
+bool EvictionPolicy::require_contiguous_space(int64_t size,
+                                              const ExtentAllocator& allocator,
+                                              const uint8_t* base,
+                                              std::vector<ObjectID>* objects_to_evict) {
+  /* Find the objects in memory that may be evicted. */
+  std::unordered_map<int64_t, ObjectID> evictable;
+  for (const auto& element : store_info_->objects) {
+    const ObjectTableEntry& entry = *element.second;
+    if (entry.pointer != NULL && cache_->contains(element.first)) {
+      evictable.emplace(entry.pointer - base, element.first);
+    }
+  }
+  std::vector<int64_t> offsets;
+  bool found = allocator.FindEvictionRange(
+      size, [&evictable](int64_t offset) { return evictable.count(offset) != 0; },
+      &offsets);
+  if (!found || offsets.empty()) {
+    return false;
+  }
+  int64_t num_bytes_evicted = 0;
+  for (int64_t offset : offsets) {
+    const ObjectID& object_id = evictable[offset];
+    auto entry = store_info_->objects[object_id].get();
+    cache_->evict(object_id);
+    num_bytes_evicted += entry->info.data_size + entry->info.metadata_size;
+    objects_to_evict->push_back(object_id);
+  }
+  memory_used_ -= num_bytes_evicted;
+  ARROW_CHECK(memory_used_ >= 0);
+  ARROW_LOG(INFO) << "There is no contiguous space to create this object, so evicting "
+                  << objects_to_evict->size() << " adjacent objects to free up "
+                  << num_bytes_evicted << " bytes.";
+  return true;
+}
+
 void EvictionPolicy::begin_object_access(const ObjectID& object_id,
                                          std::vector<ObjectID>* objects_to_evict) {
-  /* If the object is in the LRU cache, remove it. */
-  cache_.remove(object_id);
+  /* If the object is in the cache, remove it. */
+  cache_->remove(object_id);
 }
 
 void EvictionPolicy::end_object_access(const ObjectID& object_id,
                                        std::vector<ObjectID>* objects_to_evict) {
   auto entry = store_info_->objects[object_id].get();
-  /* Add the object to the LRU cache.*/
-  cache_.add(object_id, entry->info.data_size + entry->info.metadata_size);
+  /* Add the object to the cache.*/
+  cache_->add(object_id, entry->info.data_size + entry->info.metadata_size);
 }
 
 void EvictionPolicy::remove_object(const ObjectID& object_id) {
-  /* If the object is in the LRU cache, remove it. */
-  cache_.remove(object_id);
+  /* If the object is in the cache, remove it. */
+  cache_->remove(object_id);
+  cache_->forget(object_id);
 
   auto entry = store_info_->objects[object_id].get();
   int64_t size = entry->info.data_size + entry->info.metadata_size;
@@ -19,11 +19,15 @@
 #define PLASMA_EVICTION_POLICY_H
 
 #include <list>
+#include <map>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "plasma/common.h"
+#include "plasma/extent_allocator.h"
 #include "plasma/plasma.h"
 
 namespace plasma {
@@ -34,16 +38,101 @@ namespace plasma {
 // need to be provided if you want to implement a new eviction algorithm for the
 // Plasma store.
 
-class LRUCache {
+/// The algorithms that can be used to choose the objects to evict.
+enum class EvictionPolicyType {
+  /// Evict the least recently used objects first.
+  LRU,
+  /// Evict the least frequently used objects first, ties are broken by
+  /// recency.
+  LFU,
+  /// GreedyDual-Size: evict the objects with the lowest priority first, where
+  /// the priority of an object is 1 / size plus an inflation value that grows
+  /// with every eviction. Small objects are kept in favor of large ones
+  /// unless the large ones are used again.
+  GDS,
+  /// Adaptive Replacement Cache: balance the objects that were used once
+  /// against the objects that were used several times, adapting the balance
+  /// to hits on recently evicted objects.
+  ARC
+};
+
+/// Parse the name of an eviction policy, one of "lru", "lfu", "gds" or "arc".
+///
+/// @param name The name of the policy.
+/// @param type The parsed policy type.
+/// @return Status::Invalid if the name is unknown.
+arrow::Status ParseEvictionPolicyType(const std::string& name, EvictionPolicyType* type);
+
+/// Return the name of an eviction policy, as parsed by ParseEvictionPolicyType.
+std::string EvictionPolicyTypeName(EvictionPolicyType type);
+
+/// A cache holds the objects that are not being used by any client, and
+/// therefore may be evicted, and chooses the ones to evict.
+class ObjectCache {
+ public:
+  virtual ~ObjectCache() {}
+
+  /// Add an object to the cache. This is called when an object is created and
+  /// whenever the last client using it releases it.
+  ///
+  /// @param key The object ID.
+  /// @param size The size of the object in bytes.
+  virtual void add(const ObjectID& key, int64_t size) = 0;
+
+  /// Remove an object from the cache, because it starts being used again or
+  /// because it is deleted.
+  ///
+  /// @param key The object ID, which must be in the cache.
+  virtual void remove(const ObjectID& key) = 0;
+
+  /// Choose objects to evict and remove them from the cache. The objects
+  /// chosen are assumed to be evicted by the caller.
+  ///
+  /// @param num_bytes_required The number of bytes of space to try to free up.
+  /// @param objects_to_evict The object IDs that were chosen for eviction will
+  ///        be stored into this vector.
+  /// @return The total number of bytes of space chosen to be evicted.
+  virtual int64_t choose_objects_to_evict(int64_t num_bytes_required,
+                                          std::vector<ObjectID>* objects_to_evict) = 0;
+
+  /// Check whether an object is in the cache, and may therefore be evicted.
+  ///
+  /// @param key The object ID.
+  /// @return True if the object is in the cache.
+  virtual bool contains(const ObjectID& key) const = 0;
+
+  /// Remove an object from the cache that the caller has chosen to evict,
+  /// for example because it is in the way of a large object.
+  ///
+  /// @param key The object ID, which must be in the cache.
+  virtual void evict(const ObjectID& key) { remove(key); }
+
+  /// Drop any history kept about an object that is deleted from the store
+  /// rather than evicted. This is called after remove.
+  ///
+  /// @param key The object ID.
+  virtual void forget(const ObjectID& key) {}
+};
+
+/// Create the cache implementing an eviction policy.
+///
+/// @param type The eviction policy.
+/// @param capacity The capacity of the store in bytes.
+/// @return The cache.
+std::unique_ptr<ObjectCache> MakeObjectCache(EvictionPolicyType type, int64_t capacity);
+
+class LRUCache : public ObjectCache {
  public:
   LRUCache() {}
 
-  void add(const ObjectID& key, int64_t size);
+  void add(const ObjectID& key, int64_t size) override;
 
-  void remove(const ObjectID& key);
+  void remove(const ObjectID& key) override;
 
   int64_t choose_objects_to_evict(int64_t num_bytes_required,
-                                  std::vector<ObjectID>* objects_to_evict);
+                                  std::vector<ObjectID>* objects_to_evict) override;
+
+  bool contains(const ObjectID& key) const override;
 
  private:
   /// A doubly-linked list containing the items in the cache and
@@ -55,15 +144,129 @@ class LRUCache {
   std::unordered_map<ObjectID, ItemList::iterator, UniqueIDHasher> item_map_;
 };
 
+class LFUCache : public ObjectCache {
+ public:
+  LFUCache() : sequence_number_(0) {}
+
+  void add(const ObjectID& key, int64_t size) override;
+
+  void remove(const ObjectID& key) override;
+
+  int64_t choose_objects_to_evict(int64_t num_bytes_required,
+                                  std::vector<ObjectID>* objects_to_evict) override;
+
+  bool contains(const ObjectID& key) const override;
+
+  void evict(const ObjectID& key) override;
+
+  void forget(const ObjectID& key) override;
+
+ private:
+  /// The items in the cache and their sizes, ordered by use count and then by
+  /// the order in which they were added.
+  typedef std::map<std::pair<int64_t, int64_t>, std::pair<ObjectID, int64_t>> ItemMap;
+  ItemMap items_;
+  /// A hash table mapping the object ID of an object in the cache to its
+  /// location in items_.
+  std::unordered_map<ObjectID, ItemMap::iterator, UniqueIDHasher> item_map_;
+  /// The number of times each object in the store was added to the cache.
+  std::unordered_map<ObjectID, int64_t, UniqueIDHasher> use_counts_;
+  int64_t sequence_number_;
+};
+
+class GreedyDualSizeCache : public ObjectCache {
+ public:
+  GreedyDualSizeCache() : inflation_(0), sequence_number_(0) {}
+
+  void add(const ObjectID& key, int64_t size) override;
+
+  void remove(const ObjectID& key) override;
+
+  int64_t choose_objects_to_evict(int64_t num_bytes_required,
+                                  std::vector<ObjectID>* objects_to_evict) override;
+
+  bool contains(const ObjectID& key) const override;
+
+ private:
+  /// The items in the cache and their sizes, ordered by priority and then by
+  /// the order in which they were added.
+  typedef std::map<std::pair<double, int64_t>, std::pair<ObjectID, int64_t>> ItemMap;
+  ItemMap items_;
+  /// A hash table mapping the object ID of an object in the cache to its
+  /// location in items_.
+  std::unordered_map<ObjectID, ItemMap::iterator, UniqueIDHasher> item_map_;
+  /// The priority of the last evicted object, which is added to the priority
+  /// of the objects added to the cache so that objects that are not used age.
+  double inflation_;
+  int64_t sequence_number_;
+};
+
+class ARCCache : public ObjectCache {
+ public:
+  /// @param capacity The capacity of the store in bytes, which bounds the
+  ///        size of the history of evicted objects.
+  explicit ARCCache(int64_t capacity);
+
+  void add(const ObjectID& key, int64_t size) override;
+
+  void remove(const ObjectID& key) override;
+
+  int64_t choose_objects_to_evict(int64_t num_bytes_required,
+                                  std::vector<ObjectID>* objects_to_evict) override;
+
+  bool contains(const ObjectID& key) const override;
+
+  void evict(const ObjectID& key) override;
+
+  void forget(const ObjectID& key) override;
+
+ private:
+  enum ListIndex { RECENT = 0, FREQUENT, RECENT_GHOST, FREQUENT_GHOST, NONE };
+
+  struct Item {
+    int64_t size;
+    /// The number of times the object was added to the cache.
+    int64_t num_adds;
+    /// The list the object is in, NONE if it is being used.
+    ListIndex list;
+    /// Whether the object was used after its creator released it.
+    bool frequent;
+    std::list<ObjectID>::iterator position;
+  };
+
+  void push(const ObjectID& key, Item* item, ListIndex list);
+
+  void erase(Item* item);
+
+  /// Evict ghost entries until the given ghost list is within capacity.
+  void trim_ghosts(ListIndex list);
+
+  int64_t capacity_;
+  /// The target size in bytes of the list of recently used objects.
+  int64_t target_recent_bytes_;
+  /// The recently used objects, the frequently used objects and the
+  /// recently evicted objects of each kind, in LRU order.
+  std::list<ObjectID> lists_[4];
+  int64_t list_bytes_[4];
+  std::unordered_map<ObjectID, Item, UniqueIDHasher> items_;
+};
+
 /// The eviction policy.
 class EvictionPolicy {
  public:
-  /// Construct an eviction policy.
+  /// Construct an eviction policy using LRU order.
   ///
   /// @param store_info Information about the Plasma store that is exposed
   ///        to the eviction policy.
   explicit EvictionPolicy(PlasmaStoreInfo* store_info);
 
+  /// Construct an eviction policy.
+  ///
+  /// @param store_info Information about the Plasma store that is exposed
+  ///        to the eviction policy.
+  /// @param cache The cache that chooses the objects to evict.
+  EvictionPolicy(PlasmaStoreInfo* store_info, std::unique_ptr<ObjectCache> cache);
+
   /// This method will be called whenever an object is first created in order to
   /// add it to the LRU cache. This is done so that the first time, the Plasma
   /// store calls begin_object_access, we can remove the object from the LRU
@@ -84,6 +287,25 @@ class EvictionPolicy {
   /// @return True if enough space can be freed and false otherwise.
   bool require_space(int64_t size, std::vector<ObjectID>* objects_to_evict);
 
+  /// This method will be called when the allocator of the Plasma store has no
+  /// free extent that is large enough for a new object. Unlike require_space,
+  /// it chooses objects that are next to each other, so that evicting them
+  /// makes room for the object even if the free memory is fragmented. When
+  /// this method is called, the eviction policy will assume that the objects
+  /// chosen to be evicted will in fact be evicted from the Plasma store by the
+  /// caller.
+  ///
+  /// @param size The size in bytes of the new object, including both data and
+  ///        metadata.
+  /// @param allocator The allocator of the store.
+  /// @param base The address of the memory that the allocator manages.
+  /// @param objects_to_evict The object IDs that were chosen for eviction will
+  ///        be stored into this vector.
+  /// @return True if enough contiguous space can be freed and false otherwise.
+  bool require_contiguous_space(int64_t size, const ExtentAllocator& allocator,
+                                const uint8_t* base,
+                                std::vector<ObjectID>* objects_to_evict);
+
   /// This method will be called whenever an unused object in the Plasma store
   /// starts to be used. When this method is called, the eviction policy will
   /// assume that the objects chosen to be evicted will in fact be evicted from
@@ -130,8 +352,8 @@ class EvictionPolicy {
   int64_t memory_used_;
   /// Pointer to the plasma store info.
   PlasmaStoreInfo* store_info_;
-  /// Datastructure for the LRU cache.
-  LRUCache cache_;
+  /// Datastructure for the cache of objects that can be evicted.
+  std::unique_ptr<ObjectCache> cache_;
 };
 
 }  // namespace plasma
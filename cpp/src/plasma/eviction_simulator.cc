@@ -0,0 +1,188 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "plasma/eviction_simulator.h"
+
+#include <sstream>
+#include <vector>
+
+namespace plasma {
+
+using arrow::Status;
+
+EvictionSimulator::EvictionSimulator(EvictionPolicyType type, int64_t capacity)
+    : eviction_policy_(&store_info_, MakeObjectCache(type, capacity)), memory_used_(0) {
+  store_info_.memory_capacity = capacity;
+  store_info_.hugepages_enabled = false;
+}
+
+void EvictionSimulator::EvictObjects(const std::vector<ObjectID>& object_ids) {
+  for (const auto& object_id : object_ids) {
+    auto it = store_info_.objects.find(object_id);
+    ARROW_CHECK(it != store_info_.objects.end());
+    int64_t size = it->second->info.data_size + it->second->info.metadata_size;
+    memory_used_ -= size;
+    stats_.num_evictions += 1;
+    stats_.bytes_evicted += size;
+    store_info_.objects.erase(it);
+  }
+}
+
+bool EvictionSimulator::RequireSpace(int64_t size) {
+  // Like the store, which evicts whenever an allocation fails.
+  while (memory_used_ + size > store_info_.memory_capacity) {
+    std::vector<ObjectID> objects_to_evict;
+    bool success = eviction_policy_.require_space(size, &objects_to_evict);
+    EvictObjects(objects_to_evict);
+    if (!success) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void EvictionSimulator::Create(const ObjectID& object_id, int64_t size) {
+  object_sizes_[object_id] = size;
+  if (store_info_.objects.count(object_id) != 0) {
+    return;
+  }
+  if (!RequireSpace(size)) {
+    stats_.num_failed_creates += 1;
+    return;
+  }
+  auto entry = std::unique_ptr<ObjectTableEntry>(new ObjectTableEntry());
+  entry->object_id = object_id;
+  entry->info.object_id = object_id.binary();
+  entry->info.data_size = size;
+  entry->info.metadata_size = 0;
+  entry->pointer = nullptr;
+  entry->fd = -1;
+  entry->state = PLASMA_SEALED;
+  entry->device_num = 0;
+  store_info_.objects[object_id] = std::move(entry);
+  memory_used_ += size;
+
+  // The creator uses the object until it seals and releases it.
+  std::vector<ObjectID> objects_to_evict;
+  eviction_policy_.object_created(object_id);
+  eviction_policy_.begin_object_access(object_id, &objects_to_evict);
+  EvictObjects(objects_to_evict);
+  objects_to_evict.clear();
+  eviction_policy_.end_object_access(object_id, &objects_to_evict);
+  EvictObjects(objects_to_evict);
+}
+
+bool EvictionSimulator::Get(const ObjectID& object_id) {
+  auto size_it = object_sizes_.find(object_id);
+  if (size_it == object_sizes_.end()) {
+    return false;
+  }
+  stats_.num_gets += 1;
+  stats_.bytes_requested += size_it->second;
+  if (store_info_.objects.count(object_id) != 0) {
+    stats_.num_hits += 1;
+    stats_.bytes_hit += size_it->second;
+  } else {
+    Create(object_id, size_it->second);
+    if (store_info_.objects.count(object_id) == 0) {
+      return false;
+    }
+  }
+  int64_t& num_users = num_users_[object_id];
+  if (num_users == 0) {
+    std::vector<ObjectID> objects_to_evict;
+    eviction_policy_.begin_object_access(object_id, &objects_to_evict);
+    EvictObjects(objects_to_evict);
+  }
+  num_users += 1;
+  return true;
+}
+
+void EvictionSimulator::Release(const ObjectID& object_id) {
+  auto it = num_users_.find(object_id);
+  ARROW_CHECK(it != num_users_.end() && it->second > 0)
+      << "To release an object it must have been gotten.";
+  it->second -= 1;
+  if (it->second == 0) {
+    num_users_.erase(it);
+    std::vector<ObjectID> objects_to_evict;
+    eviction_policy_.end_object_access(object_id, &objects_to_evict);
+    EvictObjects(objects_to_evict);
+  }
+}
+
+void EvictionSimulator::Delete(const ObjectID& object_id) {
+  auto it = store_info_.objects.find(object_id);
+  if (it == store_info_.objects.end() || num_users_.count(object_id) != 0) {
+    return;
+  }
+  eviction_policy_.remove_object(object_id);
+  memory_used_ -= it->second->info.data_size + it->second->info.metadata_size;
+  store_info_.objects.erase(it);
+}
+
+ObjectID EvictionSimulator::GetObjectID(const std::string& name) {
+  auto it = object_ids_.find(name);
+  if (it == object_ids_.end()) {
+    it = object_ids_.emplace(name, ObjectID::from_random()).first;
+  }
+  return it->second;
+}
+
+Status EvictionSimulator::Replay(std::istream* trace) {
+  std::string line;
+  int64_t line_number = 0;
+  while (std::getline(*trace, line)) {
+    line_number += 1;
+    std::istringstream fields(line);
+    std::string op, name;
+    if (!(fields >> op) || op[0] == '#') {
+      continue;
+    }
+    if (!(fields >> name)) {
+      std::stringstream ss;
+      ss << "line " << line_number << " of the trace has no object name";
+      return Status::Invalid(ss.str());
+    }
+    ObjectID object_id = GetObjectID(name);
+    if (op == "create") {
+      int64_t size;
+      if (!(fields >> size) || size < 0) {
+        std::stringstream ss;
+        ss << "line " << line_number << " of the trace has no valid object size";
+        return Status::Invalid(ss.str());
+      }
+      Create(object_id, size);
+    } else if (op == "get") {
+      Get(object_id);
+    } else if (op == "release") {
+      if (num_users_.count(object_id) != 0) {
+        Release(object_id);
+      }
+    } else if (op == "delete") {
+      Delete(object_id);
+    } else {
+      std::stringstream ss;
+      ss << "line " << line_number << " of the trace has unknown operation '" << op
+         << "'";
+      return Status::Invalid(ss.str());
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace plasma
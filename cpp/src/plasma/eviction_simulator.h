@@ -0,0 +1,135 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PLASMA_EVICTION_SIMULATOR_H
+#define PLASMA_EVICTION_SIMULATOR_H
+
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+#include "plasma/common.h"
+#include "plasma/eviction_policy.h"
+#include "plasma/plasma.h"
+
+namespace plasma {
+
+/// The statistics collected while replaying a trace.
+struct EvictionSimulatorStats {
+  /// The number of get requests.
+  int64_t num_gets = 0;
+  /// The number of get requests for objects that were in the store.
+  int64_t num_hits = 0;
+  /// The total size of the objects requested.
+  int64_t bytes_requested = 0;
+  /// The total size of the objects requested that were in the store.
+  int64_t bytes_hit = 0;
+  /// The number of objects evicted.
+  int64_t num_evictions = 0;
+  /// The total size of the objects evicted.
+  int64_t bytes_evicted = 0;
+  /// The number of objects that could not be created because not enough
+  /// space could be freed.
+  int64_t num_failed_creates = 0;
+
+  double hit_ratio() const {
+    return num_gets == 0 ? 0 : static_cast<double>(num_hits) / num_gets;
+  }
+
+  double byte_hit_ratio() const {
+    return bytes_requested == 0 ? 0 : static_cast<double>(bytes_hit) / bytes_requested;
+  }
+};
+
+/// Replays the object accesses of a Plasma store against an eviction policy,
+/// without allocating the objects, to compare the hit ratios of the policies.
+///
+/// Objects are created, sealed and released by their creator in a single
+/// step. A get request for an object that was evicted counts as a miss, and
+/// the object is then recreated as if the client had recomputed it.
+class EvictionSimulator {
+ public:
+  /// @param type The eviction policy.
+  /// @param capacity The capacity of the simulated store in bytes.
+  EvictionSimulator(EvictionPolicyType type, int64_t capacity);
+
+  /// Create an object, evicting other objects if necessary. Creating an object
+  /// that is already in the store does nothing.
+  ///
+  /// @param object_id The object ID.
+  /// @param size The size of the object in bytes.
+  void Create(const ObjectID& object_id, int64_t size);
+
+  /// Get an object. The caller must call Release once it is done with the
+  /// object, if this returns true.
+  ///
+  /// @param object_id The object ID.
+  /// @return False if the object was never created, or it was evicted and
+  ///         cannot be recreated.
+  bool Get(const ObjectID& object_id);
+
+  /// Release an object that was returned by Get.
+  ///
+  /// @param object_id The object ID.
+  void Release(const ObjectID& object_id);
+
+  /// Delete an object, if it is in the store and not used.
+  ///
+  /// @param object_id The object ID.
+  void Delete(const ObjectID& object_id);
+
+  /// Replay a trace. Each line of the trace is one of
+  ///
+  ///   create <name> <size>
+  ///   get <name>
+  ///   release <name>
+  ///   delete <name>
+  ///
+  /// where <name> is any string without whitespace identifying an object.
+  /// Empty lines and lines starting with # are ignored.
+  ///
+  /// @param trace The trace to replay.
+  /// @return Status::Invalid if a line cannot be parsed.
+  arrow::Status Replay(std::istream* trace);
+
+  const EvictionSimulatorStats& stats() const { return stats_; }
+
+ private:
+  /// Make room for size more bytes. Return false if that is not possible.
+  bool RequireSpace(int64_t size);
+
+  void EvictObjects(const std::vector<ObjectID>& object_ids);
+
+  ObjectID GetObjectID(const std::string& name);
+
+  PlasmaStoreInfo store_info_;
+  EvictionPolicy eviction_policy_;
+  /// The total size of the objects in the store.
+  int64_t memory_used_;
+  /// The size of every object ever created, so that evicted objects can be
+  /// recreated.
+  std::unordered_map<ObjectID, int64_t, UniqueIDHasher> object_sizes_;
+  /// The number of pending Get calls for each object in the store.
+  std::unordered_map<ObjectID, int64_t, UniqueIDHasher> num_users_;
+  /// The object IDs of the names used in the replayed trace.
+  std::unordered_map<std::string, ObjectID> object_ids_;
+  EvictionSimulatorStats stats_;
+};
+
+}  // namespace plasma
+
+#endif  // PLASMA_EVICTION_SIMULATOR_H
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// PLASMA EVICTION SIMULATOR: Replay a trace of object accesses against the
+// eviction policies of the plasma store and report their hit ratios.
+//
+// Usage: plasma_eviction_simulator -m <capacity> [-e <policy>] [-t <trace>]
+//
+// The trace format is described in eviction_simulator.h. It is read from
+// standard input if no trace file is given. All policies are compared if none
+// is given.
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "plasma/eviction_policy.h"
+#include "plasma/eviction_simulator.h"
+
+int main(int argc, char* argv[]) {
+  std::string trace_file;
+  int64_t capacity = -1;
+  std::vector<plasma::EvictionPolicyType> types;
+  int c;
+  while ((c = getopt(argc, argv, "m:e:t:")) != -1) {
+    switch (c) {
+      case 'm': {
+        char extra;
+        int scanned = sscanf(optarg, "%" SCNd64 "%c", &capacity, &extra);
+        ARROW_CHECK(scanned == 1) << "invalid capacity " << optarg;
+        break;
+      }
+      case 'e': {
+        plasma::EvictionPolicyType type;
+        ARROW_CHECK_OK(plasma::ParseEvictionPolicyType(std::string(optarg), &type));
+        types.push_back(type);
+        break;
+      }
+      case 't':
+        trace_file = std::string(optarg);
+        break;
+      default:
+        exit(-1);
+    }
+  }
+  if (capacity <= 0) {
+    ARROW_LOG(FATAL) << "please specify the capacity of the store with -m switch";
+  }
+  if (types.empty()) {
+    types = {plasma::EvictionPolicyType::LRU, plasma::EvictionPolicyType::LFU,
+             plasma::EvictionPolicyType::GDS, plasma::EvictionPolicyType::ARC};
+  }
+
+  // Read the whole trace once, so that it can be replayed for each policy.
+  std::stringstream trace;
+  if (trace_file.empty()) {
+    trace << std::cin.rdbuf();
+  } else {
+    std::ifstream file(trace_file);
+    ARROW_CHECK(file.good()) << "could not open trace file " << trace_file;
+    trace << file.rdbuf();
+  }
+  const std::string trace_data = trace.str();
+
+  printf("%-8s %12s %12s %14s %12s\n", "policy", "gets", "hit ratio", "byte hit ratio",
+         "evictions");
+  for (auto type : types) {
+    plasma::EvictionSimulator simulator(type, capacity);
+    std::istringstream input(trace_data);
+    ARROW_CHECK_OK(simulator.Replay(&input));
+    const auto& stats = simulator.stats();
+    printf("%-8s %12" PRId64 " %12.4f %14.4f %12" PRId64 "\n",
+           plasma::EvictionPolicyTypeName(type).c_str(), stats.num_gets,
+           stats.hit_ratio(), stats.byte_hit_ratio(), stats.num_evictions);
+  }
+  return 0;
+}
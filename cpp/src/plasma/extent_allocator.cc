@@ -0,0 +1,276 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "plasma/extent_allocator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "arrow/util/logging.h"
+
+namespace plasma {
+
+static int64_t RoundUp(int64_t size) {
+  return std::max(kExtentAlignment,
+                  (size + kExtentAlignment - 1) / kExtentAlignment * kExtentAlignment);
+}
+
+ExtentAllocator::ExtentAllocator(int64_t capacity)
+    : capacity_(capacity / kExtentAlignment * kExtentAlignment), allocated_(0) {
+  // Four size classes for each power of two, so that at most a fifth of a
+  // block is wasted, except for the smallest objects.
+  for (int64_t base = kExtentAlignment; base < kMaxSmallObjectSize; base *= 2) {
+    for (int64_t step = 0; step < 4; ++step) {
+      int64_t size = RoundUp(base + step * base / 4);
+      if (class_sizes_.empty() || size > class_sizes_.back()) {
+        class_sizes_.push_back(size);
+      }
+    }
+  }
+  class_sizes_.push_back(kMaxSmallObjectSize);
+  partial_slabs_.resize(class_sizes_.size());
+  if (capacity_ > 0) {
+    AddFreeExtent(0, capacity_);
+  }
+}
+
+int ExtentAllocator::SizeClass(int64_t size) const {
+  auto it = std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size);
+  DCHECK(it != class_sizes_.end());
+  return static_cast<int>(it - class_sizes_.begin());
+}
+
+int64_t ExtentAllocator::Allocate(int64_t size) {
+  if (size <= kMaxSmallObjectSize) {
+    int64_t offset = AllocateBlock(SizeClass(size));
+    if (offset != -1) {
+      return offset;
+    }
+    // There is no room for another slab, but there may be for the object.
+  }
+  int64_t offset = AllocateExtent(RoundUp(size), false);
+  if (offset != -1) {
+    allocated_ += extents_[offset].size;
+  }
+  return offset;
+}
+
+int64_t ExtentAllocator::AllocateBlock(int size_class) {
+  std::set<int64_t>& partial_slabs = partial_slabs_[size_class];
+  const int64_t block_size = class_sizes_[size_class];
+  if (partial_slabs.empty()) {
+    int64_t slab_offset = AllocateExtent(kSlabSize, true);
+    if (slab_offset == -1) {
+      return -1;
+    }
+    Slab& slab = slabs_[slab_offset];
+    slab.size_class = size_class;
+    slab.num_used = 0;
+    for (int64_t i = kSlabSize / block_size - 1; i >= 0; --i) {
+      slab.free_blocks.push_back(slab_offset + i * block_size);
+    }
+    partial_slabs.insert(slab_offset);
+  }
+  // Fill the slab at the lowest address first, so that the others are more
+  // likely to become empty.
+  int64_t slab_offset = *partial_slabs.begin();
+  Slab& slab = slabs_[slab_offset];
+  int64_t offset = slab.free_blocks.back();
+  slab.free_blocks.pop_back();
+  slab.num_used += 1;
+  if (slab.free_blocks.empty()) {
+    partial_slabs.erase(slab_offset);
+  }
+  allocated_ += block_size;
+  return offset;
+}
+
+int64_t ExtentAllocator::AllocateExtent(int64_t size, bool is_slab) {
+  // Take the smallest free extent that fits, at the lowest address among the
+  // ones of the same size.
+  auto it = free_by_size_.lower_bound(std::make_pair(size, int64_t(0)));
+  if (it == free_by_size_.end()) {
+    return -1;
+  }
+  int64_t extent_size = it->first;
+  int64_t offset = it->second;
+  RemoveFreeExtent(offset, extent_size);
+  if (extent_size > size) {
+    AddFreeExtent(offset + size, extent_size - size);
+  }
+  extents_[offset] = {size, is_slab};
+  return offset;
+}
+
+void ExtentAllocator::Free(int64_t offset) {
+  auto it = extents_.upper_bound(offset);
+  ARROW_CHECK(it != extents_.begin()) << "freeing memory that is not allocated";
+  --it;
+  int64_t extent_offset = it->first;
+  Extent extent = it->second;
+  ARROW_CHECK(offset < extent_offset + extent.size)
+      << "freeing memory that is not allocated";
+  if (!extent.is_slab) {
+    ARROW_CHECK(offset == extent_offset);
+    allocated_ -= extent.size;
+    extents_.erase(it);
+    AddFreeExtent(extent_offset, extent.size);
+    return;
+  }
+  Slab& slab = slabs_[extent_offset];
+  slab.free_blocks.push_back(offset);
+  slab.num_used -= 1;
+  allocated_ -= class_sizes_[slab.size_class];
+  if (slab.num_used == 0) {
+    partial_slabs_[slab.size_class].erase(extent_offset);
+    slabs_.erase(extent_offset);
+    extents_.erase(it);
+    AddFreeExtent(extent_offset, extent.size);
+  } else if (slab.free_blocks.size() == 1) {
+    partial_slabs_[slab.size_class].insert(extent_offset);
+  }
+}
+
+void ExtentAllocator::AddFreeExtent(int64_t offset, int64_t size) {
+  // Merge the extent with the free extents before and after it.
+  auto next = free_by_offset_.find(offset + size);
+  if (next != free_by_offset_.end()) {
+    int64_t next_size = next->second;
+    RemoveFreeExtent(offset + size, next_size);
+    size += next_size;
+  }
+  auto previous = free_by_offset_.lower_bound(offset);
+  if (previous != free_by_offset_.begin()) {
+    --previous;
+    if (previous->first + previous->second == offset) {
+      int64_t previous_offset = previous->first;
+      int64_t previous_size = previous->second;
+      RemoveFreeExtent(previous_offset, previous_size);
+      offset = previous_offset;
+      size += previous_size;
+    }
+  }
+  free_by_offset_[offset] = size;
+  free_by_size_.insert(std::make_pair(size, offset));
+}
+
+void ExtentAllocator::RemoveFreeExtent(int64_t offset, int64_t size) {
+  free_by_offset_.erase(offset);
+  free_by_size_.erase(std::make_pair(size, offset));
+}
+
+int64_t ExtentAllocator::largest_free_extent() const {
+  return free_by_size_.empty() ? 0 : free_by_size_.rbegin()->first;
+}
+
+bool ExtentAllocator::FindEvictionRange(int64_t size,
+                                        const std::function<bool(int64_t)>& is_evictable,
+                                        std::vector<int64_t>* offsets) const {
+  size = RoundUp(size);
+  // The memory in address order, as free extents and allocated extents that
+  // can or cannot be evicted.
+  struct Segment {
+    int64_t offset;
+    int64_t size;
+    /// The number of bytes that are evicted, or -1 if it cannot be evicted.
+    int64_t cost;
+    /// The allocations in the segment, as a range of allocations.
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Segment> segments;
+  std::vector<int64_t> allocations;
+  int64_t position = 0;
+  for (const auto& element : extents_) {
+    const int64_t offset = element.first;
+    const Extent& extent = element.second;
+    if (offset > position) {
+      segments.push_back({position, offset - position, 0, 0, 0});
+    }
+    Segment segment = {offset, extent.size, 0, allocations.size(), 0};
+    if (extent.is_slab) {
+      const Slab& slab = slabs_.at(offset);
+      const int64_t block_size = class_sizes_[slab.size_class];
+      std::set<int64_t> free_blocks(slab.free_blocks.begin(), slab.free_blocks.end());
+      for (int64_t block = offset; block + block_size <= offset + extent.size;
+           block += block_size) {
+        if (free_blocks.count(block) != 0) {
+          continue;
+        }
+        if (!is_evictable(block)) {
+          segment.cost = -1;
+          break;
+        }
+        allocations.push_back(block);
+        segment.cost += block_size;
+      }
+    } else if (is_evictable(offset)) {
+      allocations.push_back(offset);
+      segment.cost = extent.size;
+    } else {
+      segment.cost = -1;
+    }
+    if (segment.cost == -1) {
+      allocations.resize(segment.begin);
+    }
+    segment.end = allocations.size();
+    segments.push_back(segment);
+    position = offset + extent.size;
+  }
+  if (position < capacity_) {
+    segments.push_back({position, capacity_ - position, 0, 0, 0});
+  }
+
+  // Slide a window over the segments that can be evicted, and keep the
+  // cheapest one that is large enough.
+  int64_t best_cost = std::numeric_limits<int64_t>::max();
+  size_t best_begin = 0;
+  size_t best_end = 0;
+  size_t begin = 0;
+  int64_t window_size = 0;
+  int64_t window_cost = 0;
+  for (size_t end = 0; end < segments.size(); ++end) {
+    if (segments[end].cost == -1) {
+      begin = end + 1;
+      window_size = 0;
+      window_cost = 0;
+      continue;
+    }
+    window_size += segments[end].size;
+    window_cost += segments[end].cost;
+    while (window_size - segments[begin].size >= size) {
+      window_size -= segments[begin].size;
+      window_cost -= segments[begin].cost;
+      ++begin;
+    }
+    if (window_size >= size && window_cost < best_cost) {
+      best_cost = window_cost;
+      best_begin = begin;
+      best_end = end + 1;
+    }
+  }
+  if (best_cost == std::numeric_limits<int64_t>::max()) {
+    return false;
+  }
+  for (size_t i = best_begin; i < best_end; ++i) {
+    offsets->insert(offsets->end(), allocations.begin() + segments[i].begin,
+                    allocations.begin() + segments[i].end);
+  }
+  return true;
+}
+
+}  // namespace plasma
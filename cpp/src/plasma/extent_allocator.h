@@ -0,0 +1,133 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PLASMA_EXTENT_ALLOCATOR_H
+#define PLASMA_EXTENT_ALLOCATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace plasma {
+
+/// The alignment of all allocations, and the granularity of their sizes.
+constexpr int64_t kExtentAlignment = 64;
+
+/// Objects up to this size are allocated from slabs of equally sized blocks.
+constexpr int64_t kMaxSmallObjectSize = 64 * 1024;
+
+/// The size of the slabs that small objects are allocated from.
+constexpr int64_t kSlabSize = 1024 * 1024;
+
+/// An allocator of a fixed range of memory, which is only dealt with as
+/// offsets into the range.
+///
+/// Small objects are allocated from slabs, each of which holds blocks of one
+/// size class. A slab is returned as a whole once all of its blocks are free,
+/// so small objects that come and go do not leave holes between the large
+/// ones. Large objects are allocated from the free extent that fits them most
+/// closely, and free extents are merged with their neighbors.
+class ExtentAllocator {
+ public:
+  /// @param capacity The size in bytes of the range of memory.
+  explicit ExtentAllocator(int64_t capacity);
+
+  /// Allocate memory.
+  ///
+  /// @param size The number of bytes to allocate.
+  /// @return The offset of the allocated memory, or -1 if there is no free
+  ///         extent that is large enough.
+  int64_t Allocate(int64_t size);
+
+  /// Free memory that has been allocated.
+  ///
+  /// @param offset The offset returned by Allocate.
+  void Free(int64_t offset);
+
+  /// Find the contiguous range of memory that can be freed for an allocation
+  /// by evicting the fewest bytes. Slabs can only be evicted as a whole.
+  ///
+  /// @param size The number of bytes to allocate.
+  /// @param is_evictable Whether the allocation at an offset can be evicted.
+  /// @param offsets The offsets of the allocations that have to be evicted.
+  /// @return True if such a range exists.
+  bool FindEvictionRange(int64_t size, const std::function<bool(int64_t)>& is_evictable,
+                         std::vector<int64_t>* offsets) const;
+
+  /// The size in bytes of the range of memory.
+  int64_t capacity() const { return capacity_; }
+
+  /// The number of bytes that are allocated, after rounding up the sizes.
+  int64_t allocated() const { return allocated_; }
+
+  /// The number of bytes that are free, including the free blocks of slabs.
+  int64_t free() const { return capacity_ - allocated_; }
+
+  /// The number of free extents outside of slabs.
+  int64_t num_free_extents() const {
+    return static_cast<int64_t>(free_by_offset_.size());
+  }
+
+  /// The size in bytes of the largest free extent.
+  int64_t largest_free_extent() const;
+
+ private:
+  struct Extent {
+    int64_t size;
+    /// Whether the extent is a slab rather than a large object.
+    bool is_slab;
+  };
+
+  struct Slab {
+    int size_class;
+    /// The offsets of the free blocks, the lowest one last.
+    std::vector<int64_t> free_blocks;
+    int64_t num_used;
+  };
+
+  /// Return the index of the smallest size class that fits an object.
+  int SizeClass(int64_t size) const;
+
+  int64_t AllocateBlock(int size_class);
+
+  int64_t AllocateExtent(int64_t size, bool is_slab);
+
+  void AddFreeExtent(int64_t offset, int64_t size);
+
+  void RemoveFreeExtent(int64_t offset, int64_t size);
+
+  int64_t capacity_;
+  int64_t allocated_;
+  /// The block sizes of the size classes, in increasing order.
+  std::vector<int64_t> class_sizes_;
+  /// The allocated extents by offset.
+  std::map<int64_t, Extent> extents_;
+  /// The slabs by offset.
+  std::map<int64_t, Slab> slabs_;
+  /// The offsets of the slabs of each size class that have free blocks.
+  std::vector<std::set<int64_t>> partial_slabs_;
+  /// The free extents by offset and by size.
+  std::map<int64_t, int64_t> free_by_offset_;
+  std::set<std::pair<int64_t, int64_t>> free_by_size_;
+};
+
+}  // namespace plasma
+
+#endif  // PLASMA_EXTENT_ALLOCATOR_H
@@ -25,6 +25,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <string>
 #include <unordered_map>
@@ -45,6 +46,7 @@ int fake_munmap(void*, int64_t);
 #define HAVE_MORECORE 0
 #define DEFAULT_MMAP_THRESHOLD MAX_SIZE_T
 #define DEFAULT_GRANULARITY ((size_t)128U * 1024U)
+#define MALLOC_INSPECT_ALL 1
 
 #include "thirdparty/dlmalloc.c"  // NOLINT
 
@@ -55,6 +57,7 @@ int fake_munmap(void*, int64_t);
 #undef USE_DL_PREFIX
 #undef HAVE_MORECORE
 #undef DEFAULT_GRANULARITY
+#undef MALLOC_INSPECT_ALL
 }
 
 struct mmap_record {
@@ -208,3 +211,27 @@ int64_t get_mmap_size(int fd) {
 }
 
 void set_malloc_granularity(int value) { change_mparam(M_GRANULARITY, value); }
+
+void* map_object_memory(int64_t size) {
+  void* pointer = fake_mmap(static_cast<size_t>(size));
+  return pointer == MAP_FAILED ? NULL : pointer;
+}
+
+static void find_largest_free_chunk(void* start, void* end, size_t used_bytes,
+                                    void* largest_free) {
+  int64_t* largest = reinterpret_cast<int64_t*>(largest_free);
+  if (used_bytes == 0) {
+    *largest = std::max(*largest, static_cast<int64_t>(pointer_distance(start, end)));
+  }
+}
+
+void get_malloc_stats(int64_t* footprint, int64_t* allocated, int64_t* free,
+                      int64_t* free_chunks, int64_t* largest_free) {
+  struct mallinfo info = dlmallinfo();
+  *footprint = static_cast<int64_t>(dlmalloc_footprint());
+  *allocated = static_cast<int64_t>(info.uordblks);
+  *free = static_cast<int64_t>(info.fordblks);
+  *free_chunks = static_cast<int64_t>(info.ordblks);
+  *largest_free = 0;
+  dlmalloc_inspect_all(find_largest_free_chunk, largest_free);
+}
@@ -31,4 +31,21 @@ int64_t get_mmap_size(int fd);
 
 void set_malloc_granularity(int value);
 
+/// Map a file for objects that are not allocated by dlmalloc. Like the files
+/// of dlmalloc, its file descriptor can be looked up with get_malloc_mapinfo.
+///
+/// @param size The size in bytes of the file.
+/// @return The address of the mapped file, or NULL if it could not be mapped.
+void* map_object_memory(int64_t size);
+
+/// Get statistics of the allocator of the objects. This walks all chunks.
+///
+/// @param footprint The number of bytes that have been mapped.
+/// @param allocated The number of mapped bytes that are allocated.
+/// @param free The number of mapped bytes that are free.
+/// @param free_chunks The number of free chunks.
+/// @param largest_free The size in bytes of the largest free chunk.
+void get_malloc_stats(int64_t* footprint, int64_t* allocated, int64_t* free,
+                      int64_t* free_chunks, int64_t* largest_free);
+
 #endif  // MALLOC_H
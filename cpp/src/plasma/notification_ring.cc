@@ -0,0 +1,232 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "plasma/notification_ring.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "arrow/util/logging.h"
+
+namespace plasma {
+
+using arrow::Status;
+
+// The ring is shared between processes, so the atomics must not use locks.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64 bit atomics must be lock free");
+
+/// Set in the cursor of a reader that has been detached.
+constexpr int64_t kReaderDetached = int64_t(1) << 62;
+
+struct NotificationRingReader {
+  /// The sequence number of the next notification to read, possibly with
+  /// kReaderDetached set.
+  std::atomic<int64_t> read_sequence;
+  /// Set by the reader before it waits to be woken up.
+  std::atomic<int64_t> waiting;
+  /// Keep the readers on separate cache lines.
+  uint8_t padding[48];
+};
+
+struct NotificationRingHeader {
+  /// The sequence number of the next notification that is written.
+  std::atomic<int64_t> write_sequence;
+  uint8_t padding[56];
+  NotificationRingReader readers[kNotificationRingMaxReaders];
+};
+
+struct NotificationRingSlot {
+  int64_t size;
+  uint8_t data[kNotificationRingSlotSize];
+};
+
+static int64_t RingFileSize() {
+  return sizeof(NotificationRingHeader) +
+         kNotificationRingCapacity * sizeof(NotificationRingSlot);
+}
+
+NotificationRing::NotificationRing(int fd, int64_t size, uint8_t* pointer)
+    : fd_(fd),
+      size_(size),
+      header_(reinterpret_cast<NotificationRingHeader*>(pointer)),
+      slots_(reinterpret_cast<NotificationRingSlot*>(pointer +
+                                                      sizeof(NotificationRingHeader))),
+      write_sequence_(0),
+      readers_in_use_(kNotificationRingMaxReaders, false) {}
+
+NotificationRing::~NotificationRing() {
+  munmap(header_, size_);
+  close(fd_);
+}
+
+Status NotificationRing::Create(const std::string& directory,
+                                std::unique_ptr<NotificationRing>* ring) {
+  std::string path = directory + "/plasmaNotificationsXXXXXX";
+  std::vector<char> file_name(path.begin(), path.end());
+  file_name.push_back('\0');
+  int fd = mkstemp(file_name.data());
+  if (fd < 0) {
+    return Status::IOError("could not create notification ring in " + directory + ": " +
+                           strerror(errno));
+  }
+  // The file is only reachable through its file descriptor.
+  unlink(file_name.data());
+  int64_t size = RingFileSize();
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    return Status::IOError(std::string("could not resize notification ring: ") +
+                           strerror(errno));
+  }
+  void* pointer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (pointer == MAP_FAILED) {
+    close(fd);
+    return Status::IOError(std::string("could not map notification ring: ") +
+                           strerror(errno));
+  }
+  // The file is zero filled, which initializes all cursors to 0.
+  ring->reset(new NotificationRing(fd, size, reinterpret_cast<uint8_t*>(pointer)));
+  return Status::OK();
+}
+
+Status NotificationRing::Open(int fd, int64_t size,
+                              std::unique_ptr<NotificationRing>* ring) {
+  if (size != RingFileSize()) {
+    close(fd);
+    return Status::IOError("notification ring has an unexpected size");
+  }
+  void* pointer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (pointer == MAP_FAILED) {
+    close(fd);
+    return Status::IOError(std::string("could not map notification ring: ") +
+                           strerror(errno));
+  }
+  ring->reset(new NotificationRing(fd, size, reinterpret_cast<uint8_t*>(pointer)));
+  return Status::OK();
+}
+
+int NotificationRing::AddReader() {
+  for (int reader = 0; reader < kNotificationRingMaxReaders; ++reader) {
+    if (!readers_in_use_[reader]) {
+      readers_in_use_[reader] = true;
+      // A new subscriber has not read anything, so it is woken up by the
+      // first notification.
+      header_->readers[reader].waiting = 1;
+      header_->readers[reader].read_sequence = write_sequence();
+      return reader;
+    }
+  }
+  return -1;
+}
+
+void NotificationRing::RemoveReader(int reader) {
+  DCHECK(readers_in_use_[reader]);
+  readers_in_use_[reader] = false;
+}
+
+int64_t NotificationRing::DetachIfFull(int reader) {
+  auto& read_sequence = header_->readers[reader].read_sequence;
+  int64_t sequence = read_sequence.load();
+  while (!(sequence & kReaderDetached) &&
+         write_sequence_ - sequence >= kNotificationRingCapacity) {
+    if (read_sequence.compare_exchange_weak(sequence, sequence | kReaderDetached)) {
+      return ClampSequence(sequence);
+    }
+    // The reader has advanced in the meantime, check again.
+  }
+  return -1;
+}
+
+int64_t NotificationRing::Detach(int reader) {
+  auto& read_sequence = header_->readers[reader].read_sequence;
+  int64_t sequence = read_sequence.load();
+  // The reader may advance in the meantime, in which case this is retried.
+  while (!(sequence & kReaderDetached) &&
+         !read_sequence.compare_exchange_weak(sequence, sequence | kReaderDetached)) {
+  }
+  return ClampSequence(sequence & ~kReaderDetached);
+}
+
+int64_t NotificationRing::ClampSequence(int64_t sequence) const {
+  int64_t oldest = std::max<int64_t>(write_sequence_ - kNotificationRingCapacity, 0);
+  return std::min(std::max(sequence, oldest), write_sequence_);
+}
+
+void NotificationRing::Get(int64_t sequence, const uint8_t** data,
+                           int64_t* size) const {
+  DCHECK(sequence < write_sequence());
+  DCHECK(write_sequence() - sequence <= kNotificationRingCapacity);
+  const NotificationRingSlot& slot = slots_[sequence % kNotificationRingCapacity];
+  *data = slot.data;
+  *size = slot.size;
+}
+
+void NotificationRing::Write(const uint8_t* data, int64_t size) {
+  DCHECK(size <= kNotificationRingSlotSize);
+  NotificationRingSlot& slot = slots_[write_sequence_ % kNotificationRingCapacity];
+  slot.size = size;
+  memcpy(slot.data, data, size);
+  write_sequence_ += 1;
+  // This is sequentially consistent so that it is ordered before the check of
+  // the waiting flags in TakeWaiting, see PrepareWait.
+  header_->write_sequence.store(write_sequence_);
+}
+
+bool NotificationRing::TakeWaiting(int reader) {
+  // Avoid the write if the flag is not set, which is the common case.
+  auto& waiting = header_->readers[reader].waiting;
+  return waiting.load() != 0 && waiting.exchange(0) != 0;
+}
+
+NotificationRing::ReadStatus NotificationRing::Read(int reader,
+                                                    std::vector<uint8_t>* notification) {
+  auto& read_sequence = header_->readers[reader].read_sequence;
+  int64_t sequence = read_sequence.load(std::memory_order_acquire);
+  if (sequence & kReaderDetached) {
+    return ReadStatus::DETACHED;
+  }
+  if (sequence == header_->write_sequence.load(std::memory_order_acquire)) {
+    return ReadStatus::EMPTY;
+  }
+  const NotificationRingSlot& slot = slots_[sequence % kNotificationRingCapacity];
+  int64_t size = std::min(slot.size, kNotificationRingSlotSize);
+  notification->assign(slot.data, slot.data + size);
+  // If the store has detached the reader in the meantime, the slot may have
+  // been overwritten while it was copied. The notification is then discarded,
+  // since the store sends it through the socket.
+  if (!read_sequence.compare_exchange_strong(sequence, sequence + 1)) {
+    return ReadStatus::DETACHED;
+  }
+  return ReadStatus::OK;
+}
+
+bool NotificationRing::PrepareWait(int reader) {
+  NotificationRingReader& state = header_->readers[reader];
+  state.waiting.store(1);
+  // The store writes the notification before it checks the flag, and this
+  // sets the flag before it checks for notifications, so either the store
+  // sees the flag or this sees the notification.
+  int64_t sequence = state.read_sequence.load();
+  return (sequence & kReaderDetached) || sequence != header_->write_sequence.load();
+}
+
+}  // namespace plasma
@@ -0,0 +1,189 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PLASMA_NOTIFICATION_RING_H
+#define PLASMA_NOTIFICATION_RING_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/status.h"
+
+namespace plasma {
+
+/// The maximum number of subscribers that can read from the ring at the same
+/// time. Further subscribers receive notifications through their socket.
+constexpr int kNotificationRingMaxReaders = 64;
+
+/// The number of notifications that the ring holds.
+constexpr int64_t kNotificationRingCapacity = 4096;
+
+/// The maximum size in bytes of a notification in the ring.
+constexpr int64_t kNotificationRingSlotSize = 248;
+
+struct NotificationRingHeader;
+struct NotificationRingSlot;
+
+/// A ring buffer in shared memory through which the store sends object
+/// notifications to subscribers in other processes.
+///
+/// The store is the only writer, and every notification is written once no
+/// matter how many subscribers there are. Each subscriber reads with its own
+/// cursor, called a reader. The store never overwrites a notification that an
+/// attached reader has not read. Before that would happen, the store detaches
+/// the reader and sends the notifications it has not read through its socket
+/// instead. A reader claims a notification by advancing its cursor with a
+/// compare-and-swap, which fails once it has been detached, so every
+/// notification is delivered exactly once.
+///
+/// Readers that are about to block set a flag in the ring, and the store only
+/// wakes up the readers whose flag is set, so that busy readers do not cost a
+/// system call per notification.
+class NotificationRing {
+ public:
+  enum class ReadStatus {
+    /// A notification has been read.
+    OK,
+    /// There is no notification to read.
+    EMPTY,
+    /// The reader has been detached, further notifications must be read from
+    /// the socket.
+    DETACHED
+  };
+
+  ~NotificationRing();
+
+  /// Create a ring in a new memory mapped file. This is called by the store.
+  ///
+  /// @param directory The directory in which the file is created. It is
+  ///        unlinked right away.
+  /// @param ring The created ring.
+  /// @return The return status.
+  static arrow::Status Create(const std::string& directory,
+                              std::unique_ptr<NotificationRing>* ring);
+
+  /// Map a ring that has been created by the store. This is called by
+  /// subscribers.
+  ///
+  /// @param fd The file descriptor of the ring. The ring takes ownership of it.
+  /// @param size The size in bytes of the file.
+  /// @param ring The mapped ring.
+  /// @return The return status.
+  static arrow::Status Open(int fd, int64_t size,
+                            std::unique_ptr<NotificationRing>* ring);
+
+  /// The file descriptor of the memory mapped file.
+  int fd() const { return fd_; }
+
+  /// The size in bytes of the memory mapped file.
+  int64_t size() const { return size_; }
+
+  // The following methods are called by the store.
+
+  /// Assign a reader to a new subscriber. It starts at the next notification
+  /// that is written.
+  ///
+  /// @return The index of the reader, or -1 if all readers are in use.
+  int AddReader();
+
+  /// Release a reader after its subscriber has gone away.
+  ///
+  /// @param reader The index of the reader.
+  void RemoveReader(int reader);
+
+  /// Detach a reader if writing the next notification would overwrite a
+  /// notification that it has not read. Subscribers can write to their cursor,
+  /// so the sequence numbers that are returned here and by Detach are limited
+  /// to the notifications that are still in the ring.
+  ///
+  /// @param reader The index of the reader.
+  /// @return The sequence number of the first notification that the reader
+  ///         has not read if it has been detached, -1 otherwise.
+  int64_t DetachIfFull(int reader);
+
+  /// Detach a reader, for example because the next notification does not fit
+  /// into a slot of the ring.
+  ///
+  /// @param reader The index of the reader. It must not be detached already.
+  /// @return The sequence number of the first notification that the reader
+  ///         has not read.
+  int64_t Detach(int reader);
+
+  /// The sequence number of the next notification that is written.
+  int64_t write_sequence() const { return write_sequence_; }
+
+  /// Look up a notification that has been written, but not overwritten yet.
+  ///
+  /// @param sequence The sequence number of the notification.
+  /// @param data The notification.
+  /// @param size The size in bytes of the notification.
+  void Get(int64_t sequence, const uint8_t** data, int64_t* size) const;
+
+  /// Append a notification. The attached readers must have room for it, see
+  /// DetachIfFull.
+  ///
+  /// @param data The notification.
+  /// @param size The size in bytes of the notification. It must not exceed
+  ///        kNotificationRingSlotSize, larger notifications have to be sent
+  ///        through the sockets, see Detach.
+  void Write(const uint8_t* data, int64_t size);
+
+  /// Check whether a reader waits to be woken up, and reset that.
+  ///
+  /// @param reader The index of the reader.
+  /// @return True if the reader has to be woken up.
+  bool TakeWaiting(int reader);
+
+  // The following methods are called by subscribers.
+
+  /// Read the next notification of a reader.
+  ///
+  /// @param reader The index of the reader.
+  /// @param notification The notification that has been read.
+  /// @return Whether a notification has been read.
+  ReadStatus Read(int reader, std::vector<uint8_t>* notification);
+
+  /// Announce that a reader is going to wait to be woken up.
+  ///
+  /// @param reader The index of the reader.
+  /// @return True if the reader does not need to wait, because there are
+  ///         notifications to read or it has been detached.
+  bool PrepareWait(int reader);
+
+ private:
+  NotificationRing(int fd, int64_t size, uint8_t* pointer);
+
+  /// Limit a sequence number that has been read from a cursor to the
+  /// notifications that are still in the ring.
+  int64_t ClampSequence(int64_t sequence) const;
+
+  int fd_;
+  int64_t size_;
+  NotificationRingHeader* header_;
+  NotificationRingSlot* slots_;
+  /// The sequence number of the next notification that is written. The store
+  /// only publishes it in the header, which subscribers can write to as well.
+  /// Only used by the store.
+  int64_t write_sequence_;
+  /// The readers that are assigned to subscribers. Only used by the store.
+  std::vector<bool> readers_in_use_;
+};
+
+}  // namespace plasma
+
+#endif  // PLASMA_NOTIFICATION_RING_H
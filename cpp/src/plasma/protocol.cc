@@ -17,6 +17,8 @@
 
 #include "plasma/protocol.h"
 
+#include <string.h>
+
 #include "flatbuffers/flatbuffers.h"
 #include "plasma/plasma_generated.h"
 
@@ -56,6 +58,18 @@ Status PlasmaSend(int sock, int64_t message_type, flatbuffers::FlatBufferBuilder
   return WriteMessage(sock, message_type, fbb->GetSize(), fbb->GetBufferPointer());
 }
 
+template <typename Message>
+void PlasmaSerialize(int64_t message_type, flatbuffers::FlatBufferBuilder* fbb,
+                     const Message& message, std::vector<uint8_t>* buffer) {
+  fbb->Finish(message);
+  // The header is the same as the one written by WriteMessage.
+  int64_t header[] = {PLASMA_PROTOCOL_VERSION, message_type,
+                      static_cast<int64_t>(fbb->GetSize())};
+  buffer->resize(sizeof(header) + fbb->GetSize());
+  memcpy(buffer->data(), header, sizeof(header));
+  memcpy(buffer->data() + sizeof(header), fbb->GetBufferPointer(), fbb->GetSize());
+}
+
 // Create messages.
 
 Status SendCreateRequest(int sock, ObjectID object_id, int64_t data_size,
@@ -135,6 +149,82 @@ Status ReadCreateReply(uint8_t* data, size_t size, ObjectID* object_id,
   return plasma_error_status(message->error());
 }
 
+Status SendCreateBatchRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
+                              const int64_t* data_sizes, const int64_t* metadata_sizes) {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<uint64_t> data_size_vector(data_sizes, data_sizes + num_objects);
+  std::vector<uint64_t> metadata_size_vector(metadata_sizes,
+                                             metadata_sizes + num_objects);
+  auto message = CreatePlasmaCreateBatchRequest(
+      fbb, to_flatbuffer(&fbb, object_ids, num_objects),
+      fbb.CreateVector(data_size_vector), fbb.CreateVector(metadata_size_vector));
+  return PlasmaSend(sock, MessageType_PlasmaCreateBatchRequest, &fbb, message);
+}
+
+Status ReadCreateBatchRequest(uint8_t* data, size_t size,
+                              std::vector<ObjectID>* object_ids,
+                              std::vector<int64_t>* data_sizes,
+                              std::vector<int64_t>* metadata_sizes) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaCreateBatchRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  uoffset_t num_objects = message->object_ids()->size();
+  ARROW_CHECK(message->data_sizes()->size() == num_objects);
+  ARROW_CHECK(message->metadata_sizes()->size() == num_objects);
+  for (uoffset_t i = 0; i < num_objects; ++i) {
+    object_ids->push_back(ObjectID::from_binary(message->object_ids()->Get(i)->str()));
+    data_sizes->push_back(message->data_sizes()->Get(i));
+    metadata_sizes->push_back(message->metadata_sizes()->Get(i));
+  }
+  return Status::OK();
+}
+
+Status SendCreateBatchReply(int sock, const std::vector<ObjectID>& object_ids,
+                            const std::vector<PlasmaObject>& objects, int error,
+                            const std::vector<int>& store_fds,
+                            const std::vector<int64_t>& mmap_sizes) {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<PlasmaObjectSpec> object_specs;
+  for (const auto& object : objects) {
+    object_specs.push_back(PlasmaObjectSpec(object.store_fd, object.data_offset,
+                                            object.data_size, object.metadata_offset,
+                                            object.metadata_size, object.device_num));
+  }
+  auto message = CreatePlasmaCreateBatchReply(
+      fbb, to_flatbuffer(&fbb, object_ids.data(), object_ids.size()),
+      fbb.CreateVectorOfStructs(object_specs), static_cast<PlasmaError>(error),
+      fbb.CreateVector(store_fds), fbb.CreateVector(mmap_sizes));
+  return PlasmaSend(sock, MessageType_PlasmaCreateBatchReply, &fbb, message);
+}
+
+Status ReadCreateBatchReply(uint8_t* data, size_t size,
+                            std::vector<ObjectID>* object_ids,
+                            std::vector<PlasmaObject>* objects,
+                            std::vector<int>* store_fds,
+                            std::vector<int64_t>* mmap_sizes) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaCreateBatchReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  for (uoffset_t i = 0; i < message->object_ids()->size(); ++i) {
+    object_ids->push_back(ObjectID::from_binary(message->object_ids()->Get(i)->str()));
+    const PlasmaObjectSpec* spec = message->plasma_objects()->Get(i);
+    PlasmaObject object;
+    object.store_fd = spec->segment_index();
+    object.data_offset = spec->data_offset();
+    object.data_size = spec->data_size();
+    object.metadata_offset = spec->metadata_offset();
+    object.metadata_size = spec->metadata_size();
+    object.device_num = spec->device_num();
+    objects->push_back(object);
+  }
+  ARROW_CHECK(message->store_fds()->size() == message->mmap_sizes()->size());
+  for (uoffset_t i = 0; i < message->store_fds()->size(); i++) {
+    store_fds->push_back(message->store_fds()->Get(i));
+    mmap_sizes->push_back(message->mmap_sizes()->Get(i));
+  }
+  return plasma_error_status(message->error());
+}
+
 Status SendAbortRequest(int sock, ObjectID object_id) {
   flatbuffers::FlatBufferBuilder fbb;
   auto message = CreatePlasmaAbortRequest(fbb, fbb.CreateString(object_id.binary()));
@@ -199,6 +289,29 @@ Status ReadSealReply(uint8_t* data, size_t size, ObjectID* object_id) {
   return plasma_error_status(message->error());
 }
 
+Status SendSealBatchRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
+                            const unsigned char* digests) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaSealBatchRequest(
+      fbb, to_flatbuffer(&fbb, object_ids, num_objects),
+      fbb.CreateVector(digests, num_objects * kDigestSize));
+  return PlasmaSend(sock, MessageType_PlasmaSealBatchRequest, &fbb, message);
+}
+
+Status ReadSealBatchRequest(uint8_t* data, size_t size, std::vector<ObjectID>* object_ids,
+                            std::vector<unsigned char>* digests) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaSealBatchRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  uoffset_t num_objects = message->object_ids()->size();
+  ARROW_CHECK(message->digests()->size() == num_objects * kDigestSize);
+  for (uoffset_t i = 0; i < num_objects; ++i) {
+    object_ids->push_back(ObjectID::from_binary(message->object_ids()->Get(i)->str()));
+  }
+  digests->assign(message->digests()->begin(), message->digests()->end());
+  return Status::OK();
+}
+
 // Release messages.
 
 Status SendReleaseRequest(int sock, ObjectID object_id) {
@@ -230,6 +343,25 @@ Status ReadReleaseReply(uint8_t* data, size_t size, ObjectID* object_id) {
   return plasma_error_status(message->error());
 }
 
+Status SendReleaseBatchRequest(int sock, const ObjectID* object_ids,
+                               int64_t num_objects) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message =
+      CreatePlasmaReleaseBatchRequest(fbb, to_flatbuffer(&fbb, object_ids, num_objects));
+  return PlasmaSend(sock, MessageType_PlasmaReleaseBatchRequest, &fbb, message);
+}
+
+Status ReadReleaseBatchRequest(uint8_t* data, size_t size,
+                               std::vector<ObjectID>* object_ids) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaReleaseBatchRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  for (uoffset_t i = 0; i < message->object_ids()->size(); ++i) {
+    object_ids->push_back(ObjectID::from_binary(message->object_ids()->Get(i)->str()));
+  }
+  return Status::OK();
+}
+
 // Delete messages.
 
 Status SendDeleteRequest(int sock, ObjectID object_id) {
@@ -368,6 +500,68 @@ Status ReadConnectReply(uint8_t* data, size_t size, int64_t* memory_capacity) {
   return Status::OK();
 }
 
+// Info messages.
+
+Status SendInfoRequest(int sock) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaInfoRequest(fbb);
+  return PlasmaSend(sock, MessageType_PlasmaInfoRequest, &fbb, message);
+}
+
+Status SendInfoReply(int sock, const PlasmaStoreStats& stats) {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<PlasmaLatencyHistogram>> latencies;
+  for (const auto& histogram : stats.latencies) {
+    latencies.push_back(CreatePlasmaLatencyHistogram(
+        fbb, fbb.CreateString(histogram.operation), fbb.CreateVector(histogram.counts)));
+  }
+  auto message = CreatePlasmaInfoReply(
+      fbb, stats.num_objects_spilled, stats.bytes_spilled, stats.num_objects_restored,
+      stats.bytes_restored, stats.num_objects_created, stats.bytes_created,
+      stats.num_objects_sealed, stats.bytes_sealed, stats.num_objects_in_use,
+      stats.bytes_in_use, stats.num_objects_evicted, stats.bytes_evicted,
+      stats.allocator_footprint, stats.allocator_allocated, stats.allocator_free,
+      stats.allocator_free_chunks, stats.num_pending_get_requests, stats.num_clients,
+      stats.num_subscribers, fbb.CreateVector(latencies), stats.allocator_largest_free,
+      stats.allocator_fragmentation);
+  return PlasmaSend(sock, MessageType_PlasmaInfoReply, &fbb, message);
+}
+
+Status ReadInfoReply(uint8_t* data, size_t size, PlasmaStoreStats* stats) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaInfoReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  stats->num_objects_spilled = message->num_objects_spilled();
+  stats->bytes_spilled = message->bytes_spilled();
+  stats->num_objects_restored = message->num_objects_restored();
+  stats->bytes_restored = message->bytes_restored();
+  stats->num_objects_created = message->num_objects_created();
+  stats->bytes_created = message->bytes_created();
+  stats->num_objects_sealed = message->num_objects_sealed();
+  stats->bytes_sealed = message->bytes_sealed();
+  stats->num_objects_in_use = message->num_objects_in_use();
+  stats->bytes_in_use = message->bytes_in_use();
+  stats->num_objects_evicted = message->num_objects_evicted();
+  stats->bytes_evicted = message->bytes_evicted();
+  stats->allocator_footprint = message->allocator_footprint();
+  stats->allocator_allocated = message->allocator_allocated();
+  stats->allocator_free = message->allocator_free();
+  stats->allocator_free_chunks = message->allocator_free_chunks();
+  stats->allocator_largest_free = message->allocator_largest_free();
+  stats->allocator_fragmentation = message->allocator_fragmentation();
+  stats->num_pending_get_requests = message->num_pending_get_requests();
+  stats->num_clients = message->num_clients();
+  stats->num_subscribers = message->num_subscribers();
+  stats->latencies.clear();
+  for (const auto& histogram : *message->latencies()) {
+    LatencyHistogram latencies;
+    latencies.operation = histogram->operation()->str();
+    latencies.counts.assign(histogram->counts()->begin(), histogram->counts()->end());
+    stats->latencies.push_back(latencies);
+  }
+  return Status::OK();
+}
+
 // Evict messages.
 
 Status SendEvictRequest(int sock, int64_t num_bytes) {
@@ -580,6 +774,197 @@ Status SendSubscribeRequest(int sock) {
   return PlasmaSend(sock, MessageType_PlasmaSubscribeRequest, &fbb, message);
 }
 
+Status SendSubscribeRingRequest(int sock) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaSubscribeRingRequest(fbb);
+  return PlasmaSend(sock, MessageType_PlasmaSubscribeRingRequest, &fbb, message);
+}
+
+Status SendSubscribeRingReply(int sock, int reader, int64_t ring_size) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaSubscribeRingReply(fbb, reader, ring_size);
+  return PlasmaSend(sock, MessageType_PlasmaSubscribeRingReply, &fbb, message);
+}
+
+Status ReadSubscribeRingReply(uint8_t* data, size_t size, int* reader,
+                              int64_t* ring_size) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaSubscribeRingReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *reader = message->reader();
+  *ring_size = message->ring_size();
+  return Status::OK();
+}
+
+// Asynchronous Get messages.
+
+Status SendGetAsyncConnectRequest(int sock) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaGetAsyncConnectRequest(fbb);
+  return PlasmaSend(sock, MessageType_PlasmaGetAsyncConnectRequest, &fbb, message);
+}
+
+Status SendGetAsyncRequest(int sock, int64_t request_id, const ObjectID* object_ids,
+                           int64_t num_objects, int64_t timeout_ms) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaGetAsyncRequest(
+      fbb, request_id, to_flatbuffer(&fbb, object_ids, num_objects), timeout_ms);
+  return PlasmaSend(sock, MessageType_PlasmaGetAsyncRequest, &fbb, message);
+}
+
+Status ReadGetAsyncRequest(uint8_t* data, size_t size, int64_t* request_id,
+                           std::vector<ObjectID>* object_ids, int64_t* timeout_ms) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaGetAsyncRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *request_id = message->request_id();
+  for (uoffset_t i = 0; i < message->object_ids()->size(); ++i) {
+    object_ids->push_back(ObjectID::from_binary(message->object_ids()->Get(i)->str()));
+  }
+  *timeout_ms = message->timeout_ms();
+  return Status::OK();
+}
+
+Status SerializeGetAsyncReply(int64_t request_id, const ObjectID& object_id,
+                              const PlasmaObject& object, int store_fd,
+                              int64_t mmap_size, std::vector<uint8_t>* buffer) {
+  flatbuffers::FlatBufferBuilder fbb;
+  PlasmaObjectSpec plasma_object(object.store_fd, object.data_offset, object.data_size,
+                                 object.metadata_offset, object.metadata_size,
+                                 object.device_num);
+  auto object_string = fbb.CreateString(object_id.binary());
+#ifdef PLASMA_GPU
+  flatbuffers::Offset<CudaHandle> ipc_handle;
+  if (object.data_size != -1 && object.device_num != 0) {
+    std::shared_ptr<arrow::Buffer> handle;
+    object.ipc_handle->Serialize(arrow::default_memory_pool(), &handle);
+    ipc_handle = CreateCudaHandle(fbb, fbb.CreateVector(handle->data(), handle->size()));
+  }
+#endif
+  PlasmaGetAsyncReplyBuilder builder(fbb);
+  builder.add_request_id(request_id);
+  builder.add_object_id(object_string);
+  builder.add_plasma_object(&plasma_object);
+  builder.add_store_fd(store_fd);
+  builder.add_mmap_size(mmap_size);
+  if (object.data_size != -1 && object.device_num != 0) {
+#ifdef PLASMA_GPU
+    builder.add_ipc_handle(ipc_handle);
+#else
+    ARROW_LOG(FATAL) << "This should be unreachable.";
+#endif
+  }
+  auto message = builder.Finish();
+  PlasmaSerialize(MessageType_PlasmaGetAsyncReply, &fbb, message, buffer);
+  return Status::OK();
+}
+
+Status ReadGetAsyncReply(uint8_t* data, size_t size, int64_t* request_id,
+                         ObjectID* object_id, PlasmaObject* object, int* store_fd,
+                         int64_t* mmap_size) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaGetAsyncReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *request_id = message->request_id();
+  *object_id = ObjectID::from_binary(message->object_id()->str());
+  object->store_fd = message->plasma_object()->segment_index();
+  object->data_offset = message->plasma_object()->data_offset();
+  object->data_size = message->plasma_object()->data_size();
+  object->metadata_offset = message->plasma_object()->metadata_offset();
+  object->metadata_size = message->plasma_object()->metadata_size();
+  object->device_num = message->plasma_object()->device_num();
+  *store_fd = message->store_fd();
+  *mmap_size = message->mmap_size();
+#ifdef PLASMA_GPU
+  if (object->data_size != -1 && object->device_num != 0) {
+    CudaIpcMemHandle::FromBuffer(message->ipc_handle()->handle()->data(),
+                                 &object->ipc_handle);
+  }
+#endif
+  return Status::OK();
+}
+
+// Replicate messages.
+
+Status SendReplicateRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
+                            const std::string& store_socket_name) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message =
+      CreatePlasmaReplicateRequest(fbb, to_flatbuffer(&fbb, object_ids, num_objects),
+                                   fbb.CreateString(store_socket_name));
+  return PlasmaSend(sock, MessageType_PlasmaReplicateRequest, &fbb, message);
+}
+
+Status ReadReplicateRequest(uint8_t* data, size_t size, std::vector<ObjectID>* object_ids,
+                            std::string* store_socket_name) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaReplicateRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  for (uoffset_t i = 0; i < message->object_ids()->size(); ++i) {
+    object_ids->push_back(ObjectID::from_binary(message->object_ids()->Get(i)->str()));
+  }
+  *store_socket_name = message->store_socket_name()->str();
+  return Status::OK();
+}
+
+Status SendReplicateReply(int sock, int error, const std::string& failure) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaReplicateReply(fbb, static_cast<PlasmaError>(error),
+                                            fbb.CreateString(failure));
+  return PlasmaSend(sock, MessageType_PlasmaReplicateReply, &fbb, message);
+}
+
+Status ReadReplicateReply(uint8_t* data, size_t size) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaReplicateReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  RETURN_NOT_OK(plasma_error_status(message->error()));
+  if (message->failure()->size() != 0) {
+    return Status::IOError(message->failure()->str());
+  }
+  return Status::OK();
+}
+
+Status SendReplicaRequest(int sock, const ObjectID& object_id, int64_t data_size,
+                          int64_t metadata_size, const unsigned char* digest) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto digest_string =
+      fbb.CreateString(reinterpret_cast<const char*>(digest), kDigestSize);
+  auto message =
+      CreatePlasmaReplicaRequest(fbb, fbb.CreateString(object_id.binary()), data_size,
+                                 metadata_size, digest_string);
+  return PlasmaSend(sock, MessageType_PlasmaReplicaRequest, &fbb, message);
+}
+
+Status ReadReplicaRequest(uint8_t* data, size_t size, ObjectID* object_id,
+                          int64_t* data_size, int64_t* metadata_size,
+                          unsigned char* digest) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaReplicaRequest>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *object_id = ObjectID::from_binary(message->object_id()->str());
+  *data_size = message->data_size();
+  *metadata_size = message->metadata_size();
+  ARROW_CHECK(message->digest()->size() == kDigestSize);
+  memcpy(digest, message->digest()->data(), kDigestSize);
+  return Status::OK();
+}
+
+Status SendReplicaReply(int sock, const ObjectID& object_id, int error) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = CreatePlasmaReplicaReply(fbb, fbb.CreateString(object_id.binary()),
+                                          static_cast<PlasmaError>(error));
+  return PlasmaSend(sock, MessageType_PlasmaReplicaReply, &fbb, message);
+}
+
+Status ReadReplicaReply(uint8_t* data, size_t size, ObjectID* object_id) {
+  DCHECK(data);
+  auto message = flatbuffers::GetRoot<PlasmaReplicaReply>(data);
+  DCHECK(verify_flatbuffer(message, data, size));
+  *object_id = ObjectID::from_binary(message->object_id()->str());
+  return plasma_error_status(message->error());
+}
+
 // Data messages.
 
 Status SendDataRequest(int sock, ObjectID object_id, const char* address, int port) {
@@ -62,6 +62,27 @@ Status SendAbortReply(int sock, ObjectID object_id);
 
 Status ReadAbortReply(uint8_t* data, size_t size, ObjectID* object_id);
 
+/* Plasma batched Create message functions. */
+
+Status SendCreateBatchRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
+                              const int64_t* data_sizes, const int64_t* metadata_sizes);
+
+Status ReadCreateBatchRequest(uint8_t* data, size_t size,
+                              std::vector<ObjectID>* object_ids,
+                              std::vector<int64_t>* data_sizes,
+                              std::vector<int64_t>* metadata_sizes);
+
+Status SendCreateBatchReply(int sock, const std::vector<ObjectID>& object_ids,
+                            const std::vector<PlasmaObject>& objects, int error,
+                            const std::vector<int>& store_fds,
+                            const std::vector<int64_t>& mmap_sizes);
+
+Status ReadCreateBatchReply(uint8_t* data, size_t size,
+                            std::vector<ObjectID>* object_ids,
+                            std::vector<PlasmaObject>* objects,
+                            std::vector<int>* store_fds,
+                            std::vector<int64_t>* mmap_sizes);
+
 /* Plasma Seal message functions. */
 
 Status SendSealRequest(int sock, ObjectID object_id, unsigned char* digest);
@@ -73,6 +94,12 @@ Status SendSealReply(int sock, ObjectID object_id, int error);
 
 Status ReadSealReply(uint8_t* data, size_t size, ObjectID* object_id);
 
+Status SendSealBatchRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
+                            const unsigned char* digests);
+
+Status ReadSealBatchRequest(uint8_t* data, size_t size, std::vector<ObjectID>* object_ids,
+                            std::vector<unsigned char>* digests);
+
 /* Plasma Get message functions. */
 
 Status SendGetRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
@@ -101,6 +128,11 @@ Status SendReleaseReply(int sock, ObjectID object_id, int error);
 
 Status ReadReleaseReply(uint8_t* data, size_t size, ObjectID* object_id);
 
+Status SendReleaseBatchRequest(int sock, const ObjectID* object_ids, int64_t num_objects);
+
+Status ReadReleaseBatchRequest(uint8_t* data, size_t size,
+                               std::vector<ObjectID>* object_ids);
+
 /* Plasma Delete message functions. */
 
 Status SendDeleteRequest(int sock, ObjectID object_id);
@@ -147,6 +179,14 @@ Status SendConnectReply(int sock, int64_t memory_capacity);
 
 Status ReadConnectReply(uint8_t* data, size_t size, int64_t* memory_capacity);
 
+/* Plasma Info message functions. */
+
+Status SendInfoRequest(int sock);
+
+Status SendInfoReply(int sock, const PlasmaStoreStats& stats);
+
+Status ReadInfoReply(uint8_t* data, size_t size, PlasmaStoreStats* stats);
+
 /* Plasma Evict message functions (no reply so far). */
 
 Status SendEvictRequest(int sock, int64_t num_bytes);
@@ -181,6 +221,56 @@ Status ReadWaitReply(uint8_t* data, size_t size, ObjectRequest object_requests[]
 
 Status SendSubscribeRequest(int sock);
 
+Status SendSubscribeRingRequest(int sock);
+
+Status SendSubscribeRingReply(int sock, int reader, int64_t ring_size);
+
+Status ReadSubscribeRingReply(uint8_t* data, size_t size, int* reader,
+                              int64_t* ring_size);
+
+/* Plasma asynchronous Get message functions. */
+
+Status SendGetAsyncConnectRequest(int sock);
+
+Status SendGetAsyncRequest(int sock, int64_t request_id, const ObjectID* object_ids,
+                           int64_t num_objects, int64_t timeout_ms);
+
+Status ReadGetAsyncRequest(uint8_t* data, size_t size, int64_t* request_id,
+                           std::vector<ObjectID>* object_ids, int64_t* timeout_ms);
+
+/// The replies are sent from the event loop of the store without blocking, so
+/// they are written to a buffer, which includes the header of the message.
+Status SerializeGetAsyncReply(int64_t request_id, const ObjectID& object_id,
+                              const PlasmaObject& object, int store_fd,
+                              int64_t mmap_size, std::vector<uint8_t>* buffer);
+
+Status ReadGetAsyncReply(uint8_t* data, size_t size, int64_t* request_id,
+                         ObjectID* object_id, PlasmaObject* object, int* store_fd,
+                         int64_t* mmap_size);
+
+/* Plasma Replicate message functions. */
+
+Status SendReplicateRequest(int sock, const ObjectID* object_ids, int64_t num_objects,
+                            const std::string& store_socket_name);
+
+Status ReadReplicateRequest(uint8_t* data, size_t size, std::vector<ObjectID>* object_ids,
+                            std::string* store_socket_name);
+
+Status SendReplicateReply(int sock, int error, const std::string& failure);
+
+Status ReadReplicateReply(uint8_t* data, size_t size);
+
+Status SendReplicaRequest(int sock, const ObjectID& object_id, int64_t data_size,
+                          int64_t metadata_size, const unsigned char* digest);
+
+Status ReadReplicaRequest(uint8_t* data, size_t size, ObjectID* object_id,
+                          int64_t* data_size, int64_t* metadata_size,
+                          unsigned char* digest);
+
+Status SendReplicaReply(int sock, const ObjectID& object_id, int error);
+
+Status ReadReplicaReply(uint8_t* data, size_t size, ObjectID* object_id);
+
 /* Data messages. */
 
 Status SendDataRequest(int sock, ObjectID object_id, const char* address, int port);
@@ -0,0 +1,202 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "plasma/replication.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+#include <utility>
+
+#include "plasma/io.h"
+#include "plasma/protocol.h"
+
+namespace plasma {
+
+using arrow::Status;
+
+namespace {
+
+// Send a range of a memory mapped file through a socket. The pages are copied
+// by the kernel with sendfile if the file system supports it, otherwise they
+// are written from the mapping.
+Status SendFileRange(int sock, int fd, int64_t offset, const uint8_t* pointer,
+                     int64_t size) {
+  int64_t sent = 0;
+#ifdef __linux__
+  while (sent < size) {
+    off_t file_offset = static_cast<off_t>(offset + sent);
+    ssize_t nbytes = sendfile(sock, fd, &file_offset, static_cast<size_t>(size - sent));
+    if (nbytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nbytes < 0 && sent == 0 && (errno == EINVAL || errno == ENOSYS)) {
+      // For example hugetlbfs does not support sendfile.
+      break;
+    }
+    if (nbytes <= 0) {
+      return Status::IOError(std::string("failed to send object contents: ") +
+                             (nbytes < 0 ? strerror(errno) : "connection closed"));
+    }
+    sent += nbytes;
+  }
+#endif
+  if (sent < size) {
+    RETURN_NOT_OK(WriteBytes(sock, const_cast<uint8_t*>(pointer) + sent,
+                             static_cast<size_t>(size - sent)));
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+ObjectReplicator::ObjectReplicator() : completion_pipe_{-1, -1}, stopping_(false) {}
+
+ObjectReplicator::~ObjectReplicator() {
+  if (thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cond_.notify_one();
+    thread_.join();
+  }
+  for (const auto& connection : connections_) {
+    close(connection.second);
+  }
+  for (int fd : completion_pipe_) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+Status ObjectReplicator::Init() {
+  if (pipe(completion_pipe_) != 0) {
+    return Status::IOError(std::string("could not create pipe for replication: ") +
+                           strerror(errno));
+  }
+  // The store drains the pipe in PopCompletions without blocking.
+  int flags = fcntl(completion_pipe_[0], F_GETFL, 0);
+  fcntl(completion_pipe_[0], F_SETFL, flags | O_NONBLOCK);
+  thread_ = std::thread([this]() { RunTasks(); });
+  return Status::OK();
+}
+
+void ObjectReplicator::Replicate(int64_t request_id, const std::string& store_socket_name,
+                                 const ObjectID& object_id, int fd, int64_t offset,
+                                 const uint8_t* pointer, int64_t data_size,
+                                 int64_t metadata_size, const unsigned char* digest) {
+  Task task;
+  task.request_id = request_id;
+  task.store_socket_name = store_socket_name;
+  task.object_id = object_id;
+  task.fd = fd;
+  task.offset = offset;
+  task.pointer = pointer;
+  task.data_size = data_size;
+  task.metadata_size = metadata_size;
+  memcpy(task.digest, digest, kDigestSize);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cond_.notify_one();
+}
+
+void ObjectReplicator::PopCompletions(std::vector<ReplicationCompletion>* completions) {
+  // Drain the pipe before taking the completions, so that a completion that
+  // is added concurrently is signaled again.
+  char buffer[64];
+  while (read(completion_pipe_[0], buffer, sizeof(buffer)) > 0) {
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  completions->insert(completions->end(), completions_.begin(), completions_.end());
+  completions_.clear();
+}
+
+void ObjectReplicator::RunTasks() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    ReplicationCompletion completion;
+    completion.request_id = task.request_id;
+    completion.object_id = task.object_id;
+    completion.status = CopyObject(task);
+    if (!completion.status.ok()) {
+      // The connection may be in the middle of a message, so it is not reused.
+      auto it = connections_.find(task.store_socket_name);
+      if (it != connections_.end()) {
+        close(it->second);
+        connections_.erase(it);
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completions_.push_back(completion);
+    }
+    char signal = 0;
+    if (write(completion_pipe_[1], &signal, 1) != 1) {
+      ARROW_LOG(WARNING) << "failed to signal finished replication";
+    }
+  }
+}
+
+Status ObjectReplicator::CopyObject(const Task& task) {
+  int sock;
+  RETURN_NOT_OK(Connect(task.store_socket_name, &sock));
+  RETURN_NOT_OK(SendReplicaRequest(sock, task.object_id, task.data_size,
+                                   task.metadata_size, task.digest));
+  RETURN_NOT_OK(SendFileRange(sock, task.fd, task.offset, task.pointer,
+                              task.data_size + task.metadata_size));
+  std::vector<uint8_t> buffer;
+  RETURN_NOT_OK(PlasmaReceive(sock, MessageType_PlasmaReplicaReply, &buffer));
+  ObjectID object_id;
+  Status s = ReadReplicaReply(buffer.data(), buffer.size(), &object_id);
+  if (s.IsPlasmaObjectExists()) {
+    // The other store has the object already.
+    return Status::OK();
+  }
+  return s;
+}
+
+Status ObjectReplicator::Connect(const std::string& store_socket_name, int* fd) {
+  auto it = connections_.find(store_socket_name);
+  if (it != connections_.end()) {
+    *fd = it->second;
+    return Status::OK();
+  }
+  // Fail right away if the store is not running, the caller can retry.
+  RETURN_NOT_OK(ConnectIpcSocketRetry(store_socket_name, 0, 0, fd));
+  connections_[store_socket_name] = *fd;
+  return Status::OK();
+}
+
+}  // namespace plasma
@@ -0,0 +1,137 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#ifndef PLASMA_REPLICATION_H
+#define PLASMA_REPLICATION_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "arrow/status.h"
+#include "plasma/common.h"
+
+namespace plasma {
+
+/// The result of copying an object to another store.
+struct ReplicationCompletion {
+  /// The request of the store that the copy belongs to.
+  int64_t request_id;
+  /// The ID of the object.
+  ObjectID object_id;
+  /// Whether the object has been copied. Copying an object that the other
+  /// store already has succeeds.
+  arrow::Status status;
+};
+
+/// Copies sealed objects to other plasma stores on the same machine.
+///
+/// The replicator connects to the other store like a client, and sends it a
+/// PlasmaReplicaRequest for each object, followed by the contents of the
+/// object. The contents are sent with sendfile from the memory mapped file of
+/// the object where the file system supports it, and are written from memory
+/// otherwise. The other store reads them straight into the object that it
+/// creates for them. Connections are kept open for further copies.
+///
+/// The copies are made in order on a single background thread. The store
+/// must keep the objects from being evicted until their copy has completed,
+/// and learns about finished copies by watching the file descriptor returned
+/// by completion_fd and calling PopCompletions when it becomes readable.
+///
+/// None of the methods are thread safe; they must all be called from the
+/// thread of the store.
+class ObjectReplicator {
+ public:
+  ObjectReplicator();
+
+  /// Stop the background thread. Copies that have not been started yet are
+  /// dropped.
+  ~ObjectReplicator();
+
+  /// Start the background thread. This must be called before any other
+  /// method.
+  arrow::Status Init();
+
+  /// Return a file descriptor that becomes readable when copies finish.
+  int completion_fd() const { return completion_pipe_[0]; }
+
+  /// Copy an object to another store.
+  ///
+  /// @param request_id The request that the copy belongs to, it is part of
+  ///        the completion.
+  /// @param store_socket_name The socket of the store to copy the object to.
+  /// @param object_id The ID of the object.
+  /// @param fd The memory mapped file that contains the object.
+  /// @param offset The offset of the object in the file.
+  /// @param pointer The address of the object in memory.
+  /// @param data_size The size in bytes of the data of the object.
+  /// @param metadata_size The size in bytes of the metadata of the object.
+  /// @param digest The digest of the object.
+  void Replicate(int64_t request_id, const std::string& store_socket_name,
+                 const ObjectID& object_id, int fd, int64_t offset,
+                 const uint8_t* pointer, int64_t data_size, int64_t metadata_size,
+                 const unsigned char* digest);
+
+  /// Get the copies that have finished since the last call.
+  ///
+  /// @param completions The finished copies are appended to this vector.
+  void PopCompletions(std::vector<ReplicationCompletion>* completions);
+
+ private:
+  struct Task {
+    int64_t request_id;
+    std::string store_socket_name;
+    ObjectID object_id;
+    int fd;
+    int64_t offset;
+    const uint8_t* pointer;
+    int64_t data_size;
+    int64_t metadata_size;
+    unsigned char digest[kDigestSize];
+  };
+
+  void RunTasks();
+
+  arrow::Status CopyObject(const Task& task);
+
+  /// Get the connection to a store, connecting to it if necessary.
+  arrow::Status Connect(const std::string& store_socket_name, int* fd);
+
+  /// A pipe through which the background thread signals finished copies.
+  int completion_pipe_[2];
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  /// The copies that have not been made yet. Protected by mutex_.
+  std::deque<Task> tasks_;
+  /// The copies that have finished. Protected by mutex_.
+  std::vector<ReplicationCompletion> completions_;
+  /// Set to stop the background thread. Protected by mutex_.
+  bool stopping_;
+  /// The connections to other stores, by their socket. Only used by the
+  /// background thread.
+  std::unordered_map<std::string, int> connections_;
+};
+
+}  // namespace plasma
+
+#endif  // PLASMA_REPLICATION_H
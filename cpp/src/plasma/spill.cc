@@ -0,0 +1,235 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "plasma/spill.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+namespace plasma {
+
+using arrow::Status;
+
+namespace {
+
+Status ErrnoStatus(const std::string& message, const std::string& path) {
+  return Status::IOError(message + " " + path + ": " + strerror(errno));
+}
+
+}  // namespace
+
+ObjectSpiller::ObjectSpiller(const std::string& directory)
+    : directory_(directory), completion_pipe_{-1, -1}, stopping_(false) {}
+
+ObjectSpiller::~ObjectSpiller() {
+  if (thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cond_.notify_one();
+    thread_.join();
+  }
+  // The spilled objects cannot be used by another store.
+  for (const auto& object_id : files_) {
+    unlink(ObjectPath(object_id).c_str());
+  }
+  for (int fd : completion_pipe_) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+Status ObjectSpiller::Init() {
+  struct stat directory_stat;
+  if (stat(directory_.c_str(), &directory_stat) != 0 ||
+      !S_ISDIR(directory_stat.st_mode) || access(directory_.c_str(), W_OK) != 0) {
+    return Status::IOError("spill directory " + directory_ +
+                           " does not exist or is not writable");
+  }
+  if (pipe(completion_pipe_) != 0) {
+    return ErrnoStatus("could not create pipe for spill directory", directory_);
+  }
+  // The store drains the pipe in PopCompletions without blocking.
+  int flags = fcntl(completion_pipe_[0], F_GETFL, 0);
+  fcntl(completion_pipe_[0], F_SETFL, flags | O_NONBLOCK);
+  thread_ = std::thread([this]() { RunTasks(); });
+  return Status::OK();
+}
+
+void ObjectSpiller::Spill(const ObjectID& object_id, uint8_t* data, int64_t size) {
+  Task task;
+  task.type = Task::SPILL;
+  task.object_id = object_id;
+  task.data = data;
+  task.size = size;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cond_.notify_one();
+}
+
+void ObjectSpiller::Restore(const ObjectID& object_id, uint8_t* destination,
+                            int64_t size) {
+  Task task;
+  task.type = Task::RESTORE;
+  task.object_id = object_id;
+  task.data = destination;
+  task.size = size;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cond_.notify_one();
+}
+
+void ObjectSpiller::Remove(const ObjectID& object_id) {
+  Task task;
+  task.type = Task::REMOVE;
+  task.object_id = object_id;
+  task.data = nullptr;
+  task.size = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cond_.notify_one();
+}
+
+void ObjectSpiller::PopCompletions(std::vector<SpillCompletion>* completions) {
+  // Drain the pipe before taking the completions, so that a completion that
+  // is added concurrently is signaled again.
+  char buffer[64];
+  while (read(completion_pipe_[0], buffer, sizeof(buffer)) > 0) {
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  completions->insert(completions->end(), completions_.begin(), completions_.end());
+  completions_.clear();
+}
+
+void ObjectSpiller::RunTasks() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      // Pending tasks are still performed on shutdown, because restores write
+      // to memory that is owned by the store.
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    SpillCompletion completion;
+    completion.object_id = task.object_id;
+    completion.size = task.size;
+    completion.data = task.data;
+    switch (task.type) {
+      case Task::SPILL:
+        completion.type = SpillCompletion::SPILL;
+        completion.status = WriteObject(task.object_id, task.data, task.size);
+        break;
+      case Task::RESTORE:
+        completion.type = SpillCompletion::RESTORE;
+        completion.status = ReadObject(task.object_id, task.data, task.size);
+        RemoveObject(task.object_id);
+        break;
+      case Task::REMOVE:
+        RemoveObject(task.object_id);
+        continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completions_.push_back(completion);
+    }
+    char signal = 0;
+    if (write(completion_pipe_[1], &signal, 1) != 1) {
+      ARROW_LOG(WARNING) << "failed to signal finished spill operation";
+    }
+  }
+}
+
+Status ObjectSpiller::WriteObject(const ObjectID& object_id, const uint8_t* data,
+                                  int64_t size) {
+  std::string path = ObjectPath(object_id);
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return ErrnoStatus("could not create spill file", path);
+  }
+  files_.insert(object_id);
+  int64_t offset = 0;
+  while (offset < size) {
+    ssize_t nbytes = write(fd, data + offset, static_cast<size_t>(size - offset));
+    if (nbytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nbytes < 0) {
+      Status s = ErrnoStatus("could not write spill file", path);
+      close(fd);
+      RemoveObject(object_id);
+      return s;
+    }
+    offset += nbytes;
+  }
+  close(fd);
+  return Status::OK();
+}
+
+Status ObjectSpiller::ReadObject(const ObjectID& object_id, uint8_t* destination,
+                                 int64_t size) {
+  std::string path = ObjectPath(object_id);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return ErrnoStatus("could not open spill file", path);
+  }
+  int64_t offset = 0;
+  while (offset < size) {
+    ssize_t nbytes = read(fd, destination + offset, static_cast<size_t>(size - offset));
+    if (nbytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nbytes <= 0) {
+      Status s = nbytes == 0 ? Status::IOError("spill file " + path + " is truncated")
+                             : ErrnoStatus("could not read spill file", path);
+      close(fd);
+      return s;
+    }
+    offset += nbytes;
+  }
+  close(fd);
+  return Status::OK();
+}
+
+void ObjectSpiller::RemoveObject(const ObjectID& object_id) {
+  if (files_.erase(object_id) != 0) {
+    unlink(ObjectPath(object_id).c_str());
+  }
+}
+
+std::string ObjectSpiller::ObjectPath(const ObjectID& object_id) const {
+  return directory_ + "/plasma-spill-" + object_id.hex();
+}
+
+}  // namespace plasma
@@ -0,0 +1,147 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PLASMA_SPILL_H
+#define PLASMA_SPILL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "arrow/status.h"
+#include "plasma/common.h"
+
+namespace plasma {
+
+/// The result of a spill or restore that has been performed by the
+/// ObjectSpiller.
+struct SpillCompletion {
+  enum Type { SPILL, RESTORE };
+
+  /// Whether the object was written to or read from disk.
+  Type type;
+  /// The ID of the object.
+  ObjectID object_id;
+  /// The size in bytes of the object, including its metadata.
+  int64_t size;
+  /// Whether the operation succeeded.
+  arrow::Status status;
+  /// The memory that the object was written from or read to. After a spill,
+  /// the store frees it.
+  uint8_t* data;
+};
+
+/// Writes evicted objects to files in a local directory and reads them back.
+///
+/// All file operations are performed in order on a single background thread,
+/// so that the event loop of the store never blocks on the disk. The store
+/// learns about finished operations by watching the file descriptor returned
+/// by completion_fd and calling PopCompletions when it becomes readable.
+///
+/// None of the methods are thread safe; they must all be called from the
+/// thread of the store.
+class ObjectSpiller {
+ public:
+  /// @param directory The directory where spilled objects are written. It
+  ///        must exist and be writable.
+  explicit ObjectSpiller(const std::string& directory);
+
+  /// Wait for the pending operations and remove the files of the objects
+  /// that are still spilled.
+  ~ObjectSpiller();
+
+  /// Check the spill directory and start the background thread. This must be
+  /// called before any other method.
+  arrow::Status Init();
+
+  /// Return a file descriptor that becomes readable when operations finish.
+  int completion_fd() const { return completion_pipe_[0]; }
+
+  /// Write an object to disk straight from the memory of the store, without
+  /// a copy. The memory holds the pending spills, so they cannot take more
+  /// than the memory of the store.
+  ///
+  /// @param object_id The ID of the object.
+  /// @param data The data and metadata of the object. It must stay valid
+  ///        until the spill has completed.
+  /// @param size The size in bytes of the object, including its metadata.
+  void Spill(const ObjectID& object_id, uint8_t* data, int64_t size);
+
+  /// Read a spilled object back and remove its file.
+  ///
+  /// @param object_id The ID of the object.
+  /// @param destination The memory where the object is read to. It must stay
+  ///        valid until the restore has completed.
+  /// @param size The size in bytes of the object, including its metadata.
+  void Restore(const ObjectID& object_id, uint8_t* destination, int64_t size);
+
+  /// Remove the file of a spilled object. This does not report a completion.
+  ///
+  /// @param object_id The ID of the object.
+  void Remove(const ObjectID& object_id);
+
+  /// Get the operations that have finished since the last call.
+  ///
+  /// @param completions The finished operations are appended to this vector.
+  void PopCompletions(std::vector<SpillCompletion>* completions);
+
+ private:
+  struct Task {
+    enum Type { SPILL, RESTORE, REMOVE };
+
+    Type type;
+    ObjectID object_id;
+    /// The memory that the object is written from or read to.
+    uint8_t* data;
+    int64_t size;
+  };
+
+  void RunTasks();
+
+  arrow::Status WriteObject(const ObjectID& object_id, const uint8_t* data,
+                            int64_t size);
+
+  arrow::Status ReadObject(const ObjectID& object_id, uint8_t* destination,
+                           int64_t size);
+
+  void RemoveObject(const ObjectID& object_id);
+
+  std::string ObjectPath(const ObjectID& object_id) const;
+
+  std::string directory_;
+  /// A pipe through which the background thread signals finished operations.
+  int completion_pipe_[2];
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  /// The operations that have not been performed yet. Protected by mutex_.
+  std::deque<Task> tasks_;
+  /// The operations that have finished. Protected by mutex_.
+  std::vector<SpillCompletion> completions_;
+  /// Set to stop the background thread. Protected by mutex_.
+  bool stopping_;
+  /// The objects whose file exists. Only used by the background thread.
+  std::unordered_set<ObjectID, UniqueIDHasher> files_;
+};
+
+}  // namespace plasma
+
+#endif  // PLASMA_SPILL_H
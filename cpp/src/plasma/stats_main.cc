@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// PLASMA STORE STATS: Print the statistics of a running plasma store.
+//
+// Usage: plasma_store_stats -s <socket>
+//
+// The objects and bytes in each state, the state of the allocator, the number
+// of evictions, clients and pending get requests are printed, followed by a
+// latency histogram for each kind of request that the store has handled.
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+
+#include "plasma/client.h"
+#include "plasma/common.h"
+
+int main(int argc, char* argv[]) {
+  std::string socket_name;
+  int c;
+  while ((c = getopt(argc, argv, "s:")) != -1) {
+    switch (c) {
+      case 's':
+        socket_name = std::string(optarg);
+        break;
+      default:
+        exit(-1);
+    }
+  }
+  if (socket_name.empty()) {
+    ARROW_LOG(FATAL) << "please specify the socket of the store with -s switch";
+  }
+
+  plasma::PlasmaClient client;
+  ARROW_CHECK_OK(client.Connect(socket_name, "", 0));
+  plasma::PlasmaStoreStats stats;
+  ARROW_CHECK_OK(client.Info(&stats));
+  ARROW_CHECK_OK(client.Disconnect());
+
+  printf("%-24s %12s %16s\n", "objects", "count", "bytes");
+  printf("%-24s %12" PRId64 " %16" PRId64 "\n", "created", stats.num_objects_created,
+         stats.bytes_created);
+  printf("%-24s %12" PRId64 " %16" PRId64 "\n", "sealed", stats.num_objects_sealed,
+         stats.bytes_sealed);
+  printf("%-24s %12" PRId64 " %16" PRId64 "\n", "in use", stats.num_objects_in_use,
+         stats.bytes_in_use);
+  printf("%-24s %12" PRId64 " %16" PRId64 "\n", "evicted", stats.num_objects_evicted,
+         stats.bytes_evicted);
+  printf("%-24s %12" PRId64 " %16" PRId64 "\n", "spilled", stats.num_objects_spilled,
+         stats.bytes_spilled);
+  printf("%-24s %12" PRId64 " %16" PRId64 "\n", "restored", stats.num_objects_restored,
+         stats.bytes_restored);
+  printf("\n");
+  printf("%-24s %16" PRId64 "\n", "allocator footprint", stats.allocator_footprint);
+  printf("%-24s %16" PRId64 "\n", "allocator allocated", stats.allocator_allocated);
+  printf("%-24s %16" PRId64 "\n", "allocator free", stats.allocator_free);
+  printf("%-24s %16" PRId64 "\n", "allocator free chunks", stats.allocator_free_chunks);
+  printf("%-24s %16" PRId64 "\n", "allocator largest free", stats.allocator_largest_free);
+  printf("%-24s %16.3f\n", "allocator fragmentation", stats.allocator_fragmentation);
+  printf("%-24s %16" PRId64 "\n", "clients", stats.num_clients);
+  printf("%-24s %16" PRId64 "\n", "subscribers", stats.num_subscribers);
+  printf("%-24s %16" PRId64 "\n", "pending get requests", stats.num_pending_get_requests);
+
+  // Print the non-empty buckets of each histogram, with their upper bounds.
+  for (const auto& histogram : stats.latencies) {
+    printf("\n%s\n", histogram.operation.c_str());
+    for (int bucket = 0; bucket < plasma::kNumLatencyBuckets; ++bucket) {
+      if (histogram.counts[bucket] == 0) {
+        continue;
+      }
+      if (bucket == plasma::kNumLatencyBuckets - 1) {
+        printf("  >= %10" PRId64 " us %12" PRId64 "\n", int64_t(1) << (bucket - 1),
+               histogram.counts[bucket]);
+      } else {
+        printf("  <  %10" PRId64 " us %12" PRId64 "\n", int64_t(1) << bucket,
+               histogram.counts[bucket]);
+      }
+    }
+  }
+  return 0;
+}
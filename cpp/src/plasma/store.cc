@@ -19,9 +19,9 @@
 //
 // It accepts incoming client connections on a unix domain socket
 // (name passed in via the -s option of the executable) and uses a
-// single thread to serve the clients. Each client establishes a
-// connection and can create objects, wait for objects and seal
-// objects through that connection.
+// single thread to serve the clients, or several threads if the -t
+// option is given. Each client establishes a connection and can create
+// objects, wait for objects and seal objects through that connection.
 //
 // It keeps a hash table that maps object_ids (which are 20 byte long,
 // just enough to store and SHA1 hash) to memory mapped files.
@@ -39,11 +39,16 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/statvfs.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <deque>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -91,6 +96,21 @@ struct GetRequest {
   /// The number of object requests in this wait request that are already
   /// satisfied.
   int64_t num_satisfied;
+  /// The requested objects that are being restored from the spill directory.
+  std::unordered_set<ObjectID, UniqueIDHasher> objects_to_restore;
+  /// Whether to return to the client once objects_to_restore is empty. This is
+  /// used for get requests with a timeout of 0, which do not wait for absent
+  /// objects, but do wait for spilled objects.
+  bool return_after_restore;
+  /// Whether the reply has been posted to the thread of the client, because
+  /// the get request was satisfied on another thread.
+  bool returned;
+  /// The time at which the request was made, for the latency histogram.
+  std::chrono::steady_clock::time_point start_time;
+  /// The ID that the client assigned to an asynchronous get request, or -1 if
+  /// the client waits for the reply. An asynchronous get request is made for
+  /// a single object.
+  int64_t async_request_id;
 };
 
 GetRequest::GetRequest(Client* client, const std::vector<ObjectID>& object_ids)
@@ -98,27 +118,101 @@ GetRequest::GetRequest(Client* client, const std::vector<ObjectID>& object_ids)
       timer(-1),
       object_ids(object_ids.begin(), object_ids.end()),
       objects(object_ids.size()),
-      num_satisfied(0) {
+      num_satisfied(0),
+      return_after_restore(false),
+      returned(false),
+      start_time(std::chrono::steady_clock::now()),
+      async_request_id(-1) {
   std::unordered_set<ObjectID, UniqueIDHasher> unique_ids(object_ids.begin(),
                                                           object_ids.end());
   num_objects_to_wait_for = unique_ids.size();
 }
 
-Client::Client(int fd) : fd(fd) {}
+struct ReplicateRequest {
+  /// The client that asked for the copies, or null if it has disconnected.
+  Client* client;
+  /// The number of copies that have not finished yet.
+  int64_t num_remaining;
+  /// A description of the first copy that failed, or empty.
+  std::string failure;
+};
+
+struct CreateRequest {
+  /// The client that asked for the objects.
+  Client* client;
+  /// Whether the objects were asked for with a batch request, which is
+  /// answered with a batch reply.
+  bool batch;
+  std::vector<ObjectID> object_ids;
+  std::vector<int64_t> data_sizes;
+  std::vector<int64_t> metadata_sizes;
+  /// The device where the object is created, see create_object. Batches are
+  /// created on the host.
+  int device_num;
+};
+
+Client::Client(int fd, EventLoop* loop)
+    : fd(fd),
+      loop(loop),
+      disconnected(false),
+      async_get_fd(-1),
+      waiting_for_async_get_write(false) {}
 
 PlasmaStore::PlasmaStore(EventLoop* loop, int64_t system_memory, std::string directory,
-                         bool hugepages_enabled)
-    : loop_(loop), eviction_policy_(&store_info_) {
+                         bool hugepages_enabled, EvictionPolicyType eviction_policy_type,
+                         std::string spill_directory, int num_threads,
+                         bool use_extent_allocator)
+    : loop_(loop),
+      next_worker_loop_(0),
+      eviction_policy_(&store_info_,
+                       MakeObjectCache(eviction_policy_type, system_memory)),
+      use_extent_allocator_(use_extent_allocator),
+      extent_base_(NULL),
+      num_pending_spills_(0),
+      next_replicate_request_id_(0),
+      replication_client_(new Client(-1, loop)),
+      latency_counts_((MessageType_MAX + 1) * kNumLatencyBuckets) {
+  for (auto& count : latency_counts_) {
+    count = 0;
+  }
   store_info_.memory_capacity = system_memory;
   store_info_.directory = directory;
   store_info_.hugepages_enabled = hugepages_enabled;
+  if (!spill_directory.empty()) {
+    spiller_.reset(new ObjectSpiller(spill_directory));
+    ARROW_CHECK_OK(spiller_->Init());
+    loop_->AddFileEvent(spiller_->completion_fd(), kEventLoopRead, [this](int events) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      process_spill_completions();
+    });
+  }
 #ifdef PLASMA_GPU
   CudaDeviceManager::GetInstance(&manager_);
 #endif
+  for (int i = 0; num_threads > 1 && i < num_threads; ++i) {
+    worker_loops_.emplace_back(new EventLoop());
+  }
+  for (auto& worker_loop : worker_loops_) {
+    EventLoop* worker = worker_loop.get();
+    worker_threads_.emplace_back([worker]() {
+      // Signals are handled by the thread of the main event loop.
+      sigset_t signals;
+      sigfillset(&signals);
+      pthread_sigmask(SIG_BLOCK, &signals, NULL);
+      worker->Start();
+    });
+  }
 }
 
 // TODO(pcm): Get rid of this destructor by using RAII to clean up data.
 PlasmaStore::~PlasmaStore() {
+  for (auto& worker_loop : worker_loops_) {
+    EventLoop* worker = worker_loop.get();
+    worker->Post([worker]() { worker->Stop(); });
+  }
+  for (auto& worker_thread : worker_threads_) {
+    worker_thread.join();
+  }
   for (const auto& element : pending_notifications_) {
     auto object_notifications = element.second.object_notifications;
     for (size_t i = 0; i < object_notifications.size(); ++i) {
@@ -127,6 +221,12 @@ PlasmaStore::~PlasmaStore() {
       // TODO(pcm): Get rid of this delete.
       delete[] data;
     }
+    if (element.second.event_fd != -1) {
+      close(element.second.event_fd);
+    }
+  }
+  for (CreateRequest* request : pending_creates_) {
+    delete request;
   }
 }
 
@@ -151,18 +251,100 @@ void PlasmaStore::add_client_to_object_clients(ObjectTableEntry* entry, Client*
   entry->clients.insert(client);
 }
 
+uint8_t* PlasmaStore::allocate_memory(int64_t size, int* fd, int64_t* map_size,
+                                      ptrdiff_t* offset) {
+  uint8_t* pointer;
+  if (use_extent_allocator_) {
+    if (!extent_allocator_) {
+      // Map all of the memory up front, with room to align the start.
+      int64_t capacity = store_info_.memory_capacity;
+      extent_base_ = reinterpret_cast<uint8_t*>(map_object_memory(capacity + BLOCK_SIZE));
+      ARROW_CHECK(extent_base_ != NULL);
+      int64_t misalignment = reinterpret_cast<uintptr_t>(extent_base_) % BLOCK_SIZE;
+      if (misalignment != 0) {
+        extent_base_ += BLOCK_SIZE - misalignment;
+      }
+      extent_allocator_.reset(new ExtentAllocator(capacity));
+    }
+    // Evict objects that are next to each other until there is a free extent
+    // that is large enough.
+    while (true) {
+      int64_t extent_offset = extent_allocator_->Allocate(size);
+      if (extent_offset != -1) {
+        pointer = extent_base_ + extent_offset;
+        break;
+      }
+      // Objects that are being spilled hold on to their memory until they have
+      // been written. The request waits for them instead of evicting more
+      // objects, see must_wait_for_spills.
+      if (num_pending_spills_ > 0) {
+        return NULL;
+      }
+      std::vector<ObjectID> objects_to_evict;
+      bool success = eviction_policy_.require_contiguous_space(
+          size, *extent_allocator_, extent_base_, &objects_to_evict);
+      delete_objects(objects_to_evict);
+      if (!success) {
+        return NULL;
+      }
+    }
+    get_malloc_mapinfo(pointer, fd, map_size, offset);
+    assert(*fd != -1);
+    return pointer;
+  }
+  // Try to evict objects until there is enough space.
+  while (true) {
+    // Allocate space for the new object. We use dlmemalign instead of dlmalloc
+    // in order to align the allocated region to a 64-byte boundary. This is not
+    // strictly necessary, but it is an optimization that could speed up the
+    // computation of a hash of the data (see compute_object_hash_parallel in
+    // plasma_client.cc). Note that even though this pointer is 64-byte aligned,
+    // it is not guaranteed that the corresponding pointer in the client will be
+    // 64-byte aligned, but in practice it often will be.
+    pointer = reinterpret_cast<uint8_t*>(dlmemalign(BLOCK_SIZE, size));
+    if (pointer != NULL) {
+      break;
+    }
+    if (num_pending_spills_ > 0) {
+      return NULL;
+    }
+    // Tell the eviction policy how much space we need to create this object.
+    std::vector<ObjectID> objects_to_evict;
+    bool success = eviction_policy_.require_space(size, &objects_to_evict);
+    delete_objects(objects_to_evict);
+    // Return NULL if not enough space could be freed to create the object.
+    if (!success) {
+      return NULL;
+    }
+  }
+  get_malloc_mapinfo(pointer, fd, map_size, offset);
+  assert(*fd != -1);
+  return pointer;
+}
+
+void PlasmaStore::free_memory(uint8_t* pointer) {
+  if (extent_allocator_) {
+    extent_allocator_->Free(pointer - extent_base_);
+  } else {
+    dlfree(pointer);
+  }
+}
+
 // Create a new object buffer in the hash table.
 int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
                                int64_t metadata_size, int device_num, Client* client,
                                PlasmaObject* result) {
   ARROW_LOG(DEBUG) << "creating object " << object_id.hex();
-  if (store_info_.objects.count(object_id) != 0) {
+  if (store_info_.objects.count(object_id) != 0 ||
+      spilled_objects_.count(object_id) != 0) {
     // There is already an object with the same ID in the Plasma Store, so
     // ignore this requst.
     return PlasmaError_ObjectExists;
   }
-  // Try to evict objects until there is enough space.
-  uint8_t* pointer;
+  uint8_t* pointer = NULL;
+  int fd = -1;
+  int64_t map_size = 0;
+  ptrdiff_t offset = 0;
 #ifdef PLASMA_GPU
   std::shared_ptr<CudaBuffer> gpu_handle;
   std::shared_ptr<CudaContext> context_;
@@ -170,44 +352,17 @@ int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
     manager_->GetContext(device_num - 1, &context_);
   }
 #endif
-  while (true) {
-    // Allocate space for the new object. We use dlmemalign instead of dlmalloc
-    // in order to align the allocated region to a 64-byte boundary. This is not
-    // strictly necessary, but it is an optimization that could speed up the
-    // computation of a hash of the data (see compute_object_hash_parallel in
-    // plasma_client.cc). Note that even though this pointer is 64-byte aligned,
-    // it is not guaranteed that the corresponding pointer in the client will be
-    // 64-byte aligned, but in practice it often will be.
-    if (device_num == 0) {
-      pointer =
-          reinterpret_cast<uint8_t*>(dlmemalign(BLOCK_SIZE, data_size + metadata_size));
-      if (pointer == NULL) {
-        // Tell the eviction policy how much space we need to create this object.
-        std::vector<ObjectID> objects_to_evict;
-        bool success =
-            eviction_policy_.require_space(data_size + metadata_size, &objects_to_evict);
-        delete_objects(objects_to_evict);
-        // Return an error to the client if not enough space could be freed to
-        // create the object.
-        if (!success) {
-          return PlasmaError_OutOfMemory;
-        }
-      } else {
-        break;
-      }
-    } else {
+  if (device_num == 0) {
+    pointer = allocate_memory(data_size + metadata_size, &fd, &map_size, &offset);
+    // Return an error to the client if not enough space could be freed to
+    // create the object.
+    if (pointer == NULL) {
+      return PlasmaError_OutOfMemory;
+    }
+  } else {
 #ifdef PLASMA_GPU
-      context_->Allocate(data_size + metadata_size, &gpu_handle);
-      break;
+    context_->Allocate(data_size + metadata_size, &gpu_handle);
 #endif
-    }
-  }
-  int fd = -1;
-  int64_t map_size = 0;
-  ptrdiff_t offset = 0;
-  if (device_num == 0) {
-    get_malloc_mapinfo(pointer, &fd, &map_size, &offset);
-    assert(fd != -1);
   }
   auto entry = std::unique_ptr<ObjectTableEntry>(new ObjectTableEntry());
   entry->object_id = object_id;
@@ -243,6 +398,92 @@ int PlasmaStore::create_object(const ObjectID& object_id, int64_t data_size,
   return PlasmaError_OK;
 }
 
+int PlasmaStore::create_objects(const std::vector<ObjectID>& object_ids,
+                                const std::vector<int64_t>& data_sizes,
+                                const std::vector<int64_t>& metadata_sizes,
+                                Client* client, std::vector<PlasmaObject>* results) {
+  results->resize(object_ids.size());
+  for (size_t i = 0; i < object_ids.size(); ++i) {
+    int error_code = create_object(object_ids[i], data_sizes[i], metadata_sizes[i], 0,
+                                   client, &(*results)[i]);
+    if (error_code != PlasmaError_OK) {
+      // Abort the objects of this batch that have been created already.
+      for (size_t j = 0; j < i; ++j) {
+        abort_object(object_ids[j], client);
+      }
+      results->clear();
+      return error_code;
+    }
+  }
+  return PlasmaError_OK;
+}
+
+bool PlasmaStore::must_wait_for_spills(int error_code) const {
+  return error_code == PlasmaError_OutOfMemory && num_pending_spills_ > 0;
+}
+
+bool PlasmaStore::process_create_request(const CreateRequest& request,
+                                         std::function<Status()>* send_reply) {
+  Client* client = request.client;
+  if (!request.batch) {
+    const ObjectID& object_id = request.object_ids[0];
+    int device_num = request.device_num;
+    PlasmaObject object;
+    memset(&object, 0, sizeof(object));
+    int error_code = create_object(object_id, request.data_sizes[0],
+                                  request.metadata_sizes[0], device_num, client, &object);
+    if (must_wait_for_spills(error_code)) {
+      return false;
+    }
+    int64_t mmap_size = 0;
+    if (error_code == PlasmaError_OK && device_num == 0) {
+      mmap_size = get_mmap_size(object.store_fd);
+    }
+    *send_reply = [client, object_id, object, error_code, mmap_size,
+                   device_num]() mutable -> Status {
+      HANDLE_SIGPIPE(
+          SendCreateReply(client->fd, object_id, &object, error_code, mmap_size),
+          client->fd);
+      if (error_code == PlasmaError_OK && device_num == 0) {
+        warn_if_sigpipe(send_fd(client->fd, object.store_fd), client->fd);
+      }
+      return Status::OK();
+    };
+    return true;
+  }
+  std::vector<ObjectID> object_ids = request.object_ids;
+  std::vector<PlasmaObject> objects;
+  int error_code = create_objects(object_ids, request.data_sizes, request.metadata_sizes,
+                                  client, &objects);
+  if (must_wait_for_spills(error_code)) {
+    return false;
+  }
+  // Send each memory mapped file only once, like in return_from_get.
+  std::vector<int> store_fds;
+  std::vector<int64_t> mmap_sizes;
+  for (const auto& created_object : objects) {
+    if (std::find(store_fds.begin(), store_fds.end(), created_object.store_fd) ==
+        store_fds.end()) {
+      store_fds.push_back(created_object.store_fd);
+      mmap_sizes.push_back(get_mmap_size(created_object.store_fd));
+    }
+  }
+  if (error_code != PlasmaError_OK) {
+    object_ids.clear();
+  }
+  *send_reply = [client, object_ids, objects, error_code, store_fds,
+                 mmap_sizes]() -> Status {
+    HANDLE_SIGPIPE(SendCreateBatchReply(client->fd, object_ids, objects, error_code,
+                                        store_fds, mmap_sizes),
+                   client->fd);
+    for (int store_fd : store_fds) {
+      warn_if_sigpipe(send_fd(client->fd, store_fd), client->fd);
+    }
+    return Status::OK();
+  };
+  return true;
+}
+
 void PlasmaObject_init(PlasmaObject* object, ObjectTableEntry* entry) {
   DCHECK(object != NULL);
   DCHECK(entry != NULL);
@@ -261,6 +502,49 @@ void PlasmaObject_init(PlasmaObject* object, ObjectTableEntry* entry) {
 }
 
 void PlasmaStore::return_from_get(GetRequest* get_req) {
+  // Remove the get request from each of the relevant object_get_requests hash
+  // tables if it is present there. It should only be present there if the get
+  // request timed out.
+  for (ObjectID& object_id : get_req->object_ids) {
+    auto& get_requests = object_get_requests_[object_id];
+    // Erase get_req from the vector.
+    auto it = std::find(get_requests.begin(), get_requests.end(), get_req);
+    if (it != get_requests.end()) {
+      get_requests.erase(it);
+    }
+  }
+  // Only the thread of the client sends messages to it, and only that thread
+  // can remove the timer of the get request.
+  EventLoop* client_loop = get_req->client->loop;
+  if (client_loop->IsLoopThread()) {
+    send_get_reply(get_req);
+  } else {
+    get_req->returned = true;
+    client_loop->Post([this, get_req]() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      send_get_reply(get_req);
+    });
+  }
+}
+
+void PlasmaStore::send_get_reply(GetRequest* get_req) {
+  if (get_req->client->disconnected) {
+    if (get_req->timer != -1) {
+      ARROW_CHECK(get_req->client->loop->RemoveTimer(get_req->timer) == AE_OK);
+    }
+    delete get_req;
+    return;
+  }
+  if (get_req->async_request_id != -1) {
+    record_latency(MessageType_PlasmaGetAsyncRequest, get_req->start_time);
+    send_get_async_reply(get_req);
+    if (get_req->timer != -1) {
+      ARROW_CHECK(get_req->client->loop->RemoveTimer(get_req->timer) == AE_OK);
+    }
+    delete get_req;
+    return;
+  }
+  record_latency(MessageType_PlasmaGetRequest, get_req->start_time);
   // Figure out how many file descriptors we need to send.
   std::unordered_set<int> fds_to_send;
   std::vector<int> store_fds;
@@ -275,52 +559,131 @@ void PlasmaStore::return_from_get(GetRequest* get_req) {
     }
   }
 
-  // Send the get reply to the client.
-  Status s = SendGetReply(get_req->client->fd, &get_req->object_ids[0], get_req->objects,
-                          get_req->object_ids.size(), store_fds, mmap_sizes);
-  warn_if_sigpipe(s.ok() ? 0 : -1, get_req->client->fd);
-  // If we successfully sent the get reply message to the client, then also send
-  // the file descriptors.
-  if (s.ok()) {
+  // Send the get reply to the client once the lock has been released. The
+  // objects are used by the client, so their memory mapped files stay open.
+  // Callbacks that are posted to the thread run in order, before the client
+  // is deleted.
+  Client* client = get_req->client;
+  std::vector<ObjectID> object_ids = get_req->object_ids;
+  std::unordered_map<ObjectID, PlasmaObject, UniqueIDHasher> objects = get_req->objects;
+  client->loop->Post([client, object_ids, objects, store_fds, mmap_sizes]() mutable {
+    if (client->disconnected) {
+      return;
+    }
+    Status s = SendGetReply(client->fd, &object_ids[0], objects, object_ids.size(),
+                            store_fds, mmap_sizes);
+    warn_if_sigpipe(s.ok() ? 0 : -1, client->fd);
+    // If we successfully sent the get reply message to the client, then also
+    // send the file descriptors.
+    if (!s.ok()) {
+      return;
+    }
     // Send all of the file descriptors for the present objects.
     for (int store_fd : store_fds) {
-      int error_code = send_fd(get_req->client->fd, store_fd);
+      int error_code = send_fd(client->fd, store_fd);
       // If we failed to send the file descriptor, loop until we have sent it
-      // successfully. TODO(rkn): This is problematic for two reasons. First
-      // of all, sending the file descriptor should just succeed without any
-      // errors, but sometimes I see a "Message too long" error number.
-      // Second, looping like this allows a client to potentially block the
-      // plasma store event loop which should never happen.
+      // successfully. TODO(rkn): Sending the file descriptor should just
+      // succeed without any errors, but sometimes I see a "Message too long"
+      // error number.
       while (error_code < 0) {
         if (errno == EMSGSIZE) {
           ARROW_LOG(WARNING) << "Failed to send file descriptor, retrying.";
-          error_code = send_fd(get_req->client->fd, store_fd);
+          error_code = send_fd(client->fd, store_fd);
           continue;
         }
-        warn_if_sigpipe(error_code, get_req->client->fd);
+        warn_if_sigpipe(error_code, client->fd);
         break;
       }
     }
-  }
+  });
 
-  // Remove the get request from each of the relevant object_get_requests hash
-  // tables if it is present there. It should only be present there if the get
-  // request timed out.
-  for (ObjectID& object_id : get_req->object_ids) {
-    auto& get_requests = object_get_requests_[object_id];
-    // Erase get_req from the vector.
-    auto it = std::find(get_requests.begin(), get_requests.end(), get_req);
-    if (it != get_requests.end()) {
-      get_requests.erase(it);
-    }
-  }
   // Remove the get request.
   if (get_req->timer != -1) {
-    ARROW_CHECK(loop_->RemoveTimer(get_req->timer) == AE_OK);
+    ARROW_CHECK(get_req->client->loop->RemoveTimer(get_req->timer) == AE_OK);
   }
   delete get_req;
 }
 
+void PlasmaStore::send_get_async_reply(GetRequest* get_req) {
+  Client* client = get_req->client;
+  const ObjectID& object_id = get_req->object_ids[0];
+  const PlasmaObject& object = get_req->objects[object_id];
+  int store_fd = -1;
+  int64_t mmap_size = 0;
+  if (object.data_size != -1 && object.device_num == 0) {
+    store_fd = object.store_fd;
+    mmap_size = get_mmap_size(store_fd);
+  }
+  AsyncGetReply reply;
+  reply.store_fd = store_fd;
+  ARROW_CHECK_OK(SerializeGetAsyncReply(get_req->async_request_id, object_id, object,
+                                        store_fd, mmap_size, &reply.message));
+  client->async_get_replies.push_back(std::move(reply));
+  // Earlier replies that are still queued are sent first.
+  if (!client->waiting_for_async_get_write) {
+    send_get_async_replies(client);
+  }
+}
+
+void PlasmaStore::send_get_async_replies(Client* client) {
+  while (!client->async_get_replies.empty()) {
+    AsyncGetReply& reply = client->async_get_replies.front();
+    ssize_t nbytes;
+    if (reply.num_sent < reply.message.size()) {
+      nbytes = send(client->async_get_fd, reply.message.data() + reply.num_sent,
+                    reply.message.size() - reply.num_sent, 0);
+      if (nbytes > 0) {
+        reply.num_sent += nbytes;
+        continue;
+      }
+    } else if (reply.store_fd == -1) {
+      // The object is missing or on a GPU, so no file descriptor follows.
+      client->async_get_replies.pop_front();
+      continue;
+    } else {
+      // The file descriptor is sent once the whole message has been sent.
+      nbytes = send_fd(client->async_get_fd, reply.store_fd);
+      if (nbytes >= 0) {
+        client->async_get_replies.pop_front();
+        continue;
+      }
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      // Wait until there is room in the send buffer of the socket.
+      if (!client->waiting_for_async_get_write) {
+        client->waiting_for_async_get_write = true;
+        client->loop->AddFileEvent(client->async_get_fd, kEventLoopWrite,
+                                   [this, client](int events) {
+                                     std::lock_guard<std::mutex> lock(mutex_);
+                                     send_get_async_replies(client);
+                                   });
+      }
+      return;
+    }
+    // The client has hung up, so no more replies are sent.
+    warn_if_sigpipe(-1, client->async_get_fd);
+    close_async_get_fd(client);
+    return;
+  }
+  if (client->waiting_for_async_get_write) {
+    client->waiting_for_async_get_write = false;
+    client->loop->RemoveFileEvent(client->async_get_fd);
+  }
+}
+
+void PlasmaStore::close_async_get_fd(Client* client) {
+  if (client->waiting_for_async_get_write) {
+    client->waiting_for_async_get_write = false;
+    client->loop->RemoveFileEvent(client->async_get_fd);
+  }
+  client->async_get_replies.clear();
+  close(client->async_get_fd);
+  client->async_get_fd = -1;
+}
+
 void PlasmaStore::update_object_get_requests(const ObjectID& object_id) {
   std::vector<GetRequest*>& get_requests = object_get_requests_[object_id];
   size_t index = 0;
@@ -356,9 +719,30 @@ void PlasmaStore::process_get_request(Client* client,
                                       const std::vector<ObjectID>& object_ids,
                                       int64_t timeout_ms) {
   // Create a get request for this object.
-  GetRequest* get_req = new GetRequest(client, object_ids);
+  wait_for_objects(new GetRequest(client, object_ids), timeout_ms);
+}
+
+void PlasmaStore::process_get_async_request(Client* client, int64_t request_id,
+                                            const std::vector<ObjectID>& object_ids,
+                                            int64_t timeout_ms) {
+  if (client->async_get_fd == -1) {
+    ARROW_LOG(WARNING) << "Client on fd " << client->fd
+                       << " made an asynchronous get request without a socket for the "
+                          "replies";
+    return;
+  }
+  // Each object is answered as soon as it is available, so each gets its own
+  // get request.
+  for (const auto& object_id : object_ids) {
+    GetRequest* get_req = new GetRequest(client, {object_id});
+    get_req->async_request_id = request_id;
+    wait_for_objects(get_req, timeout_ms);
+  }
+}
 
-  for (auto object_id : object_ids) {
+void PlasmaStore::wait_for_objects(GetRequest* get_req, int64_t timeout_ms) {
+  Client* client = get_req->client;
+  for (auto object_id : get_req->object_ids) {
     // Check if this object is already present locally. If so, record that the
     // object is being used and mark it as accounted for.
     auto entry = get_object_table_entry(&store_info_, object_id);
@@ -370,6 +754,16 @@ void PlasmaStore::process_get_request(Client* client,
       // where entry == NULL, this will be called from seal_object.
       add_client_to_object_clients(entry, client);
     } else {
+      // If the object has been spilled, read it back. The client is answered
+      // when the restore has finished, like for an object that is not sealed.
+      if (spilled_objects_.count(object_id) != 0 &&
+          pending_restores_.count(object_id) == 0) {
+        restore_object(object_id);
+      }
+      if (restoring_objects_.count(object_id) != 0 ||
+          pending_restores_.count(object_id) != 0) {
+        get_req->objects_to_restore.insert(object_id);
+      }
       // Add a placeholder plasma object to the get request to indicate that the
       // object is not present. This will be parsed by the client. We set the
       // data size to -1 to indicate that the object is not present.
@@ -380,17 +774,387 @@ void PlasmaStore::process_get_request(Client* client,
   }
 
   // If all of the objects are present already or if the timeout is 0, return to
-  // the client.
-  if (get_req->num_satisfied == get_req->num_objects_to_wait_for || timeout_ms == 0) {
+  // the client. Restores are waited for even if the timeout is 0.
+  if (get_req->num_satisfied == get_req->num_objects_to_wait_for ||
+      (timeout_ms == 0 && get_req->objects_to_restore.empty())) {
     return_from_get(get_req);
+  } else if (timeout_ms == 0) {
+    get_req->return_after_restore = true;
   } else if (timeout_ms != -1) {
     // Set a timer that will cause the get request to return to the client. Note
     // that a timeout of -1 is used to indicate that no timer should be set.
-    get_req->timer = loop_->AddTimer(timeout_ms, [this, get_req](int64_t timer_id) {
+    get_req->timer =
+        client->loop->AddTimer(timeout_ms, [this, get_req](int64_t timer_id) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (get_req->returned) {
+            // The reply has been posted by another thread, but the timer fired
+            // before it could be removed.
+            get_req->timer = -1;
+          } else {
+            return_from_get(get_req);
+          }
+          return kEventLoopTimerDone;
+        });
+  }
+}
+
+void PlasmaStore::restore_object(const ObjectID& object_id) {
+  auto it = spilled_objects_.find(object_id);
+  ARROW_CHECK(it != spilled_objects_.end());
+  int64_t size = it->second.data_size + it->second.metadata_size;
+  int fd = -1;
+  int64_t map_size = 0;
+  ptrdiff_t offset = 0;
+  uint8_t* pointer = allocate_memory(size, &fd, &map_size, &offset);
+  if (pointer == NULL) {
+    if (num_pending_spills_ > 0) {
+      // Try again once the objects that are being spilled have been written.
+      pending_restores_.insert(object_id);
+      return;
+    }
+    // Leave the object on disk, a later get request may find enough space.
+    ARROW_LOG(WARNING) << "not enough space to restore object " << object_id.hex();
+    return;
+  }
+  auto entry = std::unique_ptr<ObjectTableEntry>(new ObjectTableEntry());
+  entry->object_id = object_id;
+  entry->info = it->second;
+  entry->pointer = pointer;
+  entry->fd = fd;
+  entry->map_size = map_size;
+  entry->offset = offset;
+  // The object is not sealed until it has been read, so that no client can
+  // get it and the eviction policy does not know about it.
+  entry->state = PLASMA_CREATED;
+  entry->device_num = 0;
+  store_info_.objects[object_id] = std::move(entry);
+  spilled_objects_.erase(it);
+  restoring_objects_.insert(object_id);
+  spiller_->Restore(object_id, pointer, size);
+}
+
+void PlasmaStore::finish_restore(const ObjectID& object_id, const Status& status) {
+  restoring_objects_.erase(object_id);
+  auto entry = get_object_table_entry(&store_info_, object_id);
+  ARROW_CHECK(entry != NULL);
+  if (status.ok()) {
+    stats_.num_objects_restored += 1;
+    stats_.bytes_restored += entry->info.data_size + entry->info.metadata_size;
+    // Subscribers were not told that the object was evicted, so they are not
+    // told that it is back either.
+    entry->state = PLASMA_SEALED;
+    eviction_policy_.object_created(object_id);
+  } else {
+    ARROW_LOG(WARNING) << "failed to restore object " << object_id.hex() << ": "
+                       << status.ToString();
+    free_memory(entry->pointer);
+    store_info_.objects.erase(object_id);
+    entry = NULL;
+    ObjectInfoT notification;
+    notification.object_id = object_id.binary();
+    notification.is_deletion = true;
+    push_notification(&notification);
+  }
+  update_restore_get_requests(object_id, entry);
+}
+
+void PlasmaStore::update_restore_get_requests(const ObjectID& object_id,
+                                              ObjectTableEntry* entry) {
+  // Unlike in update_object_get_requests, the get requests must also be
+  // answered if the object could not be restored and they do not wait for
+  // other objects.
+  std::vector<GetRequest*> get_requests;
+  for (GetRequest* get_req : object_get_requests_[object_id]) {
+    if (std::find(get_requests.begin(), get_requests.end(), get_req) ==
+        get_requests.end()) {
+      get_requests.push_back(get_req);
+    }
+  }
+  for (GetRequest* get_req : get_requests) {
+    get_req->objects_to_restore.erase(object_id);
+    if (entry != NULL) {
+      PlasmaObject_init(&get_req->objects[object_id], entry);
+      get_req->num_satisfied += 1;
+      add_client_to_object_clients(entry, get_req->client);
+    }
+    if (get_req->num_satisfied == get_req->num_objects_to_wait_for ||
+        (get_req->return_after_restore && get_req->objects_to_restore.empty())) {
       return_from_get(get_req);
-      return kEventLoopTimerDone;
+    }
+  }
+  // If the object could not be restored, the get requests that have not been
+  // answered keep waiting for it, like for an object that does not exist, until
+  // it is created again or they time out.
+  if (entry != NULL || object_get_requests_[object_id].empty()) {
+    object_get_requests_.erase(object_id);
+  }
+}
+
+void PlasmaStore::process_spill_completions() {
+  std::vector<SpillCompletion> completions;
+  spiller_->PopCompletions(&completions);
+  bool memory_freed = false;
+  for (const auto& completion : completions) {
+    const ObjectID& object_id = completion.object_id;
+    if (completion.type == SpillCompletion::RESTORE) {
+      finish_restore(object_id, completion.status);
+    } else {
+      finish_spill(completion);
+      memory_freed = true;
+    }
+  }
+  if (memory_freed) {
+    retry_requests_waiting_for_spills();
+  }
+}
+
+void PlasmaStore::finish_spill(const SpillCompletion& completion) {
+  const ObjectID& object_id = completion.object_id;
+  free_memory(completion.data);
+  num_pending_spills_ -= 1;
+  if (completion.status.ok()) {
+    stats_.num_objects_spilled += 1;
+    stats_.bytes_spilled += completion.size;
+    return;
+  }
+  ARROW_LOG(WARNING) << "failed to spill object " << object_id.hex() << ": "
+                     << completion.status.ToString();
+  // The object is lost. If it is being restored, finish_restore reports that
+  // instead.
+  if (spilled_objects_.erase(object_id) != 0) {
+    ObjectInfoT notification;
+    notification.object_id = object_id.binary();
+    notification.is_deletion = true;
+    push_notification(&notification);
+  }
+}
+
+void PlasmaStore::retry_requests_waiting_for_spills() {
+  // The requests that still have to wait are added back.
+  std::deque<CreateRequest*> create_requests;
+  create_requests.swap(pending_creates_);
+  for (CreateRequest* request : create_requests) {
+    std::function<Status()> send_reply;
+    if (!process_create_request(*request, &send_reply)) {
+      pending_creates_.push_back(request);
+      continue;
+    }
+    Client* client = request->client;
+    delete request;
+    // Replies are only sent from the thread of the client. If it disconnects
+    // before, the objects are aborted by disconnect_client.
+    client->loop->Post([client, send_reply]() {
+      if (client->disconnected) {
+        return;
+      }
+      Status s = send_reply();
+      if (!s.ok()) {
+        ARROW_LOG(FATAL) << "Failed to send create reply: " << s;
+      }
     });
   }
+
+  std::unordered_set<ObjectID, UniqueIDHasher> restores;
+  restores.swap(pending_restores_);
+  for (const auto& object_id : restores) {
+    if (spilled_objects_.count(object_id) != 0) {
+      restore_object(object_id);
+    }
+    if (restoring_objects_.count(object_id) == 0 &&
+        pending_restores_.count(object_id) == 0) {
+      // The object has been deleted, or there is not enough space for it.
+      update_restore_get_requests(object_id, NULL);
+    }
+  }
+
+  std::vector<Client*> replica_clients;
+  replica_clients.swap(pending_replicas_);
+  for (Client* client : replica_clients) {
+    if (!create_replica(client)) {
+      pending_replicas_.push_back(client);
+      continue;
+    }
+    // Read the contents of the object on the thread of the client.
+    client->loop->Post([this, client]() {
+      if (!client->disconnected) {
+        watch_client(client);
+      }
+    });
+  }
+}
+
+int PlasmaStore::replicate_objects(Client* client,
+                                   const std::vector<ObjectID>& object_ids,
+                                   const std::string& store_socket_name) {
+  for (const auto& object_id : object_ids) {
+    auto entry = get_object_table_entry(&store_info_, object_id);
+    if (entry == NULL || entry->state != PLASMA_SEALED || entry->device_num != 0) {
+      return PlasmaError_ObjectNonexistent;
+    }
+  }
+  if (!replicator_) {
+    replicator_.reset(new ObjectReplicator());
+    ARROW_CHECK_OK(replicator_->Init());
+    // Completions are handled on the thread of the main event loop, like the
+    // ones of the spiller.
+    auto add_file_event = [this]() {
+      int fd = replicator_->completion_fd();
+      loop_->AddFileEvent(fd, kEventLoopRead, [this](int events) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        process_replication_completions();
+      });
+    };
+    if (loop_->IsLoopThread()) {
+      add_file_event();
+    } else {
+      loop_->Post(add_file_event);
+    }
+  }
+  int64_t request_id = next_replicate_request_id_++;
+  ReplicateRequest* request = new ReplicateRequest();
+  request->client = client;
+  request->num_remaining = object_ids.size();
+  replicate_requests_[request_id] = request;
+  for (const auto& object_id : object_ids) {
+    auto entry = get_object_table_entry(&store_info_, object_id);
+    // Keep the object from being evicted until it has been copied.
+    add_client_to_object_clients(entry, replication_client_.get());
+    replicating_objects_[object_id] += 1;
+    // The digest that the object was sealed with is kept in its info.
+    replicator_->Replicate(
+        request_id, store_socket_name, object_id, entry->fd, entry->offset,
+        entry->pointer, entry->info.data_size, entry->info.metadata_size,
+        reinterpret_cast<const unsigned char*>(entry->info.digest.data()));
+  }
+  return PlasmaError_OK;
+}
+
+void PlasmaStore::process_replication_completions() {
+  std::vector<ReplicationCompletion> completions;
+  replicator_->PopCompletions(&completions);
+  for (const auto& completion : completions) {
+    const ObjectID& object_id = completion.object_id;
+    auto count = replicating_objects_.find(object_id);
+    ARROW_CHECK(count != replicating_objects_.end());
+    if (--count->second == 0) {
+      replicating_objects_.erase(count);
+      remove_client_from_object_clients(get_object_table_entry(&store_info_, object_id),
+                                        replication_client_.get());
+    }
+    auto it = replicate_requests_.find(completion.request_id);
+    ARROW_CHECK(it != replicate_requests_.end());
+    ReplicateRequest* request = it->second;
+    if (!completion.status.ok() && request->failure.empty()) {
+      request->failure = "failed to copy object " + object_id.hex() + ": " +
+                         completion.status.ToString();
+    }
+    if (--request->num_remaining > 0) {
+      continue;
+    }
+    replicate_requests_.erase(it);
+    if (request->client == nullptr) {
+      // The client has disconnected.
+      delete request;
+      continue;
+    }
+    EventLoop* client_loop = request->client->loop;
+    if (client_loop->IsLoopThread()) {
+      send_replicate_reply(request);
+    } else {
+      client_loop->Post([this, request]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        send_replicate_reply(request);
+      });
+    }
+  }
+}
+
+void PlasmaStore::send_replicate_reply(ReplicateRequest* request) {
+  int client_fd = request->client->fd;
+  if (!request->client->disconnected) {
+    Status s = SendReplicateReply(client_fd, PlasmaError_OK, request->failure);
+    warn_if_sigpipe(s.ok() ? 0 : -1, client_fd);
+  }
+  delete request;
+}
+
+bool PlasmaStore::receive_replica(Client* client, const ObjectID& object_id,
+                                  int64_t data_size, int64_t metadata_size,
+                                  unsigned char* digest) {
+  std::unique_ptr<IncomingReplica> replica(new IncomingReplica());
+  replica->object_id = object_id;
+  replica->size = data_size + metadata_size;
+  replica->metadata_size = metadata_size;
+  memcpy(replica->digest, digest, kDigestSize);
+  client->replica = std::move(replica);
+  if (create_replica(client)) {
+    return true;
+  }
+  // The contents stay in the socket until retry_requests_waiting_for_spills
+  // has created the object.
+  client->loop->RemoveFileEvent(client->fd);
+  pending_replicas_.push_back(client);
+  return false;
+}
+
+bool PlasmaStore::create_replica(Client* client) {
+  IncomingReplica* replica = client->replica.get();
+  PlasmaObject object;
+  replica->error_code =
+      create_object(replica->object_id, replica->size - replica->metadata_size,
+                    replica->metadata_size, 0, client, &object);
+  if (must_wait_for_spills(replica->error_code)) {
+    return false;
+  }
+  if (replica->error_code == PlasmaError_OK) {
+    replica->pointer = get_object_table_entry(&store_info_, replica->object_id)->pointer;
+  }
+  return true;
+}
+
+Status PlasmaStore::read_replica(Client* client) {
+  IncomingReplica* replica = client->replica.get();
+  // The new object is held by the client, so it stays in place while its
+  // contents are read. They are read even if the object could not be created,
+  // so that the next message can be read.
+  std::vector<uint8_t> discarded;
+  if (replica->pointer == NULL) {
+    discarded.resize(std::min<int64_t>(replica->size, 1 << 16));
+  }
+  while (replica->num_read < replica->size) {
+    uint8_t* cursor = replica->pointer + replica->num_read;
+    int64_t length = replica->size - replica->num_read;
+    if (replica->pointer == NULL) {
+      cursor = discarded.data();
+      length = std::min<int64_t>(length, discarded.size());
+    }
+    ssize_t nbytes = recv(client->fd, cursor, static_cast<size_t>(length), MSG_DONTWAIT);
+    if (nbytes > 0) {
+      replica->num_read += nbytes;
+    } else if (nbytes < 0 && errno == EINTR) {
+      continue;
+    } else if (nbytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // The rest is read when the socket becomes readable again.
+      return Status::OK();
+    } else {
+      // The other store has gone away. The object is aborted along with the
+      // other objects that the client has not sealed.
+      std::lock_guard<std::mutex> lock(mutex_);
+      disconnect_client(client->fd);
+      return Status::OK();
+    }
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (replica->pointer != NULL) {
+    seal_object(replica->object_id, replica->digest);
+    release_object(replica->object_id, client);
+  }
+  ObjectID object_id = replica->object_id;
+  int error_code = replica->error_code;
+  client->replica.reset();
+  lock.unlock();
+  HANDLE_SIGPIPE(SendReplicaReply(client->fd, object_id, error_code), client->fd);
+  return Status::OK();
 }
 
 int PlasmaStore::remove_client_from_object_clients(ObjectTableEntry* entry,
@@ -424,7 +1188,13 @@ void PlasmaStore::release_object(const ObjectID& object_id, Client* client) {
 // Check if an object is present.
 int PlasmaStore::contains_object(const ObjectID& object_id) {
   auto entry = get_object_table_entry(&store_info_, object_id);
-  return entry && (entry->state == PLASMA_SEALED) ? OBJECT_FOUND : OBJECT_NOT_FOUND;
+  if (entry == NULL) {
+    // Spilled objects are still in the store, they are just not in memory.
+    return spilled_objects_.count(object_id) != 0 ? OBJECT_FOUND : OBJECT_NOT_FOUND;
+  }
+  return entry->state == PLASMA_SEALED || restoring_objects_.count(object_id) != 0
+             ? OBJECT_FOUND
+             : OBJECT_NOT_FOUND;
 }
 
 // Seal an object that has been created in the hash table.
@@ -456,7 +1226,7 @@ int PlasmaStore::abort_object(const ObjectID& object_id, Client* client) {
     return 0;
   } else {
     // The client requesting the abort is the creator. Free the object.
-    dlfree(entry->pointer);
+    free_memory(entry->pointer);
     store_info_.objects.erase(object_id);
     return 1;
   }
@@ -468,6 +1238,14 @@ int PlasmaStore::delete_object(ObjectID& object_id) {
   // error. Maybe we should also support deleting objects that have been
   // created but not sealed.
   if (entry == NULL) {
+    if (spilled_objects_.erase(object_id) != 0) {
+      spiller_->Remove(object_id);
+      ObjectInfoT notification;
+      notification.object_id = object_id.binary();
+      notification.is_deletion = true;
+      push_notification(&notification);
+      return PlasmaError_OK;
+    }
     // To delete an object it must be in the object table.
     return PlasmaError_ObjectNonexistent;
   }
@@ -484,7 +1262,7 @@ int PlasmaStore::delete_object(ObjectID& object_id) {
 
   eviction_policy_.remove_object(object_id);
 
-  dlfree(entry->pointer);
+  free_memory(entry->pointer);
   store_info_.objects.erase(object_id);
   // Inform all subscribers that the object has been deleted.
   ObjectInfoT notification;
@@ -507,7 +1285,22 @@ void PlasmaStore::delete_objects(const std::vector<ObjectID>& object_ids) {
         << "To delete an object it must have been sealed.";
     ARROW_CHECK(entry->clients.size() == 0)
         << "To delete an object, there must be no clients currently using it.";
-    dlfree(entry->pointer);
+    if (spiller_ && entry->device_num == 0) {
+      // The object is written straight from its memory, which is freed once
+      // the spill has completed. It stays in the store, so subscribers are not
+      // notified.
+      int64_t size = entry->info.data_size + entry->info.metadata_size;
+      spiller_->Spill(object_id, entry->pointer, size);
+      num_pending_spills_ += 1;
+      spilled_objects_[object_id] = entry->info;
+      store_info_.objects.erase(object_id);
+      stats_.num_objects_evicted += 1;
+      stats_.bytes_evicted += size;
+      continue;
+    }
+    stats_.num_objects_evicted += 1;
+    stats_.bytes_evicted += entry->info.data_size + entry->info.metadata_size;
+    free_memory(entry->pointer);
     store_info_.objects.erase(object_id);
     // Inform all subscribers that the object has been deleted.
     ObjectInfoT notification;
@@ -520,27 +1313,47 @@ void PlasmaStore::delete_objects(const std::vector<ObjectID>& object_ids) {
 void PlasmaStore::connect_client(int listener_sock) {
   int client_fd = AcceptClient(listener_sock);
 
-  Client* client = new Client(client_fd);
-  connected_clients_[client_fd] = std::unique_ptr<Client>(client);
+  // Distribute the clients over the worker threads, if there are any.
+  EventLoop* client_loop = loop_;
+  if (!worker_loops_.empty()) {
+    client_loop = worker_loops_[next_worker_loop_].get();
+    next_worker_loop_ = (next_worker_loop_ + 1) % worker_loops_.size();
+  }
+  Client* client = new Client(client_fd, client_loop);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connected_clients_[client_fd] = std::unique_ptr<Client>(client);
+  }
 
   // Add a callback to handle events on this socket.
+  if (client_loop == loop_) {
+    watch_client(client);
+  } else {
+    client_loop->Post([this, client]() { watch_client(client); });
+  }
+  ARROW_LOG(DEBUG) << "New connection with fd " << client_fd;
+}
+
+void PlasmaStore::watch_client(Client* client) {
   // TODO(pcm): Check return value.
-  loop_->AddFileEvent(client_fd, kEventLoopRead, [this, client](int events) {
+  client->loop->AddFileEvent(client->fd, kEventLoopRead, [this, client](int events) {
     Status s = process_message(client);
     if (!s.ok()) {
       ARROW_LOG(FATAL) << "Failed to process file event: " << s;
     }
   });
-  ARROW_LOG(DEBUG) << "New connection with fd " << client_fd;
 }
 
 void PlasmaStore::disconnect_client(int client_fd) {
   ARROW_CHECK(client_fd > 0);
   auto it = connected_clients_.find(client_fd);
   ARROW_CHECK(it != connected_clients_.end());
-  loop_->RemoveFileEvent(client_fd);
+  it->second->loop->RemoveFileEvent(client_fd);
   // Close the socket.
   close(client_fd);
+  if (it->second->async_get_fd != -1) {
+    close_async_get_fd(it->second.get());
+  }
   ARROW_LOG(INFO) << "Disconnecting client on fd " << client_fd;
   // If this client was using any objects, remove it from the appropriate
   // lists.
@@ -560,12 +1373,61 @@ void PlasmaStore::disconnect_client(int client_fd) {
   for (const auto& entry : unsealed_objects) {
     abort_object(entry, client);
   }
+  // Drop the get requests of the client that are still waiting for objects.
+  std::unordered_set<GetRequest*> get_requests;
+  for (auto& element : object_get_requests_) {
+    auto& object_requests = element.second;
+    for (auto request = object_requests.begin(); request != object_requests.end();) {
+      if ((*request)->client == client) {
+        get_requests.insert(*request);
+        request = object_requests.erase(request);
+      } else {
+        ++request;
+      }
+    }
+  }
+  for (GetRequest* get_req : get_requests) {
+    if (get_req->timer != -1) {
+      ARROW_CHECK(client->loop->RemoveTimer(get_req->timer) == AE_OK);
+    }
+    delete get_req;
+  }
+  // Drop the requests of the client that wait for spills.
+  for (auto request = pending_creates_.begin(); request != pending_creates_.end();) {
+    if ((*request)->client == client) {
+      delete *request;
+      request = pending_creates_.erase(request);
+    } else {
+      ++request;
+    }
+  }
+  pending_replicas_.erase(
+      std::remove(pending_replicas_.begin(), pending_replicas_.end(), client),
+      pending_replicas_.end());
+  // End the subscriptions of the client, so that their readers of the
+  // notification ring can be reused.
+  for (auto queue = pending_notifications_.begin();
+       queue != pending_notifications_.end();) {
+    auto next = std::next(queue);
+    if (queue->second.client == client) {
+      remove_subscriber(queue);
+    }
+    queue = next;
+  }
+  // The copies that the client has asked for are still made.
+  for (auto& element : replicate_requests_) {
+    if (element.second->client == client) {
+      element.second->client = nullptr;
+    }
+  }
 
-  // Note, the store may still attempt to send a message to the disconnected
-  // client (for example, when an object ID that the client was waiting for
-  // is ready). In these cases, the attempt to send the message will fail, but
-  // the store should just ignore the failure.
+  // Replies to get requests that have already been answered by another thread
+  // may still be posted to the thread of the client. They are dropped in
+  // send_get_reply, and the client is deleted after them.
+  client->disconnected = true;
+  it->second.release();
   connected_clients_.erase(it);
+  client->loop->Post([client]() { delete client; });
 }
 
 /// Send notifications about sealed objects to the subscribers. This is called
@@ -576,6 +1438,11 @@ void PlasmaStore::disconnect_client(int client_fd) {
 /// @param client_fd The client to send the notification to.
 void PlasmaStore::send_notifications(int client_fd) {
   auto it = pending_notifications_.find(client_fd);
+  if (it == pending_notifications_.end()) {
+    // The subscriber has hung up while the socket was being waited for.
+    return;
+  }
+  EventLoop* loop = it->second.loop;
 
   int num_processed = 0;
   bool closed = false;
@@ -596,14 +1463,19 @@ void PlasmaStore::send_notifications(int client_fd) {
       ARROW_LOG(DEBUG) << "The socket's send buffer is full, so we are caching this "
                           "notification and will send it later.";
       // Add a callback to the event loop to send queued notifications whenever
-      // there is room in the socket's send buffer. Callbacks can be added
-      // more than once here and will be overwritten. The callback is removed
-      // at the end of the method.
-      // TODO(pcm): Introduce status codes and check in case the file descriptor
-      // is added twice.
-      loop_->AddFileEvent(client_fd, kEventLoopWrite, [this, client_fd](int events) {
-        send_notifications(client_fd);
-      });
+      // there is room in the socket's send buffer. The callback is removed
+      // at the end of the method once the queue is empty. This may be called
+      // on any thread, so the event loop is changed through Post, which also
+      // keeps the changes in order.
+      if (!it->second.waiting_for_write) {
+        it->second.waiting_for_write = true;
+        loop->Post([this, loop, client_fd]() {
+          loop->AddFileEvent(client_fd, kEventLoopWrite, [this, client_fd](int events) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            send_notifications(client_fd);
+          });
+        });
+      }
       break;
     } else {
       ARROW_LOG(WARNING) << "Failed to send notification to client on fd " << client_fd;
@@ -621,39 +1493,153 @@ void PlasmaStore::send_notifications(int client_fd) {
   it->second.object_notifications.erase(
       it->second.object_notifications.begin(),
       it->second.object_notifications.begin() + num_processed);
+  // A subscriber that has been detached from the notification ring waits on
+  // its eventfd, not on the socket.
+  if (num_processed > 0 && it->second.event_fd != -1) {
+    signal_event_fd(it->second.event_fd);
+  }
 
   // Stop sending notifications if the pipe was broken.
   if (closed) {
-    close(client_fd);
-    pending_notifications_.erase(client_fd);
+    remove_subscriber(it);
+    return;
   }
 
   // If we have sent all notifications, remove the fd from the event loop.
-  if (it->second.object_notifications.empty()) {
-    loop_->RemoveFileEvent(client_fd);
+  if (it->second.object_notifications.empty() && it->second.waiting_for_write) {
+    it->second.waiting_for_write = false;
+    loop->Post([loop, client_fd]() { loop->RemoveFileEvent(client_fd); });
+  }
+}
+
+void PlasmaStore::remove_subscriber(
+    std::unordered_map<int, NotificationQueue>::iterator it) {
+  int fd = it->first;
+  NotificationQueue& queue = it->second;
+  EventLoop* loop = queue.loop;
+  bool waiting_for_write = queue.waiting_for_write;
+  if (queue.ring_reader != -1) {
+    notification_ring_->RemoveReader(queue.ring_reader);
+    close(queue.event_fd);
+  }
+  for (uint8_t* notification : queue.object_notifications) {
+    delete[] notification;
   }
+  pending_notifications_.erase(it);
+  // The socket is closed after it has been removed from the event loop, so
+  // that its file descriptor cannot be reused before.
+  loop->Post([loop, fd, waiting_for_write]() {
+    if (waiting_for_write) {
+      loop->RemoveFileEvent(fd);
+    }
+    close(fd);
+  });
 }
 
 void PlasmaStore::push_notification(ObjectInfoT* object_info) {
+  // The subscribers that read from the notification ring share a single copy
+  // of the notification, the others get it through their sockets.
+  uint8_t* ring_notification = nullptr;
+  bool fits_ring = false;
+  if (notification_ring_ != nullptr) {
+    ring_notification = create_object_info_buffer(object_info);
+    fits_ring = *(reinterpret_cast<int64_t*>(ring_notification)) <=
+                kNotificationRingSlotSize;
+  }
+  bool write_to_ring = false;
+  std::vector<int> socket_fds;
   for (auto& element : pending_notifications_) {
+    NotificationQueue& queue = element.second;
+    if (queue.ring_reader != -1 && !queue.ring_detached) {
+      int64_t sequence = notification_ring_->DetachIfFull(queue.ring_reader);
+      if (sequence == -1 && fits_ring) {
+        write_to_ring = true;
+        continue;
+      }
+      if (sequence == -1) {
+        sequence = notification_ring_->Detach(queue.ring_reader);
+      }
+      // The subscriber has not read the notifications that would be
+      // overwritten, or the notification does not fit into the ring, so the
+      // unread notifications are sent through its socket, followed by all
+      // further notifications. This also happens if the subscriber is gone,
+      // in which case the socket is closed once sending fails.
+      ARROW_LOG(DEBUG) << "Subscriber on fd " << element.first
+                       << " is detached from the notification ring";
+      queue.ring_detached = true;
+      for (; sequence < notification_ring_->write_sequence(); ++sequence) {
+        const uint8_t* data;
+        int64_t size;
+        notification_ring_->Get(sequence, &data, &size);
+        uint8_t* notification = new uint8_t[sizeof(int64_t) + size];
+        *(reinterpret_cast<int64_t*>(notification)) = size;
+        memcpy(notification + sizeof(int64_t), data, size);
+        queue.object_notifications.push_back(notification);
+      }
+    }
+    socket_fds.push_back(element.first);
+  }
+  if (write_to_ring) {
+    notification_ring_->Write(ring_notification + sizeof(int64_t),
+                              *(reinterpret_cast<int64_t*>(ring_notification)));
+    // Only wake up the subscribers that are waiting for a notification.
+    for (auto& element : pending_notifications_) {
+      const NotificationQueue& queue = element.second;
+      if (queue.ring_reader != -1 && !queue.ring_detached &&
+          notification_ring_->TakeWaiting(queue.ring_reader)) {
+        signal_event_fd(queue.event_fd);
+      }
+    }
+  }
+  delete[] ring_notification;
+  // Sending may remove subscribers that have hung up, so the file descriptors
+  // are collected first.
+  for (int fd : socket_fds) {
     uint8_t* notification = create_object_info_buffer(object_info);
-    element.second.object_notifications.push_back(notification);
-    send_notifications(element.first);
+    pending_notifications_[fd].object_notifications.push_back(notification);
+    send_notifications(fd);
     // The notification gets freed in send_notifications when the notification
     // is sent over the socket.
   }
 }
 
+void PlasmaStore::signal_event_fd(int event_fd) {
+  uint64_t count = 1;
+  if (write(event_fd, &count, sizeof(count)) != sizeof(count)) {
+    ARROW_LOG(WARNING) << "Failed to wake up subscriber on eventfd " << event_fd;
+  }
+}
+
 // Subscribe to notifications about sealed objects.
-void PlasmaStore::subscribe_to_updates(Client* client) {
+void PlasmaStore::subscribe_to_updates(Client* client, int fd, bool use_ring,
+                                       std::function<Status()>* send_reply) {
   ARROW_LOG(DEBUG) << "subscribing to updates on fd " << client->fd;
-  // TODO(rkn): The store could block here if the client doesn't send a file
-  // descriptor.
-  int fd = recv_fd(client->fd);
+  // A ring subscription is answered with the reader of the ring, or with -1 if
+  // the notifications are sent through the socket. The file descriptors of the
+  // ring are duplicated, so that they stay valid until they have been sent.
+  auto send_ring_reply = [client](int reader, int64_t ring_size, int ring_fd,
+                                  int event_fd) -> Status {
+    Status s = SendSubscribeRingReply(client->fd, reader, ring_size);
+    if (s.ok() && reader != -1 &&
+        (send_fd(client->fd, ring_fd) < 0 || send_fd(client->fd, event_fd) < 0)) {
+      ARROW_LOG(WARNING) << "Failed to send the notification ring to client on fd "
+                         << client->fd;
+    }
+    if (reader != -1) {
+      close(ring_fd);
+      close(event_fd);
+    }
+    HANDLE_SIGPIPE(s, client->fd);
+    return Status::OK();
+  };
+  *send_reply = []() { return Status::OK(); };
   if (fd < 0) {
     // This may mean that the client died before sending the file descriptor.
     ARROW_LOG(WARNING) << "Failed to receive file descriptor from client on fd "
                        << client->fd << ".";
+    if (use_ring) {
+      *send_reply = std::bind(send_ring_reply, -1, 0, -1, -1);
+    }
     return;
   }
 
@@ -661,7 +1647,38 @@ void PlasmaStore::subscribe_to_updates(Client* client) {
   // subscriber yet because the socket send buffer is full. TODO(rkn): the queue
   // never gets freed.
   // TODO(pcm): Is the following neccessary?
-  pending_notifications_[fd];
+  NotificationQueue& queue = pending_notifications_[fd];
+  queue.loop = client->loop;
+  queue.client = client;
+
+  if (use_ring) {
+#ifdef __linux__
+    if (notification_ring_ == nullptr) {
+      Status s = NotificationRing::Create(store_info_.directory, &notification_ring_);
+      if (!s.ok()) {
+        ARROW_LOG(WARNING) << "Sending notifications through sockets only: "
+                           << s.ToString();
+      }
+    }
+    if (notification_ring_ != nullptr) {
+      queue.ring_reader = notification_ring_->AddReader();
+    }
+    if (queue.ring_reader != -1) {
+      queue.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (queue.event_fd < 0) {
+        notification_ring_->RemoveReader(queue.ring_reader);
+        queue.ring_reader = -1;
+      }
+    }
+#endif
+    if (queue.ring_reader == -1) {
+      *send_reply = std::bind(send_ring_reply, -1, 0, -1, -1);
+    } else {
+      *send_reply =
+          std::bind(send_ring_reply, queue.ring_reader, notification_ring_->size(),
+                    dup(notification_ring_->fd()), dup(queue.event_fd));
+    }
+  }
 
   // Push notifications to the new subscriber about existing objects.
   for (const auto& entry : store_info_.objects) {
@@ -671,43 +1688,63 @@ void PlasmaStore::subscribe_to_updates(Client* client) {
 }
 
 Status PlasmaStore::process_message(Client* client) {
+  // The contents of an object from another store come before the next message.
+  if (client->replica != nullptr) {
+    return read_replica(client);
+  }
   int64_t type;
-  Status s = ReadMessage(client->fd, &type, &input_buffer_);
+  Status s = ReadMessage(client->fd, &type, &client->input_buffer);
   ARROW_CHECK(s.ok() || s.IsIOError());
+  auto start = std::chrono::steady_clock::now();
 
-  uint8_t* input = input_buffer_.data();
-  size_t input_size = input_buffer_.size();
+  uint8_t* input = client->input_buffer.data();
+  size_t input_size = client->input_buffer.size();
   ObjectID object_id;
   PlasmaObject object;
   // TODO(pcm): Get rid of the following.
   memset(&object, 0, sizeof(object));
 
+  // Replies to this client are only sent from this thread, so the lock is
+  // released before sending them where possible.
+  std::unique_lock<std::mutex> lock(mutex_);
+
   // Process the different types of requests.
   switch (type) {
-    case MessageType_PlasmaCreateRequest: {
-      int64_t data_size;
-      int64_t metadata_size;
-      int device_num;
-      RETURN_NOT_OK(ReadCreateRequest(input, input_size, &object_id, &data_size,
-                                      &metadata_size, &device_num));
-      int error_code =
-          create_object(object_id, data_size, metadata_size, device_num, client, &object);
-      int64_t mmap_size = 0;
-      if (error_code == PlasmaError_OK && device_num == 0) {
-        mmap_size = get_mmap_size(object.store_fd);
+    case MessageType_PlasmaCreateRequest:
+    case MessageType_PlasmaCreateBatchRequest: {
+      std::unique_ptr<CreateRequest> request(new CreateRequest());
+      request->client = client;
+      request->batch = type == MessageType_PlasmaCreateBatchRequest;
+      request->device_num = 0;
+      if (request->batch) {
+        RETURN_NOT_OK(ReadCreateBatchRequest(input, input_size, &request->object_ids,
+                                             &request->data_sizes,
+                                             &request->metadata_sizes));
+      } else {
+        request->object_ids.resize(1);
+        request->data_sizes.resize(1);
+        request->metadata_sizes.resize(1);
+        RETURN_NOT_OK(ReadCreateRequest(input, input_size, &request->object_ids[0],
+                                        &request->data_sizes[0],
+                                        &request->metadata_sizes[0],
+                                        &request->device_num));
       }
-      HANDLE_SIGPIPE(
-          SendCreateReply(client->fd, object_id, &object, error_code, mmap_size),
-          client->fd);
-      if (error_code == PlasmaError_OK && device_num == 0) {
-        warn_if_sigpipe(send_fd(client->fd, object.store_fd), client->fd);
+      std::function<Status()> send_reply;
+      if (!process_create_request(*request, &send_reply)) {
+        // The client is answered once the objects that are being spilled have
+        // been written and their memory has been freed.
+        pending_creates_.push_back(request.release());
+        break;
       }
+      lock.unlock();
+      RETURN_NOT_OK(send_reply());
     } break;
     case MessageType_PlasmaAbortRequest: {
       RETURN_NOT_OK(ReadAbortRequest(input, input_size, &object_id));
       ARROW_CHECK(abort_object(object_id, client) == 1) << "To abort an object, the only "
                                                            "client currently using it "
                                                            "must be the creator.";
+      lock.unlock();
       HANDLE_SIGPIPE(SendAbortReply(client->fd, object_id), client->fd);
     } break;
     case MessageType_PlasmaGetRequest: {
@@ -716,18 +1753,87 @@ Status PlasmaStore::process_message(Client* client) {
       RETURN_NOT_OK(ReadGetRequest(input, input_size, object_ids_to_get, &timeout_ms));
       process_get_request(client, object_ids_to_get, timeout_ms);
     } break;
+    case MessageType_PlasmaGetAsyncConnectRequest: {
+      // The socket follows the request. It is received without holding the
+      // lock, since the client may be slow to send it.
+      lock.unlock();
+      int fd = recv_fd(client->fd);
+      if (fd < 0) {
+        ARROW_LOG(WARNING) << "Failed to receive the socket for asynchronous gets";
+        break;
+      }
+      // The replies are sent from the event loop, which must not block if
+      // the client does not read them.
+      int flags = fcntl(fd, F_GETFL, 0);
+      if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+        ARROW_LOG(WARNING) << "Failed to make the socket for asynchronous gets "
+                              "non-blocking";
+      }
+      lock.lock();
+      if (client->async_get_fd != -1) {
+        close_async_get_fd(client);
+      }
+      client->async_get_fd = fd;
+    } break;
+    case MessageType_PlasmaGetAsyncRequest: {
+      int64_t request_id;
+      std::vector<ObjectID> object_ids_to_get;
+      int64_t timeout_ms;
+      RETURN_NOT_OK(ReadGetAsyncRequest(input, input_size, &request_id,
+                                        &object_ids_to_get, &timeout_ms));
+      process_get_async_request(client, request_id, object_ids_to_get, timeout_ms);
+    } break;
+    case MessageType_PlasmaReplicateRequest: {
+      std::vector<ObjectID> object_ids;
+      std::string store_socket_name;
+      RETURN_NOT_OK(
+          ReadReplicateRequest(input, input_size, &object_ids, &store_socket_name));
+      int error_code = PlasmaError_OK;
+      if (!object_ids.empty()) {
+        error_code = replicate_objects(client, object_ids, store_socket_name);
+      }
+      lock.unlock();
+      // Otherwise the client is answered once the objects have been copied.
+      if (error_code != PlasmaError_OK || object_ids.empty()) {
+        HANDLE_SIGPIPE(SendReplicateReply(client->fd, error_code, ""), client->fd);
+      }
+    } break;
+    case MessageType_PlasmaReplicaRequest: {
+      int64_t data_size;
+      int64_t metadata_size;
+      unsigned char digest[kDigestSize];
+      RETURN_NOT_OK(ReadReplicaRequest(input, input_size, &object_id, &data_size,
+                                       &metadata_size, &digest[0]));
+      bool created =
+          receive_replica(client, object_id, data_size, metadata_size, &digest[0]);
+      // Read what has arrived already. An empty object is finished right away.
+      lock.unlock();
+      if (created) {
+        RETURN_NOT_OK(read_replica(client));
+      }
+    } break;
     case MessageType_PlasmaReleaseRequest: {
       RETURN_NOT_OK(ReadReleaseRequest(input, input_size, &object_id));
       release_object(object_id, client);
     } break;
+    case MessageType_PlasmaReleaseBatchRequest: {
+      std::vector<ObjectID> object_ids;
+      RETURN_NOT_OK(ReadReleaseBatchRequest(input, input_size, &object_ids));
+      for (const auto& released_object_id : object_ids) {
+        release_object(released_object_id, client);
+      }
+    } break;
     case MessageType_PlasmaDeleteRequest: {
       RETURN_NOT_OK(ReadDeleteRequest(input, input_size, &object_id));
       int error_code = delete_object(object_id);
+      lock.unlock();
       HANDLE_SIGPIPE(SendDeleteReply(client->fd, object_id, error_code), client->fd);
     } break;
     case MessageType_PlasmaContainsRequest: {
       RETURN_NOT_OK(ReadContainsRequest(input, input_size, &object_id));
-      if (contains_object(object_id) == OBJECT_FOUND) {
+      bool found = contains_object(object_id) == OBJECT_FOUND;
+      lock.unlock();
+      if (found) {
         HANDLE_SIGPIPE(SendContainsReply(client->fd, object_id, 1), client->fd);
       } else {
         HANDLE_SIGPIPE(SendContainsReply(client->fd, object_id, 0), client->fd);
@@ -738,6 +1844,14 @@ Status PlasmaStore::process_message(Client* client) {
       RETURN_NOT_OK(ReadSealRequest(input, input_size, &object_id, &digest[0]));
       seal_object(object_id, &digest[0]);
     } break;
+    case MessageType_PlasmaSealBatchRequest: {
+      std::vector<ObjectID> object_ids;
+      std::vector<unsigned char> digests;
+      RETURN_NOT_OK(ReadSealBatchRequest(input, input_size, &object_ids, &digests));
+      for (size_t i = 0; i < object_ids.size(); ++i) {
+        seal_object(object_ids[i], &digests[i * kDigestSize]);
+      }
+    } break;
     case MessageType_PlasmaEvictRequest: {
       // This code path should only be used for testing.
       int64_t num_bytes;
@@ -746,42 +1860,142 @@ Status PlasmaStore::process_message(Client* client) {
       int64_t num_bytes_evicted =
           eviction_policy_.choose_objects_to_evict(num_bytes, &objects_to_evict);
       delete_objects(objects_to_evict);
+      lock.unlock();
       HANDLE_SIGPIPE(SendEvictReply(client->fd, num_bytes_evicted), client->fd);
     } break;
     case MessageType_PlasmaSubscribeRequest:
-      subscribe_to_updates(client);
-      break;
+    case MessageType_PlasmaSubscribeRingRequest: {
+      // The socket for the notifications follows the request. It is received
+      // without holding the lock, since the client may be slow to send it.
+      lock.unlock();
+      int fd = recv_fd(client->fd);
+      lock.lock();
+      std::function<Status()> send_reply;
+      subscribe_to_updates(client, fd, type == MessageType_PlasmaSubscribeRingRequest,
+                           &send_reply);
+      lock.unlock();
+      RETURN_NOT_OK(send_reply());
+    } break;
+    case MessageType_PlasmaInfoRequest: {
+      PlasmaStoreStats stats;
+      collect_stats(&stats);
+      lock.unlock();
+      HANDLE_SIGPIPE(SendInfoReply(client->fd, stats), client->fd);
+    } break;
     case MessageType_PlasmaConnectRequest: {
+      lock.unlock();
       HANDLE_SIGPIPE(SendConnectReply(client->fd, store_info_.memory_capacity),
                      client->fd);
     } break;
     case DISCONNECT_CLIENT:
       ARROW_LOG(DEBUG) << "Disconnecting client on fd " << client->fd;
       disconnect_client(client->fd);
-      break;
+      return Status::OK();
     default:
       // This code should be unreachable.
       ARROW_CHECK(0);
   }
+  // The latency of a get request is recorded when it is answered.
+  if (type != MessageType_PlasmaGetRequest && type != MessageType_PlasmaGetAsyncRequest) {
+    record_latency(type, start);
+  }
   return Status::OK();
 }
 
+void PlasmaStore::record_latency(int64_t type,
+                                 std::chrono::steady_clock::time_point start) {
+  if (type < 0 || type > MessageType_MAX) {
+    return;
+  }
+  int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  // Bucket i holds the latencies below 2^i microseconds.
+  int bucket = 0;
+  while (bucket < kNumLatencyBuckets - 1 && (micros >> bucket) != 0) {
+    ++bucket;
+  }
+  latency_counts_[type * kNumLatencyBuckets + bucket].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+void PlasmaStore::collect_stats(PlasmaStoreStats* stats) {
+  *stats = stats_;
+  for (const auto& element : store_info_.objects) {
+    const ObjectTableEntry& entry = *element.second;
+    int64_t size = entry.info.data_size + entry.info.metadata_size;
+    if (entry.state == PLASMA_SEALED) {
+      stats->num_objects_sealed += 1;
+      stats->bytes_sealed += size;
+    } else {
+      stats->num_objects_created += 1;
+      stats->bytes_created += size;
+    }
+    if (!entry.clients.empty()) {
+      stats->num_objects_in_use += 1;
+      stats->bytes_in_use += size;
+    }
+  }
+  if (extent_allocator_) {
+    stats->allocator_footprint = extent_allocator_->capacity();
+    stats->allocator_allocated = extent_allocator_->allocated();
+    stats->allocator_free = extent_allocator_->free();
+    stats->allocator_free_chunks = extent_allocator_->num_free_extents();
+    stats->allocator_largest_free = extent_allocator_->largest_free_extent();
+  } else {
+    get_malloc_stats(&stats->allocator_footprint, &stats->allocator_allocated,
+                     &stats->allocator_free, &stats->allocator_free_chunks,
+                     &stats->allocator_largest_free);
+  }
+  // The share of the free memory that an object could not use, because it is
+  // not in the largest free extent.
+  stats->allocator_fragmentation =
+      stats->allocator_free > 0
+          ? 1.0 - static_cast<double>(stats->allocator_largest_free) /
+                      static_cast<double>(stats->allocator_free)
+          : 0.0;
+  // A get request that waits for several objects is in several lists.
+  std::unordered_set<GetRequest*> get_requests;
+  for (const auto& element : object_get_requests_) {
+    get_requests.insert(element.second.begin(), element.second.end());
+  }
+  stats->num_pending_get_requests = get_requests.size();
+  stats->num_clients = connected_clients_.size();
+  stats->num_subscribers = pending_notifications_.size();
+  stats->latencies.clear();
+  for (int64_t type = 0; type <= MessageType_MAX; ++type) {
+    LatencyHistogram histogram;
+    int64_t total = 0;
+    for (int bucket = 0; bucket < kNumLatencyBuckets; ++bucket) {
+      histogram.counts.push_back(latency_counts_[type * kNumLatencyBuckets + bucket]);
+      total += histogram.counts.back();
+    }
+    if (total > 0) {
+      histogram.operation = EnumNameMessageType(static_cast<MessageType>(type));
+      stats->latencies.push_back(histogram);
+    }
+  }
+}
+
 class PlasmaStoreRunner {
  public:
   PlasmaStoreRunner() {}
 
   void Start(char* socket_name, int64_t system_memory, std::string directory,
-             bool hugepages_enabled, bool use_one_memory_mapped_file) {
+             bool hugepages_enabled, bool use_one_memory_mapped_file,
+             EvictionPolicyType eviction_policy_type, std::string spill_directory,
+             int num_threads, bool use_extent_allocator) {
     // Create the event loop.
     loop_.reset(new EventLoop);
-    store_.reset(
-        new PlasmaStore(loop_.get(), system_memory, directory, hugepages_enabled));
+    store_.reset(new PlasmaStore(loop_.get(), system_memory, directory, hugepages_enabled,
+                                 eviction_policy_type, spill_directory, num_threads,
+                                 use_extent_allocator));
     plasma_config = store_->get_plasma_store_info();
 
     // If the store is configured to use a single memory-mapped file, then we
     // achieve that by mallocing and freeing a single large amount of space.
     // that maximum allowed size up front.
-    if (use_one_memory_mapped_file) {
+    if (use_one_memory_mapped_file && !use_extent_allocator) {
       void* pointer = plasma::dlmemalign(BLOCK_SIZE, system_memory);
       ARROW_CHECK(pointer != NULL);
       plasma::dlfree(pointer);
@@ -799,8 +2013,9 @@ class PlasmaStoreRunner {
 
   void Shutdown() {
     loop_->Stop();
-    loop_ = nullptr;
+    // The store stops its worker threads before the event loop is destroyed.
     store_ = nullptr;
+    loop_ = nullptr;
   }
 
  private:
@@ -821,7 +2036,9 @@ void HandleSignal(int signal) {
 }
 
 void start_server(char* socket_name, int64_t system_memory, std::string plasma_directory,
-                  bool hugepages_enabled, bool use_one_memory_mapped_file) {
+                  bool hugepages_enabled, bool use_one_memory_mapped_file,
+                  EvictionPolicyType eviction_policy_type, std::string spill_directory,
+                  int num_threads, bool use_extent_allocator) {
   // Ignore SIGPIPE signals. If we don't do this, then when we attempt to write
   // to a client that has already died, the store could die.
   signal(SIGPIPE, SIG_IGN);
@@ -829,7 +2046,8 @@ void start_server(char* socket_name, int64_t system_memory, std::string plasma_d
   g_runner.reset(new PlasmaStoreRunner());
   signal(SIGTERM, HandleSignal);
   g_runner->Start(socket_name, system_memory, plasma_directory, hugepages_enabled,
-                  use_one_memory_mapped_file);
+                  use_one_memory_mapped_file, eviction_policy_type, spill_directory,
+                  num_threads, use_extent_allocator);
 }
 
 }  // namespace plasma
@@ -842,9 +2060,45 @@ int main(int argc, char* argv[]) {
   // True if a single large memory-mapped file should be created at startup.
   bool use_one_memory_mapped_file = false;
   int64_t system_memory = -1;
+  // The algorithm used to choose the objects to evict.
+  plasma::EvictionPolicyType eviction_policy_type = plasma::EvictionPolicyType::LRU;
+  // Directory where evicted objects are written, if any.
+  std::string spill_directory;
+  // The number of threads that serve clients.
+  int num_threads = 1;
+  // Whether objects are allocated with the extent allocator instead of dlmalloc.
+  bool use_extent_allocator = false;
   int c;
-  while ((c = getopt(argc, argv, "s:m:d:hf")) != -1) {
+  while ((c = getopt(argc, argv, "s:m:d:e:S:t:a:hf")) != -1) {
     switch (c) {
+      case 'a': {
+        std::string allocator(optarg);
+        if (allocator != "dlmalloc" && allocator != "extent") {
+          ARROW_LOG(FATAL) << "unknown allocator '" << allocator
+                           << "', expected one of dlmalloc or extent";
+        }
+        use_extent_allocator = allocator == "extent";
+        break;
+      }
+      case 't': {
+        char extra;
+        int scanned = sscanf(optarg, "%d%c", &num_threads, &extra);
+        if (scanned != 1 || num_threads < 1) {
+          ARROW_LOG(FATAL) << "the number of threads must be a positive integer";
+        }
+        break;
+      }
+      case 'S':
+        spill_directory = std::string(optarg);
+        break;
+      case 'e': {
+        arrow::Status s =
+            plasma::ParseEvictionPolicyType(std::string(optarg), &eviction_policy_type);
+        if (!s.ok()) {
+          ARROW_LOG(FATAL) << s.message();
+        }
+        break;
+      }
       case 'd':
         plasma_directory = std::string(optarg);
         break;
@@ -889,8 +2143,19 @@ int main(int argc, char* argv[]) {
 #endif
   }
   ARROW_LOG(INFO) << "Starting object store with directory " << plasma_directory
-                  << " and huge page support "
-                  << (hugepages_enabled ? "enabled" : "disabled");
+                  << ", huge page support "
+                  << (hugepages_enabled ? "enabled" : "disabled")
+                  << " and eviction policy "
+                  << plasma::EvictionPolicyTypeName(eviction_policy_type);
+  if (!spill_directory.empty()) {
+    ARROW_LOG(INFO) << "Spilling evicted objects to " << spill_directory;
+  }
+  if (num_threads > 1) {
+    ARROW_LOG(INFO) << "Serving clients with " << num_threads << " threads";
+  }
+  if (use_extent_allocator) {
+    ARROW_LOG(INFO) << "Allocating objects with size classes and best-fit extents";
+  }
 #ifdef __linux__
   if (!hugepages_enabled) {
     // On Linux, check that the amount of memory available in /dev/shm is large
@@ -920,5 +2185,6 @@ int main(int argc, char* argv[]) {
   plasma::dlmalloc_set_footprint_limit((size_t)system_memory);
   ARROW_LOG(DEBUG) << "starting server listening on " << socket_name;
   plasma::start_server(socket_name, system_memory, plasma_directory, hugepages_enabled,
-                       use_one_memory_mapped_file);
+                       use_one_memory_mapped_file, eviction_policy_type, spill_directory,
+                       num_threads, use_extent_allocator);
 }
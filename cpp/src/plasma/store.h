@@ -18,41 +18,128 @@
 #ifndef PLASMA_STORE_H
 #define PLASMA_STORE_H
 
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "plasma/common.h"
 #include "plasma/events.h"
 #include "plasma/eviction_policy.h"
+#include "plasma/notification_ring.h"
 #include "plasma/plasma.h"
 #include "plasma/protocol.h"
+#include "plasma/replication.h"
+#include "plasma/spill.h"
 
 namespace plasma {
 
+struct Client;
+struct CreateRequest;
 struct GetRequest;
+struct ReplicateRequest;
 
 struct NotificationQueue {
   /// The object notifications for clients. We notify the client about the
   /// objects in the order that the objects were sealed or deleted.
   std::deque<uint8_t*> object_notifications;
+  /// The client that subscribed. The subscription ends when it disconnects.
+  Client* client = nullptr;
+  /// The event loop that waits for the socket to become writable when its
+  /// send buffer is full.
+  EventLoop* loop;
+  /// Whether the socket is registered with the event loop.
+  bool waiting_for_write = false;
+  /// The reader of the notification ring, or -1 if the subscriber only
+  /// receives notifications through the socket.
+  int ring_reader = -1;
+  /// Whether the reader has been detached from the ring because the
+  /// subscriber fell behind. Notifications are sent through the socket then.
+  bool ring_detached = false;
+  /// The eventfd through which the subscriber is woken up, or -1.
+  int event_fd = -1;
+};
+
+/// A reply to an asynchronous get that has not been sent completely.
+struct AsyncGetReply {
+  /// The message, including its header.
+  std::vector<uint8_t> message;
+  /// The number of bytes of the message that have been sent.
+  size_t num_sent = 0;
+  /// The file descriptor that is sent after the message, or -1.
+  int store_fd = -1;
+};
+
+/// A copy of an object that is being received from another store.
+struct IncomingReplica {
+  ObjectID object_id;
+  /// Where the contents of the object are read to, or null if the object
+  /// could not be created and its contents are thrown away.
+  uint8_t* pointer = nullptr;
+  /// The size in bytes of the contents of the object.
+  int64_t size = 0;
+  /// The number of bytes that have been read.
+  int64_t num_read = 0;
+  /// The size in bytes of the metadata of the object.
+  int64_t metadata_size = 0;
+  /// The result of creating the object, which is sent back.
+  int error_code = 0;
+  unsigned char digest[kDigestSize];
 };
 
 /// Contains all information that is associated with a Plasma store client.
 struct Client {
-  explicit Client(int fd);
+  Client(int fd, EventLoop* loop);
 
   /// The file descriptor used to communicate with the client.
   int fd;
+  /// The event loop that serves this client. All messages to the client are
+  /// sent from the thread of this event loop.
+  EventLoop* loop;
+  /// Input buffer. This is allocated only once to avoid mallocs for every
+  /// call to process_message.
+  std::vector<uint8_t> input_buffer;
+  /// Whether the client has disconnected. The client is deleted once the
+  /// callbacks that have been posted to its event loop have run.
+  bool disconnected;
+  /// The socket through which the replies to asynchronous get requests are
+  /// sent, or -1 if the client has not made any. It is non-blocking.
+  int async_get_fd;
+  /// The replies to asynchronous get requests that wait for room in the send
+  /// buffer of the socket.
+  std::deque<AsyncGetReply> async_get_replies;
+  /// Whether the socket for asynchronous gets is registered with the event
+  /// loop, because its send buffer is full.
+  bool waiting_for_async_get_write;
+  /// The copy of an object that the client, which is another store, is
+  /// sending, or null. Its contents are read as they arrive, before the next
+  /// message.
+  std::unique_ptr<IncomingReplica> replica;
 };
 
 class PlasmaStore {
  public:
   // TODO: PascalCase PlasmaStore methods.
+  /// @param num_threads The number of threads that serve clients. If it is
+  ///        larger than 1, each client is assigned to one of that many event
+  ///        loops running on their own threads, and the event loop passed in
+  ///        only accepts connections. Otherwise all clients are served by the
+  ///        event loop passed in.
+  /// @param use_extent_allocator Whether objects are allocated with an
+  ///        ExtentAllocator from a single memory mapped file rather than with
+  ///        dlmalloc.
   PlasmaStore(EventLoop* loop, int64_t system_memory, std::string directory,
-              bool hugetlbfs_enabled);
+              bool hugetlbfs_enabled,
+              EvictionPolicyType eviction_policy_type = EvictionPolicyType::LRU,
+              std::string spill_directory = "", int num_threads = 1,
+              bool use_extent_allocator = false);
 
   ~PlasmaStore();
 
@@ -83,6 +170,21 @@ class PlasmaStore {
   int create_object(const ObjectID& object_id, int64_t data_size, int64_t metadata_size,
                     int device_num, Client* client, PlasmaObject* result);
 
+  /// Create several objects on the host. Either all of them are created, or
+  /// none of them.
+  ///
+  /// @param object_ids Object IDs of the objects to be created.
+  /// @param data_sizes Sizes in bytes of the objects to be created.
+  /// @param metadata_sizes Sizes in bytes of the objects' metadata.
+  /// @param client The client that created the objects.
+  /// @param results The objects that have been created.
+  /// @return The error code of the first object that could not be created, see
+  ///         create_object, or PlasmaError_OK.
+  int create_objects(const std::vector<ObjectID>& object_ids,
+                     const std::vector<int64_t>& data_sizes,
+                     const std::vector<int64_t>& metadata_sizes, Client* client,
+                     std::vector<PlasmaObject>* results);
+
   /// Abort a created but unsealed object. If the client is not the
   /// creator, then the abort will fail.
   ///
@@ -103,6 +205,8 @@ class PlasmaStore {
 
   /// Delete objects that have been created in the hash table. This should only
   /// be called on objects that are returned by the eviction policy to evict.
+  /// If the store has a spill directory, the objects are written there instead
+  /// of being discarded.
   ///
   /// @param object_ids Object IDs of the objects to be deleted.
   void delete_objects(const std::vector<ObjectID>& object_ids);
@@ -115,12 +219,28 @@ class PlasmaStore {
   /// For each object, the client must do a call to release_object to tell the
   /// store when it is done with the object.
   ///
+  /// Objects that have been spilled to disk are restored in the background. The
+  /// request waits for them even if the timeout is 0.
+  ///
   /// @param client The client making this request.
   /// @param object_ids Object IDs of the objects to be gotten.
   /// @param timeout_ms The timeout for the get request in milliseconds.
   void process_get_request(Client* client, const std::vector<ObjectID>& object_ids,
                            int64_t timeout_ms);
 
+  /// Process an asynchronous get request from a client. Unlike for
+  /// process_get_request, each object is answered on its own as soon as it is
+  /// sealed, or when the request times out. The replies are sent through the
+  /// socket that the client has passed with a PlasmaGetAsyncConnectRequest.
+  ///
+  /// @param client The client making this request.
+  /// @param request_id The ID that the client assigned to this request.
+  /// @param object_ids Object IDs of the objects to be gotten.
+  /// @param timeout_ms The timeout for each object in milliseconds.
+  void process_get_async_request(Client* client, int64_t request_id,
+                                 const std::vector<ObjectID>& object_ids,
+                                 int64_t timeout_ms);
+
   /// Seal an object. The object is now immutable and can be accessed with get.
   ///
   /// @param object_id Object ID of the object to be sealed.
@@ -145,7 +265,15 @@ class PlasmaStore {
   /// Subscribe a file descriptor to updates about new sealed objects.
   ///
   /// @param client The client making this request.
-  void subscribe_to_updates(Client* client);
+  /// @param fd The socket that the client has sent for the notifications, or
+  ///        -1 if it could not be received.
+  /// @param use_ring Whether the client asked to read notifications from the
+  ///        notification ring. It is sent a reader of the ring if one is
+  ///        available.
+  /// @param send_reply Set to a function that sends the reply. It must be
+  ///        called on the thread of the client, without holding the lock.
+  void subscribe_to_updates(Client* client, int fd, bool use_ring,
+                            std::function<Status()>* send_reply);
 
   /// Connect a new client to the PlasmaStore.
   ///
@@ -161,27 +289,199 @@ class PlasmaStore {
 
   Status process_message(Client* client);
 
+  /// Handle the spills and restores that have been finished by the spiller.
+  void process_spill_completions();
+
+  /// Free the memory of an object that has been written to disk, or report
+  /// that it is lost if the spill failed.
+  void finish_spill(const SpillCompletion& completion);
+
+  /// Whether a request that failed with this error code has to wait for the
+  /// memory of the objects that are being spilled, instead of failing.
+  bool must_wait_for_spills(int error_code) const;
+
+  /// Retry the requests that have been waiting for the memory of the objects
+  /// that were being spilled.
+  void retry_requests_waiting_for_spills();
+
+  /// Create the objects of a create request and prepare the reply.
+  ///
+  /// @param request The create request.
+  /// @param send_reply Set to a function that sends the reply. It must be
+  ///        called on the thread of the client, without holding the lock.
+  /// @return False if the request has to wait for spills, see
+  ///         must_wait_for_spills. Nothing is created in that case.
+  bool process_create_request(const CreateRequest& request,
+                              std::function<Status()>* send_reply);
+
+  /// Handle the messages of a client on the thread of the client.
+  void watch_client(Client* client);
+
+  /// Copy sealed objects to another store. The objects are kept from being
+  /// evicted until they have been copied, and the client is answered once all
+  /// of them have been copied.
+  ///
+  /// @param client The client making this request.
+  /// @param object_ids Object IDs of the objects to copy.
+  /// @param store_socket_name The socket of the store to copy the objects to.
+  /// @return PlasmaError_OK if the copies have been started, or
+  ///         PlasmaError_ObjectNonexistent if one of the objects is not sealed
+  ///         in memory, in which case none of them is copied.
+  int replicate_objects(Client* client, const std::vector<ObjectID>& object_ids,
+                        const std::string& store_socket_name);
+
+  /// Handle the copies that have been finished by the replicator.
+  void process_replication_completions();
+
+  /// Start receiving a copy of an object from another store. The contents of
+  /// the object follow the request on the socket of the client. They are read
+  /// by read_replica when the socket is readable.
+  ///
+  /// @param client The other store, which is connected like a client.
+  /// @param object_id The ID of the object.
+  /// @param data_size The size in bytes of the data of the object.
+  /// @param metadata_size The size in bytes of the metadata of the object.
+  /// @param digest The digest of the object.
+  /// @return False if the object has to wait for spills, see
+  ///         must_wait_for_spills. The socket is not read until it has been
+  ///         created.
+  bool receive_replica(Client* client, const ObjectID& object_id, int64_t data_size,
+                       int64_t metadata_size, unsigned char* digest);
+
+  /// Create the object that a replica is read to.
+  ///
+  /// @param client The other store, which is connected like a client.
+  /// @return False if the object has to wait for spills, see
+  ///         must_wait_for_spills.
+  bool create_replica(Client* client);
+
+  /// Read the contents of an object from another store that have arrived,
+  /// straight into the new object and without holding the lock. The object
+  /// is sealed once all of them have been read.
+  ///
+  /// @param client The other store, which is connected like a client.
+  /// @return The return status.
+  Status read_replica(Client* client);
+
+  /// Take a snapshot of the statistics of the store, which are returned by
+  /// the Info call.
+  ///
+  /// @param stats The statistics.
+  void collect_stats(PlasmaStoreStats* stats);
+
  private:
+  /// Count a request in the latency histogram of its type.
+  ///
+  /// @param type The message type of the request.
+  /// @param start The time at which the request was read.
+  void record_latency(int64_t type, std::chrono::steady_clock::time_point start);
+
+  /// Allocate host memory for an object, evicting other objects if needed.
+  ///
+  /// @param size The number of bytes to allocate.
+  /// @param fd The file descriptor of the memory mapped file of the allocation.
+  /// @param map_size The size of the memory mapped file.
+  /// @param offset The offset of the allocation in the memory mapped file.
+  /// @return The allocated memory, or NULL if not enough space could be freed
+  ///         right away. Objects that are being spilled free their memory
+  ///         only when their spill completes.
+  uint8_t* allocate_memory(int64_t size, int* fd, int64_t* map_size, ptrdiff_t* offset);
+
+  /// Free host memory that was allocated with allocate_memory.
+  ///
+  /// @param pointer The allocated memory.
+  void free_memory(uint8_t* pointer);
+
+  /// Start reading a spilled object back into memory. The object is added to
+  /// the object table, but only becomes sealed once it has been read.
+  ///
+  /// @param object_id The object ID of the spilled object.
+  void restore_object(const ObjectID& object_id);
+
+  void finish_restore(const ObjectID& object_id, const Status& status);
+
+  /// Answer the get requests that wait for the restore of an object.
+  ///
+  /// @param object_id The object ID of the spilled object.
+  /// @param entry The restored object, or null if it could not be restored.
+  void update_restore_get_requests(const ObjectID& object_id, ObjectTableEntry* entry);
+
   void push_notification(ObjectInfoT* object_notification);
 
+  /// Stop sending notifications to a subscriber, release its reader of the
+  /// notification ring and close its socket.
+  ///
+  /// @param it The notification queue of the subscriber.
+  void remove_subscriber(std::unordered_map<int, NotificationQueue>::iterator it);
+
+  /// Wake up a subscriber that waits for notifications.
+  ///
+  /// @param event_fd The eventfd of the subscriber.
+  void signal_event_fd(int event_fd);
+
   void add_client_to_object_clients(ObjectTableEntry* entry, Client* client);
 
+  /// Remove a get request from the requests waiting for objects and answer it
+  /// on the thread of its client.
   void return_from_get(GetRequest* get_req);
 
+  /// Look up the objects of a new get request and wait for the ones that are
+  /// not sealed yet.
+  ///
+  /// @param get_req The get request.
+  /// @param timeout_ms The timeout for the get request in milliseconds.
+  void wait_for_objects(GetRequest* get_req, int64_t timeout_ms);
+
+  /// Send the reply to a get request and delete it. This must be called on
+  /// the thread of the client that made the request. The reply is sent from
+  /// a callback that is posted to that thread, so that the lock is not held
+  /// while the file descriptors are sent.
+  void send_get_reply(GetRequest* get_req);
+
+  /// Queue the reply to an asynchronous get request and send it if the
+  /// socket has room.
+  void send_get_async_reply(GetRequest* get_req);
+
+  /// Send as many of the queued replies to asynchronous get requests of a
+  /// client as its socket takes. If the send buffer is full, this is called
+  /// again when the socket becomes writable. This must be called on the thread
+  /// of the client.
+  void send_get_async_replies(Client* client);
+
+  /// Stop sending replies to asynchronous get requests through the socket of
+  /// a client, and close it.
+  void close_async_get_fd(Client* client);
+
+  /// Send the reply to a replicate request and delete it. This must be called
+  /// on the thread of the client that made the request.
+  void send_replicate_reply(ReplicateRequest* request);
+
   void update_object_get_requests(const ObjectID& object_id);
 
   int remove_client_from_object_clients(ObjectTableEntry* entry, Client* client);
 
   /// Event loop of the plasma store.
   EventLoop* loop_;
+  /// The event loops that serve clients if the store uses several threads.
+  std::vector<std::unique_ptr<EventLoop>> worker_loops_;
+  std::vector<std::thread> worker_threads_;
+  /// The worker loop that the next client is assigned to.
+  size_t next_worker_loop_;
+  /// Protects all of the state below, including the memory allocator, since
+  /// clients may be served by several threads. Messages are read and most
+  /// replies are sent without holding it.
+  std::mutex mutex_;
   /// The plasma store information, including the object tables, that is exposed
   /// to the eviction policy.
   PlasmaStoreInfo store_info_;
   /// The state that is managed by the eviction policy.
   EvictionPolicy eviction_policy_;
-  /// Input buffer. This is allocated only once to avoid mallocs for every
-  /// call to process_message.
-  std::vector<uint8_t> input_buffer_;
+  bool use_extent_allocator_;
+  /// The allocator of the objects if use_extent_allocator_ is set. It is
+  /// created with the first object.
+  std::unique_ptr<ExtentAllocator> extent_allocator_;
+  /// The address of the memory that extent_allocator_ manages.
+  uint8_t* extent_base_;
   /// A hash table mapping object IDs to a vector of the get requests that are
   /// waiting for the object to arrive.
   std::unordered_map<ObjectID, std::vector<GetRequest*>, UniqueIDHasher>
@@ -192,8 +492,48 @@ class PlasmaStore {
   /// TODO(pcm): Consider putting this into the Client data structure and
   /// reorganize the code slightly.
   std::unordered_map<int, NotificationQueue> pending_notifications_;
+  /// The ring through which notifications are sent to subscribers in shared
+  /// memory. It is created when the first subscriber asks for it.
+  std::unique_ptr<NotificationRing> notification_ring_;
 
   std::unordered_map<int, std::unique_ptr<Client>> connected_clients_;
+  /// Writes evicted objects to the spill directory, or null if the store
+  /// has none.
+  std::unique_ptr<ObjectSpiller> spiller_;
+  /// The objects that have been spilled, with the information needed to
+  /// restore them.
+  std::unordered_map<ObjectID, ObjectInfoT, UniqueIDHasher> spilled_objects_;
+  /// The objects that are being restored. They are in the object table, but
+  /// not sealed yet.
+  std::unordered_set<ObjectID, UniqueIDHasher> restoring_objects_;
+  /// The number of spills that have not completed. The memory of the spilled
+  /// objects is freed when their spill completes.
+  int64_t num_pending_spills_;
+  /// The create requests that wait for the memory of the objects that are
+  /// being spilled. They are answered once it is freed.
+  std::deque<CreateRequest*> pending_creates_;
+  /// The spilled objects whose restore waits for the memory of the objects
+  /// that are being spilled.
+  std::unordered_set<ObjectID, UniqueIDHasher> pending_restores_;
+  /// The clients whose replica waits for the memory of the objects that are
+  /// being spilled. Their sockets are not read until it is freed.
+  std::vector<Client*> pending_replicas_;
+  /// Copies objects to other stores. It is created for the first replicate
+  /// request.
+  std::unique_ptr<ObjectReplicator> replicator_;
+  /// The replicate requests that wait for copies, by their ID.
+  std::unordered_map<int64_t, ReplicateRequest*> replicate_requests_;
+  int64_t next_replicate_request_id_;
+  /// Stands in for the replicator in the clients of the objects that are being
+  /// copied, which keeps them from being evicted.
+  std::unique_ptr<Client> replication_client_;
+  /// The number of pending copies of each object that is being copied.
+  std::unordered_map<ObjectID, int, UniqueIDHasher> replicating_objects_;
+  /// Statistics reported to clients through the Info call.
+  PlasmaStoreStats stats_;
+  /// The latency histograms of the requests, kNumLatencyBuckets counts for
+  /// each message type. They are updated without holding the mutex.
+  std::vector<std::atomic<int64_t>> latency_counts_;
 #ifdef PLASMA_GPU
   arrow::gpu::CudaDeviceManager* manager_;
 #endif
@@ -0,0 +1,480 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arrow/io/interfaces.h"
+#include "arrow/test-util.h"
+#include "plasma/client.h"
+#include "plasma/common.h"
+#include "plasma/io.h"
+
+namespace plasma {
+
+constexpr char kStoreSocket[] = "/tmp/plasma_benchmark_store";
+
+// Runs a plasma store next to the benchmark executable for the lifetime of the
+// process.
+class StoreProcess {
+ public:
+  StoreProcess(const std::string& socket, int num_threads,
+               int64_t memory = 1000000000, const std::string& allocator = "dlmalloc") {
+    char executable[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+    ARROW_CHECK(length > 0);
+    std::string path(executable, length);
+    std::string store = path.substr(0, path.find_last_of("/")) + "/plasma_store";
+    std::string threads = std::to_string(num_threads);
+    std::string memory_arg = std::to_string(memory);
+    pid_ = fork();
+    if (pid_ == 0) {
+      execl(store.c_str(), store.c_str(), "-m", memory_arg.c_str(), "-s", socket.c_str(),
+            "-t", threads.c_str(), "-a", allocator.c_str(), static_cast<char*>(NULL));
+      _exit(1);
+    }
+    ARROW_CHECK(pid_ > 0);
+    // Wait until the store accepts connections.
+    PlasmaClient client;
+    ABORT_NOT_OK(client.Connect(socket, "", 0));
+    ABORT_NOT_OK(client.Disconnect());
+  }
+
+  ~StoreProcess() {
+    kill(pid_, SIGTERM);
+    waitpid(pid_, NULL, 0);
+  }
+
+ private:
+  pid_t pid_;
+};
+
+static std::unique_ptr<PlasmaClient> ConnectClient(const std::string& socket) {
+  std::unique_ptr<PlasmaClient> client(new PlasmaClient());
+  // Release objects right away, so that the release requests are measured.
+  ABORT_NOT_OK(client->Connect(socket, "", 0));
+  return client;
+}
+
+static std::unique_ptr<PlasmaClient> ConnectClient() {
+  static StoreProcess store(kStoreSocket, 1);
+  return ConnectClient(kStoreSocket);
+}
+
+static double MicrosecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                   start)
+      .count();
+}
+
+// Describe the median and the 99th percentile of the latencies of single
+// operations, which are shown as the label of the benchmark.
+static std::string LatencyPercentiles(std::vector<double>* latencies) {
+  if (latencies->empty()) {
+    return "";
+  }
+  auto percentile = [latencies](double fraction) {
+    auto nth =
+        latencies->begin() + static_cast<int64_t>(fraction * (latencies->size() - 1));
+    std::nth_element(latencies->begin(), nth, latencies->end());
+    return *nth;
+  };
+  char label[64];
+  snprintf(label, sizeof(label), "p50 %.1f us, p99 %.1f us", percentile(0.5),
+           percentile(0.99));
+  return label;
+}
+
+static void DeleteObjects(PlasmaClient* client, const std::vector<ObjectID>& object_ids) {
+  for (const auto& object_id : object_ids) {
+    ABORT_NOT_OK(client->Delete(object_id));
+  }
+}
+
+static void BM_CreateSealRelease(benchmark::State& state) {  // NOLINT non-const ref
+  const int64_t num_objects = state.range(0);
+  const int64_t object_size = state.range(1);
+  auto client = ConnectClient();
+  std::vector<ObjectID> object_ids(num_objects);
+  std::shared_ptr<Buffer> data;
+  while (state.KeepRunning()) {
+    for (auto& object_id : object_ids) {
+      object_id = ObjectID::from_random();
+      ABORT_NOT_OK(client->Create(object_id, object_size, NULL, 0, &data));
+      data->mutable_data()[0] = 1;
+      ABORT_NOT_OK(client->Seal(object_id));
+      ABORT_NOT_OK(client->Release(object_id));
+    }
+    state.PauseTiming();
+    DeleteObjects(client.get(), object_ids);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_objects);
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+// Create, fill, seal and release an object, then get and release it again,
+// which asks the store since the client does not use the object anymore.
+static void BM_CreateSealGetRelease(benchmark::State& state) {  // NOLINT non-const ref
+  const int64_t object_size = state.range(0);
+  // Objects of up to 1 GiB do not fit into the default store.
+  static StoreProcess store(std::string(kStoreSocket) + "_large", 1, 2000000000);
+  auto client = ConnectClient(std::string(kStoreSocket) + "_large");
+  std::shared_ptr<Buffer> data;
+  ObjectBuffer object_buffer;
+  std::vector<double> latencies;
+  while (state.KeepRunning()) {
+    ObjectID object_id = ObjectID::from_random();
+    auto start = std::chrono::steady_clock::now();
+    ABORT_NOT_OK(client->Create(object_id, object_size, NULL, 0, &data));
+    memset(data->mutable_data(), 1, object_size);
+    ABORT_NOT_OK(client->Seal(object_id));
+    ABORT_NOT_OK(client->Release(object_id));
+    ABORT_NOT_OK(client->Get(&object_id, 1, 0, &object_buffer));
+    ABORT_NOT_OK(client->Release(object_id));
+    latencies.push_back(MicrosecondsSince(start));
+    state.PauseTiming();
+    DeleteObjects(client.get(), {object_id});
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * object_size);
+  state.SetLabel(LatencyPercentiles(&latencies));
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+// Look up objects that are in the store, and ones that are not.
+static void BM_Contains(benchmark::State& state) {  // NOLINT non-const reference
+  const int64_t num_objects = state.range(0);
+  auto client = ConnectClient();
+  std::vector<ObjectID> object_ids(num_objects);
+  std::shared_ptr<Buffer> data;
+  for (auto& object_id : object_ids) {
+    object_id = ObjectID::from_random();
+    ABORT_NOT_OK(client->Create(object_id, 64, NULL, 0, &data));
+    ABORT_NOT_OK(client->Seal(object_id));
+    ABORT_NOT_OK(client->Release(object_id));
+  }
+  std::vector<double> latencies;
+  bool has_object;
+  int64_t i = 0;
+  while (state.KeepRunning()) {
+    ObjectID object_id =
+        i % 2 == 0 ? object_ids[i / 2 % num_objects] : ObjectID::from_random();
+    auto start = std::chrono::steady_clock::now();
+    ABORT_NOT_OK(client->Contains(object_id, &has_object));
+    latencies.push_back(MicrosecondsSince(start));
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(LatencyPercentiles(&latencies));
+  DeleteObjects(client.get(), object_ids);
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+// Seal objects and wait for the notification of a subscriber.
+static void BM_SubscribeNotification(benchmark::State& state) {  // NOLINT non-const ref
+  const int64_t num_subscribers = state.range(0);
+  auto client = ConnectClient();
+  std::vector<std::unique_ptr<PlasmaClient>> subscribers;
+  std::vector<int> fds(num_subscribers);
+  for (int64_t i = 0; i < num_subscribers; ++i) {
+    subscribers.push_back(ConnectClient(kStoreSocket));
+    ABORT_NOT_OK(subscribers.back()->Subscribe(&fds[i]));
+  }
+  std::shared_ptr<Buffer> data;
+  std::vector<double> latencies;
+  ObjectID notified_id;
+  int64_t data_size;
+  int64_t metadata_size;
+  while (state.KeepRunning()) {
+    ObjectID object_id = ObjectID::from_random();
+    ABORT_NOT_OK(client->Create(object_id, 64, NULL, 0, &data));
+    auto start = std::chrono::steady_clock::now();
+    ABORT_NOT_OK(client->Seal(object_id));
+    for (int64_t i = 0; i < num_subscribers; ++i) {
+      ABORT_NOT_OK(subscribers[i]->GetNotification(fds[i], &notified_id, &data_size,
+                                                   &metadata_size));
+    }
+    latencies.push_back(MicrosecondsSince(start));
+    state.PauseTiming();
+    ABORT_NOT_OK(client->Release(object_id));
+    DeleteObjects(client.get(), {object_id});
+    // Skip the notifications of the deletion.
+    for (int64_t i = 0; i < num_subscribers; ++i) {
+      ABORT_NOT_OK(subscribers[i]->GetNotification(fds[i], &notified_id, &data_size,
+                                                   &metadata_size));
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_subscribers);
+  state.SetLabel(LatencyPercentiles(&latencies));
+  for (auto& subscriber : subscribers) {
+    ABORT_NOT_OK(subscriber->Disconnect());
+  }
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+// Create objects of mixed sizes in a store that is much smaller than all of
+// them together, so that most creations evict other objects.
+static void BM_CreateEvict(benchmark::State& state) {  // NOLINT non-const reference
+  const int64_t max_object_size = state.range(0);
+  const std::string allocator = state.range(1) == 0 ? "dlmalloc" : "extent";
+  static std::map<std::string, std::unique_ptr<StoreProcess>> stores;
+  const std::string socket = std::string(kStoreSocket) + "_evict_" + allocator;
+  if (stores.count(allocator) == 0) {
+    stores[allocator].reset(new StoreProcess(socket, 1, 100000000, allocator));
+  }
+  auto client = ConnectClient(socket);
+  // The same sizes for each allocator, with many more small objects than
+  // large ones.
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> exponent(0, std::log2(max_object_size / 100));
+  std::shared_ptr<Buffer> data;
+  std::vector<double> latencies;
+  int64_t bytes_created = 0;
+  while (state.KeepRunning()) {
+    ObjectID object_id = ObjectID::from_random();
+    int64_t object_size = static_cast<int64_t>(100 * std::exp2(exponent(generator)));
+    auto start = std::chrono::steady_clock::now();
+    Status s = client->Create(object_id, object_size, NULL, 0, &data);
+    if (s.ok()) {
+      ABORT_NOT_OK(client->Seal(object_id));
+      ABORT_NOT_OK(client->Release(object_id));
+      bytes_created += object_size;
+    } else {
+      ARROW_CHECK(s.IsPlasmaStoreFull());
+    }
+    latencies.push_back(MicrosecondsSince(start));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(bytes_created);
+  state.SetLabel(LatencyPercentiles(&latencies));
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+static void BM_CreateSealReleaseBatch(
+    benchmark::State& state) {  // NOLINT non-const reference
+  const int64_t num_objects = state.range(0);
+  const int64_t object_size = state.range(1);
+  auto client = ConnectClient();
+  std::vector<ObjectID> object_ids(num_objects);
+  std::vector<int64_t> data_sizes(num_objects, object_size);
+  std::vector<int64_t> metadata_sizes(num_objects, 0);
+  std::vector<std::shared_ptr<Buffer>> data(num_objects);
+  while (state.KeepRunning()) {
+    for (auto& object_id : object_ids) {
+      object_id = ObjectID::from_random();
+    }
+    ABORT_NOT_OK(client->Create(object_ids.data(), num_objects, data_sizes.data(), NULL,
+                                metadata_sizes.data(), data.data()));
+    for (auto& buffer : data) {
+      buffer->mutable_data()[0] = 1;
+    }
+    ABORT_NOT_OK(client->Seal(object_ids.data(), num_objects));
+    ABORT_NOT_OK(client->Release(object_ids.data(), num_objects));
+    state.PauseTiming();
+    DeleteObjects(client.get(), object_ids);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_objects);
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+// Create, fill and seal an object. It is filled through OpenObjectWriter,
+// which hashes the data as it is written with DigestMode::INCREMENTAL.
+static void BM_SealDigest(benchmark::State& state) {  // NOLINT non-const reference
+  const DigestMode mode = static_cast<DigestMode>(state.range(0));
+  const int64_t object_size = state.range(1);
+  auto client = ConnectClient();
+  client->SetDigestMode(mode);
+  std::vector<uint8_t> values(object_size, 1);
+  std::shared_ptr<Buffer> data;
+  uint8_t digest[kDigestSize];
+  while (state.KeepRunning()) {
+    ObjectID object_id = ObjectID::from_random();
+    ABORT_NOT_OK(client->Create(object_id, object_size, NULL, 0, &data));
+    std::shared_ptr<arrow::io::OutputStream> writer;
+    ABORT_NOT_OK(client->OpenObjectWriter(object_id, &writer));
+    ABORT_NOT_OK(writer->Write(values.data(), object_size));
+    ABORT_NOT_OK(client->Seal(object_id));
+    if (mode == DigestMode::LAZY) {
+      // Include the deferred hashing.
+      ABORT_NOT_OK(client->Hash(object_id, digest));
+    }
+    state.PauseTiming();
+    DeleteObjects(client.get(), {object_id});
+    state.ResumeTiming();
+  }
+  state.SetBytesProcessed(state.iterations() * object_size);
+  ABORT_NOT_OK(client->Disconnect());
+}
+
+constexpr int64_t kOperationsPerClient = 1000;
+
+// Create, seal, get and delete small objects, like a client of the store
+// that runs in its own process. The latency of each of these sequences is
+// written to the given file descriptor.
+static void RunClientProcess(const std::string& socket, int latency_fd) {
+  PlasmaClient client;
+  ABORT_NOT_OK(client.Connect(socket, "", 0));
+  std::shared_ptr<Buffer> data;
+  ObjectBuffer object_buffer;
+  std::vector<double> latencies;
+  for (int64_t i = 0; i < kOperationsPerClient; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    ObjectID object_id = ObjectID::from_random();
+    ABORT_NOT_OK(client.Create(object_id, 64, NULL, 0, &data));
+    data->mutable_data()[0] = 1;
+    ABORT_NOT_OK(client.Seal(object_id));
+    ABORT_NOT_OK(client.Release(object_id));
+    // The object is not in use by the client anymore, so this asks the store.
+    ABORT_NOT_OK(client.Get(&object_id, 1, 0, &object_buffer));
+    ABORT_NOT_OK(client.Release(object_id));
+    ABORT_NOT_OK(client.Delete(object_id));
+    latencies.push_back(MicrosecondsSince(start));
+  }
+  ABORT_NOT_OK(client.Disconnect());
+  ABORT_NOT_OK(WriteBytes(latency_fd, reinterpret_cast<uint8_t*>(latencies.data()),
+                          latencies.size() * sizeof(double)));
+}
+
+static void BM_ConcurrentClients(benchmark::State& state) {  // NOLINT non-const ref
+  const int num_threads = static_cast<int>(state.range(0));
+  const int64_t num_clients = state.range(1);
+  // Start one store for each number of threads.
+  static std::map<int, std::unique_ptr<StoreProcess>> stores;
+  const std::string socket =
+      std::string(kStoreSocket) + "_" + std::to_string(num_threads);
+  if (stores.count(num_threads) == 0) {
+    stores[num_threads].reset(new StoreProcess(socket, num_threads));
+  }
+  std::vector<double> latencies;
+  while (state.KeepRunning()) {
+    std::vector<pid_t> pids;
+    std::vector<int> latency_fds;
+    for (int64_t i = 0; i < num_clients; ++i) {
+      int fds[2];
+      ARROW_CHECK(pipe(fds) == 0);
+      pid_t pid = fork();
+      if (pid == 0) {
+        close(fds[0]);
+        RunClientProcess(socket, fds[1]);
+        _exit(0);
+      }
+      ARROW_CHECK(pid > 0);
+      close(fds[1]);
+      pids.push_back(pid);
+      latency_fds.push_back(fds[0]);
+    }
+    for (size_t i = 0; i < pids.size(); ++i) {
+      std::vector<double> client_latencies(kOperationsPerClient);
+      ABORT_NOT_OK(ReadBytes(latency_fds[i],
+                             reinterpret_cast<uint8_t*>(client_latencies.data()),
+                             client_latencies.size() * sizeof(double)));
+      close(latency_fds[i]);
+      latencies.insert(latencies.end(), client_latencies.begin(), client_latencies.end());
+      int status;
+      ARROW_CHECK(waitpid(pids[i], &status, 0) == pids[i]);
+      ARROW_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_clients * kOperationsPerClient);
+  state.SetLabel(LatencyPercentiles(&latencies));
+}
+
+// The arguments are the number of objects and their size in bytes.
+#define ADD_SMALL_OBJECT_ARGS(WHAT) \
+  WHAT->Args({1000, 64})            \
+      ->Args({1000, 4096})          \
+      ->Args({10000, 64})           \
+      ->Unit(benchmark::kMillisecond)
+
+ADD_SMALL_OBJECT_ARGS(BENCHMARK(BM_CreateSealRelease));
+ADD_SMALL_OBJECT_ARGS(BENCHMARK(BM_CreateSealReleaseBatch));
+
+// The argument is the object size in bytes, from 100 bytes to 1 GiB.
+BENCHMARK(BM_CreateSealGetRelease)
+    ->Arg(100)
+    ->Arg(10000)
+    ->Arg(1000000)
+    ->Arg(100000000)
+    ->Arg(1 << 30)
+    ->Unit(benchmark::kMicrosecond);
+
+// The argument is the number of objects in the store.
+BENCHMARK(BM_Contains)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// The argument is the number of subscribers.
+BENCHMARK(BM_SubscribeNotification)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+
+// The arguments are the largest object size in bytes and the allocator of the
+// store, 0 for dlmalloc and 1 for the extent allocator.
+BENCHMARK(BM_CreateEvict)
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 1})
+    ->Args({16 << 20, 0})
+    ->Args({16 << 20, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+// The arguments are the digest mode and the object size in bytes.
+static void SealDigestArgs(benchmark::internal::Benchmark* benchmark) {
+  for (DigestMode mode : {DigestMode::EAGER, DigestMode::NONE, DigestMode::LAZY,
+                          DigestMode::INCREMENTAL}) {
+    for (int64_t object_size : {1 << 20, 64 << 20, 256 << 20}) {
+      benchmark->Args({static_cast<int>(mode), object_size});
+    }
+  }
+}
+
+BENCHMARK(BM_SealDigest)->Apply(SealDigestArgs)->Unit(benchmark::kMillisecond);
+
+// The arguments are the number of threads of the store and the number of
+// client processes.
+static void ConcurrentClientArgs(benchmark::internal::Benchmark* benchmark) {
+  for (int num_threads : {1, 4, 16}) {
+    for (int num_clients = 1; num_clients <= 64; num_clients *= 4) {
+      benchmark->Args({num_threads, num_clients});
+    }
+  }
+}
+
+BENCHMARK(BM_ConcurrentClients)
+    ->Apply(ConcurrentClientArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace plasma
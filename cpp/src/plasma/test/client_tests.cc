@@ -16,12 +16,24 @@
 // under the License.
 
 #include <assert.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/io/interfaces.h"
+#include "arrow/record_batch.h"
+#include "arrow/table.h"
+#include "arrow/tensor.h"
+#include "arrow/test-util.h"
 #include "plasma/client.h"
 #include "plasma/common.h"
 #include "plasma/plasma.h"
@@ -33,24 +45,45 @@ namespace plasma {
 
 std::string test_executable;  // NOLINT
 
-class TestPlasmaStore : public ::testing::Test {
+// Base of the fixtures that run plasma stores with different flags.
+class PlasmaStoreFixture : public ::testing::Test {
  public:
+  virtual void Finish() {
+    for (PlasmaClient* client : clients_) {
+      ARROW_CHECK_OK(client->Disconnect());
+    }
+    system("killall plasma_store &");
+  }
+
+ protected:
+  // Start a store that listens on the given socket. The other command line
+  // flags of the store are passed in flags.
   // TODO(pcm): At the moment, stdout of the test gets mixed up with
   // stdout of the object store. Consider changing that.
-  void SetUp() {
+  void StartStore(const std::string& socket_name, const std::string& flags) {
     std::string plasma_directory =
         test_executable.substr(0, test_executable.find_last_of("/"));
-    std::string plasma_command =
-        plasma_directory +
-        "/plasma_store -m 1000000000 -s /tmp/store 1> /dev/null 2> /dev/null &";
+    std::string plasma_command = plasma_directory + "/plasma_store -s " + socket_name +
+                                 " " + flags + " 1> /dev/null 2> /dev/null &";
     system(plasma_command.c_str());
-    ARROW_CHECK_OK(client_.Connect("/tmp/store", "", PLASMA_DEFAULT_RELEASE_DELAY));
-    ARROW_CHECK_OK(client2_.Connect("/tmp/store", "", PLASMA_DEFAULT_RELEASE_DELAY));
   }
-  virtual void Finish() {
-    ARROW_CHECK_OK(client_.Disconnect());
-    ARROW_CHECK_OK(client2_.Disconnect());
-    system("killall plasma_store &");
+
+  // Connect a client to a store. It is disconnected by Finish.
+  void Connect(PlasmaClient* client, const std::string& socket_name, int release_delay) {
+    ARROW_CHECK_OK(client->Connect(socket_name, "", release_delay));
+    clients_.push_back(client);
+  }
+
+ private:
+  std::vector<PlasmaClient*> clients_;
+};
+
+class TestPlasmaStore : public PlasmaStoreFixture {
+ public:
+  void SetUp() {
+    StartStore("/tmp/store", "-m 1000000000");
+    Connect(&client_, "/tmp/store", PLASMA_DEFAULT_RELEASE_DELAY);
+    Connect(&client2_, "/tmp/store", PLASMA_DEFAULT_RELEASE_DELAY);
   }
 
  protected:
@@ -83,6 +116,170 @@ TEST_F(TestPlasmaStore, DeleteTest) {
   ARROW_CHECK_OK(client_.Delete(object_id));
 }
 
+TEST_F(TestPlasmaStore, StatsTest) {
+  ObjectID sealed_id = ObjectID::from_random();
+  ObjectID created_id = ObjectID::from_random();
+  std::shared_ptr<Buffer> data;
+  ARROW_CHECK_OK(client_.Create(sealed_id, 100, NULL, 0, &data));
+  ARROW_CHECK_OK(client_.Seal(sealed_id));
+  ARROW_CHECK_OK(client_.Create(created_id, 200, NULL, 0, &data));
+
+  PlasmaStoreStats stats;
+  ARROW_CHECK_OK(client_.Info(&stats));
+  ASSERT_EQ(stats.num_objects_sealed, 1);
+  ASSERT_EQ(stats.bytes_sealed, 100);
+  ASSERT_EQ(stats.num_objects_created, 1);
+  ASSERT_EQ(stats.bytes_created, 200);
+  ASSERT_EQ(stats.num_objects_in_use, 2);
+  ASSERT_EQ(stats.bytes_in_use, 300);
+  ASSERT_EQ(stats.num_clients, 2);
+  ASSERT_EQ(stats.num_pending_get_requests, 0);
+  ASSERT_GE(stats.allocator_allocated, 300);
+  ASSERT_GE(stats.allocator_footprint,
+            stats.allocator_allocated + stats.allocator_free);
+
+  // The requests that have been handled are in the latency histograms.
+  bool found_create = false;
+  for (const auto& histogram : stats.latencies) {
+    ASSERT_EQ(kNumLatencyBuckets, static_cast<int>(histogram.counts.size()));
+    if (histogram.operation == "PlasmaCreateRequest") {
+      found_create = true;
+      int64_t total = 0;
+      for (int64_t count : histogram.counts) {
+        total += count;
+      }
+      ASSERT_GE(total, 2);
+    }
+  }
+  ASSERT_TRUE(found_create);
+
+  // A get request for an object that is not sealed waits for it.
+  std::thread get_thread([this, created_id]() {
+    ObjectBuffer object_buffer;
+    ARROW_CHECK_OK(client2_.Get(&created_id, 1, -1, &object_buffer));
+    ARROW_CHECK_OK(client2_.Release(created_id));
+  });
+  do {
+    ARROW_CHECK_OK(client_.Info(&stats));
+  } while (stats.num_pending_get_requests == 0);
+  ARROW_CHECK_OK(client_.Seal(created_id));
+  get_thread.join();
+  ARROW_CHECK_OK(client_.Info(&stats));
+  ASSERT_EQ(stats.num_pending_get_requests, 0);
+}
+
+TEST_F(TestPlasmaStore, GetAsyncTest) {
+  ObjectID sealed_id = ObjectID::from_random();
+  ObjectID later_id = ObjectID::from_random();
+  ObjectID missing_id = ObjectID::from_random();
+  std::shared_ptr<Buffer> data;
+  ARROW_CHECK_OK(client2_.Create(sealed_id, 1, NULL, 0, &data));
+  data->mutable_data()[0] = 1;
+  ARROW_CHECK_OK(client2_.Seal(sealed_id));
+
+  std::vector<ObjectID> returned_ids;
+  std::vector<ObjectBuffer> returned_buffers;
+  auto callback = [&](const ObjectID& object_id, const ObjectBuffer& object_buffer) {
+    returned_ids.push_back(object_id);
+    returned_buffers.push_back(object_buffer);
+  };
+  ObjectID object_ids[] = {sealed_id, later_id};
+  ARROW_CHECK_OK(client_.GetAsync(object_ids, 2, -1, callback));
+  ARROW_CHECK_OK(client_.GetAsync(&missing_id, 1, 50, callback));
+  int fd;
+  ARROW_CHECK_OK(client_.GetAsyncFd(&fd));
+  auto wait_for_replies = [&](size_t num_replies) {
+    while (returned_ids.size() < num_replies) {
+      struct pollfd poll_fd = {fd, POLLIN, 0};
+      ASSERT_EQ(1, poll(&poll_fd, 1, 10000));
+      ARROW_CHECK_OK(client_.ProcessGetAsyncReplies());
+    }
+  };
+
+  // The sealed object is returned right away, and the missing one once the
+  // request has timed out.
+  wait_for_replies(2);
+  ASSERT_TRUE(returned_ids[0] == sealed_id);
+  ASSERT_EQ(1, returned_buffers[0].data_size);
+  ASSERT_EQ(1, returned_buffers[0].data->data()[0]);
+  ASSERT_TRUE(returned_ids[1] == missing_id);
+  ASSERT_EQ(-1, returned_buffers[1].data_size);
+
+  // The other object is returned once it has been sealed.
+  ARROW_CHECK_OK(client2_.Create(later_id, 1, NULL, 0, &data));
+  data->mutable_data()[0] = 2;
+  ARROW_CHECK_OK(client2_.Seal(later_id));
+  wait_for_replies(3);
+  ASSERT_TRUE(returned_ids[2] == later_id);
+  ASSERT_EQ(2, returned_buffers[2].data->data()[0]);
+  ARROW_CHECK_OK(client_.Release(sealed_id));
+  ARROW_CHECK_OK(client_.Release(later_id));
+}
+
+TEST_F(TestPlasmaStore, GetAsyncUnreadRepliesTest) {
+  // More replies than fit into the send buffer of the socket.
+  std::vector<ObjectID> object_ids(10000);
+  for (auto& object_id : object_ids) {
+    object_id = ObjectID::from_random();
+  }
+  int64_t num_replies = 0;
+  auto callback = [&](const ObjectID& object_id, const ObjectBuffer& object_buffer) {
+    ASSERT_EQ(-1, object_buffer.data_size);
+    num_replies += 1;
+  };
+  ARROW_CHECK_OK(client_.GetAsync(object_ids.data(), object_ids.size(), 0, callback));
+
+  // The store keeps serving requests while the replies are not read.
+  bool has_object;
+  ARROW_CHECK_OK(client2_.Contains(object_ids[0], &has_object));
+  ASSERT_FALSE(has_object);
+
+  int fd;
+  ARROW_CHECK_OK(client_.GetAsyncFd(&fd));
+  while (num_replies < static_cast<int64_t>(object_ids.size())) {
+    struct pollfd poll_fd = {fd, POLLIN, 0};
+    ASSERT_EQ(1, poll(&poll_fd, 1, 10000));
+    ARROW_CHECK_OK(client_.ProcessGetAsyncReplies());
+  }
+}
+
+TEST_F(TestPlasmaStore, GetAsyncMissingThenSealedTest) {
+  ObjectID missing_id = ObjectID::from_random();
+  ObjectID sealed_id = ObjectID::from_random();
+  std::shared_ptr<Buffer> data;
+  ARROW_CHECK_OK(client2_.Create(sealed_id, 1, NULL, 0, &data));
+  data->mutable_data()[0] = 3;
+  ARROW_CHECK_OK(client2_.Seal(sealed_id));
+
+  std::vector<ObjectID> returned_ids;
+  std::vector<ObjectBuffer> returned_buffers;
+  auto callback = [&](const ObjectID& object_id, const ObjectBuffer& object_buffer) {
+    returned_ids.push_back(object_id);
+    returned_buffers.push_back(object_buffer);
+  };
+  int fd;
+  ARROW_CHECK_OK(client_.GetAsyncFd(&fd));
+  auto wait_for_replies = [&](size_t num_replies) {
+    while (returned_ids.size() < num_replies) {
+      struct pollfd poll_fd = {fd, POLLIN, 0};
+      ASSERT_EQ(1, poll(&poll_fd, 1, 10000));
+      ARROW_CHECK_OK(client_.ProcessGetAsyncReplies());
+    }
+  };
+
+  // A reply without a file descriptor does not break the connection for the
+  // replies that follow.
+  ARROW_CHECK_OK(client_.GetAsync(&missing_id, 1, 0, callback));
+  wait_for_replies(1);
+  ASSERT_TRUE(returned_ids[0] == missing_id);
+  ASSERT_EQ(-1, returned_buffers[0].data_size);
+  ARROW_CHECK_OK(client_.GetAsync(&sealed_id, 1, -1, callback));
+  wait_for_replies(2);
+  ASSERT_TRUE(returned_ids[1] == sealed_id);
+  ASSERT_EQ(3, returned_buffers[1].data->data()[0]);
+  ARROW_CHECK_OK(client_.Release(sealed_id));
+}
+
 TEST_F(TestPlasmaStore, ContainsTest) {
   ObjectID object_id = ObjectID::from_random();
 
@@ -159,6 +356,185 @@ TEST_F(TestPlasmaStore, MultipleGetTest) {
   ASSERT_EQ(object_buffer[1].data->data()[0], 2);
 }
 
+TEST_F(TestPlasmaStore, BatchTest) {
+  const int64_t num_objects = 10;
+  std::vector<ObjectID> object_ids;
+  std::vector<int64_t> data_sizes;
+  std::vector<int64_t> metadata_sizes;
+  std::vector<uint8_t> metadata_values;
+  for (int64_t i = 0; i < num_objects; i++) {
+    object_ids.push_back(ObjectID::from_random());
+    data_sizes.push_back(i + 1);
+    metadata_sizes.push_back(1);
+    metadata_values.push_back(static_cast<uint8_t>(i));
+  }
+  std::vector<uint8_t*> metadata;
+  for (auto& value : metadata_values) {
+    metadata.push_back(&value);
+  }
+  std::vector<std::shared_ptr<Buffer>> data(num_objects);
+  ARROW_CHECK_OK(client_.Create(object_ids.data(), num_objects, data_sizes.data(),
+                                metadata.data(), metadata_sizes.data(), data.data()));
+  for (int64_t i = 0; i < num_objects; i++) {
+    ASSERT_EQ(data[i]->size(), i + 1);
+    data[i]->mutable_data()[0] = static_cast<uint8_t>(i);
+  }
+  ARROW_CHECK_OK(client_.Seal(object_ids.data(), num_objects));
+
+  std::vector<ObjectBuffer> object_buffers(num_objects);
+  ARROW_CHECK_OK(client2_.Get(object_ids.data(), num_objects, -1, object_buffers.data()));
+  for (int64_t i = 0; i < num_objects; i++) {
+    ASSERT_EQ(object_buffers[i].data_size, i + 1);
+    ASSERT_EQ(object_buffers[i].data->data()[0], i);
+    ASSERT_EQ(object_buffers[i].metadata->data()[0], i);
+  }
+  ARROW_CHECK_OK(client2_.Release(object_ids.data(), num_objects));
+  ARROW_CHECK_OK(client_.Release(object_ids.data(), num_objects));
+
+  // Creating a batch with an existing object creates none of its objects.
+  ObjectID new_object_id = ObjectID::from_random();
+  ObjectID batch_ids[2] = {new_object_id, object_ids[0]};
+  ASSERT_TRUE(client_
+                  .Create(batch_ids, 2, data_sizes.data(), NULL, metadata_sizes.data(),
+                          data.data())
+                  .IsPlasmaObjectExists());
+  bool has_object;
+  ARROW_CHECK_OK(client_.Contains(new_object_id, &has_object));
+  ASSERT_EQ(has_object, false);
+}
+
+TEST_F(TestPlasmaStore, ArrowObjectTest) {
+  std::shared_ptr<arrow::Array> values;
+  arrow::ArrayFromVector<arrow::Int64Type, int64_t>({1, 2, 3, 4}, &values);
+  auto schema = arrow::schema({arrow::field("values", arrow::int64())});
+  auto batch = arrow::RecordBatch::Make(schema, 4, {values});
+
+  ObjectID batch_id = ObjectID::from_random();
+  ARROW_CHECK_OK(client_.Put(batch_id, *batch));
+  std::shared_ptr<arrow::RecordBatch> batch2;
+  ARROW_CHECK_OK(client2_.Get(batch_id, -1, &batch2));
+  ASSERT_TRUE(batch2->Equals(*batch));
+
+  // The table has two chunks, so it cannot be read as a record batch.
+  std::shared_ptr<arrow::Table> table;
+  ARROW_CHECK_OK(arrow::Table::FromRecordBatches({batch, batch}, &table));
+  ObjectID table_id = ObjectID::from_random();
+  ARROW_CHECK_OK(client_.Put(table_id, *table));
+  std::shared_ptr<arrow::Table> table2;
+  ARROW_CHECK_OK(client2_.Get(table_id, -1, &table2));
+  ASSERT_TRUE(table2->Equals(*table));
+  ASSERT_TRUE(client2_.Get(table_id, -1, &batch2).IsInvalid());
+
+  std::vector<int64_t> shape = {2, 2};
+  arrow::Tensor tensor(arrow::int64(), values->data()->buffers[1], shape);
+  ObjectID tensor_id = ObjectID::from_random();
+  ARROW_CHECK_OK(client_.Put(tensor_id, tensor));
+  std::shared_ptr<arrow::Tensor> tensor2;
+  ARROW_CHECK_OK(client2_.Get(tensor_id, -1, &tensor2));
+  ASSERT_TRUE(tensor2->Equals(tensor));
+
+  // The record batch points into the object, which stays in use until the
+  // record batch is gone.
+  ARROW_CHECK_OK(client2_.Get(batch_id, -1, &batch2));
+  ASSERT_TRUE(client2_.Delete(batch_id).IsUnknownError());
+  batch2.reset();
+  ARROW_CHECK_OK(client2_.Delete(batch_id));
+
+  ObjectID missing_id = ObjectID::from_random();
+  ASSERT_TRUE(client2_.Get(missing_id, 0, &batch2).IsPlasmaObjectNonexistent());
+}
+
+TEST_F(TestPlasmaStore, DigestModeTest) {
+  // Large enough to be hashed in chunks.
+  std::vector<uint8_t> values(3 * (1 << 20) / 2 + 7);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<uint8_t>(i % 251);
+  }
+  uint8_t metadata[] = {5};
+  client_.SetDigestMode(DigestMode::INCREMENTAL);
+  ObjectID object_id = ObjectID::from_random();
+  std::shared_ptr<Buffer> data;
+  ARROW_CHECK_OK(client_.Create(object_id, values.size(), metadata, 1, &data));
+  std::shared_ptr<arrow::io::OutputStream> writer;
+  ARROW_CHECK_OK(client_.OpenObjectWriter(object_id, &writer));
+  for (size_t i = 0; i < values.size(); i += 1000) {
+    size_t size = std::min<size_t>(1000, values.size() - i);
+    ARROW_CHECK_OK(writer->Write(values.data() + i, size));
+  }
+  ARROW_CHECK_OK(client_.Seal(object_id));
+
+  // The digest from writing the object is the same as the one from hashing
+  // the whole object.
+  uint8_t digest[kDigestSize];
+  uint8_t digest2[kDigestSize];
+  ARROW_CHECK_OK(client_.Hash(object_id, digest));
+  ARROW_CHECK_OK(client2_.Hash(object_id, digest2));
+  ASSERT_EQ(0, memcmp(digest, digest2, kDigestSize));
+
+  // The object is only hashed when Hash is called.
+  client_.SetDigestMode(DigestMode::LAZY);
+  ObjectID object_id2 = ObjectID::from_random();
+  ARROW_CHECK_OK(client_.Create(object_id2, values.size(), metadata, 1, &data));
+  memcpy(data->mutable_data(), values.data(), values.size());
+  ARROW_CHECK_OK(client_.Seal(object_id2));
+  ARROW_CHECK_OK(client_.Hash(object_id2, digest2));
+  ASSERT_EQ(0, memcmp(digest, digest2, kDigestSize));
+
+  // A digest stays cached after the object is released, until a notification
+  // says that the object has been deleted.
+  PlasmaClient client3;
+  ARROW_CHECK_OK(client3.Connect("/tmp/store", "", 0));
+  client3.SetDigestMode(DigestMode::LAZY);
+  int fd;
+  ARROW_CHECK_OK(client3.Subscribe(&fd));
+  auto num_get_requests = [&client3]() {
+    PlasmaStoreStats stats;
+    ARROW_CHECK_OK(client3.Info(&stats));
+    int64_t count = 0;
+    for (const auto& histogram : stats.latencies) {
+      if (histogram.operation == "PlasmaGetRequest") {
+        for (int64_t bucket : histogram.counts) {
+          count += bucket;
+        }
+      }
+    }
+    return count;
+  };
+  ObjectID object_id3 = ObjectID::from_random();
+  ARROW_CHECK_OK(client2_.Create(object_id3, values.size(), metadata, 1, &data));
+  memcpy(data->mutable_data(), values.data(), values.size());
+  ARROW_CHECK_OK(client2_.Seal(object_id3));
+  ARROW_CHECK_OK(client2_.Release(object_id3));
+  ARROW_CHECK_OK(client3.Hash(object_id3, digest2));
+  ASSERT_EQ(0, memcmp(digest, digest2, kDigestSize));
+  // The second call does not get the object from the store.
+  int64_t num_gets = num_get_requests();
+  ARROW_CHECK_OK(client3.Hash(object_id3, digest2));
+  ASSERT_EQ(0, memcmp(digest, digest2, kDigestSize));
+  ASSERT_EQ(num_gets, num_get_requests());
+
+  ARROW_CHECK_OK(client2_.Delete(object_id3));
+  ARROW_CHECK_OK(client2_.Create(object_id3, values.size(), metadata, 1, &data));
+  memcpy(data->mutable_data(), values.data(), values.size());
+  data->mutable_data()[0] ^= 1;
+  ARROW_CHECK_OK(client2_.Seal(object_id3));
+  ARROW_CHECK_OK(client2_.Release(object_id3));
+  // The object was sealed, deleted and sealed again.
+  ObjectID notified_id;
+  int64_t data_size;
+  int64_t metadata_size;
+  for (int64_t expected_size : {static_cast<int64_t>(values.size()), int64_t(-1),
+                                static_cast<int64_t>(values.size())}) {
+    ARROW_CHECK_OK(
+        client3.GetNotification(fd, &notified_id, &data_size, &metadata_size));
+    ASSERT_TRUE(notified_id == object_id3);
+    ASSERT_EQ(expected_size, data_size);
+  }
+  ARROW_CHECK_OK(client3.Hash(object_id3, digest2));
+  ASSERT_NE(0, memcmp(digest, digest2, kDigestSize));
+  ARROW_CHECK_OK(client3.Disconnect());
+}
+
 TEST_F(TestPlasmaStore, AbortTest) {
   ObjectID object_id = ObjectID::from_random();
   ObjectBuffer object_buffer;
@@ -295,6 +671,290 @@ TEST_F(TestPlasmaStore, ManyObjectTest) {
   }
 }
 
+TEST_F(TestPlasmaStore, SubscribeTest) {
+  int fd;
+  ARROW_CHECK_OK(client2_.Subscribe(&fd));
+  // Seal more objects than the notification ring holds, so that the
+  // subscriber falls behind and gets the rest through its socket.
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < 5000; i++) {
+    ObjectID object_id = ObjectID::from_random();
+    object_ids.push_back(object_id);
+    std::shared_ptr<Buffer> data;
+    ARROW_CHECK_OK(client_.Create(object_id, i % 100 + 1, NULL, 0, &data));
+    ARROW_CHECK_OK(client_.Seal(object_id));
+    ARROW_CHECK_OK(client_.Release(object_id));
+    if (i == 0) {
+      // The file descriptor becomes readable with the first notification.
+      struct pollfd poll_fd = {fd, POLLIN, 0};
+      ASSERT_EQ(1, poll(&poll_fd, 1, 10000));
+    }
+  }
+  for (int i = 0; i < 5000; i++) {
+    ObjectID object_id;
+    int64_t data_size;
+    int64_t metadata_size;
+    ARROW_CHECK_OK(client2_.GetNotification(fd, &object_id, &data_size, &metadata_size));
+    ASSERT_TRUE(object_id == object_ids[i]);
+    ASSERT_EQ(i % 100 + 1, data_size);
+    ASSERT_EQ(0, metadata_size);
+  }
+}
+
+class TestPlasmaStoreSpill : public PlasmaStoreFixture {
+ public:
+  void SetUp() {
+    char spill_directory[] = "/tmp/plasma-spill-XXXXXX";
+    ARROW_CHECK(mkdtemp(spill_directory) != NULL);
+    spill_directory_ = spill_directory;
+    StartStore("/tmp/store_spill", "-m 10000000 -S " + spill_directory_);
+    // Release objects right away so that they can be evicted.
+    Connect(&client_, "/tmp/store_spill", 0);
+  }
+
+ protected:
+  PlasmaClient client_;
+  std::string spill_directory_;
+};
+
+TEST_F(TestPlasmaStoreSpill, RestoreSpilledObject) {
+  // Create more objects than fit into the store, so that the first ones are
+  // spilled.
+  const int64_t data_size = 3000000;
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < 5; i++) {
+    ObjectID object_id = ObjectID::from_random();
+    object_ids.push_back(object_id);
+    std::shared_ptr<Buffer> data;
+    ARROW_CHECK_OK(client_.Create(object_id, data_size, NULL, 0, &data));
+    memset(data->mutable_data(), i, data_size);
+    ARROW_CHECK_OK(client_.Seal(object_id));
+    ARROW_CHECK_OK(client_.Release(object_id));
+  }
+
+  // A spilled object is still in the store.
+  bool has_object;
+  ARROW_CHECK_OK(client_.Contains(object_ids[0], &has_object));
+  ASSERT_EQ(has_object, true);
+
+  // Getting it restores it, even with a timeout of 0.
+  ObjectBuffer object_buffer;
+  ARROW_CHECK_OK(client_.Get(&object_ids[0], 1, 0, &object_buffer));
+  ASSERT_EQ(object_buffer.data_size, data_size);
+  for (int64_t i = 0; i < data_size; i++) {
+    ASSERT_EQ(object_buffer.data->data()[i], 0);
+  }
+  ARROW_CHECK_OK(client_.Release(object_ids[0]));
+
+  PlasmaStoreStats stats;
+  ARROW_CHECK_OK(client_.Info(&stats));
+  ASSERT_GE(stats.num_objects_spilled, 1);
+  ASSERT_GE(stats.bytes_spilled, data_size);
+  ASSERT_EQ(stats.num_objects_restored, 1);
+  ASSERT_EQ(stats.bytes_restored, data_size);
+  // Spilled objects are counted as evicted.
+  ASSERT_GE(stats.num_objects_evicted, stats.num_objects_spilled);
+  ASSERT_GE(stats.bytes_evicted, stats.bytes_spilled);
+}
+
+TEST_F(TestPlasmaStoreSpill, CreateBatchWaitsForSpills) {
+  const int64_t data_size = 3000000;
+  for (int i = 0; i < 3; i++) {
+    ObjectID object_id = ObjectID::from_random();
+    std::shared_ptr<Buffer> data;
+    ARROW_CHECK_OK(client_.Create(object_id, data_size, NULL, 0, &data));
+    ARROW_CHECK_OK(client_.Seal(object_id));
+    ARROW_CHECK_OK(client_.Release(object_id));
+  }
+  // The batch only fits once the objects that are evicted for it have been
+  // written to disk, and the store answers it then.
+  ObjectID object_ids[] = {ObjectID::from_random(), ObjectID::from_random()};
+  int64_t data_sizes[] = {data_size, data_size};
+  uint8_t* metadata[] = {NULL, NULL};
+  int64_t metadata_sizes[] = {0, 0};
+  std::shared_ptr<Buffer> data[2];
+  ARROW_CHECK_OK(
+      client_.Create(object_ids, 2, data_sizes, metadata, metadata_sizes, data));
+  for (const auto& object_id : object_ids) {
+    ARROW_CHECK_OK(client_.Seal(object_id));
+    ARROW_CHECK_OK(client_.Release(object_id));
+  }
+  PlasmaStoreStats stats;
+  ARROW_CHECK_OK(client_.Info(&stats));
+  ASSERT_GE(stats.num_objects_spilled, 2);
+}
+
+class TestPlasmaStoreThreads : public PlasmaStoreFixture {
+ public:
+  void SetUp() {
+    StartStore("/tmp/store_threads", "-m 1000000000 -t 2");
+    // The clients are served by different threads of the store.
+    Connect(&client_, "/tmp/store_threads", 0);
+    Connect(&client2_, "/tmp/store_threads", 0);
+  }
+
+ protected:
+  PlasmaClient client_;
+  PlasmaClient client2_;
+};
+
+TEST_F(TestPlasmaStoreThreads, GetFromOtherThread) {
+  ObjectID object_id = ObjectID::from_random();
+  ObjectBuffer object_buffer;
+
+  // The second client waits for the object, and is answered when the first
+  // client seals it.
+  std::thread waiter([this, &object_id, &object_buffer]() {
+    ARROW_CHECK_OK(client2_.Get(&object_id, 1, 10000, &object_buffer));
+  });
+  int64_t data_size = 100;
+  uint8_t metadata[] = {5};
+  int64_t metadata_size = sizeof(metadata);
+  std::shared_ptr<Buffer> data;
+  ARROW_CHECK_OK(client_.Create(object_id, data_size, metadata, metadata_size, &data));
+  for (int64_t i = 0; i < data_size; i++) {
+    data->mutable_data()[i] = static_cast<uint8_t>(i % 4);
+  }
+  ARROW_CHECK_OK(client_.Seal(object_id));
+  waiter.join();
+
+  ASSERT_EQ(object_buffer.data_size, data_size);
+  for (int64_t i = 0; i < data_size; i++) {
+    ASSERT_EQ(object_buffer.data->data()[i], static_cast<uint8_t>(i % 4));
+  }
+  ARROW_CHECK_OK(client2_.Release(object_id));
+  ARROW_CHECK_OK(client_.Release(object_id));
+
+  bool has_object;
+  ARROW_CHECK_OK(client2_.Contains(object_id, &has_object));
+  ASSERT_EQ(has_object, true);
+}
+
+class TestPlasmaStoreExtentAllocator : public PlasmaStoreFixture {
+ public:
+  void SetUp() {
+    StartStore("/tmp/store_extent", "-m 10000000 -a extent");
+    Connect(&client_, "/tmp/store_extent", 0);
+  }
+
+ protected:
+  PlasmaClient client_;
+};
+
+TEST_F(TestPlasmaStoreExtentAllocator, EvictAdjacentObjects) {
+  // Fill 9 tenths of the store, and keep every other object in use.
+  std::vector<ObjectID> object_ids;
+  std::shared_ptr<Buffer> data;
+  for (int i = 0; i < 9; ++i) {
+    object_ids.push_back(ObjectID::from_random());
+    ARROW_CHECK_OK(client_.Create(object_ids[i], 1000000, NULL, 0, &data));
+    ARROW_CHECK_OK(client_.Seal(object_ids[i]));
+  }
+  for (int i = 0; i < 9; i += 2) {
+    ARROW_CHECK_OK(client_.Release(object_ids[i]));
+  }
+  PlasmaStoreStats stats;
+  ARROW_CHECK_OK(client_.Info(&stats));
+  ASSERT_EQ(stats.allocator_largest_free, 1000000);
+  ASSERT_EQ(stats.allocator_fragmentation, 0);
+
+  // Leave a hole between two objects that are in use.
+  ARROW_CHECK_OK(client_.Delete(object_ids[4]));
+  ARROW_CHECK_OK(client_.Info(&stats));
+  ASSERT_EQ(stats.allocator_free, 2000000);
+  ASSERT_EQ(stats.allocator_free_chunks, 2);
+  ASSERT_DOUBLE_EQ(stats.allocator_fragmentation, 0.5);
+
+  // There is room for the object only if the last object is evicted, while
+  // the older objects that are not in use are kept.
+  ObjectID object_id = ObjectID::from_random();
+  ARROW_CHECK_OK(client_.Create(object_id, 1800000, NULL, 0, &data));
+  bool has_object;
+  for (int i : {0, 2, 6}) {
+    ARROW_CHECK_OK(client_.Contains(object_ids[i], &has_object));
+    ASSERT_TRUE(has_object);
+  }
+  ARROW_CHECK_OK(client_.Contains(object_ids[8], &has_object));
+  ASSERT_FALSE(has_object);
+
+  // The object does not fit even if all other objects that are not in use
+  // are evicted.
+  ASSERT_TRUE(client_.Create(ObjectID::from_random(), 2000000, NULL, 0, &data)
+                  .IsPlasmaStoreFull());
+}
+
+class TestPlasmaStoreReplication : public PlasmaStoreFixture {
+ public:
+  void SetUp() {
+    StartStore("/tmp/store_source", "-m 1000000000");
+    StartStore("/tmp/store_replica", "-m 1000000000");
+    Connect(&source_, "/tmp/store_source", 0);
+    Connect(&replica_, "/tmp/store_replica", 0);
+  }
+
+ protected:
+  PlasmaClient source_;
+  PlasmaClient replica_;
+};
+
+TEST_F(TestPlasmaStoreReplication, ReplicateObjects) {
+  std::vector<ObjectID> object_ids;
+  for (int64_t data_size : {int64_t(100), int64_t(5000000)}) {
+    ObjectID object_id = ObjectID::from_random();
+    object_ids.push_back(object_id);
+    uint8_t metadata[] = {static_cast<uint8_t>(data_size % 256)};
+    std::shared_ptr<Buffer> data;
+    ARROW_CHECK_OK(source_.Create(object_id, data_size, metadata, 1, &data));
+    for (int64_t i = 0; i < data_size; i++) {
+      data->mutable_data()[i] = static_cast<uint8_t>(i % 251);
+    }
+    ARROW_CHECK_OK(source_.Seal(object_id));
+    ARROW_CHECK_OK(source_.Release(object_id));
+  }
+
+  ARROW_CHECK_OK(source_.Replicate(object_ids.data(), 2, "/tmp/store_replica"));
+  // Copying objects that the other store has already succeeds.
+  ARROW_CHECK_OK(source_.Replicate(object_ids.data(), 2, "/tmp/store_replica"));
+
+  ObjectBuffer object_buffers[2];
+  ARROW_CHECK_OK(replica_.Get(object_ids.data(), 2, 0, object_buffers));
+  for (const auto& object_buffer : object_buffers) {
+    ASSERT_EQ(object_buffer.metadata_size, 1);
+    ASSERT_EQ(object_buffer.metadata->data()[0], object_buffer.data_size % 256);
+    for (int64_t i = 0; i < object_buffer.data_size; i++) {
+      ASSERT_EQ(object_buffer.data->data()[i], static_cast<uint8_t>(i % 251));
+    }
+  }
+  // The objects are sealed with the same digests.
+  for (const auto& object_id : object_ids) {
+    uint8_t source_digest[kDigestSize];
+    uint8_t replica_digest[kDigestSize];
+    ARROW_CHECK_OK(source_.Hash(object_id, source_digest));
+    ARROW_CHECK_OK(replica_.Hash(object_id, replica_digest));
+    ASSERT_EQ(0, memcmp(source_digest, replica_digest, kDigestSize));
+  }
+  ARROW_CHECK_OK(replica_.Release(object_ids[0]));
+  ARROW_CHECK_OK(replica_.Release(object_ids[1]));
+}
+
+TEST_F(TestPlasmaStoreReplication, ReplicateErrors) {
+  // Nothing is copied if one of the objects is missing.
+  ObjectID object_ids[] = {ObjectID::from_random(), ObjectID::from_random()};
+  std::shared_ptr<Buffer> data;
+  ARROW_CHECK_OK(source_.Create(object_ids[0], 10, NULL, 0, &data));
+  ARROW_CHECK_OK(source_.Seal(object_ids[0]));
+  Status s = source_.Replicate(object_ids, 2, "/tmp/store_replica");
+  ASSERT_TRUE(s.IsPlasmaObjectNonexistent());
+  bool has_object;
+  ARROW_CHECK_OK(replica_.Contains(object_ids[0], &has_object));
+  ASSERT_FALSE(has_object);
+
+  // The copy fails if there is no store at the socket.
+  s = source_.Replicate(object_ids, 1, "/tmp/store_nonexistent");
+  ASSERT_TRUE(s.IsIOError());
+  ARROW_CHECK_OK(source_.Release(object_ids[0]));
+}
+
 #ifdef PLASMA_GPU
 using arrow::gpu::CudaBuffer;
 using arrow::gpu::CudaBufferReader;
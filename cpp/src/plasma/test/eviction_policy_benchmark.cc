@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "plasma/common.h"
+#include "plasma/eviction_policy.h"
+#include "plasma/eviction_simulator.h"
+
+namespace plasma {
+
+constexpr int64_t kCapacity = 1 << 30;
+
+struct TraceEvent {
+  enum { CREATE, GET } type;
+  int64_t object;
+  int64_t size;
+};
+
+// A trace of gets of small objects with Zipf-distributed popularity,
+// interleaved with large objects that are created and used once.
+static std::vector<TraceEvent> MakeTrace(int64_t num_events, int64_t num_small_objects,
+                                         int64_t small_object_size,
+                                         int64_t large_object_size,
+                                         double large_fraction) {
+  std::mt19937 gen(0);
+  std::vector<double> weights;
+  for (int64_t i = 0; i < num_small_objects; ++i) {
+    weights.push_back(1.0 / static_cast<double>(i + 1));
+  }
+  std::discrete_distribution<int64_t> popularity(weights.begin(), weights.end());
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  std::vector<TraceEvent> trace;
+  for (int64_t i = 0; i < num_small_objects; ++i) {
+    trace.push_back({TraceEvent::CREATE, i, small_object_size});
+  }
+  int64_t next_large_object = num_small_objects;
+  for (int64_t i = 0; i < num_events; ++i) {
+    if (uniform(gen) < large_fraction) {
+      trace.push_back({TraceEvent::CREATE, next_large_object, large_object_size});
+      trace.push_back({TraceEvent::GET, next_large_object, large_object_size});
+      next_large_object += 1;
+    } else {
+      trace.push_back({TraceEvent::GET, popularity(gen), small_object_size});
+    }
+  }
+  return trace;
+}
+
+static void BenchReplay(benchmark::State& state,  // NOLINT non-const reference
+                        const std::vector<TraceEvent>& trace) {
+  const auto type = static_cast<EvictionPolicyType>(state.range(0));
+  std::vector<ObjectID> object_ids;
+  for (const auto& event : trace) {
+    while (static_cast<int64_t>(object_ids.size()) <= event.object) {
+      object_ids.push_back(ObjectID::from_random());
+    }
+  }
+
+  EvictionSimulatorStats stats;
+  while (state.KeepRunning()) {
+    EvictionSimulator simulator(type, kCapacity);
+    for (const auto& event : trace) {
+      const ObjectID& object_id = object_ids[event.object];
+      if (event.type == TraceEvent::CREATE) {
+        simulator.Create(object_id, event.size);
+      } else if (simulator.Get(object_id)) {
+        simulator.Release(object_id);
+      }
+    }
+    stats = simulator.stats();
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+
+  std::stringstream label;
+  label << EvictionPolicyTypeName(type) << " hit ratio " << stats.hit_ratio()
+        << ", byte hit ratio " << stats.byte_hit_ratio();
+  state.SetLabel(label.str());
+}
+
+static void BM_ReplaySmallObjects(benchmark::State& state) {  // NOLINT non-const ref
+  static const auto trace = MakeTrace(1 << 18, 1 << 15, 64 << 10, 0, 0);
+  BenchReplay(state, trace);
+}
+
+static void BM_ReplayLargeOneShotObjects(
+    benchmark::State& state) {  // NOLINT non-const reference
+  static const auto trace = MakeTrace(1 << 18, 1 << 15, 64 << 10, 256 << 20, 0.001);
+  BenchReplay(state, trace);
+}
+
+// The argument is the eviction policy.
+#define ADD_POLICY_ARGS(WHAT)                          \
+  WHAT->Arg(static_cast<int>(EvictionPolicyType::LRU)) \
+      ->Arg(static_cast<int>(EvictionPolicyType::LFU)) \
+      ->Arg(static_cast<int>(EvictionPolicyType::GDS)) \
+      ->Arg(static_cast<int>(EvictionPolicyType::ARC)) \
+      ->Unit(benchmark::kMillisecond)
+
+ADD_POLICY_ARGS(BENCHMARK(BM_ReplaySmallObjects));
+ADD_POLICY_ARGS(BENCHMARK(BM_ReplayLargeOneShotObjects));
+
+}  // namespace plasma
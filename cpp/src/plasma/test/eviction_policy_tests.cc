@@ -0,0 +1,192 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <sstream>
+#include <vector>
+
+#include "plasma/common.h"
+#include "plasma/eviction_policy.h"
+#include "plasma/eviction_simulator.h"
+
+#include "gtest/gtest.h"
+
+namespace plasma {
+
+std::vector<ObjectID> random_object_ids(int num_objects) {
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < num_objects; ++i) {
+    object_ids.push_back(ObjectID::from_random());
+  }
+  return object_ids;
+}
+
+TEST(EvictionPolicy, ParseType) {
+  for (auto type : {EvictionPolicyType::LRU, EvictionPolicyType::LFU,
+                    EvictionPolicyType::GDS, EvictionPolicyType::ARC}) {
+    EvictionPolicyType parsed;
+    ARROW_CHECK_OK(ParseEvictionPolicyType(EvictionPolicyTypeName(type), &parsed));
+    ASSERT_EQ(type, parsed);
+  }
+  EvictionPolicyType parsed;
+  ASSERT_TRUE(ParseEvictionPolicyType("fifo", &parsed).IsInvalid());
+}
+
+TEST(EvictionPolicy, LRUCache) {
+  auto ids = random_object_ids(3);
+  LRUCache cache;
+  cache.add(ids[0], 10);
+  cache.add(ids[1], 10);
+  cache.add(ids[2], 10);
+  // Use the oldest object again.
+  cache.remove(ids[0]);
+  cache.add(ids[0], 10);
+
+  std::vector<ObjectID> evicted;
+  ASSERT_EQ(20, cache.choose_objects_to_evict(15, &evicted));
+  ASSERT_EQ(std::vector<ObjectID>({ids[1], ids[2]}), evicted);
+}
+
+TEST(EvictionPolicy, LFUCache) {
+  auto ids = random_object_ids(3);
+  LFUCache cache;
+  for (const auto& id : ids) {
+    cache.add(id, 10);
+  }
+  // Use the first and last objects again, the first one twice.
+  for (int i = 0; i < 2; ++i) {
+    cache.remove(ids[0]);
+    cache.add(ids[0], 10);
+  }
+  cache.remove(ids[2]);
+  cache.add(ids[2], 10);
+
+  std::vector<ObjectID> evicted;
+  ASSERT_EQ(30, cache.choose_objects_to_evict(30, &evicted));
+  ASSERT_EQ(std::vector<ObjectID>({ids[1], ids[2], ids[0]}), evicted);
+}
+
+TEST(EvictionPolicy, GreedyDualSizeCache) {
+  auto ids = random_object_ids(3);
+  GreedyDualSizeCache cache;
+  cache.add(ids[0], 10);
+  cache.add(ids[1], 1000);
+  cache.add(ids[2], 10);
+
+  // The large object is evicted first even if it is not the oldest.
+  std::vector<ObjectID> evicted;
+  ASSERT_EQ(1000, cache.choose_objects_to_evict(10, &evicted));
+  ASSERT_EQ(std::vector<ObjectID>({ids[1]}), evicted);
+
+  // Objects added after an eviction have a higher priority.
+  cache.remove(ids[0]);
+  cache.add(ids[0], 10);
+  evicted.clear();
+  ASSERT_EQ(10, cache.choose_objects_to_evict(10, &evicted));
+  ASSERT_EQ(std::vector<ObjectID>({ids[2]}), evicted);
+}
+
+TEST(EvictionPolicy, ARCCacheScanResistance) {
+  auto hot = random_object_ids(2);
+  auto scan = random_object_ids(4);
+  ARCCache cache(100);
+  // Objects are added when they are created and when their creator releases
+  // them; the hot objects are used again after that.
+  for (const auto& id : hot) {
+    cache.add(id, 10);
+    cache.remove(id);
+    cache.add(id, 10);
+    cache.remove(id);
+    cache.add(id, 10);
+  }
+  for (const auto& id : scan) {
+    cache.add(id, 10);
+    cache.remove(id);
+    cache.add(id, 10);
+  }
+
+  std::vector<ObjectID> evicted;
+  ASSERT_EQ(40, cache.choose_objects_to_evict(40, &evicted));
+  ASSERT_EQ(scan, evicted);
+
+  // Recreating an evicted object makes it a frequently used one.
+  cache.add(scan[0], 10);
+  evicted.clear();
+  ASSERT_EQ(30, cache.choose_objects_to_evict(30, &evicted));
+  ASSERT_EQ(std::vector<ObjectID>({hot[0], hot[1], scan[0]}), evicted);
+}
+
+TEST(EvictionSimulator, Replay) {
+  std::istringstream trace(
+      "# a comment\n"
+      "create a 40\n"
+      "create b 40\n"
+      "get a\n"
+      "release a\n"
+      "create c 40\n"
+      "get b\n"
+      "release b\n"
+      "get a\n"
+      "release a\n"
+      "delete a\n");
+  EvictionSimulator simulator(EvictionPolicyType::LRU, 100);
+  ARROW_CHECK_OK(simulator.Replay(&trace));
+  const auto& stats = simulator.stats();
+  // Creating c evicts b, which evicts a when it is recreated by its get, which
+  // evicts c when it is recreated in turn.
+  ASSERT_EQ(3, stats.num_gets);
+  ASSERT_EQ(1, stats.num_hits);
+  ASSERT_EQ(120, stats.bytes_requested);
+  ASSERT_EQ(40, stats.bytes_hit);
+  ASSERT_EQ(3, stats.num_evictions);
+  ASSERT_EQ(0, stats.num_failed_creates);
+
+  std::istringstream invalid("create a\n");
+  ASSERT_TRUE(simulator.Replay(&invalid).IsInvalid());
+  std::istringstream unknown("put a 10\n");
+  ASSERT_TRUE(simulator.Replay(&unknown).IsInvalid());
+}
+
+TEST(EvictionSimulator, LargeOneShotObjects) {
+  // Small objects that are used repeatedly, interleaved with large objects
+  // that are used only once.
+  const int64_t capacity = 1000;
+  auto small = random_object_ids(10);
+  double hit_ratios[2];
+  EvictionPolicyType types[2] = {EvictionPolicyType::LRU, EvictionPolicyType::GDS};
+  for (int i = 0; i < 2; ++i) {
+    EvictionSimulator simulator(types[i], capacity);
+    for (const auto& id : small) {
+      simulator.Create(id, 20);
+    }
+    for (int round = 0; round < 20; ++round) {
+      for (int j = 0; j < 3; ++j) {
+        simulator.Create(ObjectID::from_random(), 400);
+      }
+      for (const auto& id : small) {
+        if (simulator.Get(id)) {
+          simulator.Release(id);
+        }
+      }
+    }
+    ASSERT_EQ(0, simulator.stats().num_failed_creates);
+    hit_ratios[i] = simulator.stats().hit_ratio();
+  }
+  ASSERT_LT(hit_ratios[0], hit_ratios[1]);
+  ASSERT_EQ(1.0, hit_ratios[1]);
+}
+
+}  // namespace plasma
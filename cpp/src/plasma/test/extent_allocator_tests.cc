@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <set>
+#include <vector>
+
+#include "plasma/extent_allocator.h"
+
+#include "gtest/gtest.h"
+
+namespace plasma {
+
+TEST(ExtentAllocator, SmallObjectsShareSlabs) {
+  ExtentAllocator allocator(4 * kSlabSize);
+  std::vector<int64_t> offsets;
+  for (int i = 0; i < 100; ++i) {
+    offsets.push_back(allocator.Allocate(100));
+    ASSERT_EQ(0, offsets.back() % kExtentAlignment);
+  }
+  // The objects are in the same slab, and the rest is one free extent.
+  ASSERT_LT(offsets.back() - offsets.front(), kSlabSize);
+  ASSERT_EQ(1, allocator.num_free_extents());
+  ASSERT_EQ(3 * kSlabSize, allocator.largest_free_extent());
+  ASSERT_EQ(100 * 128, allocator.allocated());
+
+  // A freed block is reused, and the slab is returned once it is empty.
+  allocator.Free(offsets[10]);
+  ASSERT_EQ(offsets[10], allocator.Allocate(128));
+  for (int64_t offset : offsets) {
+    allocator.Free(offset);
+  }
+  ASSERT_EQ(0, allocator.allocated());
+  ASSERT_EQ(4 * kSlabSize, allocator.largest_free_extent());
+}
+
+TEST(ExtentAllocator, BestFit) {
+  ExtentAllocator allocator(13 * kSlabSize);
+  std::vector<int64_t> offsets;
+  for (int64_t num_slabs : {1, 2, 1, 3, 1, 4, 1}) {
+    offsets.push_back(allocator.Allocate(num_slabs * kSlabSize));
+  }
+  ASSERT_EQ(-1, allocator.Allocate(kSlabSize));
+  // Leave holes of two, three and four slabs.
+  allocator.Free(offsets[1]);
+  allocator.Free(offsets[3]);
+  allocator.Free(offsets[5]);
+  ASSERT_EQ(3, allocator.num_free_extents());
+  ASSERT_EQ(4 * kSlabSize, allocator.largest_free_extent());
+  ASSERT_EQ(9 * kSlabSize, allocator.free());
+
+  // The smallest hole that fits is used.
+  ASSERT_EQ(offsets[3], allocator.Allocate(2 * kSlabSize + 1));
+  ASSERT_EQ(offsets[5], allocator.Allocate(4 * kSlabSize));
+  ASSERT_EQ(offsets[1], allocator.Allocate(2 * kSlabSize));
+  ASSERT_EQ(1, allocator.num_free_extents());
+  ASSERT_EQ(kSlabSize - kExtentAlignment, allocator.largest_free_extent());
+  ASSERT_EQ(-1, allocator.Allocate(kSlabSize));
+}
+
+TEST(ExtentAllocator, SmallObjectWithoutRoomForSlab) {
+  ExtentAllocator allocator(kSlabSize / 2);
+  int64_t offset = allocator.Allocate(1000);
+  ASSERT_EQ(0, offset);
+  ASSERT_EQ(1024, allocator.allocated());
+  allocator.Free(offset);
+  ASSERT_EQ(kSlabSize / 2, allocator.largest_free_extent());
+}
+
+TEST(ExtentAllocator, FindEvictionRange) {
+  ExtentAllocator allocator(10 * kSlabSize);
+  std::vector<int64_t> offsets;
+  for (int i = 0; i < 9; ++i) {
+    offsets.push_back(allocator.Allocate(kSlabSize));
+  }
+  // Objects 1, 3, 5 and 7 cannot be evicted.
+  std::set<int64_t> evictable = {offsets[0], offsets[2], offsets[4], offsets[6],
+                                 offsets[8]};
+  auto is_evictable = [&evictable](int64_t offset) {
+    return evictable.count(offset) != 0;
+  };
+  std::vector<int64_t> to_evict;
+  // The last object is next to the free space at the end.
+  ASSERT_TRUE(allocator.FindEvictionRange(2 * kSlabSize, is_evictable, &to_evict));
+  ASSERT_EQ(std::vector<int64_t>({offsets[8]}), to_evict);
+  to_evict.clear();
+  ASSERT_FALSE(allocator.FindEvictionRange(3 * kSlabSize, is_evictable, &to_evict));
+
+  // Slabs are evicted as a whole, only if all of their blocks can be.
+  allocator.Free(offsets[8]);
+  int64_t small1 = allocator.Allocate(100);
+  int64_t small2 = allocator.Allocate(100);
+  ASSERT_EQ(offsets[8], small1);
+  evictable.insert(small1);
+  to_evict.clear();
+  ASSERT_FALSE(allocator.FindEvictionRange(2 * kSlabSize, is_evictable, &to_evict));
+  evictable.insert(small2);
+  ASSERT_TRUE(allocator.FindEvictionRange(2 * kSlabSize, is_evictable, &to_evict));
+  ASSERT_EQ(std::vector<int64_t>({small1, small2}), to_evict);
+}
+
+}  // namespace plasma
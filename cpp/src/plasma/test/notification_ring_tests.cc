@@ -0,0 +1,173 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+#include "arrow/util/logging.h"
+#include "plasma/notification_ring.h"
+
+#include "gtest/gtest.h"
+
+namespace plasma {
+
+class TestNotificationRing : public ::testing::Test {
+ public:
+  void SetUp() {
+    ARROW_CHECK_OK(NotificationRing::Create("/tmp", &ring_));
+    // Map the ring a second time, like a subscriber does.
+    ARROW_CHECK_OK(NotificationRing::Open(dup(ring_->fd()), ring_->size(), &mapped_));
+  }
+
+ protected:
+  void Write(int64_t value) {
+    ring_->Write(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+  }
+
+  int64_t Value(const std::vector<uint8_t>& notification) {
+    EXPECT_EQ(sizeof(int64_t), notification.size());
+    return *reinterpret_cast<const int64_t*>(notification.data());
+  }
+
+  std::unique_ptr<NotificationRing> ring_;
+  std::unique_ptr<NotificationRing> mapped_;
+};
+
+TEST_F(TestNotificationRing, ReadersSeeEveryNotification) {
+  int reader1 = ring_->AddReader();
+  Write(1);
+  int reader2 = ring_->AddReader();
+  Write(2);
+  ASSERT_NE(reader1, reader2);
+
+  std::vector<uint8_t> notification;
+  ASSERT_EQ(NotificationRing::ReadStatus::OK, mapped_->Read(reader1, &notification));
+  ASSERT_EQ(1, Value(notification));
+  ASSERT_EQ(NotificationRing::ReadStatus::OK, mapped_->Read(reader1, &notification));
+  ASSERT_EQ(2, Value(notification));
+  ASSERT_EQ(NotificationRing::ReadStatus::EMPTY, mapped_->Read(reader1, &notification));
+
+  // A reader starts at the notification after the ones that were written
+  // before it was added.
+  ASSERT_EQ(NotificationRing::ReadStatus::OK, mapped_->Read(reader2, &notification));
+  ASSERT_EQ(2, Value(notification));
+  ASSERT_EQ(NotificationRing::ReadStatus::EMPTY, mapped_->Read(reader2, &notification));
+}
+
+TEST_F(TestNotificationRing, DetachReaderThatFallsBehind) {
+  int fast_reader = ring_->AddReader();
+  int slow_reader = ring_->AddReader();
+  std::vector<uint8_t> notification;
+  std::vector<int64_t> resent;
+  for (int64_t i = 0; i < 2 * kNotificationRingCapacity; ++i) {
+    ASSERT_EQ(-1, ring_->DetachIfFull(fast_reader));
+    int64_t sequence = ring_->DetachIfFull(slow_reader);
+    if (sequence != -1) {
+      // The notifications that the reader has not read are still in the ring.
+      for (; sequence < ring_->write_sequence(); ++sequence) {
+        const uint8_t* data;
+        int64_t size;
+        ring_->Get(sequence, &data, &size);
+        resent.push_back(*reinterpret_cast<const int64_t*>(data));
+      }
+    }
+    Write(i);
+    ASSERT_EQ(NotificationRing::ReadStatus::OK,
+              mapped_->Read(fast_reader, &notification));
+    ASSERT_EQ(i, Value(notification));
+    if (i == 10) {
+      ASSERT_EQ(NotificationRing::ReadStatus::OK,
+                mapped_->Read(slow_reader, &notification));
+      ASSERT_EQ(0, Value(notification));
+    }
+  }
+  // The slow reader read the first notification and got the others that were
+  // written before it was detached.
+  ASSERT_EQ(kNotificationRingCapacity, static_cast<int64_t>(resent.size()));
+  ASSERT_EQ(1, resent.front());
+  ASSERT_EQ(kNotificationRingCapacity, resent.back());
+  ASSERT_EQ(NotificationRing::ReadStatus::DETACHED,
+            mapped_->Read(slow_reader, &notification));
+  ASSERT_TRUE(mapped_->PrepareWait(slow_reader));
+}
+
+TEST_F(TestNotificationRing, DetachReader) {
+  int reader = ring_->AddReader();
+  std::vector<uint8_t> notification;
+  Write(1);
+  Write(2);
+  ASSERT_EQ(NotificationRing::ReadStatus::OK, mapped_->Read(reader, &notification));
+  // The notification that has not been read is sent through the socket.
+  ASSERT_EQ(1, ring_->Detach(reader));
+  ASSERT_EQ(NotificationRing::ReadStatus::DETACHED, mapped_->Read(reader, &notification));
+  ASSERT_TRUE(mapped_->PrepareWait(reader));
+}
+
+TEST_F(TestNotificationRing, IgnoreOverwrittenCursors) {
+  int reader1 = ring_->AddReader();
+  int reader2 = ring_->AddReader();
+  Write(1);
+  Write(2);
+  // Subscribers map the ring writable, so they can overwrite the header. The
+  // header holds the write sequence, followed by the cursors of the readers,
+  // each of which is on its own cache line.
+  void* pointer =
+      mmap(NULL, ring_->size(), PROT_READ | PROT_WRITE, MAP_SHARED, ring_->fd(), 0);
+  ASSERT_NE(MAP_FAILED, pointer);
+  int64_t* header = reinterpret_cast<int64_t*>(pointer);
+  header[0] = int64_t(1) << 40;
+  header[8 * (reader1 + 1)] = -5;
+  header[8 * (reader2 + 1)] = 100;
+  ASSERT_EQ(2, ring_->write_sequence());
+  // The store only resends notifications that are still in the ring.
+  ASSERT_EQ(0, ring_->Detach(reader1));
+  ASSERT_EQ(-1, ring_->DetachIfFull(reader2));
+  ASSERT_EQ(2, ring_->Detach(reader2));
+  Write(3);
+  ASSERT_EQ(3, ring_->write_sequence());
+  ASSERT_EQ(3, header[0]);
+  munmap(pointer, ring_->size());
+}
+
+TEST_F(TestNotificationRing, Waiting) {
+  int reader = ring_->AddReader();
+  // A new reader waits for the first notification.
+  ASSERT_TRUE(ring_->TakeWaiting(reader));
+  ASSERT_FALSE(ring_->TakeWaiting(reader));
+  ASSERT_FALSE(mapped_->PrepareWait(reader));
+  Write(1);
+  ASSERT_TRUE(ring_->TakeWaiting(reader));
+  ASSERT_FALSE(ring_->TakeWaiting(reader));
+  // There is a notification, so the reader does not need to wait.
+  ASSERT_TRUE(mapped_->PrepareWait(reader));
+}
+
+TEST_F(TestNotificationRing, ReuseReader) {
+  std::vector<int> readers;
+  for (int i = 0; i < kNotificationRingMaxReaders; ++i) {
+    readers.push_back(ring_->AddReader());
+    ASSERT_NE(-1, readers.back());
+  }
+  ASSERT_EQ(-1, ring_->AddReader());
+  ring_->RemoveReader(readers[3]);
+  ASSERT_EQ(readers[3], ring_->AddReader());
+}
+
+}  // namespace plasma
@@ -414,4 +414,28 @@ TEST(PlasmaSerialization, DataReply) {
   ASSERT_EQ(metadata_size1, metadata_size2);
 }
 
+TEST(PlasmaSerialization, GetAsyncReply) {
+  int fd = create_temp_file();
+  ObjectID object_id1 = ObjectID::from_random();
+  PlasmaObject object1 = random_plasma_object();
+  std::vector<uint8_t> buffer;
+  ARROW_CHECK_OK(SerializeGetAsyncReply(42, object_id1, object1, 3, 1024, &buffer));
+  ASSERT_EQ(static_cast<ssize_t>(buffer.size()), write(fd, buffer.data(), buffer.size()));
+  /* Reading message back. */
+  std::vector<uint8_t> data = read_message_from_file(fd, MessageType_PlasmaGetAsyncReply);
+  int64_t request_id;
+  ObjectID object_id2;
+  PlasmaObject object2;
+  int store_fd;
+  int64_t mmap_size;
+  ARROW_CHECK_OK(ReadGetAsyncReply(data.data(), data.size(), &request_id, &object_id2,
+                                   &object2, &store_fd, &mmap_size));
+  ASSERT_EQ(42, request_id);
+  ASSERT_EQ(object_id1, object_id2);
+  ASSERT_EQ(memcmp(&object1, &object2, sizeof(object1)), 0);
+  ASSERT_EQ(3, store_fd);
+  ASSERT_EQ(1024, mmap_size);
+  close(fd);
+}
+
 }  // namespace plasma
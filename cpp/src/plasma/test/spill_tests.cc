@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "plasma/common.h"
+#include "plasma/spill.h"
+
+#include "gtest/gtest.h"
+
+namespace plasma {
+
+class TestObjectSpiller : public ::testing::Test {
+ public:
+  void SetUp() {
+    char directory[] = "/tmp/plasma-spill-test-XXXXXX";
+    ASSERT_TRUE(mkdtemp(directory) != NULL);
+    directory_ = directory;
+  }
+
+  void TearDown() { rmdir(directory_.c_str()); }
+
+ protected:
+  // Wait until the spiller has finished the given number of operations.
+  std::vector<SpillCompletion> WaitForCompletions(ObjectSpiller* spiller,
+                                                  size_t num_completions) {
+    std::vector<SpillCompletion> completions;
+    while (completions.size() < num_completions) {
+      struct pollfd fd = {spiller->completion_fd(), POLLIN, 0};
+      EXPECT_EQ(1, poll(&fd, 1, 10000));
+      spiller->PopCompletions(&completions);
+    }
+    return completions;
+  }
+
+  std::string directory_;
+};
+
+TEST_F(TestObjectSpiller, SpillAndRestore) {
+  ObjectSpiller spiller(directory_);
+  ARROW_CHECK_OK(spiller.Init());
+  ObjectID object_id = ObjectID::from_random();
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i % 251);
+  }
+  spiller.Spill(object_id, data.data(), static_cast<int64_t>(data.size()));
+  std::vector<uint8_t> restored(data.size());
+  spiller.Restore(object_id, restored.data(), static_cast<int64_t>(restored.size()));
+
+  auto completions = WaitForCompletions(&spiller, 2);
+  ASSERT_EQ(2, static_cast<int>(completions.size()));
+  ASSERT_EQ(SpillCompletion::SPILL, completions[0].type);
+  ASSERT_TRUE(completions[0].status.ok());
+  ASSERT_EQ(1000, completions[0].size);
+  ASSERT_EQ(data.data(), completions[0].data);
+  ASSERT_EQ(SpillCompletion::RESTORE, completions[1].type);
+  ASSERT_TRUE(completions[1].object_id == object_id);
+  ASSERT_TRUE(completions[1].status.ok());
+  ASSERT_EQ(data, restored);
+
+  // The file is removed once the object has been restored.
+  spiller.Restore(object_id, restored.data(), static_cast<int64_t>(restored.size()));
+  completions = WaitForCompletions(&spiller, 1);
+  ASSERT_TRUE(completions[0].status.IsIOError());
+}
+
+TEST_F(TestObjectSpiller, RemoveFiles) {
+  ObjectID object_id = ObjectID::from_random();
+  std::vector<uint8_t> data(10);
+  {
+    ObjectSpiller spiller(directory_);
+    ARROW_CHECK_OK(spiller.Init());
+    spiller.Spill(object_id, data.data(), 10);
+    spiller.Remove(object_id);
+    std::vector<uint8_t> restored(10);
+    spiller.Restore(object_id, restored.data(), 10);
+    auto completions = WaitForCompletions(&spiller, 2);
+    ASSERT_TRUE(completions[0].status.ok());
+    ASSERT_TRUE(completions[1].status.IsIOError());
+
+    // Objects that are still spilled are removed by the destructor, which
+    // allows TearDown to remove the directory.
+    spiller.Spill(ObjectID::from_random(), data.data(), 10);
+  }
+  ASSERT_EQ(0, rmdir(directory_.c_str()));
+}
+
+TEST_F(TestObjectSpiller, InvalidDirectory) {
+  ObjectSpiller spiller(directory_ + "/nonexistent");
+  ASSERT_TRUE(spiller.Init().IsIOError());
+}
+
+}  // namespace plasma
@@ -0,0 +1,73 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import array
+import os
+import pickle
+
+import pyarrow as pa
+
+
+class SerializeObjects(object):
+    """
+    Benchmark pa.serialize and pa.deserialize round trips of nested Python
+    containers, compared to pickle
+    """
+    size = 10 ** 5
+    kinds = ('int lists', 'float lists', 'string lists', 'mixed lists',
+             'dict of int lists', 'large bytes', 'array.array')
+
+    param_names = ['kind']
+    params = [kinds]
+
+    def _generate(self, kind):
+        n = self.size
+        if kind == 'int lists':
+            return [list(range(i, i + 100)) for i in range(n // 100)]
+        elif kind == 'float lists':
+            return [[float(j) for j in range(i, i + 100)]
+                    for i in range(n // 100)]
+        elif kind == 'string lists':
+            return [[str(j) for j in range(i, i + 100)]
+                    for i in range(n // 100)]
+        elif kind == 'mixed lists':
+            return [[j, float(j), str(j)] for j in range(n // 3)]
+        elif kind == 'dict of int lists':
+            return {str(i): list(range(100)) for i in range(n // 100)}
+        elif kind == 'large bytes':
+            return [os.urandom(1 << 20) for i in range(16)]
+        elif kind == 'array.array':
+            return [array.array('d', range(1000)) for i in range(n // 1000)]
+        else:
+            raise ValueError(kind)
+
+    def setup(self, kind):
+        self.data = self._generate(kind)
+        self.serialized = pa.serialize(self.data).to_buffer()
+        self.pickled = pickle.dumps(self.data, protocol=pickle.HIGHEST_PROTOCOL)
+
+    def time_serialize(self, *args):
+        pa.serialize(self.data).to_buffer()
+
+    def time_deserialize(self, *args):
+        pa.deserialize(self.serialized)
+
+    def time_pickle_dumps(self, *args):
+        pickle.dumps(self.data, protocol=pickle.HIGHEST_PROTOCOL)
+
+    def time_pickle_loads(self, *args):
+        pickle.loads(self.pickled)
@@ -108,3 +108,24 @@ cdef class FeatherReader:
         cdef Column col = Column()
         col.init(sp_column)
         return col
+
+    def read_table(self, indices=None, int nthreads=1):
+        """
+        Read the columns at the given indices, or all columns, as a Table.
+        The columns are read by nthreads threads.
+        """
+        cdef:
+            vector[int] c_indices
+            shared_ptr[CTable] sp_table
+
+        self.reader.get().set_num_threads(nthreads)
+        if indices is None:
+            with nogil:
+                check_status(self.reader.get().Read(&sp_table))
+        else:
+            for i in indices:
+                c_indices.push_back(i)
+            with nogil:
+                check_status(self.reader.get().Read(c_indices, &sp_table))
+
+        return pyarrow_wrap_table(sp_table)
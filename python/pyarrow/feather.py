@@ -23,7 +23,7 @@ import pandas as pd
 
 from pyarrow.compat import pdapi
 from pyarrow.lib import FeatherError  # noqa
-from pyarrow.lib import RecordBatch, Table
+from pyarrow.lib import RecordBatch
 import pyarrow.lib as ext
 
 try:
@@ -45,19 +45,12 @@ class FeatherReader(ext.FeatherReader):
     def read(self, columns=None, nthreads=1):
         if columns is not None:
             column_set = set(columns)
+            indices = [i for i in range(self.num_columns)
+                       if self.get_column_name(i) in column_set]
         else:
-            column_set = None
-
-        columns = []
-        names = []
-        for i in range(self.num_columns):
-            name = self.get_column_name(i)
-            if column_set is None or name in column_set:
-                col = self.get_column(i)
-                columns.append(col)
-                names.append(name)
-
-        table = Table.from_arrays(columns, names=names)
+            indices = None
+
+        table = self.read_table(indices, nthreads=nthreads)
         return table.to_pandas(nthreads=nthreads)
 
 
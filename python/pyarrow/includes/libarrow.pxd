@@ -511,6 +511,7 @@ cdef extern from "arrow/io/api.h" namespace "arrow::io" nogil:
 
     cdef cppclass Writeable:
         CStatus Write(const uint8_t* data, int64_t nbytes)
+        CStatus Flush()
 
     cdef cppclass OutputStream(FileInterface, Writeable):
         pass
@@ -799,6 +800,10 @@ cdef extern from "arrow/ipc/api.h" namespace "arrow::ipc" nogil:
         CStatus GetColumn(int i, shared_ptr[CColumn]* out)
         c_string GetColumnName(int i)
 
+        CStatus Read(shared_ptr[CTable]* out)
+        CStatus Read(const vector[int]& indices, shared_ptr[CTable]* out)
+        void set_num_threads(int num_threads)
+
 
 cdef extern from "arrow/compute/api.h" namespace "arrow::compute" nogil:
 
@@ -899,9 +904,11 @@ cdef extern from "arrow/python/api.h" namespace "arrow::py" nogil:
 
     cdef cppclass PyReadableFile(RandomAccessFile):
         PyReadableFile(object fo)
+        PyReadableFile(object fo, int64_t buffer_size)
 
     cdef cppclass PyOutputStream(OutputStream):
         PyOutputStream(object fo)
+        PyOutputStream(object fo, int64_t buffer_size)
 
     cdef struct PandasOptions:
         c_bool strings_to_categorical
@@ -914,6 +921,7 @@ cdef extern from "arrow/python/api.h" namespace 'arrow::py' nogil:
         vector[shared_ptr[CTensor]] tensors
 
         CStatus WriteTo(OutputStream* dst)
+        CStatus WriteTo(const shared_ptr[CBuffer]& dst, int nthreads)
         CStatus GetComponents(CMemoryPool* pool, PyObject** dst)
 
     CStatus SerializeObject(object context, object sequence,
@@ -99,8 +99,11 @@ cdef class NativeFile:
     def flush(self):
         """Flush the buffer stream, if applicable.
 
-        No-op to match the IOBase interface."""
+        No-op for unbuffered streams, to match the IOBase interface."""
         self._assert_open()
+        if self.is_writable:
+            with nogil:
+                check_status(self.wr_file.get().Flush())
 
     cdef read_handle(self, shared_ptr[RandomAccessFile]* file):
         self._assert_readable()
@@ -407,17 +410,31 @@ cdef class NativeFile:
 
 
 cdef class PythonFile(NativeFile):
+    """
+    Wrap a Python file-like object for use by Arrow
+
+    Parameters
+    ----------
+    handle : file-like object
+    mode : {'w', 'r'}, default 'w'
+    buffer_size : int, default 0
+        If positive, reads and writes smaller than this are buffered in
+        memory so that the Python object is only called once per
+        buffer_size bytes. Reading ahead means the position of handle can
+        be past the position of this file
+    """
     cdef:
         object handle
 
-    def __cinit__(self, handle, mode='w'):
+    def __cinit__(self, handle, mode='w', buffer_size=0):
+        cdef int64_t c_buffer_size = buffer_size
         self.handle = handle
 
         if mode.startswith('w'):
-            self.wr_file.reset(new PyOutputStream(handle))
+            self.wr_file.reset(new PyOutputStream(handle, c_buffer_size))
             self.is_writable = True
         elif mode.startswith('r'):
-            self.rd_file.reset(new PyReadableFile(handle))
+            self.rd_file.reset(new PyReadableFile(handle, c_buffer_size))
             self.is_readable = True
         else:
             raise ValueError('Invalid file mode: {0}'.format(mode))
@@ -125,6 +125,12 @@ cdef class SerializationContext:
             self.custom_serializers[type_id] = custom_serializer
             self.custom_deserializers[type_id] = custom_deserializer
 
+    def _has_serialize_handler(self, obj):
+        for type_ in type(obj).__mro__:
+            if type_ in self.type_to_type_id:
+                return True
+        return False
+
     def _serialize_callback(self, obj):
         found = False
         for type_ in type(obj).__mro__:
@@ -264,12 +270,17 @@ cdef class SerializedPyObject:
     def to_buffer(self, nthreads=1):
         """
         Write serialized data as Buffer
+
+        Parameters
+        ----------
+        nthreads : int, default 1
+            Number of threads to use to copy the tensors and buffers
         """
-        cdef Buffer output = allocate_buffer(self.total_bytes)
-        sink = FixedSizeBufferWriter(output)
-        if nthreads > 1:
-            sink.set_memcopy_threads(nthreads)
-        self.write_to(sink)
+        cdef:
+            Buffer output = allocate_buffer(self.total_bytes)
+            int c_nthreads = nthreads
+        with nogil:
+            check_status(self.data.WriteTo(output.buffer, c_nthreads))
         return output
 
     @staticmethod
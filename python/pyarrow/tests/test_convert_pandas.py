@@ -1491,6 +1491,29 @@ class TestConvertMisc(object):
         for values in arrays:
             _check_array_roundtrip(values)
 
+    def test_category_zero_copy_outlives_table(self):
+        values = pd.Categorical(['foo', 'bar', 'baz', 'foo'] * 5)
+        df = pd.DataFrame({'cat': values})
+        table = pa.Table.from_pandas(df, preserve_index=False)
+
+        result = table.to_pandas()
+        del table
+        tm.assert_frame_equal(result, df)
+
+    def test_category_chunked_no_nulls(self):
+        arr = pa.DictionaryArray.from_arrays(
+            pa.array([0, 1, 2, 0], type=pa.int16()), ['a', 'b', 'c'])
+        batch = pa.RecordBatch.from_arrays([arr], ['foo'])
+        table = pa.Table.from_batches([batch, batch, batch])
+
+        result = table.to_pandas()
+        expected = pd.DataFrame({
+            'foo': pd.Categorical.from_codes(
+                np.array([0, 1, 2, 0] * 3, dtype='int16'),
+                categories=['a', 'b', 'c'])
+        })
+        tm.assert_frame_equal(result, expected)
+
     def test_mixed_types_fails(self):
         data = pd.DataFrame({'a': ['a', 1, 2.0]})
         with pytest.raises(pa.ArrowException):
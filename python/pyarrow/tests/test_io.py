@@ -21,6 +21,7 @@ import gc
 import os
 import pytest
 import sys
+import threading
 
 import numpy as np
 
@@ -82,6 +83,94 @@ def test_python_file_read():
     f.close()
 
 
+def test_python_file_buffered_write():
+    buf = BytesIO()
+
+    f = pa.PythonFile(buf, buffer_size=8)
+
+    f.write(b'abc')
+    f.write(b'def')
+    assert f.tell() == 6
+    assert buf.getvalue() == b''
+
+    # Spills the buffered bytes, then writes through
+    f.write(b'0123456789')
+    assert buf.getvalue() == b'abcdef0123456789'
+
+    f.write(b'xyz')
+    f.flush()
+    assert buf.getvalue() == b'abcdef0123456789xyz'
+    assert f.tell() == 19
+
+    f.write(b'!')
+    f.close()
+    assert buf.getvalue() == b'abcdef0123456789xyz!'
+
+    # The buffered bytes are written when the file is released unclosed
+    buf = BytesIO()
+    f = pa.PythonFile(buf, buffer_size=8)
+    f.write(b'abc')
+    del f
+    assert buf.getvalue() == b'abc'
+
+
+def test_python_file_buffered_read():
+    data = b''.join(str(i).encode('ascii') for i in range(200))
+
+    buf = BytesIO(data)
+    f = pa.PythonFile(buf, mode='r', buffer_size=16)
+
+    assert f.size() == len(data)
+    assert f.tell() == 0
+
+    assert f.read(4) == data[:4]
+    assert f.tell() == 4
+    assert f.read(4) == data[4:8]
+
+    # Larger than the buffer
+    assert f.read(40) == data[8:48]
+    assert f.tell() == 48
+
+    f.seek(2)
+    assert f.tell() == 2
+    assert f.read(3) == data[2:5]
+
+    f.seek(len(data) - 5)
+    assert f.read(50) == data[-5:]
+    assert f.read(50) == b''
+
+    f.close()
+
+
+def test_python_file_buffered_read_threads():
+    # Reads from several threads each get whole records, and together all
+    # of them, when the read-ahead buffer is shared
+    num_records = 2000
+    data = b''.join('{:04d}'.format(i).encode('ascii')
+                    for i in range(num_records))
+    f = pa.PythonFile(BytesIO(data), mode='r', buffer_size=10)
+
+    records = []
+
+    def read_records():
+        while True:
+            record = f.read(4)
+            if not record:
+                return
+            # list.append is atomic
+            records.append(record)
+
+    threads = [threading.Thread(target=read_records) for i in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    assert sorted(records) == [data[i:i + 4]
+                               for i in range(0, len(data), 4)]
+    f.close()
+
+
 def test_bytes_reader():
     # Like a BytesIO, but zero-copy underneath for C++ consumers
     data = b'some sample data'
@@ -20,6 +20,7 @@ from __future__ import division
 import pytest
 
 from collections import namedtuple, OrderedDict, defaultdict
+import array
 import datetime
 import os
 import string
@@ -294,6 +295,85 @@ def test_serialize_to_buffer():
             assert_equal(value, result)
 
 
+def test_serialize_to_buffer_many_tensors():
+    value = {'array_{}'.format(i): np.random.randn(1000 + i)
+             for i in range(100)}
+    serialized = pa.serialize(value)
+
+    expected = serialized.to_buffer()
+    for nthreads in [2, 8, 200]:
+        buf = serialized.to_buffer(nthreads=nthreads)
+        assert buf.equals(expected)
+        assert_equal(value, pa.deserialize(buf))
+
+
+def test_deserialize_components_outlives_components():
+    value = [np.arange(1000), np.random.randn(100, 10)]
+    components = pa.serialize(value).to_components()
+    result = pa.deserialize_components(components)
+    del components
+    assert_equal(value, result)
+
+
+def test_homogeneous_sequence_serialization(large_buffer):
+    values = [
+        [1, 2, 3], (1, 2, 3), [-1 << 63, (1 << 63) - 1], [0, 1 << 64],
+        [1.5, -2.0], (0.5,), [u"a", u"bc", u""], (u"\u262F",),
+        [1, 2.0, u"3"], [True, False], [1, True], [[1, 2], (3.0, 4.0)],
+        {"a": [1, 2], "b": (u"x", u"y")}, [[], ()], [1, None]
+    ]
+    for value in values:
+        serialization_roundtrip(value, large_buffer)
+        result = pa.deserialize(pa.serialize(value).to_buffer())
+        assert type(result) == type(value)
+        for x, y in zip(value, result):
+            assert type(x) == type(y)
+
+
+def test_large_bytes_serialization():
+    data = os.urandom(1 << 17)
+    value = [data, b"small", {"key": data}]
+    serialized = pa.serialize(value)
+    # the large bytes objects are referenced rather than copied
+    assert serialized.to_components()['num_buffers'] == 2
+    result = pa.deserialize(serialized.to_buffer())
+    assert type(result[0]) == bytes
+    assert result == value
+
+
+def test_memoryview_serialization():
+    data = bytearray(b"abcdefgh" * 100)
+    value = [memoryview(data), memoryview(data)[8:16]]
+    result = pa.deserialize(pa.serialize(value).to_buffer())
+    assert [type(x) for x in result] == [memoryview, memoryview]
+    assert [x.tobytes() for x in result] == [x.tobytes() for x in value]
+
+
+def test_pyarray_serialization():
+    value = [array.array('d', [1.0, 2.5, -3.0]), array.array('i', range(100)),
+             array.array('b')]
+    result = pa.deserialize(pa.serialize(value).to_buffer())
+    for x, y in zip(value, result):
+        assert type(y) == array.array
+        assert x.typecode == y.typecode
+        assert x == y
+
+
+def test_buffer_like_custom_serializer():
+    # Registered handlers take precedence over the zero-copy path
+    context = pa.SerializationContext()
+    context.register_type(memoryview, 'memoryview',
+                          custom_serializer=lambda x: x.tobytes(),
+                          custom_deserializer=lambda x: ('memoryview', x))
+    context.register_type(array.array, 'array.array',
+                          custom_serializer=lambda x: (x.typecode, x.tolist()),
+                          custom_deserializer=lambda x: ('array', x))
+    value = [memoryview(b'abc'), array.array('i', [1, 2, 3])]
+    serialized = pa.serialize(value, context=context)
+    result = serialized.deserialize(context=context)
+    assert result == [('memoryview', b'abc'), ('array', ('i', [1, 2, 3]))]
+
+
 def test_complex_serialization(large_buffer):
     for obj in COMPLEX_OBJECTS:
         serialization_roundtrip(obj, large_buffer)